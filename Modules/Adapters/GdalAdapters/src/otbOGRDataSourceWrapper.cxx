@@ -84,6 +84,7 @@ const ExtensionDriverAssociation k_ExtensionDriverMap[] =
     {".GMT", "OGR_GMT"},
     {".GPX", "GPX"},
     {".SQLITE", "SQLite"},
+    {".GPKG", "GPKG"},
     {".KML", "KML"},
   };
 /**\ingroup GeometryInternals
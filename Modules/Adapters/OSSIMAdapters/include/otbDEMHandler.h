@@ -29,6 +29,10 @@
 #include "itkObjectFactory.h"
 #include "itkPoint.h"
 
+#include "otbDEMTileCache.h"
+
+#include <vector>
+
 #include "OTBOSSIMAdaptersExport.h"
 
 class ossimElevManager;
@@ -80,6 +84,13 @@ namespace otb
  * height above ellipsoid, and follow the same logic as the
  * GetHeightAboveEllipsoid() method.
  *
+ * When all the opened DEM directories contain tiles GDAL can read in
+ * geographic coordinates, OTB lookups do not go through OSSIM but
+ * through a DEMTileCache, which can be queried concurrently by several
+ * threads. The geoid is then sampled once on a 15 arc-minutes grid.
+ * The batch versions of GetHeightAboveEllipsoid() and GetHeightAboveMSL()
+ * should be preferred to query many points.
+ *
  * DEM directory can either contain DTED or SRTM formats.
  * \ingroup Images
  *
@@ -143,6 +154,14 @@ public:
   virtual double GetHeightAboveEllipsoid(double lon, double lat) const;
   virtual double GetHeightAboveEllipsoid(const PointType& geoPoint) const;
 
+  /** Compute the height above MSL of a batch of geographic points. */
+  virtual void GetHeightAboveMSL(const std::vector<PointType>& geoPoints,
+                                 std::vector<double>& heights) const;
+
+  /** Compute the height above ellipsoid of a batch of geographic points. */
+  virtual void GetHeightAboveEllipsoid(const std::vector<PointType>& geoPoints,
+                                       std::vector<double>& heights) const;
+
   /** Set the default height above ellipsoid in case no information is available*/
   virtual void SetDefaultHeightAboveEllipsoid(double h);
 
@@ -173,6 +192,12 @@ protected:
 
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
 
+  /** Sample the OSSIM geoid on the grid of the tile cache */
+  void UpdateGeoidGrid();
+
+  /** Height above ellipsoid from the tile cache */
+  double GetHeightAboveEllipsoid(DEMTileCache::Handle& handle, double lon, double lat) const;
+
   // Ossim does not allow retrieving the geoid file path
   // We therefore must keep it on our side
   std::string m_GeoidFile;
@@ -181,6 +206,10 @@ protected:
   // ellipsoid We therefore must keep it on our side
   double m_DefaultHeightAboveEllipsoid;
 
+  // Native DEM tiles, used when every DEM directory could be indexed
+  DEMTileCache::Pointer m_TileCache;
+  bool                  m_UseTileCache;
+
   static Pointer m_Singleton;
 
 };
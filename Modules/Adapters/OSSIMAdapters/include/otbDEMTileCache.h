@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDEMTileCache_h
+#define otbDEMTileCache_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkFastMutexLock.h"
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "OTBOSSIMAdaptersExport.h"
+
+namespace otb
+{
+
+/** \class DEMTileCache
+ * \brief In-memory cache of DEM tiles with thread-safe lookups.
+ *
+ * The tiles of the DEM directories (SRTM hgt, DTED, GeoTIFF or any
+ * other single band raster GDAL can read, in geographic coordinates)
+ * are indexed when the directory is added, and each tile is read
+ * once, on the first lookup falling into it. Tiles stay in memory
+ * until Clear() is called.
+ *
+ * Lookups go through a Handle, which each thread owns. A handle
+ * keeps the last tile it used, so that consecutive lookups in the
+ * same tile do not touch any shared state. Lookups in loaded tiles
+ * do not take any lock: the lock of the cache is only taken to load
+ * a tile.
+ *
+ * Heights are interpolated bilinearly between the posts of the tile,
+ * ignoring no-data posts, like the OSSIM elevation handlers. An
+ * optional geoid grid, sampled on a regular geographic grid, gives
+ * the offset between the mean sea level and the ellipsoid.
+ *
+ * AddDirectory(), SetGeoidGrid() and Clear() must not be called while
+ * lookups are running.
+ *
+ * \sa DEMHandler
+ *
+ * \ingroup OTBOSSIMAdapters
+ */
+class OTBOSSIMAdapters_EXPORT DEMTileCache : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef DEMTileCache                  Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(DEMTileCache, itk::Object);
+
+  /** A DEM tile: footprint, post grid and (once loaded) heights */
+  struct Tile
+  {
+    Tile() : Loaded(false) {}
+
+    std::string        FileName;
+    double             OriginLon;   // Longitude of the first post
+    double             OriginLat;   // Latitude of the first post
+    double             StepLon;
+    double             StepLat;     // Negative for north-up tiles
+    unsigned int       SizeLon;
+    unsigned int       SizeLat;
+    double             MinLon, MaxLon, MinLat, MaxLat;
+    std::vector<float> Heights;     // No-data posts are NaN
+
+    // Set once Heights is filled (even if the tile could not be
+    // read), so that lookups can test it without the lock
+    std::atomic<bool>  Loaded;
+
+    bool Contains(double lon, double lat) const
+    {
+      return lon >= MinLon && lon <= MaxLon && lat >= MinLat && lat <= MaxLat;
+    }
+
+    /** Bilinear interpolation of the height above MSL, NaN if no
+     * valid post surrounds the point */
+    double Interpolate(double lon, double lat) const;
+  };
+
+  /** \class Handle
+   * \brief Per-thread lookup handle of a DEMTileCache.
+   *
+   * Handles are cheap to build and must not be shared between
+   * threads.
+   *
+   * \ingroup OTBOSSIMAdapters
+   */
+  class OTBOSSIMAdapters_EXPORT Handle
+  {
+  public:
+    explicit Handle(const DEMTileCache * cache) : m_Cache(cache), m_Tile(ITK_NULLPTR) {}
+
+    /** Height above mean sea level, NaN if no tile covers the point */
+    double GetHeightAboveMSL(double lon, double lat);
+
+    /** Geoid offset from the ellipsoid, NaN if no geoid is set */
+    double GetGeoidOffset(double lon, double lat) const
+    {
+      return m_Cache->GetGeoidOffset(lon, lat);
+    }
+
+  private:
+    const DEMTileCache * m_Cache;
+    const Tile *         m_Tile;
+  };
+
+  /** Index the tiles of a directory. Returns the number of tiles
+   * found, which is 0 if no file of the directory is a geographic
+   * DEM GDAL can read. A directory is only indexed once. */
+  unsigned int AddDirectory(const std::string & directory);
+
+  /** Number of indexed tiles */
+  unsigned int GetNumberOfTiles() const
+  {
+    return static_cast<unsigned int>(m_Tiles.size());
+  }
+
+  /** Set the geoid offsets sampled on a regular grid: offsets[j * sizeLon + i]
+   * is the offset at (originLon + i * step, originLat + j * step) */
+  void SetGeoidGrid(double originLon, double originLat, double step,
+                    unsigned int sizeLon, unsigned int sizeLat,
+                    const std::vector<double> & offsets);
+
+  /** Remove the geoid grid */
+  void ClearGeoidGrid();
+
+  /** Return true if a geoid grid is set */
+  bool HasGeoidGrid() const
+  {
+    return !m_GeoidOffsets.empty();
+  }
+
+  /** Geoid offset from the ellipsoid, NaN if no geoid grid is set */
+  double GetGeoidOffset(double lon, double lat) const;
+
+  /** Remove all the tiles */
+  void Clear();
+
+protected:
+  DEMTileCache();
+  ~DEMTileCache() ITK_OVERRIDE {}
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+  /** Find the tile covering a point and load it if needed. Returns
+   * NULL if no tile covers the point. */
+  const Tile * FindTile(double lon, double lat) const;
+
+  /** Read the heights of a tile */
+  void LoadTile(Tile & tile) const;
+
+private:
+  DEMTileCache(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  typedef std::pair<int, int>                          CellType;
+  typedef std::map<CellType, std::vector<unsigned int> > CellIndexType;
+
+  // Tiles are loaded lazily by const lookups. Tiles are not copyable
+  // (atomic flag): the deque keeps them in place when it grows.
+  mutable std::deque<Tile> m_Tiles;
+
+  // Tiles overlapping each one degree cell
+  CellIndexType m_CellIndex;
+
+  // Number of tiles of each indexed directory
+  std::map<std::string, unsigned int> m_Directories;
+
+  double              m_GeoidOriginLon;
+  double              m_GeoidOriginLat;
+  double              m_GeoidStep;
+  unsigned int        m_GeoidSizeLon;
+  unsigned int        m_GeoidSizeLat;
+  std::vector<double> m_GeoidOffsets;
+
+  mutable itk::SimpleFastMutexLock m_Lock;
+};
+
+} // namespace otb
+
+#endif
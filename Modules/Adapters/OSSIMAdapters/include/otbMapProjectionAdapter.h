@@ -85,6 +85,14 @@ public:
   void ForwardTransform(double lon, double lat, double h,
                         double& x, double& y, double& z);
 
+  /** Batch versions of the transforms. Input and output points are
+   * packed with inDimension and outDimension (2 or 3) coordinates per
+   * point. Without input heights, the height is 0. */
+  void InverseTransform(const double* in, unsigned int inDimension,
+                        double* out, unsigned int outDimension, size_t n);
+  void ForwardTransform(const double* in, unsigned int inDimension,
+                        double* out, unsigned int outDimension, size_t n);
+
   void PrintMap() const;
 
 protected:
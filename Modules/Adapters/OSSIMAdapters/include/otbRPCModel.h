@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRPCModel_h
+#define otbRPCModel_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+
+#include "OTBOSSIMAdaptersExport.h"
+
+namespace otb
+{
+
+/** \class RPCModel
+ * \brief Native evaluation of a rational polynomial coefficients model.
+ *
+ * The model maps a ground point (longitude, latitude, height above
+ * the ellipsoid) to an image point (sample, line) in the OSSIM image
+ * frame, through four 20 terms cubic polynomials in the normalized
+ * ground coordinates, with the RPC00B term order.
+ *
+ * WorldToImage() evaluates the model for blocks of points: the 20
+ * monomials of the block are computed once and shared by the four
+ * polynomials, and all the loops run across the points of the block
+ * so that the compiler can vectorize them.
+ *
+ * ImageToWorld() inverts the model at a given height with a Newton
+ * iteration, using the analytic jacobian of the polynomials.
+ *
+ * \sa SensorModelAdapter
+ *
+ * \ingroup OTBOSSIMAdapters
+ */
+class OTBOSSIMAdapters_EXPORT RPCModel : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef RPCModel                      Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(RPCModel, itk::Object);
+
+  /** Offsets, scales and coefficients of the model */
+  struct ParametersType
+  {
+    double LineOffset;
+    double SampleOffset;
+    double LatOffset;
+    double LonOffset;
+    double HeightOffset;
+    double LineScale;
+    double SampleScale;
+    double LatScale;
+    double LonScale;
+    double HeightScale;
+    double LineNumCoefficients[20];
+    double LineDenCoefficients[20];
+    double SampleNumCoefficients[20];
+    double SampleDenCoefficients[20];
+  };
+
+  void SetParameters(const ParametersType & parameters);
+
+  const ParametersType & GetParameters() const
+  {
+    return m_Parameters;
+  }
+
+  /** Image coordinates of n ground points. A NaN height is
+   * replaced by 0. */
+  void WorldToImage(const double * lon, const double * lat, const double * h,
+                    double * x, double * y, size_t n) const;
+
+  /** Ground coordinates of n image points at the given heights. */
+  void ImageToWorld(const double * x, const double * y, const double * h,
+                    double * lon, double * lat, size_t n) const;
+
+  /** Maximum number of Newton iterations of ImageToWorld() */
+  itkSetMacro(MaximumNumberOfIterations, unsigned int);
+  itkGetConstMacro(MaximumNumberOfIterations, unsigned int);
+
+  /** Convergence threshold of ImageToWorld(), in pixels */
+  itkSetMacro(Precision, double);
+  itkGetConstMacro(Precision, double);
+
+protected:
+  RPCModel();
+  ~RPCModel() ITK_OVERRIDE {}
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  RPCModel(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  ParametersType m_Parameters;
+
+  unsigned int m_MaximumNumberOfIterations;
+
+  double m_Precision;
+};
+
+} // namespace otb
+
+#endif
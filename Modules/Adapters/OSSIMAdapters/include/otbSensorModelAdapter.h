@@ -22,6 +22,7 @@
 #define otbSensorModelAdapter_h
 
 #include "otbDEMHandler.h"
+#include "otbRPCModel.h"
 
 class ossimProjection;
 class ossimTieGptSet;
@@ -88,6 +89,20 @@ public:
                              double& x, double& y, double& z) const;
 
 
+  /** Batch forward sensor modelling. Input points (x, y[, z]) and
+   * output points (lon, lat[, h]) are packed with inDimension and
+   * outDimension coordinates per point. Without input elevation, it
+   * is estimated by the algorithm. */
+  void ForwardTransformPoints(const double* in, unsigned int inDimension,
+                              double* out, unsigned int outDimension, size_t n) const;
+
+  /** Batch inverse sensor modelling. Input points (lon, lat[, h]) and
+   * output points (x, y[, z]) are packed with inDimension and
+   * outDimension coordinates per point. Without input elevation, the
+   * elevations of the whole batch are read from DEMHandler at once. */
+  void InverseTransformPoints(const double* in, unsigned int inDimension,
+                              double* out, unsigned int outDimension, size_t n) const;
+
   /** Add a tie point with elevation (above ellipsoid) provided by the user */
   void AddTiePoint(double x, double y, double z, double lon, double lat);
 
@@ -97,9 +112,27 @@ public:
   /** Clear all tie points */
   void ClearTiePoints();
 
-  /** Optimize sensor model with respect to tie points */
+  /** Optimize sensor model with respect to tie points. The optimized
+   * model is evaluated by OSSIM. */
   double Optimize();
 
+  /** Evaluate RPC sensor models with the native RPCModel instead of
+   * OSSIM. The native model is only used when the OSSIM model is a
+   * plain RPC model and when both give the same image coordinates on
+   * a grid of control points. Points without elevation in the forward
+   * direction still go through OSSIM, which intersects the DEM. */
+  void SetUseNativeRPCModel(bool value);
+  bool GetUseNativeRPCModel() const
+  {
+    return m_UseNativeRPCModel;
+  }
+
+  /** Return true if the transforms are done by the native RPC model */
+  bool IsUsingNativeRPCModel() const
+  {
+    return m_RPCModel.IsNotNull();
+  }
+
   /** Is sensor model valid method. return false if the m_SensorModel is null*/
   bool IsValidSensorModel() const;
 
@@ -117,8 +150,16 @@ private:
   SensorModelAdapter(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
 
+  /** Build (or drop) the native RPC model from m_SensorModel */
+  void UpdateRPCModel();
+
   InternalMapProjectionPointer m_SensorModel;
 
+  bool m_UseNativeRPCModel;
+
+  /** Native RPC model, null when OSSIM is used */
+  RPCModel::Pointer m_RPCModel;
+
   InternalTiePointsContainerPointer m_TiePoints;
 
   /** Object that read and use DEM */
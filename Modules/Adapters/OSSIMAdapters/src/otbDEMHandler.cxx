@@ -72,13 +72,46 @@ DEMHandler::Pointer DEMHandler::Instance()
 DEMHandler
 ::DEMHandler() :
   m_GeoidFile(""),
-  m_DefaultHeightAboveEllipsoid(0)
+  m_DefaultHeightAboveEllipsoid(0),
+  m_TileCache(DEMTileCache::New()),
+  m_UseTileCache(false)
 {
   assert( ossimElevManager::instance()!=NULL );
 
   ossimElevManager::instance()->setDefaultHeightAboveEllipsoid(m_DefaultHeightAboveEllipsoid);
   // Force geoid fallback
   ossimElevManager::instance()->setUseGeoidIfNullFlag(true);
+
+  // A geoid may already be loaded from the ossim preferences
+  UpdateGeoidGrid();
+}
+
+void
+DEMHandler
+::UpdateGeoidGrid()
+{
+  // The EGM96 geoid grid has a 15 arc-minutes spacing: sampling it
+  // at its nodes keeps its bilinear interpolation unchanged
+  const double       step = 0.25;
+  const unsigned int sizeLon = 1441;
+  const unsigned int sizeLat = 721;
+
+  ossimGeoidManager * geoidManager = ossimGeoidManager::instance();
+  if (ossim::isnan(geoidManager->offsetFromEllipsoid(ossimGpt(0., 0.))))
+    {
+    m_TileCache->ClearGeoidGrid();
+    return;
+    }
+
+  std::vector<double> offsets(sizeLon * sizeLat);
+  for (unsigned int j = 0; j < sizeLat; ++j)
+    {
+    for (unsigned int i = 0; i < sizeLon; ++i)
+      {
+      offsets[j * sizeLon + i] = geoidManager->offsetFromEllipsoid(ossimGpt(-90. + j * step, -180. + i * step));
+      }
+    }
+  m_TileCache->SetGeoidGrid(-180., -90., step, sizeLon, sizeLat, offsets);
 }
 
 void
@@ -89,6 +122,11 @@ DEMHandler
 
   ossimFilename ossimDEMDir( DEMDirectory );
 
+  // Native lookups are only used if every DEM directory can be indexed
+  const bool firstDirectory = ossimElevManager::instance()->getNumberOfElevationDatabases() == 0;
+  const bool indexed = m_TileCache->AddDirectory(DEMDirectory) > 0;
+  m_UseTileCache = indexed && (firstDirectory || m_UseTileCache);
+
   if (!ossimElevManager::instance()->loadElevationPath(ossimDEMDir))
     {
     // In ossim elevation database factory code, the
@@ -119,6 +157,9 @@ DEMHandler
   assert( ossimElevManager::instance()!=NULL );
 
   ossimElevManager::instance()->clear();
+
+  m_TileCache->Clear();
+  m_UseTileCache = false;
 }
 
 
@@ -172,6 +213,8 @@ DEMHandler
 
       ossimElevManager::instance()->setDefaultHeightAboveEllipsoid(ossim::nan());
 
+      UpdateGeoidGrid();
+
       return true;
       }
     else
@@ -199,6 +242,13 @@ double
 DEMHandler
 ::GetHeightAboveMSL(double lon, double lat) const
 {
+  if (m_UseTileCache)
+    {
+    DEMTileCache::Handle handle(m_TileCache);
+    double height = handle.GetHeightAboveMSL(lon, lat);
+    return ossim::isnan(height) ? 0. : height;
+    }
+
   double   height;
   ossimGpt ossimWorldPoint;
 
@@ -223,6 +273,12 @@ double
 DEMHandler
 ::GetHeightAboveEllipsoid(double lon, double lat) const
 {
+  if (m_UseTileCache)
+    {
+    DEMTileCache::Handle handle(m_TileCache);
+    return GetHeightAboveEllipsoid(handle, lon, lat);
+    }
+
   double   height;
   ossimGpt ossimWorldPoint;
 
@@ -243,6 +299,70 @@ DEMHandler
   return GetHeightAboveEllipsoid(geoPoint[0], geoPoint[1]);
 }
 
+double
+DEMHandler
+::GetHeightAboveEllipsoid(DEMTileCache::Handle& handle, double lon, double lat) const
+{
+  // Same fallbacks as ossimElevManager::getHeightAboveEllipsoid()
+  const double height = handle.GetHeightAboveMSL(lon, lat);
+  const double geoidOffset = handle.GetGeoidOffset(lon, lat);
+
+  if (!ossim::isnan(height))
+    {
+    return ossim::isnan(geoidOffset) ? height : height + geoidOffset;
+    }
+  if (!ossim::isnan(geoidOffset))
+    {
+    return geoidOffset;
+    }
+  return m_DefaultHeightAboveEllipsoid;
+}
+
+void
+DEMHandler
+::GetHeightAboveMSL(const std::vector<PointType>& geoPoints, std::vector<double>& heights) const
+{
+  heights.resize(geoPoints.size());
+
+  if (!m_UseTileCache)
+    {
+    for (size_t i = 0; i < geoPoints.size(); ++i)
+      {
+      heights[i] = GetHeightAboveMSL(geoPoints[i]);
+      }
+    return;
+    }
+
+  DEMTileCache::Handle handle(m_TileCache);
+  for (size_t i = 0; i < geoPoints.size(); ++i)
+    {
+    const double height = handle.GetHeightAboveMSL(geoPoints[i][0], geoPoints[i][1]);
+    heights[i] = ossim::isnan(height) ? 0. : height;
+    }
+}
+
+void
+DEMHandler
+::GetHeightAboveEllipsoid(const std::vector<PointType>& geoPoints, std::vector<double>& heights) const
+{
+  heights.resize(geoPoints.size());
+
+  if (!m_UseTileCache)
+    {
+    for (size_t i = 0; i < geoPoints.size(); ++i)
+      {
+      heights[i] = GetHeightAboveEllipsoid(geoPoints[i]);
+      }
+    return;
+    }
+
+  DEMTileCache::Handle handle(m_TileCache);
+  for (size_t i = 0; i < geoPoints.size(); ++i)
+    {
+    heights[i] = GetHeightAboveEllipsoid(handle, geoPoints[i][0], geoPoints[i][1]);
+    }
+}
+
 void
 DEMHandler
 ::SetDefaultHeightAboveEllipsoid(double h)
@@ -300,6 +420,8 @@ DEMHandler
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "DEMHandler" << std::endl;
+  os << indent << "UseTileCache: " << m_UseTileCache << std::endl;
+  m_TileCache->Print(os, indent.GetNextIndent());
 }
 
 } // namespace otb
@@ -0,0 +1,364 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbDEMTileCache.h"
+#include "otbMacro.h"
+
+#include "vnl/vnl_math.h"
+
+#include "itksys/SystemTools.hxx"
+#include "itksys/Directory.hxx"
+
+#include "gdal.h"
+#include "cpl_error.h"
+#include "ogr_srs_api.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace otb
+{
+
+namespace
+{
+// Open a file as a geographic single band DEM, NULL otherwise
+GDALDatasetH OpenDEMFile(const std::string & filename, double geoTransform[6])
+{
+  CPLPushErrorHandler(CPLQuietErrorHandler);
+  GDALDatasetH dataset = GDALOpen(filename.c_str(), GA_ReadOnly);
+  CPLPopErrorHandler();
+
+  if (dataset == ITK_NULLPTR)
+    {
+    return ITK_NULLPTR;
+    }
+
+  bool valid = GDALGetRasterCount(dataset) == 1
+    && GDALGetGeoTransform(dataset, geoTransform) == CE_None
+    && geoTransform[2] == 0. && geoTransform[4] == 0.;
+
+  if (valid)
+    {
+    OGRSpatialReferenceH srs = OSRNewSpatialReference(ITK_NULLPTR);
+    char * wkt = const_cast<char *>(GDALGetProjectionRef(dataset));
+    valid = wkt != ITK_NULLPTR
+      && OSRImportFromWkt(srs, &wkt) == OGRERR_NONE
+      && OSRIsGeographic(srs);
+    OSRDestroySpatialReference(srs);
+    }
+
+  if (!valid)
+    {
+    GDALClose(dataset);
+    return ITK_NULLPTR;
+    }
+  return dataset;
+}
+}
+
+double
+DEMTileCache::Tile
+::Interpolate(double lon, double lat) const
+{
+  // Position in the post grid, clamped to the tile posts
+  double x = (lon - OriginLon) / StepLon;
+  double y = (lat - OriginLat) / StepLat;
+  x = std::min(std::max(x, 0.), static_cast<double>(SizeLon - 1));
+  y = std::min(std::max(y, 0.), static_cast<double>(SizeLat - 1));
+
+  const unsigned int x0 = std::min(static_cast<unsigned int>(x), SizeLon > 1 ? SizeLon - 2 : 0);
+  const unsigned int y0 = std::min(static_cast<unsigned int>(y), SizeLat > 1 ? SizeLat - 2 : 0);
+  const unsigned int x1 = std::min(x0 + 1, SizeLon - 1);
+  const unsigned int y1 = std::min(y0 + 1, SizeLat - 1);
+  const double dx = x - x0;
+  const double dy = y - y0;
+
+  const float p00 = Heights[y0 * SizeLon + x0];
+  const float p01 = Heights[y0 * SizeLon + x1];
+  const float p10 = Heights[y1 * SizeLon + x0];
+  const float p11 = Heights[y1 * SizeLon + x1];
+
+  // Null posts do not contribute to the interpolation
+  const double w00 = !vnl_math_isnan(p00) ? (1. - dx) * (1. - dy) : 0.;
+  const double w01 = !vnl_math_isnan(p01) ? dx * (1. - dy) : 0.;
+  const double w10 = !vnl_math_isnan(p10) ? (1. - dx) * dy : 0.;
+  const double w11 = !vnl_math_isnan(p11) ? dx * dy : 0.;
+
+  const double sumWeights = w00 + w01 + w10 + w11;
+  if (sumWeights <= 0.)
+    {
+    return std::numeric_limits<double>::quiet_NaN();
+    }
+
+  double height = 0.;
+  if (w00 > 0.) height += w00 * p00;
+  if (w01 > 0.) height += w01 * p01;
+  if (w10 > 0.) height += w10 * p10;
+  if (w11 > 0.) height += w11 * p11;
+  return height / sumWeights;
+}
+
+double
+DEMTileCache::Handle
+::GetHeightAboveMSL(double lon, double lat)
+{
+  if (lon >= 180.)
+    {
+    lon -= 360.;
+    }
+  else if (lon < -180.)
+    {
+    lon += 360.;
+    }
+
+  if (m_Tile == ITK_NULLPTR || !m_Tile->Contains(lon, lat))
+    {
+    m_Tile = m_Cache->FindTile(lon, lat);
+    if (m_Tile == ITK_NULLPTR)
+      {
+      return std::numeric_limits<double>::quiet_NaN();
+      }
+    }
+  return m_Tile->Interpolate(lon, lat);
+}
+
+DEMTileCache
+::DEMTileCache()
+  : m_GeoidOriginLon(0.),
+    m_GeoidOriginLat(0.),
+    m_GeoidStep(1.),
+    m_GeoidSizeLon(0),
+    m_GeoidSizeLat(0)
+{
+  GDALAllRegister();
+}
+
+unsigned int
+DEMTileCache
+::AddDirectory(const std::string & directory)
+{
+  std::map<std::string, unsigned int>::const_iterator indexed = m_Directories.find(directory);
+  if (indexed != m_Directories.end())
+    {
+    return indexed->second;
+    }
+
+  itksys::Directory dir;
+  if (!dir.Load(directory.c_str()))
+    {
+    return 0;
+    }
+
+  unsigned int nbTiles = 0;
+  for (unsigned long i = 0; i < dir.GetNumberOfFiles(); ++i)
+    {
+    const std::string filename = directory + "/" + dir.GetFile(i);
+    if (itksys::SystemTools::FileIsDirectory(filename.c_str()))
+      {
+      continue;
+      }
+
+    double geoTransform[6];
+    GDALDatasetH dataset = OpenDEMFile(filename, geoTransform);
+    if (dataset == ITK_NULLPTR)
+      {
+      continue;
+      }
+
+    const unsigned int tileIdx = static_cast<unsigned int>(m_Tiles.size());
+    m_Tiles.emplace_back();
+    Tile & tile = m_Tiles.back();
+    tile.FileName = filename;
+    tile.SizeLon = GDALGetRasterXSize(dataset);
+    tile.SizeLat = GDALGetRasterYSize(dataset);
+    tile.StepLon = geoTransform[1];
+    tile.StepLat = geoTransform[5];
+    // GDAL geotransforms refer to the pixel corner, posts are at the
+    // pixel centers
+    tile.OriginLon = geoTransform[0] + 0.5 * tile.StepLon;
+    tile.OriginLat = geoTransform[3] + 0.5 * tile.StepLat;
+    const double endLon = geoTransform[0] + tile.SizeLon * tile.StepLon;
+    const double endLat = geoTransform[3] + tile.SizeLat * tile.StepLat;
+    tile.MinLon = std::min(geoTransform[0], endLon);
+    tile.MaxLon = std::max(geoTransform[0], endLon);
+    tile.MinLat = std::min(geoTransform[3], endLat);
+    tile.MaxLat = std::max(geoTransform[3], endLat);
+    GDALClose(dataset);
+
+    for (int lat = static_cast<int>(std::floor(tile.MinLat)); lat <= static_cast<int>(std::floor(tile.MaxLat)); ++lat)
+      {
+      for (int lon = static_cast<int>(std::floor(tile.MinLon)); lon <= static_cast<int>(std::floor(tile.MaxLon)); ++lon)
+        {
+        m_CellIndex[CellType(lon, lat)].push_back(tileIdx);
+        }
+      }
+    ++nbTiles;
+    }
+
+  m_Directories[directory] = nbTiles;
+  otbMsgDevMacro(<< nbTiles << " DEM tiles found in " << directory);
+  this->Modified();
+  return nbTiles;
+}
+
+const DEMTileCache::Tile *
+DEMTileCache
+::FindTile(double lon, double lat) const
+{
+  CellIndexType::const_iterator cell = m_CellIndex.find(
+    CellType(static_cast<int>(std::floor(lon)), static_cast<int>(std::floor(lat))));
+  if (cell == m_CellIndex.end())
+    {
+    return ITK_NULLPTR;
+    }
+
+  for (std::vector<unsigned int>::const_iterator it = cell->second.begin(); it != cell->second.end(); ++it)
+    {
+    Tile & tile = m_Tiles[*it];
+    if (tile.Contains(lon, lat))
+      {
+      // Only the first lookups in a tile take the lock
+      if (!tile.Loaded.load(std::memory_order_acquire))
+        {
+        m_Lock.Lock();
+        if (!tile.Loaded.load(std::memory_order_relaxed))
+          {
+          this->LoadTile(tile);
+          }
+        m_Lock.Unlock();
+        }
+      return tile.Heights.empty() ? ITK_NULLPTR : &tile;
+      }
+    }
+  return ITK_NULLPTR;
+}
+
+void
+DEMTileCache
+::LoadTile(Tile & tile) const
+{
+  double geoTransform[6];
+  GDALDatasetH dataset = OpenDEMFile(tile.FileName, geoTransform);
+  if (dataset == ITK_NULLPTR)
+    {
+    otbMsgDevMacro(<< "Unable to read DEM tile " << tile.FileName);
+    tile.Loaded.store(true, std::memory_order_release);
+    return;
+    }
+
+  GDALRasterBandH band = GDALGetRasterBand(dataset, 1);
+  tile.Heights.resize(static_cast<size_t>(tile.SizeLon) * tile.SizeLat);
+  if (GDALRasterIO(band, GF_Read, 0, 0, tile.SizeLon, tile.SizeLat,
+                   &tile.Heights[0], tile.SizeLon, tile.SizeLat, GDT_Float32, 0, 0) != CE_None)
+    {
+    otbMsgDevMacro(<< "Unable to read DEM tile " << tile.FileName);
+    tile.Heights.clear();
+    }
+  else
+    {
+    int hasNoData = 0;
+    const float noData = static_cast<float>(GDALGetRasterNoDataValue(band, &hasNoData));
+    if (hasNoData)
+      {
+      std::replace(tile.Heights.begin(), tile.Heights.end(), noData,
+                   std::numeric_limits<float>::quiet_NaN());
+      }
+    }
+  GDALClose(dataset);
+
+  // Publish the heights to the lookups which do not take the lock
+  tile.Loaded.store(true, std::memory_order_release);
+}
+
+void
+DEMTileCache
+::SetGeoidGrid(double originLon, double originLat, double step,
+               unsigned int sizeLon, unsigned int sizeLat,
+               const std::vector<double> & offsets)
+{
+  m_GeoidOriginLon = originLon;
+  m_GeoidOriginLat = originLat;
+  m_GeoidStep = step;
+  m_GeoidSizeLon = sizeLon;
+  m_GeoidSizeLat = sizeLat;
+  m_GeoidOffsets = offsets;
+  this->Modified();
+}
+
+void
+DEMTileCache
+::ClearGeoidGrid()
+{
+  m_GeoidSizeLon = 0;
+  m_GeoidSizeLat = 0;
+  m_GeoidOffsets.clear();
+  this->Modified();
+}
+
+double
+DEMTileCache
+::GetGeoidOffset(double lon, double lat) const
+{
+  if (m_GeoidOffsets.empty())
+    {
+    return std::numeric_limits<double>::quiet_NaN();
+    }
+
+  double x = (lon - m_GeoidOriginLon) / m_GeoidStep;
+  double y = (lat - m_GeoidOriginLat) / m_GeoidStep;
+  // The grid covers the whole longitude range
+  x -= m_GeoidSizeLon > 1 ? (m_GeoidSizeLon - 1) * std::floor(x / (m_GeoidSizeLon - 1)) : 0.;
+  x = std::min(std::max(x, 0.), static_cast<double>(m_GeoidSizeLon - 1));
+  y = std::min(std::max(y, 0.), static_cast<double>(m_GeoidSizeLat - 1));
+
+  const unsigned int x0 = std::min(static_cast<unsigned int>(x), m_GeoidSizeLon > 1 ? m_GeoidSizeLon - 2 : 0);
+  const unsigned int y0 = std::min(static_cast<unsigned int>(y), m_GeoidSizeLat > 1 ? m_GeoidSizeLat - 2 : 0);
+  const unsigned int x1 = std::min(x0 + 1, m_GeoidSizeLon - 1);
+  const unsigned int y1 = std::min(y0 + 1, m_GeoidSizeLat - 1);
+  const double dx = x - x0;
+  const double dy = y - y0;
+
+  return (1. - dy) * ((1. - dx) * m_GeoidOffsets[y0 * m_GeoidSizeLon + x0] + dx * m_GeoidOffsets[y0 * m_GeoidSizeLon + x1])
+    + dy * ((1. - dx) * m_GeoidOffsets[y1 * m_GeoidSizeLon + x0] + dx * m_GeoidOffsets[y1 * m_GeoidSizeLon + x1]);
+}
+
+void
+DEMTileCache
+::Clear()
+{
+  m_Lock.Lock();
+  m_Tiles.clear();
+  m_CellIndex.clear();
+  m_Directories.clear();
+  m_Lock.Unlock();
+  this->Modified();
+}
+
+void
+DEMTileCache
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfTiles: " << m_Tiles.size() << std::endl;
+  os << indent << "GeoidGrid: " << (this->HasGeoidGrid() ? "yes" : "no") << std::endl;
+}
+
+} // namespace otb
@@ -326,6 +326,60 @@ void MapProjectionAdapter::ForwardTransform(double lon, double lat, double h,
   z = h;
 }
 
+void MapProjectionAdapter::InverseTransform(const double* in, unsigned int inDimension,
+                                            double* out, unsigned int outDimension, size_t n)
+{
+  InternalMapProjectionPointer projection = this->GetMapProjection();
+  const ossimDatum* wgs84 = ossimDatumFactory::instance()->wgs84();
+
+  for (size_t i = 0; i < n; ++i, in += inDimension, out += outDimension)
+    {
+    const double z = inDimension > 2 ? in[2] : 0.0;
+    if (projection == ITK_NULLPTR)
+      {
+      out[0] = in[0];
+      out[1] = in[1];
+      }
+    else
+      {
+      ossimGpt ossimGPoint = projection->inverse(ossimDpt(in[0], in[1]));
+      ossimGPoint.changeDatum(wgs84);
+      out[0] = ossimGPoint.lon;
+      out[1] = ossimGPoint.lat;
+      }
+    if (outDimension > 2)
+      {
+      out[2] = z;
+      }
+    }
+}
+
+void MapProjectionAdapter::ForwardTransform(const double* in, unsigned int inDimension,
+                                            double* out, unsigned int outDimension, size_t n)
+{
+  InternalMapProjectionPointer projection = this->GetMapProjection();
+
+  for (size_t i = 0; i < n; ++i, in += inDimension, out += outDimension)
+    {
+    const double h = inDimension > 2 ? in[2] : 0.0;
+    if (projection == ITK_NULLPTR)
+      {
+      out[0] = in[0];
+      out[1] = in[1];
+      }
+    else
+      {
+      const ossimDpt ossimDPoint = projection->forward(ossimGpt(in[1], in[0], h));
+      out[0] = ossimDPoint.x;
+      out[1] = ossimDPoint.y;
+      }
+    if (outDimension > 2)
+      {
+      out[2] = h;
+      }
+    }
+}
+
 void MapProjectionAdapter::ApplyParametersToProjection()
 {
   // Start by identifying the projection, that will be necessary for
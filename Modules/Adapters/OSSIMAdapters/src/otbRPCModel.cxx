@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbRPCModel.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "vnl/vnl_math.h"
+
+namespace otb
+{
+
+namespace
+{
+
+/** Number of points evaluated together by WorldToImage() */
+const size_t BlockSize = 64;
+
+/** Monomials of the RPC00B polynomials for a block of normalized
+ * points (P: latitude, L: longitude, H: height) */
+void ComputeMonomials(const double * P, const double * L, const double * H,
+                      size_t n, double monomials[20][BlockSize])
+{
+  for (size_t j = 0; j < n; ++j)
+    {
+    const double p = P[j];
+    const double l = L[j];
+    const double h = H[j];
+    monomials[0][j]  = 1.0;
+    monomials[1][j]  = l;
+    monomials[2][j]  = p;
+    monomials[3][j]  = h;
+    monomials[4][j]  = l * p;
+    monomials[5][j]  = l * h;
+    monomials[6][j]  = p * h;
+    monomials[7][j]  = l * l;
+    monomials[8][j]  = p * p;
+    monomials[9][j]  = h * h;
+    monomials[10][j] = p * l * h;
+    monomials[11][j] = l * l * l;
+    monomials[12][j] = l * p * p;
+    monomials[13][j] = l * h * h;
+    monomials[14][j] = l * l * p;
+    monomials[15][j] = p * p * p;
+    monomials[16][j] = p * h * h;
+    monomials[17][j] = l * l * h;
+    monomials[18][j] = p * p * h;
+    monomials[19][j] = h * h * h;
+    }
+}
+
+/** Value of a polynomial for a block of points */
+void EvaluatePolynomial(const double * coefficients, const double monomials[20][BlockSize],
+                        size_t n, double * values)
+{
+  for (size_t j = 0; j < n; ++j)
+    {
+    values[j] = coefficients[0];
+    }
+  for (unsigned int k = 1; k < 20; ++k)
+    {
+    const double c = coefficients[k];
+    const double * m = monomials[k];
+    for (size_t j = 0; j < n; ++j)
+      {
+      values[j] += c * m[j];
+      }
+    }
+}
+
+/** Monomials of one normalized point and their derivatives with
+ * respect to the latitude and the longitude */
+void ComputeMonomialsAndDerivatives(double p, double l, double h,
+                                    double m[20], double dmdp[20], double dmdl[20])
+{
+  m[0]  = 1.0;       dmdp[0]  = 0.0;         dmdl[0]  = 0.0;
+  m[1]  = l;         dmdp[1]  = 0.0;         dmdl[1]  = 1.0;
+  m[2]  = p;         dmdp[2]  = 1.0;         dmdl[2]  = 0.0;
+  m[3]  = h;         dmdp[3]  = 0.0;         dmdl[3]  = 0.0;
+  m[4]  = l * p;     dmdp[4]  = l;           dmdl[4]  = p;
+  m[5]  = l * h;     dmdp[5]  = 0.0;         dmdl[5]  = h;
+  m[6]  = p * h;     dmdp[6]  = h;           dmdl[6]  = 0.0;
+  m[7]  = l * l;     dmdp[7]  = 0.0;         dmdl[7]  = 2.0 * l;
+  m[8]  = p * p;     dmdp[8]  = 2.0 * p;     dmdl[8]  = 0.0;
+  m[9]  = h * h;     dmdp[9]  = 0.0;         dmdl[9]  = 0.0;
+  m[10] = p * l * h; dmdp[10] = l * h;       dmdl[10] = p * h;
+  m[11] = l * l * l; dmdp[11] = 0.0;         dmdl[11] = 3.0 * l * l;
+  m[12] = l * p * p; dmdp[12] = 2.0 * l * p; dmdl[12] = p * p;
+  m[13] = l * h * h; dmdp[13] = 0.0;         dmdl[13] = h * h;
+  m[14] = l * l * p; dmdp[14] = l * l;       dmdl[14] = 2.0 * l * p;
+  m[15] = p * p * p; dmdp[15] = 3.0 * p * p; dmdl[15] = 0.0;
+  m[16] = p * h * h; dmdp[16] = h * h;       dmdl[16] = 0.0;
+  m[17] = l * l * h; dmdp[17] = 0.0;         dmdl[17] = 2.0 * l * h;
+  m[18] = p * p * h; dmdp[18] = 2.0 * p * h; dmdl[18] = 0.0;
+  m[19] = h * h * h; dmdp[19] = 0.0;         dmdl[19] = 0.0;
+}
+
+/** Value of a polynomial and of its derivatives for one point */
+void EvaluatePolynomial(const double * coefficients,
+                        const double m[20], const double dmdp[20], const double dmdl[20],
+                        double & value, double & dvdp, double & dvdl)
+{
+  value = 0.0;
+  dvdp = 0.0;
+  dvdl = 0.0;
+  for (unsigned int k = 0; k < 20; ++k)
+    {
+    value += coefficients[k] * m[k];
+    dvdp  += coefficients[k] * dmdp[k];
+    dvdl  += coefficients[k] * dmdl[k];
+    }
+}
+
+} // end anonymous namespace
+
+RPCModel::RPCModel()
+  : m_MaximumNumberOfIterations(20),
+    m_Precision(1e-8)
+{
+  m_Parameters = ParametersType();
+  m_Parameters.LineScale   = 1.0;
+  m_Parameters.SampleScale = 1.0;
+  m_Parameters.LatScale    = 1.0;
+  m_Parameters.LonScale    = 1.0;
+  m_Parameters.HeightScale = 1.0;
+  m_Parameters.LineDenCoefficients[0]   = 1.0;
+  m_Parameters.SampleDenCoefficients[0] = 1.0;
+}
+
+void RPCModel::SetParameters(const ParametersType & parameters)
+{
+  m_Parameters = parameters;
+  this->Modified();
+}
+
+void RPCModel::WorldToImage(const double * lon, const double * lat, const double * h,
+                            double * x, double * y, size_t n) const
+{
+  double P[BlockSize];
+  double L[BlockSize];
+  double H[BlockSize];
+  double monomials[20][BlockSize];
+  double sampleNum[BlockSize];
+  double sampleDen[BlockSize];
+  double lineNum[BlockSize];
+  double lineDen[BlockSize];
+
+  const double latOffset = m_Parameters.LatOffset;
+  const double lonOffset = m_Parameters.LonOffset;
+  const double heightOffset = m_Parameters.HeightOffset;
+  const double latScale = 1.0 / m_Parameters.LatScale;
+  const double lonScale = 1.0 / m_Parameters.LonScale;
+  const double heightScale = 1.0 / m_Parameters.HeightScale;
+
+  for (size_t start = 0; start < n; start += BlockSize)
+    {
+    const size_t count = std::min(BlockSize, n - start);
+
+    // Normalize the ground coordinates
+    for (size_t j = 0; j < count; ++j)
+      {
+      const double height = vnl_math_isnan(h[start + j]) ? 0.0 : h[start + j];
+      P[j] = (lat[start + j] - latOffset) * latScale;
+      L[j] = (lon[start + j] - lonOffset) * lonScale;
+      H[j] = (height - heightOffset) * heightScale;
+      }
+
+    ComputeMonomials(P, L, H, count, monomials);
+
+    EvaluatePolynomial(m_Parameters.SampleNumCoefficients, monomials, count, sampleNum);
+    EvaluatePolynomial(m_Parameters.SampleDenCoefficients, monomials, count, sampleDen);
+    EvaluatePolynomial(m_Parameters.LineNumCoefficients, monomials, count, lineNum);
+    EvaluatePolynomial(m_Parameters.LineDenCoefficients, monomials, count, lineDen);
+
+    // Denormalize the image coordinates
+    for (size_t j = 0; j < count; ++j)
+      {
+      x[start + j] = sampleNum[j] / sampleDen[j] * m_Parameters.SampleScale + m_Parameters.SampleOffset;
+      y[start + j] = lineNum[j] / lineDen[j] * m_Parameters.LineScale + m_Parameters.LineOffset;
+      }
+    }
+}
+
+void RPCModel::ImageToWorld(const double * x, const double * y, const double * h,
+                            double * lon, double * lat, size_t n) const
+{
+  double m[20];
+  double dmdp[20];
+  double dmdl[20];
+
+  const double sampleEpsilon = m_Precision / m_Parameters.SampleScale;
+  const double lineEpsilon = m_Precision / m_Parameters.LineScale;
+
+  for (size_t i = 0; i < n; ++i)
+    {
+    const double height = vnl_math_isnan(h[i]) ? 0.0 : h[i];
+    const double U = (x[i] - m_Parameters.SampleOffset) / m_Parameters.SampleScale;
+    const double V = (y[i] - m_Parameters.LineOffset) / m_Parameters.LineScale;
+    const double H = (height - m_Parameters.HeightOffset) / m_Parameters.HeightScale;
+
+    // Newton iteration from the center of the model
+    double P = 0.0;
+    double L = 0.0;
+    for (unsigned int iteration = 0; iteration < m_MaximumNumberOfIterations; ++iteration)
+      {
+      ComputeMonomialsAndDerivatives(P, L, H, m, dmdp, dmdl);
+
+      double sn, dsndp, dsndl, sd, dsddp, dsddl;
+      double ln, dlndp, dlndl, ld, dlddp, dlddl;
+      EvaluatePolynomial(m_Parameters.SampleNumCoefficients, m, dmdp, dmdl, sn, dsndp, dsndl);
+      EvaluatePolynomial(m_Parameters.SampleDenCoefficients, m, dmdp, dmdl, sd, dsddp, dsddl);
+      EvaluatePolynomial(m_Parameters.LineNumCoefficients, m, dmdp, dmdl, ln, dlndp, dlndl);
+      EvaluatePolynomial(m_Parameters.LineDenCoefficients, m, dmdp, dmdl, ld, dlddp, dlddl);
+
+      const double du = U - sn / sd;
+      const double dv = V - ln / ld;
+      if (std::abs(du) < sampleEpsilon && std::abs(dv) < lineEpsilon)
+        {
+        break;
+        }
+
+      // Jacobian of the normalized image coordinates
+      const double dudp = (dsndp * sd - sn * dsddp) / (sd * sd);
+      const double dudl = (dsndl * sd - sn * dsddl) / (sd * sd);
+      const double dvdp = (dlndp * ld - ln * dlddp) / (ld * ld);
+      const double dvdl = (dlndl * ld - ln * dlddl) / (ld * ld);
+
+      const double det = dudp * dvdl - dudl * dvdp;
+      if (det == 0.0)
+        {
+        break;
+        }
+
+      P += (du * dvdl - dv * dudl) / det;
+      L += (dv * dudp - du * dvdp) / det;
+      }
+
+    lat[i] = P * m_Parameters.LatScale + m_Parameters.LatOffset;
+    lon[i] = L * m_Parameters.LonScale + m_Parameters.LonOffset;
+    }
+}
+
+void RPCModel::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "LineOffset: " << m_Parameters.LineOffset << std::endl;
+  os << indent << "SampleOffset: " << m_Parameters.SampleOffset << std::endl;
+  os << indent << "LatOffset: " << m_Parameters.LatOffset << std::endl;
+  os << indent << "LonOffset: " << m_Parameters.LonOffset << std::endl;
+  os << indent << "HeightOffset: " << m_Parameters.HeightOffset << std::endl;
+  os << indent << "LineScale: " << m_Parameters.LineScale << std::endl;
+  os << indent << "SampleScale: " << m_Parameters.SampleScale << std::endl;
+  os << indent << "LatScale: " << m_Parameters.LatScale << std::endl;
+  os << indent << "LonScale: " << m_Parameters.LonScale << std::endl;
+  os << indent << "HeightScale: " << m_Parameters.HeightScale << std::endl;
+  os << indent << "MaximumNumberOfIterations: " << m_MaximumNumberOfIterations << std::endl;
+  os << indent << "Precision: " << m_Precision << std::endl;
+}
+
+} // namespace otb
@@ -21,10 +21,14 @@
 
 #include "otbSensorModelAdapter.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <vector>
 
 #include "otbMacro.h"
 #include "otbImageKeywordlist.h"
+#include "vnl/vnl_math.h"
 
 #if defined(__GNUC__) || defined(__clang__)
 #pragma GCC diagnostic push
@@ -35,6 +39,7 @@
 #include "ossim/projection/ossimSensorModelFactory.h"
 #include "ossim/projection/ossimSensorModel.h"
 #include "ossim/projection/ossimRpcProjection.h"
+#include "ossim/projection/ossimRpcModel.h"
 #include "ossim/ossimPluginProjectionFactory.h"
 #include "ossim/base/ossimTieGptSet.h"
 
@@ -44,6 +49,7 @@
 #include "ossim/projection/ossimSensorModelFactory.h"
 #include "ossim/projection/ossimSensorModel.h"
 #include "ossim/projection/ossimRpcProjection.h"
+#include "ossim/projection/ossimRpcModel.h"
 #include "ossim/ossimPluginProjectionFactory.h"
 #include "ossim/base/ossimTieGptSet.h"
 
@@ -54,7 +60,7 @@ namespace otb
 {
 
 SensorModelAdapter::SensorModelAdapter():
-  m_SensorModel(ITK_NULLPTR), m_TiePoints(ITK_NULLPTR) // FIXME keeping the original value but...
+  m_SensorModel(ITK_NULLPTR), m_UseNativeRPCModel(false), m_TiePoints(ITK_NULLPTR) // FIXME keeping the original value but...
 {
   m_DEMHandler = DEMHandler::Instance();
   m_TiePoints = new ossimTieGptSet();
@@ -79,6 +85,8 @@ void SensorModelAdapter::CreateProjection(const ImageKeywordlist& image_kwl)
     {
     m_SensorModel = ossimplugins::ossimPluginProjectionFactory::instance()->createProjection(geom);
     }
+
+  this->UpdateRPCModel();
 }
 
 bool SensorModelAdapter::IsValidSensorModel() const
@@ -86,6 +94,95 @@ bool SensorModelAdapter::IsValidSensorModel() const
   return m_SensorModel != ITK_NULLPTR;
 }
 
+void SensorModelAdapter::SetUseNativeRPCModel(bool value)
+{
+  if (m_UseNativeRPCModel != value)
+    {
+    m_UseNativeRPCModel = value;
+    this->UpdateRPCModel();
+    this->Modified();
+    }
+}
+
+void SensorModelAdapter::UpdateRPCModel()
+{
+  m_RPCModel = ITK_NULLPTR;
+
+  if (!m_UseNativeRPCModel || m_SensorModel == ITK_NULLPTR)
+    {
+    return;
+    }
+
+  ossimRpcModel * rpcModel = dynamic_cast<ossimRpcModel *>(m_SensorModel);
+  if (rpcModel == ITK_NULLPTR)
+    {
+    otbMsgDevMacro(<< "Not an RPC sensor model, using OSSIM");
+    return;
+    }
+
+  ossimRpcModel::rpcModelStruct ossimRpcStruct;
+  rpcModel->getRpcParameters(ossimRpcStruct);
+  if (ossimRpcStruct.type != 'B')
+    {
+    otbMsgDevMacro(<< "RPC model of type " << ossimRpcStruct.type << ", using OSSIM");
+    return;
+    }
+
+  RPCModel::ParametersType parameters;
+  parameters.LineOffset   = ossimRpcStruct.lineOffset;
+  parameters.SampleOffset = ossimRpcStruct.sampOffset;
+  parameters.LatOffset    = ossimRpcStruct.latOffset;
+  parameters.LonOffset    = ossimRpcStruct.lonOffset;
+  parameters.HeightOffset = ossimRpcStruct.hgtOffset;
+  parameters.LineScale    = ossimRpcStruct.lineScale;
+  parameters.SampleScale  = ossimRpcStruct.sampScale;
+  parameters.LatScale     = ossimRpcStruct.latScale;
+  parameters.LonScale     = ossimRpcStruct.lonScale;
+  parameters.HeightScale  = ossimRpcStruct.hgtScale;
+  std::copy(ossimRpcStruct.lineNumCoef, ossimRpcStruct.lineNumCoef + 20, parameters.LineNumCoefficients);
+  std::copy(ossimRpcStruct.lineDenCoef, ossimRpcStruct.lineDenCoef + 20, parameters.LineDenCoefficients);
+  std::copy(ossimRpcStruct.sampNumCoef, ossimRpcStruct.sampNumCoef + 20, parameters.SampleNumCoefficients);
+  std::copy(ossimRpcStruct.sampDenCoef, ossimRpcStruct.sampDenCoef + 20, parameters.SampleDenCoefficients);
+
+  RPCModel::Pointer model = RPCModel::New();
+  model->SetParameters(parameters);
+
+  // Check the native model against OSSIM on a grid of control points
+  // covering the validity domain of the model: OSSIM models deriving
+  // from ossimRpcModel may apply their own corrections.
+  double maxError = 0.;
+  for (int i = -3; i <= 3; ++i)
+    {
+    for (int j = -3; j <= 3; ++j)
+      {
+      for (int k = -1; k <= 1; ++k)
+        {
+        const double lat = parameters.LatOffset + i * parameters.LatScale / 3.;
+        const double lon = parameters.LonOffset + j * parameters.LonScale / 3.;
+        const double h = parameters.HeightOffset + k * parameters.HeightScale;
+
+        ossimGpt ossimGPoint(lat, lon, h);
+        ossimDpt ossimDPoint;
+        m_SensorModel->worldToLineSample(ossimGPoint, ossimDPoint);
+
+        double x, y;
+        model->WorldToImage(&lon, &lat, &h, &x, &y, 1);
+
+        const double error = std::max(std::abs(x - ossimDPoint.x), std::abs(y - ossimDPoint.y));
+        maxError = error > maxError || vnl_math_isnan(error) ? error : maxError;
+        }
+      }
+    }
+
+  if (!(maxError < 1e-6))
+    {
+    otbMsgDevMacro(<< "Native RPC model differs from OSSIM by " << maxError << " pixels, using OSSIM");
+    return;
+    }
+
+  m_RPCModel = model;
+}
+
 void SensorModelAdapter::ForwardTransformPoint(double x, double y, double z,
                                                double& lon, double& lat, double& h) const
 {
@@ -94,6 +191,15 @@ void SensorModelAdapter::ForwardTransformPoint(double x, double y, double z,
     itkExceptionMacro(<< "ForwardTransformPoint(): Invalid sensor model (m_SensorModel pointer is null)");
     }
 
+  if (m_RPCModel.IsNotNull())
+    {
+    const double ossimX = internal::ConvertToOSSIMFrame(x);
+    const double ossimY = internal::ConvertToOSSIMFrame(y);
+    m_RPCModel->ImageToWorld(&ossimX, &ossimY, &z, &lon, &lat, 1);
+    h = z;
+    return;
+    }
+
   ossimDpt ossimPoint( internal::ConvertToOSSIMFrame(x),
                        internal::ConvertToOSSIMFrame(y));
   ossimGpt ossimGPoint;
@@ -132,6 +238,16 @@ void SensorModelAdapter::InverseTransformPoint(double lon, double lat, double h,
     itkExceptionMacro(<< "InverseTransformPoint(): Invalid sensor model (m_SensorModel pointer is null)");
     }
 
+  if (m_RPCModel.IsNotNull())
+    {
+    double ossimX, ossimY;
+    m_RPCModel->WorldToImage(&lon, &lat, &h, &ossimX, &ossimY, 1);
+    x = internal::ConvertFromOSSIMFrame(ossimX);
+    y = internal::ConvertFromOSSIMFrame(ossimY);
+    z = h;
+    return;
+    }
+
   // Initialize with value from the function parameters
   ossimGpt ossimGPoint(lat, lon, h);
   ossimDpt ossimDPoint;
@@ -155,6 +271,16 @@ void SensorModelAdapter::InverseTransformPoint(double lon, double lat,
   // Get elevation from DEMHandler
   double h = m_DEMHandler->GetHeightAboveEllipsoid(lon,lat);
 
+  if (m_RPCModel.IsNotNull())
+    {
+    double ossimX, ossimY;
+    m_RPCModel->WorldToImage(&lon, &lat, &h, &ossimX, &ossimY, 1);
+    x = internal::ConvertFromOSSIMFrame(ossimX);
+    y = internal::ConvertFromOSSIMFrame(ossimY);
+    z = h;
+    return;
+    }
+
   // Initialize with value from the function parameters
   ossimGpt ossimGPoint(lat, lon, h);
   ossimDpt ossimDPoint;
@@ -166,6 +292,133 @@ void SensorModelAdapter::InverseTransformPoint(double lon, double lat,
   z = ossimGPoint.height();
 }
 
+void SensorModelAdapter::ForwardTransformPoints(const double* in, unsigned int inDimension,
+                                                double* out, unsigned int outDimension, size_t n) const
+{
+  if (this->m_SensorModel == ITK_NULLPTR)
+    {
+    itkExceptionMacro(<< "ForwardTransformPoints(): Invalid sensor model (m_SensorModel pointer is null)");
+    }
+
+  if (m_RPCModel.IsNotNull() && inDimension > 2)
+    {
+    std::vector<double> x(n), y(n), h(n), lon(n), lat(n);
+    for (size_t i = 0; i < n; ++i)
+      {
+      x[i] = internal::ConvertToOSSIMFrame(in[i * inDimension]);
+      y[i] = internal::ConvertToOSSIMFrame(in[i * inDimension + 1]);
+      h[i] = in[i * inDimension + 2];
+      }
+    if (n > 0)
+      {
+      m_RPCModel->ImageToWorld(&x[0], &y[0], &h[0], &lon[0], &lat[0], n);
+      }
+    for (size_t i = 0; i < n; ++i, out += outDimension)
+      {
+      out[0] = lon[i];
+      out[1] = lat[i];
+      if (outDimension > 2)
+        {
+        out[2] = h[i];
+        }
+      }
+    return;
+    }
+
+  ossimGpt ossimGPoint;
+  for (size_t i = 0; i < n; ++i, in += inDimension, out += outDimension)
+    {
+    ossimDpt ossimPoint( internal::ConvertToOSSIMFrame(in[0]),
+                         internal::ConvertToOSSIMFrame(in[1]));
+
+    if (inDimension > 2)
+      {
+      this->m_SensorModel->lineSampleHeightToWorld(ossimPoint, in[2], ossimGPoint);
+      }
+    else
+      {
+      this->m_SensorModel->lineSampleToWorld(ossimPoint, ossimGPoint);
+      }
+
+    out[0] = ossimGPoint.lon;
+    out[1] = ossimGPoint.lat;
+    if (outDimension > 2)
+      {
+      out[2] = ossimGPoint.hgt;
+      }
+    }
+}
+
+void SensorModelAdapter::InverseTransformPoints(const double* in, unsigned int inDimension,
+                                                double* out, unsigned int outDimension, size_t n) const
+{
+  if (this->m_SensorModel == ITK_NULLPTR)
+    {
+    itkExceptionMacro(<< "InverseTransformPoints(): Invalid sensor model (m_SensorModel pointer is null)");
+    }
+
+  // Get the elevations of the whole batch from DEMHandler
+  std::vector<double> heights;
+  if (inDimension < 3)
+    {
+    std::vector<DEMHandler::PointType> geoPoints(n);
+    for (size_t i = 0; i < n; ++i)
+      {
+      geoPoints[i][0] = in[i * inDimension];
+      geoPoints[i][1] = in[i * inDimension + 1];
+      }
+    m_DEMHandler->GetHeightAboveEllipsoid(geoPoints, heights);
+    }
+
+  if (m_RPCModel.IsNotNull())
+    {
+    std::vector<double> lon(n), lat(n), x(n), y(n);
+    if (inDimension > 2)
+      {
+      heights.resize(n);
+      }
+    for (size_t i = 0; i < n; ++i)
+      {
+      lon[i] = in[i * inDimension];
+      lat[i] = in[i * inDimension + 1];
+      if (inDimension > 2)
+        {
+        heights[i] = in[i * inDimension + 2];
+        }
+      }
+    if (n > 0)
+      {
+      m_RPCModel->WorldToImage(&lon[0], &lat[0], &heights[0], &x[0], &y[0], n);
+      }
+    for (size_t i = 0; i < n; ++i, out += outDimension)
+      {
+      out[0] = internal::ConvertFromOSSIMFrame(x[i]);
+      out[1] = internal::ConvertFromOSSIMFrame(y[i]);
+      if (outDimension > 2)
+        {
+        out[2] = heights[i];
+        }
+      }
+    return;
+    }
+
+  ossimDpt ossimDPoint;
+  for (size_t i = 0; i < n; ++i, in += inDimension, out += outDimension)
+    {
+    const double h = inDimension > 2 ? in[2] : heights[i];
+    ossimGpt ossimGPoint(in[1], in[0], h);
+
+    this->m_SensorModel->worldToLineSample(ossimGPoint, ossimDPoint);
+
+    out[0] = internal::ConvertFromOSSIMFrame(ossimDPoint.x);
+    out[1] = internal::ConvertFromOSSIMFrame(ossimDPoint.y);
+    if (outDimension > 2)
+      {
+      out[2] = ossimGPoint.height();
+      }
+    }
+}
+
 void SensorModelAdapter::AddTiePoint(double x, double y, double z, double lon, double lat)
 {
   // Create the tie point
@@ -224,6 +477,9 @@ double SensorModelAdapter::Optimize()
       // Call optimize fit
       precision  = simpleRpcModel->optimizeFit(*m_TiePoints);
       }
+
+    // The native model does not hold the adjustment, OSSIM is used
+    m_RPCModel = ITK_NULLPTR;
     }
 
   // Return the precision
@@ -243,6 +499,8 @@ bool SensorModelAdapter::ReadGeomFile(const std::string & infile)
     m_SensorModel = ossimplugins::ossimPluginProjectionFactory::instance()->createProjection(geom);
     }
 
+  this->UpdateRPCModel();
+
   // otbMsgDevMacro(<< "ReadGeomFile("<<geom<<") -> " << m_SensorModel);
   return (m_SensorModel != ITK_NULLPTR);
 }
@@ -22,6 +22,17 @@
 #include "itkMacro.h"
 #include "otbDEMHandler.h"
 
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#pragma GCC diagnostic ignored "-Wshadow"
+#include "ossim/elevation/ossimElevManager.h"
+#pragma GCC diagnostic pop
+#else
+#include "ossim/elevation/ossimElevManager.h"
+#endif
+
 int otbDEMHandlerTest(int argc, char * argv[])
 {
   if(argc!=9)
@@ -120,3 +131,64 @@ int otbDEMHandlerTest(int argc, char * argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbDEMHandlerBatchTest(int argc, char * argv[])
+{
+  if(argc!=8)
+    {
+    std::cerr<<"Usage: "<<argv[0]<<" demdir geoid originLongitude originLatitude spacing size tolerance"<<std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::string demdir    = argv[1];
+  std::string geoid     = argv[2];
+  double originLon      = atof(argv[3]);
+  double originLat      = atof(argv[4]);
+  double spacing        = atof(argv[5]);
+  unsigned int size     = atoi(argv[6]);
+  double tolerance      = atof(argv[7]);
+
+  otb::DEMHandler::Pointer demHandler = otb::DEMHandler::Instance();
+  demHandler->OpenDEMDirectory(demdir);
+  demHandler->OpenGeoidFile(geoid);
+
+  std::vector<otb::DEMHandler::PointType> points;
+  for (unsigned int j = 0; j < size; ++j)
+    {
+    for (unsigned int i = 0; i < size; ++i)
+      {
+      otb::DEMHandler::PointType point;
+      point[0] = originLon + i * spacing;
+      point[1] = originLat - j * spacing;
+      points.push_back(point);
+      }
+    }
+
+  std::vector<double> heights;
+  std::vector<double> heightsMSL;
+  demHandler->GetHeightAboveEllipsoid(points, heights);
+  demHandler->GetHeightAboveMSL(points, heightsMSL);
+
+  // Batch lookups must match single point lookups and OSSIM lookups
+  bool fail = false;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    {
+    ossimGpt ossimWorldPoint;
+    ossimWorldPoint.lon = points[i][0];
+    ossimWorldPoint.lat = points[i][1];
+    const double ossimHeight = ossimElevManager::instance()->getHeightAboveEllipsoid(ossimWorldPoint);
+    const double ossimHeightMSL = ossimElevManager::instance()->getHeightAboveMSL(ossimWorldPoint);
+
+    if (heights[i] != demHandler->GetHeightAboveEllipsoid(points[i])
+        || heightsMSL[i] != demHandler->GetHeightAboveMSL(points[i])
+        || vcl_abs(heights[i] - ossimHeight) > tolerance
+        || vcl_abs(heightsMSL[i] - ossimHeightMSL) > tolerance)
+      {
+      std::cerr<<"Heights differ at "<<points[i]<<": batch "<<heights[i]<<" (MSL "<<heightsMSL[i]
+               <<"), ossim "<<ossimHeight<<" (MSL "<<ossimHeightMSL<<")"<<std::endl;
+      fail = true;
+      }
+    }
+
+  return fail ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "otbSensorModelAdapter.h"
+#include "itkTimeProbe.h"
+
+int otbRPCModelTest(int argc, char* argv[])
+{
+  if (argc < 6)
+    {
+    std::cout << "Usage: test_driver input grid_size img_tol dem_dir geoid" << std::endl;
+    return EXIT_FAILURE;
+    }
+  // This test checks the native RPC model against the OSSIM one:
+  // image coordinates of ground points must be the same, and the
+  // native forward transform must invert the inverse one.
+  const std::string infname = argv[1];
+  const unsigned int gridSize = atoi(argv[2]);
+  const double imgTol = atof(argv[3]);
+  const std::string demdir = argv[4];
+  const std::string geoid = argv[5];
+
+  otb::DEMHandler::Pointer demHandler = otb::DEMHandler::Instance();
+  if(demdir!="no")
+    demHandler->OpenDEMDirectory(demdir);
+  if(geoid!="no")
+    demHandler->OpenGeoidFile(geoid);
+
+  typedef otb::Image<double>              ImageType;
+  typedef otb::ImageFileReader<ImageType> ReaderType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(infname);
+  reader->UpdateOutputInformation();
+
+  otb::SensorModelAdapter::Pointer ossimModel = otb::SensorModelAdapter::New();
+  ossimModel->CreateProjection(reader->GetOutput()->GetImageKeywordlist());
+
+  otb::SensorModelAdapter::Pointer nativeModel = otb::SensorModelAdapter::New();
+  nativeModel->SetUseNativeRPCModel(true);
+  nativeModel->CreateProjection(reader->GetOutput()->GetImageKeywordlist());
+
+  if (!ossimModel->IsValidSensorModel() || !nativeModel->IsUsingNativeRPCModel())
+    {
+    std::cerr << "The native RPC model could not be built from " << infname << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Ground points of a grid of image points
+  const ImageType::SizeType size = reader->GetOutput()->GetLargestPossibleRegion().GetSize();
+  std::vector<double> imagePoints;
+  std::vector<double> groundPoints;
+  for (unsigned int i = 0; i <= gridSize; ++i)
+    {
+    for (unsigned int j = 0; j <= gridSize; ++j)
+      {
+      const double x = i * static_cast<double>(size[0]) / gridSize;
+      const double y = j * static_cast<double>(size[1]) / gridSize;
+      double lon, lat, h;
+      ossimModel->ForwardTransformPoint(x, y, lon, lat, h);
+      imagePoints.push_back(x);
+      imagePoints.push_back(y);
+      groundPoints.push_back(lon);
+      groundPoints.push_back(lat);
+      groundPoints.push_back(h);
+      }
+    }
+  const size_t n = imagePoints.size() / 2;
+
+  double inverseError = 0.;
+  double demInverseError = 0.;
+  double forwardError = 0.;
+  double roundTripError = 0.;
+  for (size_t i = 0; i < n; ++i)
+    {
+    const double x = imagePoints[2 * i];
+    const double y = imagePoints[2 * i + 1];
+    const double lon = groundPoints[3 * i];
+    const double lat = groundPoints[3 * i + 1];
+    const double h = groundPoints[3 * i + 2];
+
+    // Inverse transform, with the given height and from the DEM
+    double ossimX, ossimY, ossimZ, nativeX, nativeY, nativeZ;
+    ossimModel->InverseTransformPoint(lon, lat, h, ossimX, ossimY, ossimZ);
+    nativeModel->InverseTransformPoint(lon, lat, h, nativeX, nativeY, nativeZ);
+    inverseError = std::max(inverseError, std::max(std::abs(ossimX - nativeX), std::abs(ossimY - nativeY)));
+
+    ossimModel->InverseTransformPoint(lon, lat, ossimX, ossimY, ossimZ);
+    nativeModel->InverseTransformPoint(lon, lat, nativeX, nativeY, nativeZ);
+    demInverseError = std::max(demInverseError, std::max(std::abs(ossimX - nativeX), std::abs(ossimY - nativeY)));
+
+    // Forward transform at the given height, checked in image space
+    double ossimLon, ossimLat, ossimH, nativeLon, nativeLat, nativeH;
+    ossimModel->ForwardTransformPoint(x, y, h, ossimLon, ossimLat, ossimH);
+    nativeModel->ForwardTransformPoint(x, y, h, nativeLon, nativeLat, nativeH);
+
+    nativeModel->InverseTransformPoint(ossimLon, ossimLat, h, ossimX, ossimY, ossimZ);
+    forwardError = std::max(forwardError, std::max(std::abs(ossimX - x), std::abs(ossimY - y)));
+
+    nativeModel->InverseTransformPoint(nativeLon, nativeLat, h, nativeX, nativeY, nativeZ);
+    roundTripError = std::max(roundTripError, std::max(std::abs(nativeX - x), std::abs(nativeY - y)));
+    }
+
+  std::cout << "Max inverse error: " << inverseError << " pixels" << std::endl;
+  std::cout << "Max inverse error with DEM: " << demInverseError << " pixels" << std::endl;
+  std::cout << "Max OSSIM forward error: " << forwardError << " pixels" << std::endl;
+  std::cout << "Max native forward error: " << roundTripError << " pixels" << std::endl;
+
+  // Batch inverse transform, compared with OSSIM and timed
+  const unsigned int repeat = 100;
+  std::vector<double> ossimPoints(2 * n);
+  std::vector<double> nativePoints(2 * n);
+  itk::TimeProbe ossimChrono, nativeChrono;
+  for (unsigned int r = 0; r < repeat; ++r)
+    {
+    ossimChrono.Start();
+    ossimModel->InverseTransformPoints(&groundPoints[0], 3, &ossimPoints[0], 2, n);
+    ossimChrono.Stop();
+    nativeChrono.Start();
+    nativeModel->InverseTransformPoints(&groundPoints[0], 3, &nativePoints[0], 2, n);
+    nativeChrono.Stop();
+    }
+
+  double batchError = 0.;
+  for (size_t i = 0; i < 2 * n; ++i)
+    {
+    batchError = std::max(batchError, std::abs(ossimPoints[i] - nativePoints[i]));
+    }
+  std::cout << "Max batch inverse error: " << batchError << " pixels" << std::endl;
+  std::cout << "OSSIM: " << ossimChrono.GetTotal() << " s, native: " << nativeChrono.GetTotal()
+            << " s for " << repeat * n << " points" << std::endl;
+
+  // The native model is exact where OSSIM iterates to a tolerance
+  if (!(inverseError < 1e-6 && demInverseError < 1e-6 && batchError < 1e-6
+        && roundTripError < 1e-6 && forwardError < imgTol))
+    {
+    std::cerr << "Native RPC model does not match OSSIM" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -22,6 +22,8 @@
 #include "otbWrapperApplicationFactory.h"
 
 #include "otbImageSampleExtractorFilter.h"
+#include "otbOGRFeatureWrapper.h"
+#include "otbContiguousSampleStore.h"
 
 namespace otb
 {
@@ -50,6 +52,8 @@ public:
   /** Filters typedef */
   typedef otb::ImageSampleExtractorFilter<FloatVectorImageType> FilterType;
 
+  typedef otb::ContiguousSampleStoreWriter<float, int>         StoreWriterType;
+
 private:
   SampleExtraction() {}
 
@@ -78,6 +82,13 @@ private:
     AddParameter(ParameterType_OutputFilename, "out", "Output samples");
     SetParameterDescription("out","Output vector data file storing sample"
       "values (OGR format). If not given, the input vector data file is updated");
+
+    AddParameter(ParameterType_OutputFilename, "outstore", "Output sample store");
+    SetParameterDescription("outstore","Output file storing the sample values "
+      "and the class labels in a single binary matrix, which can be given to "
+      "TrainVectorClassifier (io.store parameter) instead of the vector data. "
+      "Values are stored in the order of the output fields.");
+    MandatoryOff("outstore");
     MandatoryOff("out");
 
     AddParameter(ParameterType_Choice, "outfield", "Output field names");
@@ -208,6 +219,67 @@ private:
     AddProcess(filter->GetStreamer(),"Extracting sample values...");
     filter->Update();
     output->SyncToDisk();
+
+    if (IsParameterEnabled("outstore") && HasValue("outstore"))
+      {
+      WriteSampleStore(output, filter->GetOutputFieldNames(), fieldName);
+      }
+    }
+
+  /** Write the sample values and the class labels of the output layer to a
+   * sample store, feature by feature */
+  void WriteSampleStore(ogr::DataSource * output,
+                        const std::vector<std::string> & sampleFieldNames,
+                        const std::string & classFieldName)
+    {
+    // In update mode, the samples are in the input layer
+    ogr::Layer layer = output->GetLayersCount() == 1
+                       ? output->GetLayer(0)
+                       : output->GetLayer(this->GetParameterInt("layer"));
+    layer.ogr().ResetReading();
+
+    OGRFeatureDefn &layerDefn = layer.GetLayerDefn();
+    const int cFieldIndex = layerDefn.GetFieldIndex(classFieldName.c_str());
+    if (cFieldIndex < 0)
+      {
+      otbAppLogFATAL("The field name for class label (" << classFieldName
+                     << ") has not been found in the output samples");
+      }
+    const unsigned int nbFeatures = sampleFieldNames.size();
+    std::vector<int> featureFieldIndex(nbFeatures, -1);
+    for (unsigned int i = 0; i < nbFeatures; ++i)
+      {
+      featureFieldIndex[i] = layerDefn.GetFieldIndex(sampleFieldNames[i].c_str());
+      if (featureFieldIndex[i] < 0)
+        {
+        otbAppLogFATAL("The field name for feature " << sampleFieldNames[i]
+                       << " has not been found in the output samples");
+        }
+      }
+
+    StoreWriterType::Pointer writer = StoreWriterType::New();
+    writer->Open(this->GetParameterString("outstore"), nbFeatures);
+
+    std::vector<float> sample(nbFeatures);
+    ogr::Feature feature = layer.ogr().GetNextFeature();
+    while (feature.addr() != 0)
+      {
+      for (unsigned int i = 0; i < nbFeatures; ++i)
+        {
+        sample[i] = static_cast<float>(feature.ogr().GetFieldAsDouble(featureFieldIndex[i]));
+        }
+      int label = 0;
+      if (ogr::Field(feature, cFieldIndex).HasBeenSet())
+        {
+        label = feature.ogr().GetFieldAsInteger(cFieldIndex);
+        }
+      writer->Write(&sample[0], label);
+      feature = layer.ogr().GetNextFeature();
+      }
+    writer->Close();
+
+    otbAppLogINFO("Wrote " << writer->GetNumberOfSamples() << " samples to "
+                  << this->GetParameterString("outstore"));
     }
 
 };
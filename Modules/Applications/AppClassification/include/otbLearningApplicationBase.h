@@ -103,6 +103,8 @@ public:
   typedef typename ModelType::TargetListSampleType  TargetListSampleType;
   typedef typename ModelType::TargetValueType       TargetValueType;
 
+  typedef typename ModelType::SampleStoreType       SampleStoreType;
+
   itkGetConstReferenceMacro(SupervisedClassifier, std::vector<std::string>);
   itkGetConstReferenceMacro(UnsupervisedClassifier, std::vector<std::string>);
 
@@ -134,6 +136,13 @@ protected:
     typename ListSampleType::Pointer validationListSample,
     std::string modelPath);
 
+  /** Generic method to load a model file and use it to classify the samples
+   * of a contiguous store. The samples are predicted by chunks, so that
+   * only one chunk is copied to a list sample at a time. */
+  typename TargetListSampleType::Pointer Classify(
+    const SampleStoreType * validationStore,
+    std::string modelPath);
+
   /** Init method that creates all the parameters for machine learning models */
   void DoInit() ITK_OVERRIDE;
 
@@ -141,6 +150,10 @@ protected:
    * False by default, child classes may change it in their constructor */
   bool m_RegressionFlag;
 
+  /** Contiguous training samples. When set, the models read their training
+   * samples and labels from it instead of the list samples given to Train() */
+  typename SampleStoreType::ConstPointer m_TrainingSampleStore;
+
 private:
   /** Specific Init and Train methods for each machine learning model */
 
@@ -25,6 +25,8 @@
 // only need this filter as a dummy process object
 #include "otbRGBAPixelConverter.h"
 
+#include <algorithm>
+
 namespace otb
 {
 namespace Wrapper
@@ -162,6 +164,72 @@ LearningApplicationBase<TInputValue,TOutputValue>
   return predictedList;
 }
 
+template <class TInputValue, class TOutputValue>
+typename LearningApplicationBase<TInputValue,TOutputValue>
+::TargetListSampleType::Pointer
+LearningApplicationBase<TInputValue,TOutputValue>
+::Classify(const SampleStoreType * validationStore,
+           std::string modelPath)
+{
+  // Setup fake reporter
+  RGBAPixelConverter<int,int>::Pointer dummyFilter =
+    RGBAPixelConverter<int,int>::New();
+  dummyFilter->SetProgress(0.0f);
+  this->AddProcess(dummyFilter,"Classify...");
+  dummyFilter->InvokeEvent(itk::StartEvent());
+
+  // load a machine learning model from file and predict the input samples
+  ModelPointerType model = ModelFactoryType::CreateMachineLearningModel(modelPath,
+                                                                        ModelFactoryType::ReadMode);
+
+  if (model.IsNull())
+    {
+    otbAppLogFATAL(<< "Error when loading model " << modelPath);
+    }
+
+  model->Load(modelPath);
+  model->SetRegressionMode(this->m_RegressionFlag);
+
+  typedef typename SampleStoreType::SizeType StoreSizeType;
+  const StoreSizeType nbSamples = validationStore->Size();
+  const unsigned int nbFeatures = validationStore->GetNumberOfFeatures();
+  const StoreSizeType chunkSize = 65536;
+
+  typename TargetListSampleType::Pointer predictedList = TargetListSampleType::New();
+  predictedList->SetMeasurementVectorSize(1);
+  predictedList->Resize(nbSamples);
+
+  // The samples of the chunk list are reused from one chunk to the next
+  typename ListSampleType::Pointer chunk = ListSampleType::New();
+  chunk->SetMeasurementVectorSize(nbFeatures);
+  SampleType sample(nbFeatures);
+
+  for (StoreSizeType start = 0; start < nbSamples; start += chunkSize)
+    {
+    const StoreSizeType size = std::min(chunkSize, nbSamples - start);
+    chunk->Resize(size);
+    for (StoreSizeType id = 0; id < size; ++id)
+      {
+      const InputValueType * values = validationStore->GetSample(start + id);
+      std::copy(values, values + nbFeatures, sample.GetDataPointer());
+      chunk->SetMeasurementVector(id, sample);
+      }
+
+    typename TargetListSampleType::Pointer chunkPredictions = model->PredictBatch(chunk, NULL);
+    for (StoreSizeType id = 0; id < size; ++id)
+      {
+      predictedList->SetMeasurementVector(start + id, chunkPredictions->GetMeasurementVector(id));
+      }
+
+    dummyFilter->UpdateProgress(static_cast<float>(start + size) / nbSamples);
+    }
+
+  dummyFilter->UpdateProgress(1.0f);
+  dummyFilter->InvokeEvent(itk::EndEvent());
+
+  return predictedList;
+}
+
 template <class TInputValue, class TOutputValue>
 void
 LearningApplicationBase<TInputValue,TOutputValue>
@@ -94,6 +94,7 @@ namespace Wrapper
     boostClassifier->SetRegressionMode(this->m_RegressionFlag);
     boostClassifier->SetInputListSample(trainingListSample);
     boostClassifier->SetTargetListSample(trainingLabeledListSample);
+    boostClassifier->SetInputSampleStore(this->m_TrainingSampleStore);
     boostClassifier->SetBoostType(GetParameterInt("classifier.boost.t"));
     boostClassifier->SetWeakCount(GetParameterInt("classifier.boost.w"));
     boostClassifier->SetWeightTrimRate(GetParameterFloat("classifier.boost.r"));
@@ -116,6 +116,7 @@ LearningApplicationBase<TInputValue,TOutputValue>
   classifier->SetRegressionMode(this->m_RegressionFlag);
   classifier->SetInputListSample(trainingListSample);
   classifier->SetTargetListSample(trainingLabeledListSample);
+  classifier->SetInputSampleStore(this->m_TrainingSampleStore);
   classifier->SetMaxDepth(GetParameterInt("classifier.dt.max"));
   classifier->SetMinSampleCount(GetParameterInt("classifier.dt.min"));
   classifier->SetRegressionAccuracy(GetParameterFloat("classifier.dt.ra"));
@@ -102,6 +102,7 @@ LearningApplicationBase<TInputValue,TOutputValue>
   classifier->SetRegressionMode(this->m_RegressionFlag);
   classifier->SetInputListSample(trainingListSample);
   classifier->SetTargetListSample(trainingLabeledListSample);
+  classifier->SetInputSampleStore(this->m_TrainingSampleStore);
   classifier->SetWeakCount(GetParameterInt("classifier.gbt.w"));
   classifier->SetShrinkage(GetParameterFloat("classifier.gbt.s"));
   classifier->SetSubSamplePortion(GetParameterFloat("classifier.gbt.p"));
@@ -68,6 +68,7 @@ namespace Wrapper
     knnClassifier->SetRegressionMode(this->m_RegressionFlag);
     knnClassifier->SetInputListSample(trainingListSample);
     knnClassifier->SetTargetListSample(trainingLabeledListSample);
+    knnClassifier->SetInputSampleStore(this->m_TrainingSampleStore);
     knnClassifier->SetK(GetParameterInt("classifier.knn.k"));
     if (this->m_RegressionFlag)
       {
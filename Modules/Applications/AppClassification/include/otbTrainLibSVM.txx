@@ -135,6 +135,7 @@ namespace Wrapper
     libSVMClassifier->SetRegressionMode(this->m_RegressionFlag);
     libSVMClassifier->SetInputListSample(trainingListSample);
     libSVMClassifier->SetTargetListSample(trainingLabeledListSample);
+    libSVMClassifier->SetInputSampleStore(this->m_TrainingSampleStore);
     //SVM Option
     //TODO : Add other options ?
     if (IsParameterEnabled("classifier.libsvm.opt"))
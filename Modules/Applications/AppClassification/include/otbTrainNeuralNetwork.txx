@@ -170,6 +170,7 @@ LearningApplicationBase<TInputValue,TOutputValue>
   classifier->SetRegressionMode(this->m_RegressionFlag);
   classifier->SetInputListSample(trainingListSample);
   classifier->SetTargetListSample(trainingLabeledListSample);
+  classifier->SetInputSampleStore(this->m_TrainingSampleStore);
 
   switch (GetParameterInt("classifier.ann.t"))
     {
@@ -188,7 +189,8 @@ LearningApplicationBase<TInputValue,TOutputValue>
   std::vector<std::string> sizes = GetParameterStringList("classifier.ann.sizes");
 
 
-  unsigned int nbImageBands = trainingListSample->GetMeasurementVectorSize();
+  unsigned int nbImageBands = this->m_TrainingSampleStore.IsNotNull() ?
+    this->m_TrainingSampleStore->GetNumberOfFeatures() : trainingListSample->GetMeasurementVectorSize();
   layerSizes.push_back(nbImageBands);
   for (unsigned int i = 0; i < sizes.size(); i++)
     {
@@ -206,9 +208,11 @@ LearningApplicationBase<TInputValue,TOutputValue>
     {
     std::set<TargetValueType> labelSet;
     TargetSampleType currentLabel;
-    for (unsigned int itLab = 0; itLab < trainingLabeledListSample->Size(); ++itLab)
+    // Labels of the sample store are in the target list sample of the model
+    const TargetListSampleType * labels = classifier->GetTargetListSample();
+    for (unsigned int itLab = 0; itLab < labels->Size(); ++itLab)
       {
-      currentLabel = trainingLabeledListSample->GetMeasurementVector(itLab);
+      currentLabel = labels->GetMeasurementVector(itLab);
       labelSet.insert(currentLabel[0]);
       }
     nbClasses = labelSet.size();
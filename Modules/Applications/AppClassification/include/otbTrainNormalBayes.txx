@@ -51,6 +51,7 @@ namespace Wrapper
     classifier->SetRegressionMode(this->m_RegressionFlag);
     classifier->SetInputListSample(trainingListSample);
     classifier->SetTargetListSample(trainingLabeledListSample);
+    classifier->SetInputSampleStore(this->m_TrainingSampleStore);
     classifier->Train();
     classifier->Save(modelPath);
   }
@@ -116,6 +116,7 @@ LearningApplicationBase<TInputValue,TOutputValue>
   classifier->SetRegressionMode(this->m_RegressionFlag);
   classifier->SetInputListSample(trainingListSample);
   classifier->SetTargetListSample(trainingLabeledListSample);
+  classifier->SetInputSampleStore(this->m_TrainingSampleStore);
   classifier->SetMaxDepth(GetParameterInt("classifier.rf.max"));
   classifier->SetMinSampleCount(GetParameterInt("classifier.rf.min"));
   classifier->SetRegressionAccuracy(GetParameterFloat("classifier.rf.ra"));
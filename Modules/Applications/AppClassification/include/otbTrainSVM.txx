@@ -140,6 +140,7 @@ namespace Wrapper
     SVMClassifier->SetRegressionMode(this->m_RegressionFlag);
     SVMClassifier->SetInputListSample(trainingListSample);
     SVMClassifier->SetTargetListSample(trainingLabeledListSample);
+    SVMClassifier->SetInputSampleStore(this->m_TrainingSampleStore);
     switch (GetParameterInt("classifier.svm.k"))
       {
       case 0: // LINEAR
@@ -64,6 +64,7 @@ void LearningApplicationBase<TInputValue, TOutputValue>::TrainSharkKMeans(
   classifier->SetRegressionMode( this->m_RegressionFlag );
   classifier->SetInputListSample( trainingListSample );
   classifier->SetTargetListSample( trainingLabeledListSample );
+  classifier->SetInputSampleStore(this->m_TrainingSampleStore);
   classifier->SetK( k );
   classifier->SetMaximumNumberOfIterations( nbMaxIter );
   classifier->Train();
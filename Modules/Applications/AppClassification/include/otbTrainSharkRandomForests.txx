@@ -89,6 +89,7 @@ LearningApplicationBase<TInputValue,TOutputValue>
   classifier->SetRegressionMode(this->m_RegressionFlag);
   classifier->SetInputListSample(trainingListSample);
   classifier->SetTargetListSample(trainingLabeledListSample);
+  classifier->SetInputSampleStore(this->m_TrainingSampleStore);
   classifier->SetNodeSize(GetParameterInt("classifier.sharkrf.nodesize"));
   classifier->SetOobRatio(GetParameterFloat("classifier.sharkrf.oobr"));
   classifier->SetNumberOfTrees(GetParameterInt("classifier.sharkrf.nbtrees"));
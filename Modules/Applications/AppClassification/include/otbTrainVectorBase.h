@@ -63,6 +63,7 @@ public:
   typedef Superclass::SampleType SampleType;
   typedef Superclass::ListSampleType ListSampleType;
   typedef Superclass::TargetListSampleType TargetListSampleType;
+  typedef Superclass::SampleStoreType SampleStoreType;
 
   typedef double ValueType;
   typedef itk::VariableLengthVector <ValueType> MeasurementType;
@@ -140,12 +141,12 @@ protected:
   virtual void ExtractAllSamples(const ShiftScaleParameters &measurement);
 
   /**
-  * Extract the training sample list
+  * Extract the training samples, from the sample store file if given,
+  * from the input vector data otherwise
   * \param measurement statics measurement (mean/stddev)
-  * \param featuresInfo information about the features
-  * \return sample list used for training
+  * \return contiguous samples used for training
   */
-  virtual SamplesWithLabel ExtractTrainingSamplesWithLabel(const ShiftScaleParameters &measurement);
+  virtual SampleStoreType::Pointer ExtractTrainingSampleStore(const ShiftScaleParameters &measurement);
 
   /**
    * Extract classification the sample list
@@ -167,6 +168,27 @@ protected:
   SamplesWithLabel
   ExtractSamplesWithLabel(std::string parameterName, std::string parameterLayer, const ShiftScaleParameters &measurement);
 
+  /** Extract samples from input file for corresponding field name in a
+   * contiguous store. The samples are centered and reduced from the values
+   * read in the file, before their conversion to the sample type.
+   *
+   * \param parameterName the name of the input file option in the input application parameters
+   * \param parameterLayer the name of the layer option in the input application parameters
+   * \param measurement statics measurement (mean/stddev)
+   * \return the samples and their labels, empty if the input file option is not set.
+   */
+  SampleStoreType::Pointer
+  ExtractSampleStore(std::string parameterName, std::string parameterLayer, const ShiftScaleParameters &measurement);
+
+  /** Center and reduce the samples of a store in a new store, or return the
+   * input store if the normalization is the identity. The input store is
+   * not modified, so that the pages of a mapped store stay clean. */
+  SampleStoreType::Pointer ShiftScaleSampleStore(SampleStoreType * store, const ShiftScaleParameters &measurement);
+
+  /** Compute the shifts and inverted scales of the normalization, and
+   * return true if it is the identity */
+  bool GetShiftScale(const ShiftScaleParameters &measurement, MeasurementType &shifts, MeasurementType &invertedScales);
+
 
   /**
    * Retrieve statistics mean and standard deviation if input statistics are provided.
@@ -177,6 +199,9 @@ protected:
 
   SamplesWithLabel m_TrainingSamplesWithLabel;
   SamplesWithLabel m_ClassificationSamplesWithLabel;
+  /** Samples used for the performance estimation: the validation samples,
+   * or the training samples if there is no validation set */
+  SampleStoreType::ConstPointer m_ClassificationSampleStore;
   TargetListSampleType::Pointer m_PredictedList;
   FeaturesInfo m_FeaturesInfo;
 
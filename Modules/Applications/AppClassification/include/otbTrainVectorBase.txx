@@ -38,6 +38,14 @@ void TrainVectorBase::DoInit()
   SetParameterDescription( "io.vd",
     "Input geometries used for training (note : all geometries from the layer will be used)" );
 
+  AddParameter( ParameterType_InputFilename, "io.store", "Input sample store" );
+  MandatoryOff( "io.store" );
+  SetParameterDescription( "io.store",
+    "Training samples written by the SampleExtraction application (outstore parameter). "
+    "If given, the training samples are read from this file instead of the input vector data, "
+    "which is still used to select the features. The file is memory-mapped, so that "
+    "sample sets larger than the available memory can be used." );
+
   AddParameter( ParameterType_InputFilename, "io.stats", "Input XML image statistics file" );
   MandatoryOff( "io.stats" );
   SetParameterDescription( "io.stats", 
@@ -162,49 +170,75 @@ void TrainVectorBase::DoExecute()
   this->Train( m_TrainingSamplesWithLabel.listSample, m_TrainingSamplesWithLabel.labeledListSample, GetParameterString( "io.out" ) );
 
   m_PredictedList =
-    this->Classify( m_ClassificationSamplesWithLabel.listSample, GetParameterString( "io.out" ) );
+    this->Classify( m_ClassificationSampleStore, GetParameterString( "io.out" ) );
+
+  this->m_TrainingSampleStore = ITK_NULLPTR;
+  m_ClassificationSampleStore = ITK_NULLPTR;
 }
 
 
 void TrainVectorBase::ExtractAllSamples(const ShiftScaleParameters &measurement)
 {
-  m_TrainingSamplesWithLabel = ExtractTrainingSamplesWithLabel(measurement);
+  // Training samples are given to the models in a contiguous store, the
+  // training list samples stay empty
+  m_TrainingSamplesWithLabel = SamplesWithLabel();
+  this->m_TrainingSampleStore = ExtractTrainingSampleStore(measurement);
   m_ClassificationSamplesWithLabel = ExtractClassificationSamplesWithLabel(measurement);
 }
 
-TrainVectorBase::SamplesWithLabel
-TrainVectorBase::ExtractTrainingSamplesWithLabel(const ShiftScaleParameters &measurement)
+TrainVectorBase::SampleStoreType::Pointer
+TrainVectorBase::ExtractTrainingSampleStore(const ShiftScaleParameters &measurement)
 {
-  return ExtractSamplesWithLabel( "io.vd", "layer", measurement);
+  SampleStoreType::Pointer store;
+  if( HasValue( "io.store" ) && IsParameterEnabled( "io.store" ) )
+    {
+    SampleStoreType::Pointer mappedStore = SampleStoreType::New();
+    mappedStore->Load( GetParameterString( "io.store" ) );
+    if( mappedStore->GetNumberOfFeatures() != m_FeaturesInfo.m_NbFeatures )
+      {
+      otbAppLogFATAL( "The sample store " << GetParameterString( "io.store" ) << " has "
+                      << mappedStore->GetNumberOfFeatures() << " features, " << m_FeaturesInfo.m_NbFeatures
+                      << " features are selected." );
+      }
+    otbAppLogINFO( "Mapped " << mappedStore->Size() << " samples from " << GetParameterString( "io.store" ) );
+    store = ShiftScaleSampleStore( mappedStore, measurement );
+    }
+  else
+    {
+    store = ExtractSampleStore( "io.vd", "layer", measurement );
+    }
+
+  if( store->Size() == 0 )
+    {
+    otbAppLogFATAL( << "Input Sample List is empty" );
+    }
+  return store;
 }
 
 TrainVectorBase::SamplesWithLabel
 TrainVectorBase::ExtractClassificationSamplesWithLabel(const ShiftScaleParameters &measurement)
 {
+  // The samples are predicted from a store, only their labels are kept in
+  // the list samples
+  m_ClassificationSampleStore = this->m_TrainingSampleStore;
   if(GetClassifierCategory() == Supervised)
     {
-    SamplesWithLabel tmpSamplesWithLabel;
-    SamplesWithLabel validationSamplesWithLabel = ExtractSamplesWithLabel( "valid.vd", "valid.layer", measurement );
+    SampleStoreType::Pointer validationStore = ExtractSampleStore( "valid.vd", "valid.layer", measurement );
     //Test the input validation set size
-    if( validationSamplesWithLabel.labeledListSample->Size() != 0 )
+    if( validationStore->Size() != 0 )
       {
-      tmpSamplesWithLabel.listSample = validationSamplesWithLabel.listSample;
-      tmpSamplesWithLabel.labeledListSample = validationSamplesWithLabel.labeledListSample;
+      m_ClassificationSampleStore = validationStore;
       }
     else
       {
       otbAppLogWARNING(
               "The validation set is empty. The performance estimation is done using the input training set in this case." );
-      tmpSamplesWithLabel.listSample = m_TrainingSamplesWithLabel.listSample;
-      tmpSamplesWithLabel.labeledListSample = m_TrainingSamplesWithLabel.labeledListSample;
       }
-
-    return tmpSamplesWithLabel;
-    }
-  else
-    {
-    return m_TrainingSamplesWithLabel;
     }
+
+  SamplesWithLabel samplesWithLabel;
+  m_ClassificationSampleStore->ExportLabels( samplesWithLabel.labeledListSample );
+  return samplesWithLabel;
 }
 
 
@@ -238,9 +272,26 @@ TrainVectorBase::ExtractSamplesWithLabel(std::string parameterName, std::string
   SamplesWithLabel samplesWithLabel;
   if( HasValue( parameterName ) && IsParameterEnabled( parameterName ) )
     {
-    ListSampleType::Pointer input = ListSampleType::New();
-    TargetListSampleType::Pointer target = TargetListSampleType::New();
-    input->SetMeasurementVectorSize( m_FeaturesInfo.m_NbFeatures );
+    SampleStoreType::Pointer store = ExtractSampleStore( parameterName, parameterLayer, measurement );
+    store->ExportSamples( samplesWithLabel.listSample );
+    store->ExportLabels( samplesWithLabel.labeledListSample );
+    }
+
+  return samplesWithLabel;
+}
+
+
+TrainVectorBase::SampleStoreType::Pointer
+TrainVectorBase::ExtractSampleStore(std::string parameterName, std::string parameterLayer,
+                                    const ShiftScaleParameters &measurement)
+{
+  SampleStoreType::Pointer store = SampleStoreType::New();
+  store->Initialize( m_FeaturesInfo.m_NbFeatures );
+  if( HasValue( parameterName ) && IsParameterEnabled( parameterName ) )
+    {
+    MeasurementType shifts;
+    MeasurementType invertedScales;
+    GetShiftScale( measurement, shifts, invertedScales );
 
     std::vector<std::string> fileList = this->GetParameterStringList( parameterName );
     for( unsigned int k = 0; k < fileList.size(); k++ )
@@ -278,44 +329,94 @@ TrainVectorBase::ExtractSamplesWithLabel(std::string parameterName, std::string
                                                         << fileList[k] );
         }
 
+      // The number of features of the layer is only a hint, some drivers
+      // have to scan the whole layer to compute it
+      const GIntBig featureCount = layer.ogr().GetFeatureCount( FALSE );
+      if( featureCount > 0 )
+        {
+        store->Reserve( store->Size() + static_cast<SampleStoreType::SizeType>( featureCount ) );
+        }
 
       while( goesOn )
         {
-        // Retrieve all the features for each field in the ogr layer.
-        MeasurementType mv;
-        mv.SetSize( m_FeaturesInfo.m_NbFeatures );
-        for( unsigned int idx = 0; idx < m_FeaturesInfo.m_NbFeatures; ++idx )
-          mv[idx] = feature.ogr().GetFieldAsDouble( featureFieldIndex[idx] );
-
-        input->PushBack( mv );
-
+        int label = 0;
         if(cFieldIndex>=0 && ogr::Field(feature,cFieldIndex).HasBeenSet())
-          target->PushBack( feature.ogr().GetFieldAsInteger( cFieldIndex ) );
-        else
-          target->PushBack( 0 );
+          label = feature.ogr().GetFieldAsInteger( cFieldIndex );
+
+        // Retrieve all the features for each field in the ogr layer, and
+        // center and reduce them before the conversion to the sample type
+        InputValueType * sample = store->PushBack( label );
+        for( unsigned int idx = 0; idx < m_FeaturesInfo.m_NbFeatures; ++idx )
+          {
+          const ValueType value = feature.ogr().GetFieldAsDouble( featureFieldIndex[idx] );
+          sample[idx] = static_cast<InputValueType>( ( value - shifts[idx] ) * invertedScales[idx] );
+          }
 
         feature = layer.ogr().GetNextFeature();
         goesOn = feature.addr() != 0;
         }
       }
+    }
 
+  return store;
+}
 
 
-    ShiftScaleFilterType::Pointer shiftScaleFilter = ShiftScaleFilterType::New();
-    shiftScaleFilter->SetInput( input );
-    shiftScaleFilter->SetShifts( measurement.meanMeasurementVector );
-    shiftScaleFilter->SetScales( measurement.stddevMeasurementVector );
-    shiftScaleFilter->Update();
-
-    samplesWithLabel.listSample = shiftScaleFilter->GetOutput();
-    samplesWithLabel.labeledListSample = target;
-    samplesWithLabel.listSample->DisconnectPipeline();
+bool TrainVectorBase::GetShiftScale(const ShiftScaleParameters &measurement,
+                                    MeasurementType &shifts, MeasurementType &invertedScales)
+{
+  const unsigned int nbFeatures = m_FeaturesInfo.m_NbFeatures;
+  if( measurement.meanMeasurementVector.Size() != nbFeatures
+      || measurement.stddevMeasurementVector.Size() != nbFeatures )
+    {
+    otbAppLogFATAL( << "Inconsistent measurement vector size : " << nbFeatures << " features, "
+                    << measurement.stddevMeasurementVector.Size() << " scales and "
+                    << measurement.meanMeasurementVector.Size() << " shifts." );
     }
 
-  return samplesWithLabel;
+  // Same computation as ShiftScaleSampleListFilter
+  shifts.SetSize( nbFeatures );
+  invertedScales.SetSize( nbFeatures );
+  bool identity = true;
+  for( unsigned int idx = 0; idx < nbFeatures; ++idx )
+    {
+    shifts[idx] = measurement.meanMeasurementVector[idx];
+    const ValueType scale = measurement.stddevMeasurementVector[idx];
+    invertedScales[idx] = ( scale - 1e-10 < 0. ) ? 0. : 1 / scale;
+    identity = identity && shifts[idx] == 0. && invertedScales[idx] == 1.;
+    }
+  return identity;
 }
 
 
+TrainVectorBase::SampleStoreType::Pointer
+TrainVectorBase::ShiftScaleSampleStore(SampleStoreType * store, const ShiftScaleParameters &measurement)
+{
+  MeasurementType shifts;
+  MeasurementType invertedScales;
+  if( GetShiftScale( measurement, shifts, invertedScales ) )
+    {
+    return store;
+    }
+
+  // The normalized samples go to a new buffer, so that the pages of a
+  // mapped store are only read
+  const unsigned int nbFeatures = store->GetNumberOfFeatures();
+  SampleStoreType::Pointer output = SampleStoreType::New();
+  output->Initialize( nbFeatures );
+  output->Reserve( store->Size() );
+  for( SampleStoreType::SizeType id = 0; id < store->Size(); ++id )
+    {
+    const InputValueType * sample = store->GetSample( id );
+    InputValueType * outputSample = output->PushBack( store->GetLabel( id ) );
+    for( unsigned int idx = 0; idx < nbFeatures; ++idx )
+      {
+      outputSample[idx] = static_cast<InputValueType>( ( sample[idx] - shifts[idx] ) * invertedScales[idx] );
+      }
+    }
+  return output;
+}
+
 }
 }
 
@@ -22,8 +22,10 @@
 #include "otbWrapperApplicationFactory.h"
 
 #include "otbPerBandVectorImageFilter.h"
+#include "otbRAMDrivenAdaptativeStreamingManager.h"
 #include "itkDiscreteGaussianImageFilter.h"
 #include "itkShrinkImageFilter.h"
+#include "itkStreamingImageFilter.h"
 
 
 namespace otb
@@ -57,6 +59,12 @@ public:
   typedef itk::ShrinkImageFilter<FloatVectorImageType,
                                  FloatVectorImageType>              ShrinkFilterType;
 
+  typedef itk::StreamingImageFilter<FloatVectorImageType,
+                                    FloatVectorImageType>           LevelStreamerType;
+
+  typedef otb::RAMDrivenAdaptativeStreamingManager<
+    FloatVectorImageType>                                           StreamingManagerType;
+
 private:
   void DoInit() ITK_OVERRIDE
   {
@@ -165,13 +173,27 @@ private:
       m_ShrinkFilter->SetInput(m_SmoothingFilter->GetOutput());
       m_ShrinkFilter->SetShrinkFactors(currentFactor);
 
-      if(!fastScheme)
-        {
-        currentFactor *= shrinkFactor;
-        }
-      else
+      // With the fast scheme, the level is kept in memory as float, so
+      // that the next one is computed from it
+      FloatVectorImageType::Pointer levelImage = m_ShrinkFilter->GetOutput();
+      if(fastScheme && currentLevel < nbLevels)
         {
-        otbAppLogWARNING("fast scheme enabled : not implemented for the moment ");
+        levelImage->UpdateOutputInformation();
+
+        StreamingManagerType::Pointer streamingManager = StreamingManagerType::New();
+        streamingManager->SetAvailableRAMInMB(GetParameterInt("ram"));
+        streamingManager->PrepareStreaming(levelImage, levelImage->GetLargestPossibleRegion());
+
+        m_LevelStreamer = LevelStreamerType::New();
+        m_LevelStreamer->SetInput(levelImage);
+        m_LevelStreamer->SetNumberOfStreamDivisions(streamingManager->GetNumberOfSplits());
+        std::ostringstream ossstreamer;
+        ossstreamer<< "Computing level "<< currentLevel;
+        AddProcess(m_LevelStreamer, ossstreamer.str());
+        m_LevelStreamer->Update();
+
+        levelImage = m_LevelStreamer->GetOutput();
+        levelImage->DisconnectPipeline();
         }
 
       // Create an output parameter to write the current output image
@@ -192,13 +214,24 @@ private:
       // Set the filename of the current output image
       paramOut->SetFileName(oss.str());
       otbAppLogINFO(<< "File: "<<paramOut->GetFileName() << " will be written.");
-      paramOut->SetValue(m_ShrinkFilter->GetOutput());
+      paramOut->SetValue(levelImage);
       paramOut->SetPixelType(this->GetParameterOutputImagePixelType("out"));
       // Add the current level to be written
       paramOut->InitializeWriters();
       AddProcess(paramOut->GetWriter(), osswriter.str());
       paramOut->Write();
 
+      if(!fastScheme)
+        {
+        currentFactor *= shrinkFactor;
+        }
+      else
+        {
+        // The next level is computed from the current one, which is
+        // shrinkFactor times smaller than the previous one
+        inImage = levelImage;
+        }
+
       ++currentLevel;
       }
 
@@ -208,6 +241,7 @@ private:
 
   SmoothingVectorImageFilterType::Pointer   m_SmoothingFilter;
   ShrinkFilterType::Pointer                 m_ShrinkFilter;
+  LevelStreamerType::Pointer                m_LevelStreamer;
 };
 }
 }
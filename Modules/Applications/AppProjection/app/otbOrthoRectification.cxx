@@ -213,6 +213,11 @@ private:
     DisableParameter("opt.rpc");
     MandatoryOff("opt.rpc");
 
+    // Native RPC evaluation
+    AddParameter(ParameterType_Empty, "opt.nativerpc", "Native RPC evaluation");
+    SetParameterDescription("opt.nativerpc","Evaluate the RPC sensor models read from the image metadata with a native implementation instead of OSSIM. It is only used for models that give the same image coordinates as OSSIM on a grid of control points. The model estimated with opt.rpc is still evaluated by OSSIM.");
+    MandatoryOff("opt.nativerpc");
+
     // RAM available
     AddRAMParameter("opt.ram");
     SetParameterDescription("opt.ram","This allows setting the maximum amount of RAM available for processing. As the writing task is time consuming, it is better to write large pieces of data, which can be achieved by increasing this parameter (pay attention to your system capabilities)");
@@ -663,6 +668,13 @@ private:
       otbAppLogINFO("Generating RPC modeling with " << GetParameterInt("opt.rpc") << " points per axis");
       }
 
+    // If activated, evaluate RPC models natively
+    if(IsParameterEnabled("opt.nativerpc"))
+      {
+      m_ResampleFilter->UseNativeRPCModelOn();
+      otbAppLogINFO("Using native RPC evaluation");
+      }
+
     // Set Output information
     ResampleFilterType::SizeType size;
     size[0] = GetParameterInt("outputs.sizex");
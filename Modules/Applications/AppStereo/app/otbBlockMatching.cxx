@@ -27,6 +27,7 @@
 #include "otbImageListToVectorImageFilter.h"
 
 #include "otbSubPixelDisparityImageFilter.h"
+#include "otbSemiGlobalMatchingImageFilter.h"
 #include "otbDisparityMapMedianFilter.h"
 
 namespace otb
@@ -65,6 +66,18 @@ public:
                                                            FloatImageType,
                                                            LPBlockMatchingFunctorType> LPBlockMatchingFilterType;
 
+  typedef otb::SemiGlobalMatchingImageFilter<FloatImageType,
+                                             FloatImageType,
+                                             FloatImageType,
+                                             FloatImageType,
+                                             SSDBlockMatchingFunctorType> SSDSemiGlobalMatchingFilterType;
+
+  typedef otb::SemiGlobalMatchingImageFilter<FloatImageType,
+                                             FloatImageType,
+                                             FloatImageType,
+                                             FloatImageType,
+                                             LPBlockMatchingFunctorType>  LPSemiGlobalMatchingFilterType;
+
   typedef otb::VarianceImageFilter<FloatImageType,FloatImageType> VarianceFilterType;
 
 
@@ -269,6 +282,45 @@ private:
     SetDefaultParameterFloat("bm.metric.lp.p", 1.0);
     SetMinimumParameterFloatValue("bm.metric.lp.p", 0.0);
 
+    AddParameter(ParameterType_Choice, "bm.optim", "Disparity optimization");
+    SetParameterDescription("bm.optim", "Method used to choose the disparity "
+      "of each pixel from the metric values");
+
+    AddChoice("bm.optim.wta", "Winner-take-all");
+    SetParameterDescription("bm.optim.wta", "Each pixel gets the disparity "
+      "with the best metric value on its block");
+
+    AddChoice("bm.optim.sgm", "Semi-global matching");
+    SetParameterDescription("bm.optim.sgm", "The mean per-pixel metric of the "
+      "blocks is aggregated along several paths ending at each pixel, with "
+      "penalties on the disparity changes between neighbors. Only available "
+      "with the SSD and Lp metrics, a step of 1, no vertical disparity and no "
+      "initial disparities.");
+
+    AddParameter(ParameterType_Float, "bm.optim.sgm.p1", "Small change penalty");
+    SetParameterDescription("bm.optim.sgm.p1", "Penalty for disparity changes "
+      "of one pixel between neighbors, in units of the per-pixel metric");
+    SetDefaultParameterFloat("bm.optim.sgm.p1", 8.);
+    SetMinimumParameterFloatValue("bm.optim.sgm.p1", 0.);
+
+    AddParameter(ParameterType_Float, "bm.optim.sgm.p2", "Large change penalty");
+    SetParameterDescription("bm.optim.sgm.p2", "Penalty for disparity changes "
+      "of more than one pixel between neighbors, in units of the per-pixel "
+      "metric (should be greater than the small change penalty)");
+    SetDefaultParameterFloat("bm.optim.sgm.p2", 32.);
+    SetMinimumParameterFloatValue("bm.optim.sgm.p2", 0.);
+
+    AddParameter(ParameterType_Int, "bm.optim.sgm.paths", "Number of paths");
+    SetParameterDescription("bm.optim.sgm.paths", "Number of aggregation "
+      "paths (4 or 8)");
+    SetDefaultParameterInt("bm.optim.sgm.paths", 8);
+
+    AddParameter(ParameterType_Int, "bm.optim.sgm.overlap", "Overlap");
+    SetParameterDescription("bm.optim.sgm.overlap", "Margin (in pixels) "
+      "around each streamed tile on which the metric is aggregated");
+    SetDefaultParameterInt("bm.optim.sgm.overlap", 16);
+    SetMinimumParameterIntValue("bm.optim.sgm.overlap", 0);
+
     AddParameter(ParameterType_Int,"bm.radius","Radius of blocks");
     SetParameterDescription("bm.radius","The radius (in pixels) of blocks in Block-Matching");
     SetDefaultParameterInt("bm.radius",3);
@@ -611,6 +663,47 @@ private:
     maskLeftImage = m_LBandMathFilter->GetOutput();
     maskRightImage = m_RBandMathFilter->GetOutput();
 
+    // Semi-global matching replaces the SSD or Lp block-matching filter
+    if (GetParameterInt("bm.optim") == 1)
+      {
+      unsigned int nbPaths = GetParameterInt("bm.optim.sgm.paths");
+      if (GetParameterInt("bm.metric") == 1)
+        {
+        otbAppLogFATAL(<<"Semi-global matching is not available with the NCC metric");
+        }
+      if (step != 1 || minvdisp != 0 || maxvdisp != 0)
+        {
+        otbAppLogFATAL(<<"Semi-global matching requires a step of 1 and no vertical disparity");
+        }
+      if (useInitialDispUniform || useInitialDispMap)
+        {
+        otbAppLogFATAL(<<"Semi-global matching does not use initial disparities");
+        }
+      if (nbPaths != 4 && nbPaths != 8)
+        {
+        otbAppLogFATAL(<<"Semi-global matching uses 4 or 8 paths, not "<<nbPaths);
+        }
+
+      if (GetParameterInt("bm.metric") == 0)
+        {
+        SSDSemiGlobalMatchingFilterType::Pointer sgmFilter = SSDSemiGlobalMatchingFilterType::New();
+        sgmFilter->SetP1(GetParameterFloat("bm.optim.sgm.p1"));
+        sgmFilter->SetP2(GetParameterFloat("bm.optim.sgm.p2"));
+        sgmFilter->SetNumberOfPaths(nbPaths);
+        sgmFilter->SetOverlap(GetParameterInt("bm.optim.sgm.overlap"));
+        m_SSDBlockMatcher = sgmFilter;
+        }
+      else
+        {
+        LPSemiGlobalMatchingFilterType::Pointer sgmFilter = LPSemiGlobalMatchingFilterType::New();
+        sgmFilter->SetP1(GetParameterFloat("bm.optim.sgm.p1"));
+        sgmFilter->SetP2(GetParameterFloat("bm.optim.sgm.p2"));
+        sgmFilter->SetNumberOfPaths(nbPaths);
+        sgmFilter->SetOverlap(GetParameterInt("bm.optim.sgm.overlap"));
+        m_LPBlockMatcher = sgmFilter;
+        }
+      }
+
     // SSD case
     if(GetParameterInt("bm.metric") == 0)
       {
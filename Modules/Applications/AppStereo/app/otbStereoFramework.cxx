@@ -24,6 +24,7 @@
 #include "otbStreamingWarpImageFilter.h"
 #include "otbBandMathImageFilter.h"
 #include "otbSubPixelDisparityImageFilter.h"
+#include "otbSemiGlobalMatchingImageFilter.h"
 #include "otbDisparityMapMedianFilter.h"
 #include "otbDisparityMapToDEMFilter.h"
 #include "otbDisparityMapTo3DFilter.h"
@@ -136,6 +137,18 @@ public:
                                                               FloatImageType,
                                                               LPBlockMatchingFunctorType> LPBlockMatchingFilterType;
 
+     typedef otb::SemiGlobalMatchingImageFilter<FloatImageType,
+                                                FloatImageType,
+                                                FloatImageType,
+                                                FloatImageType,
+                                                SSDBlockMatchingFunctorType> SSDSemiGlobalMatchingFilterType;
+
+     typedef otb::SemiGlobalMatchingImageFilter<FloatImageType,
+                                                FloatImageType,
+                                                FloatImageType,
+                                                FloatImageType,
+                                                LPBlockMatchingFunctorType>  LPSemiGlobalMatchingFilterType;
+
   typedef otb::BandMathImageFilter
     <FloatImageType>                          BandMathFilterType;
 
@@ -454,6 +467,44 @@ private:
     SetDefaultParameterFloat("bm.metric.lp.p", 1.0);
     SetMinimumParameterFloatValue("bm.metric.lp.p", 0.0);
 
+    AddParameter(ParameterType_Choice, "bm.optim", "Disparity optimization");
+    SetParameterDescription("bm.optim", "Method used to choose the disparity "
+      "of each pixel from the metric values");
+
+    AddChoice("bm.optim.wta", "Winner-take-all");
+    SetParameterDescription("bm.optim.wta", "Each pixel gets the disparity "
+      "with the best metric value on its block");
+
+    AddChoice("bm.optim.sgm", "Semi-global matching");
+    SetParameterDescription("bm.optim.sgm", "The mean per-pixel metric of the "
+      "blocks is aggregated along several paths ending at each pixel, with "
+      "penalties on the disparity changes between neighbors. Only available "
+      "with the ssd and lp metrics.");
+
+    AddParameter(ParameterType_Float, "bm.optim.sgm.p1", "Small change penalty");
+    SetParameterDescription("bm.optim.sgm.p1", "Penalty for disparity changes "
+      "of one pixel between neighbors, in units of the per-pixel metric");
+    SetDefaultParameterFloat("bm.optim.sgm.p1", 8.);
+    SetMinimumParameterFloatValue("bm.optim.sgm.p1", 0.);
+
+    AddParameter(ParameterType_Float, "bm.optim.sgm.p2", "Large change penalty");
+    SetParameterDescription("bm.optim.sgm.p2", "Penalty for disparity changes "
+      "of more than one pixel between neighbors, in units of the per-pixel "
+      "metric (should be greater than the small change penalty)");
+    SetDefaultParameterFloat("bm.optim.sgm.p2", 32.);
+    SetMinimumParameterFloatValue("bm.optim.sgm.p2", 0.);
+
+    AddParameter(ParameterType_Int, "bm.optim.sgm.paths", "Number of paths");
+    SetParameterDescription("bm.optim.sgm.paths", "Number of aggregation "
+      "paths (4 or 8)");
+    SetDefaultParameterInt("bm.optim.sgm.paths", 8);
+
+    AddParameter(ParameterType_Int, "bm.optim.sgm.overlap", "Overlap");
+    SetParameterDescription("bm.optim.sgm.overlap", "Margin (in pixels) "
+      "around each streamed tile on which the metric is aggregated");
+    SetDefaultParameterInt("bm.optim.sgm.overlap", 16);
+    SetMinimumParameterIntValue("bm.optim.sgm.overlap", 0);
+
     AddParameter(ParameterType_Int,"bm.radius","Radius of blocks for matching filter (in pixels)");
     SetParameterDescription("bm.radius","The radius of blocks in Block-Matching (in pixels)");
     SetDefaultParameterInt("bm.radius",2);
@@ -590,8 +641,39 @@ private:
   }
 
 
+  /** Create a block-matching filter, or the semi-global matching filter
+   *  replacing it if bm.optim is sgm */
+  template<class TBlockMatchingFilter, class TSemiGlobalMatchingFilter>
+  typename TBlockMatchingFilter::Pointer CreateBlockMatchingFilter()
+  {
+    if (GetParameterInt("bm.optim") == 1)
+      {
+      typename TSemiGlobalMatchingFilter::Pointer sgmFilter = TSemiGlobalMatchingFilter::New();
+      sgmFilter->SetP1(GetParameterFloat("bm.optim.sgm.p1"));
+      sgmFilter->SetP2(GetParameterFloat("bm.optim.sgm.p2"));
+      sgmFilter->SetNumberOfPaths(GetParameterInt("bm.optim.sgm.paths"));
+      sgmFilter->SetOverlap(GetParameterInt("bm.optim.sgm.overlap"));
+      return typename TBlockMatchingFilter::Pointer(sgmFilter.GetPointer());
+      }
+    return TBlockMatchingFilter::New();
+  }
+
   void DoExecute() ITK_OVERRIDE
   {
+    // Semi-global matching replaces the SSD or Lp block-matching filters
+    if (GetParameterInt("bm.optim") == 1)
+      {
+      const int nbPaths = GetParameterInt("bm.optim.sgm.paths");
+      if (GetParameterInt("bm.metric") != 1 && GetParameterInt("bm.metric") != 3)
+        {
+        otbAppLogFATAL(<<"Semi-global matching is only available with the ssd and lp metrics");
+        }
+      if (nbPaths != 4 && nbPaths != 8)
+        {
+        otbAppLogFATAL(<<"Semi-global matching uses 4 or 8 paths, not "<<nbPaths);
+        }
+      }
+
     // Setup the DSM Handler
     otb::Wrapper::ElevationParametersHandler::SetupDEMHandlerFromElevationParameters(this, "elev");
     double underElev = this->GetParameterFloat("bm.minhoffset");
@@ -961,14 +1043,14 @@ private:
           case 1: //SSD
           otbAppLogINFO(<<"Using SSD Metric for BlockMatching.");
 
-          SSDBlockMatcherFilter = SSDBlockMatchingFilterType::New();
+          SSDBlockMatcherFilter = this->CreateBlockMatchingFilter<SSDBlockMatchingFilterType, SSDSemiGlobalMatchingFilterType>();
           blockMatcherFilterPointer = SSDBlockMatcherFilter.GetPointer();
           m_Filters.push_back(blockMatcherFilterPointer);
 
           if (IsParameterEnabled("postproc.bij"))
             {
             //Reverse correlation
-            invSSDBlockMatcherFilter = SSDBlockMatchingFilterType::New();
+            invSSDBlockMatcherFilter = this->CreateBlockMatchingFilter<SSDBlockMatchingFilterType, SSDSemiGlobalMatchingFilterType>();
             invBlockMatcherFilterPointer = invSSDBlockMatcherFilter.GetPointer();
             m_Filters.push_back(invBlockMatcherFilterPointer);
             }
@@ -1024,7 +1106,7 @@ private:
         case 3: //LP
           otbAppLogINFO(<<"Using Lp Metric for BlockMatching.");
 
-          LPBlockMatcherFilter = LPBlockMatchingFilterType::New();
+          LPBlockMatcherFilter = this->CreateBlockMatchingFilter<LPBlockMatchingFilterType, LPSemiGlobalMatchingFilterType>();
           LPBlockMatcherFilter->GetFunctor().SetP(static_cast<double> (GetParameterFloat("bm.metric.lp.p")));
 
           blockMatcherFilterPointer = LPBlockMatcherFilter.GetPointer();
@@ -1033,7 +1115,7 @@ private:
           if (IsParameterEnabled("postproc.bij"))
             {
             //Reverse correlation
-            invLPBlockMatcherFilter = LPBlockMatchingFilterType::New();
+            invLPBlockMatcherFilter = this->CreateBlockMatchingFilter<LPBlockMatchingFilterType, LPSemiGlobalMatchingFilterType>();
             invLPBlockMatcherFilter->GetFunctor().SetP(static_cast<double> (GetParameterFloat("bm.metric.lp.p")));
             invBlockMatcherFilterPointer = invLPBlockMatcherFilter.GetPointer();
             m_Filters.push_back(invBlockMatcherFilterPointer);
@@ -84,6 +84,16 @@ public:
    */
   static RAMValueType GetMaxRAMHint();
 
+  /**
+   * GridCacheDirectory is the path to a directory where the
+   * displacement grids of sensor model resamplings are cached.
+   *
+   * If environment variable OTB_GRID_CACHE_DIRECTORY is defined,
+   * returns it contents as a string
+   * Else, returns an empty string (no cache)
+   */
+  static std::string GetGridCacheDirectory();
+
 private:
   ConfigurationManager(); //purposely not implemented
   ~ConfigurationManager(); //purposely not implemented
@@ -49,6 +49,12 @@ namespace otb
    * changing to a new tile, ensuring the former tile will be only
    * read once.
    *
+   * If a Padding is set (i.e. the pipeline enlarges each split by
+   * some pixels to feed neighborhood filters), tiles are grouped along
+   * the lines first, so that consecutive splits are rows of tiles: the
+   * tiles shared by the padded regions of two consecutive splits are
+   * then read twice in a row and can be served by the reader cache.
+   *
    * If the TileHint is empty, or is VImageDimension is not 2, the
    * splitter falls back to the behaviour of
    * otb::ImageRegionSquareTileSplitter.
@@ -105,6 +111,12 @@ public:
   /** Get the TileHint parameter */
   itkGetConstReferenceMacro(TileHint, SizeType);
 
+  /** Set the Padding parameter */
+  itkSetMacro(Padding, SizeType);
+
+  /** Get the Padding parameter */
+  itkGetConstReferenceMacro(Padding, SizeType);
+
   /** Set the ImageRegion parameter */
   itkSetMacro(ImageRegion, RegionType);
 
@@ -143,6 +155,7 @@ public:
 
 protected:
   ImageRegionAdaptativeSplitter() : m_TileHint(),
+                                    m_Padding(),
                                     m_ImageRegion(),
                                     m_RequestedNumberOfSplits(0),
                                     m_StreamVector(),
@@ -163,6 +176,9 @@ private:
   // This reflects the input image tiling
   SizeType   m_TileHint;
 
+  // Margin added around each split by the pipeline
+  SizeType   m_Padding;
+
   // This contains the ImageRegion that is currently being split
   RegionType m_ImageRegion;
 
@@ -129,10 +129,18 @@ ImageRegionAdaptativeSplitter<VImageDimension>
 
     unsigned int i=0;
 
+    // With padding, build rows of tiles first
+    const bool groupLinesFirst = (m_Padding[0] > 0 || m_Padding[1] > 0);
+
     // TODO: this should not fall in infinite loop, but add more
     // security just in case.
     while(totalTiles / (groupTiles[0] * groupTiles[1]) > m_RequestedNumberOfSplits)
       {
+      if(groupLinesFirst && groupTiles[0] < tilesPerDim[0])
+        {
+        groupTiles[0]++;
+        continue;
+        }
       if(groupTiles[i] < tilesPerDim[i])
         {
         groupTiles[i]++;
@@ -264,6 +272,7 @@ ImageRegionAdaptativeSplitter<VImageDimension>
   os<<indent<<"IsUpToDate: "<<(m_IsUpToDate ? "true" : "false")<<std::endl;
   os<<indent<<"ImageRegion: "<<m_ImageRegion<<std::endl;
   os<<indent<<"Tile hint: "<<m_TileHint<<std::endl;
+  os<<indent<<"Padding: "<<m_Padding<<std::endl;
   os<<indent<<"Requested number of splits: "<<m_RequestedNumberOfSplits<<std::endl;
   os<<indent<<"Actual number of splits: "<<m_StreamVector.size()<<std::endl;
 }
@@ -41,6 +41,13 @@ std::string ConfigurationManager::GetGeoidFile()
   return svalue;
 }
 
+std::string ConfigurationManager::GetGridCacheDirectory()
+{
+  std::string svalue;
+  itksys::SystemTools::GetEnv("OTB_GRID_CACHE_DIRECTORY",svalue);
+  return svalue;
+}
+
 ConfigurationManager::RAMValueType ConfigurationManager::GetMaxRAMHint()
 {
   std::string svalue;
@@ -28,6 +28,8 @@
 #include "vnl/vnl_vector.h"
 
 #include <string>
+#include <vector>
+#include <typeinfo>
 
 #include "OTBImageBaseExport.h"
 
@@ -323,6 +325,20 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   virtual void Read(void* buffer) = 0;
 
+  /** Reads the IORegion directly into a buffer holding nbComponents
+   * components of type componentType per pixel, keeping only the components
+   * listed in bandList (0-based, all of them if empty). The type conversion
+   * and the band selection are done by the ImageIO, without intermediate
+   * buffer. Returns false if the requested layout is not supported, in
+   * which case nothing has been read and Read() should be used instead. */
+  virtual bool ReadDirect(void* itkNotUsed(buffer),
+                          const std::type_info& itkNotUsed(componentType),
+                          unsigned int itkNotUsed(nbComponents),
+                          const std::vector<unsigned int>& itkNotUsed(bandList))
+    {
+    return false;
+    }
+
 
   /*-------- This part of the interfaces deals with writing data ----- */
 
@@ -175,6 +175,17 @@ public:
     return lutVal;
   }
 
+  void GetValues(const IndexValueType x, const IndexValueType itkNotUsed(y),
+                 const unsigned int n, double * values) const ITK_OVERRIDE
+  {
+    // Gains only depend on the column
+    for (unsigned int i = 0; i < n; ++i)
+      {
+      const size_t pos = x + i + m_Offset;
+      values[i] = pos < m_Gains.size() ? m_Gains[pos] : 1.0;
+      }
+  }
+
   void PrintSelf(std::ostream & os, itk::Indent indent) const ITK_OVERRIDE
   {
     os << indent << " offset:'" << m_Offset << "'" << std::endl;
@@ -68,6 +68,18 @@ class OTBMetadata_EXPORT SarCalibrationLookupData : public itk::LightObject {
     return 1.0;
   }
 
+  /** Get the values of the n pixels of line y starting at column x. The
+   * default implementation calls GetValue() for each pixel; sub-classes
+   * override it to compute the line interpolation weights only once. */
+  virtual void GetValues(const IndexValueType x, const IndexValueType y,
+                         const unsigned int n, double * values) const
+  {
+    for (unsigned int i = 0; i < n; ++i)
+      {
+      values[i] = this->GetValue(x + i, y);
+      }
+  }
+
   void SetType(short t)
   {
     m_Type = t;
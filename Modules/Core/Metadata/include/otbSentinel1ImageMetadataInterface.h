@@ -192,16 +192,56 @@ public:
     return lutVal;
   }
 
+  void GetValues(const IndexValueType x, const IndexValueType y,
+                 const unsigned int n, double * values) const ITK_OVERRIDE
+  {
+    if (n == 0)
+      {
+      return;
+      }
+    // The azimuth interpolation weight is the same for the whole line
+    const int calVecIdx = GetVectorIndex(y);
+    assert(calVecIdx>=0 && calVecIdx < count-1);
+    const Sentinel1CalibrationStruct & vec0 = calibrationVectorList[calVecIdx];
+    const Sentinel1CalibrationStruct & vec1 = calibrationVectorList[calVecIdx + 1];
+    const double azTime = firstLineTime + y * lineTimeInterval;
+    const double muY = (azTime - vec0.timeMJD) / vec1.deltaMJD;
+
+    // Pixels are sorted: the range segment only moves forward along the line
+    const int lastPixelIdx = static_cast<int>(vec0.pixels.size()) - 2;
+    int pixelIdx = GetPixelIndex(x, vec0);
+    for (unsigned int i = 0; i < n; ++i)
+      {
+      const IndexValueType px = x + i;
+      while (pixelIdx < lastPixelIdx && px >= vec0.pixels[pixelIdx + 1])
+        {
+        ++pixelIdx;
+        }
+      const double muX = (px - vec0.pixels[pixelIdx]) / vec0.deltaPixels[pixelIdx + 1];
+      values[i]
+        = (1 - muY) * ((1 - muX) * vec0.vect[pixelIdx] + muX * vec0.vect[pixelIdx + 1])
+        +       muY * ((1 - muX) * vec1.vect[pixelIdx] + muX * vec1.vect[pixelIdx + 1]);
+      }
+  }
+
   int GetVectorIndex(int y) const
   {
-    for (int i = 1; i < count; i++)
+    // Calibration vectors are sorted by line: look for the first one after y
+    int first = 1;
+    int last = count;
+    while (first < last)
       {
-      if (y < calibrationVectorList[i].line)
+      const int middle = (first + last) / 2;
+      if (y < calibrationVectorList[middle].line)
+        {
+        last = middle;
+        }
+      else
         {
-        return i - 1;
+        first = middle + 1;
         }
       }
-    return -1;
+    return first < count ? first - 1 : -1;
   }
 
   int GetPixelIndex(int x, const Sentinel1CalibrationStruct& calVec) const
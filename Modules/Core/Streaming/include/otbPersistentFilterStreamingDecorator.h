@@ -23,6 +23,11 @@
 
 #include "otbStreamingImageVirtualWriter.h"
 #include "itkProcessObject.h"
+#include "itkMultiThreader.h"
+#include "itkMutexLock.h"
+#include "itkConditionVariable.h"
+#include <deque>
+#include <vector>
 
 namespace otb
 {
@@ -38,6 +43,18 @@ namespace otb
  *  temporary data. One can access the persistent filter via the GetFilter() method, and
  * StreamingVirtualWriter via the GetStreamer() method.
  *
+ *  By default, each division is read from the upstream pipeline and then
+ *  processed by the persistent filter, one after the other. When a number of
+ *  pipelined divisions is set with SetNumberOfPipelinedDivisions(), the
+ *  persistent filter is detached from the upstream pipeline and runs in a
+ *  dedicated worker thread: the upstream pipeline produces the next divisions
+ *  while the filter accumulates the current one. Up to N produced divisions
+ *  wait in a bounded queue, and their memory footprint is reported to the
+ *  streaming manager. The persistent data is still accumulated by the
+ *  filter threads and reduced once in Synthetize(). This mode is only
+ *  available for persistent filters with a single input; otherwise the
+ *  sequential mode is used.
+ *
  * \sa StreamingStatisticsImageFilter
  * \sa StreamingStatisticsVectorImageFilter
  *
@@ -73,6 +90,12 @@ public:
   itkGetConstObjectMacro(Filter, FilterType);
   itkGetObjectMacro(Streamer, StreamerType);
 
+  /** Set the maximum number of divisions produced by the upstream pipeline
+   *  and waiting to be processed by the persistent filter. 0 (the default)
+   *  disables pipelined processing. */
+  itkSetMacro(NumberOfPipelinedDivisions, unsigned int);
+  itkGetConstMacro(NumberOfPipelinedDivisions, unsigned int);
+
   void Update(void) ITK_OVERRIDE;
 
 protected:
@@ -85,6 +108,9 @@ protected:
 
   void GenerateData(void) ITK_OVERRIDE;
 
+  /** Stream the image with the persistent filter running in a worker thread */
+  void PipelinedGenerateData(void);
+
   /// Object responsible for streaming
   StreamerPointerType m_Streamer;
 
@@ -95,6 +121,37 @@ private:
   PersistentFilterStreamingDecorator(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
 
+  typedef typename ImageType::Pointer    ImagePointerType;
+  typedef typename ImageType::RegionType RegionType;
+  typedef typename FilterType::OutputImageType::RegionType OutputRegionType;
+
+  /** A division read from the upstream pipeline */
+  struct PipelinedDivisionType
+  {
+    ImagePointerType buffer;
+    OutputRegionType outputRegion;
+  };
+
+  /** Number of input slots of the filter which are actually connected */
+  unsigned int GetNumberOfConnectedInputs();
+
+  /** Body of the worker thread running the persistent filter */
+  void PipelinedProcessLoop();
+
+  /** Record a failure of the worker thread and wake up the main thread */
+  void PipelinedProcessFailed(const std::string & message);
+
+  static ITK_THREAD_RETURN_TYPE PipelinedProcessThreadCallback(void * arg);
+
+  unsigned int                          m_NumberOfPipelinedDivisions;
+  std::deque<PipelinedDivisionType>     m_PipelineQueue;
+  itk::SimpleMutexLock                  m_PipelineLock;
+  itk::ConditionVariable::Pointer       m_PipelineNotEmpty;
+  itk::ConditionVariable::Pointer       m_PipelineNotFull;
+  bool                                  m_PipelineInputDone;
+  bool                                  m_PipelineFailed;
+  std::string                           m_PipelineErrorMessage;
+  itk::MultiThreader::Pointer           m_PipelineThreader;
 };
 } // End namespace otb
 #ifndef OTB_MANUAL_INSTANTIATION
@@ -22,6 +22,10 @@
 #define otbPersistentFilterStreamingDecorator_txx
 
 #include "otbPersistentFilterStreamingDecorator.h"
+#include "otbMacro.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMutexLockHolder.h"
 
 namespace otb
 {
@@ -31,9 +35,16 @@ namespace otb
 template <class TFilter>
 PersistentFilterStreamingDecorator<TFilter>
 ::PersistentFilterStreamingDecorator()
+  : m_NumberOfPipelinedDivisions(0),
+    m_PipelineInputDone(false),
+    m_PipelineFailed(false)
 {
   m_Filter = FilterType::New();
   m_Streamer = StreamerType::New();
+
+  m_PipelineNotEmpty = itk::ConditionVariable::New();
+  m_PipelineNotFull = itk::ConditionVariable::New();
+  m_PipelineThreader = itk::MultiThreader::New();
 }
 
 template <class TFilter>
@@ -41,6 +52,16 @@ void
 PersistentFilterStreamingDecorator<TFilter>
 ::GenerateData(void)
 {
+  if (m_NumberOfPipelinedDivisions > 0)
+    {
+    if (this->GetNumberOfConnectedInputs() == 1)
+      {
+      this->PipelinedGenerateData();
+      return;
+      }
+    otbMsgDevMacro(<< "Pipelined processing needs a single input filter, falling back to sequential streaming");
+    }
+
   // Reset the filter before the generation.
   this->GetFilter()->Reset();
 
@@ -58,6 +79,245 @@ PersistentFilterStreamingDecorator<TFilter>
   this->GetFilter()->Synthetize();
 }
 
+template <class TFilter>
+unsigned int
+PersistentFilterStreamingDecorator<TFilter>
+::GetNumberOfConnectedInputs()
+{
+  unsigned int nbInputs = 0;
+  itk::ProcessObject::DataObjectPointerArray inputs = m_Filter->GetInputs();
+  for (unsigned int i = 0; i < inputs.size(); ++i)
+    {
+    if (inputs[i].IsNotNull())
+      {
+      ++nbInputs;
+      }
+    }
+  return nbInputs;
+}
+
+template <class TFilter>
+void
+PersistentFilterStreamingDecorator<TFilter>
+::PipelinedGenerateData(void)
+{
+  ImagePointerType inputPtr = const_cast<ImageType *>(m_Filter->GetInput());
+  typename FilterType::OutputImageType * outputPtr = m_Filter->GetOutput();
+
+  // Compute the divisions on the filter output, as the streamer would do
+  outputPtr->UpdateOutputInformation();
+  const OutputRegionType largestRegion = outputPtr->GetLargestPossibleRegion();
+
+  typename StreamerType::StreamingManagerType * streamingManager = m_Streamer->GetStreamingManager();
+  streamingManager->SetNumberOfBufferedDivisions(m_NumberOfPipelinedDivisions + 1);
+  streamingManager->PrepareStreaming(outputPtr, largestRegion);
+  const unsigned int nbDivisions = streamingManager->GetNumberOfSplits();
+
+  // While the filter is still connected, compute the input region it
+  // needs for each division (filters may pad their requested region)
+  std::vector<OutputRegionType> outputRegions(nbDivisions);
+  std::vector<RegionType>       inputRegions(nbDivisions);
+  for (unsigned int i = 0; i < nbDivisions; ++i)
+    {
+    outputRegions[i] = streamingManager->GetSplit(i);
+    outputPtr->SetRequestedRegion(outputRegions[i]);
+    outputPtr->PropagateRequestedRegion();
+    inputRegions[i] = inputPtr->GetRequestedRegion();
+    }
+
+  // From now on, the filter only sees division buffers, so that the
+  // upstream pipeline and the filter can run at the same time
+  m_Filter->Reset();
+
+  m_PipelineQueue.clear();
+  m_PipelineInputDone = false;
+  m_PipelineFailed = false;
+  m_PipelineErrorMessage = "";
+
+  this->SetAbortGenerateData(0);
+  this->UpdateProgress(0.0);
+  this->InvokeEvent(itk::StartEvent());
+
+  itk::ThreadIdType threadId = m_PipelineThreader->SpawnThread(&Self::PipelinedProcessThreadCallback, this);
+
+  bool upstreamFailed = false;
+  std::string upstreamErrorMessage;
+
+  // Any exception must stop the worker before leaving, so that it is
+  // always joined below
+  try
+    {
+    for (unsigned int i = 0; i < nbDivisions && !this->GetAbortGenerateData(); ++i)
+      {
+      PipelinedDivisionType division;
+      division.outputRegion = outputRegions[i];
+
+      inputPtr->SetRequestedRegion(inputRegions[i]);
+      inputPtr->PropagateRequestedRegion();
+      inputPtr->UpdateOutputData();
+
+      // The upstream buffer is reused for the next division: copy it
+      division.buffer = ImageType::New();
+      division.buffer->CopyInformation(inputPtr);
+      division.buffer->SetMetaDataDictionary(inputPtr->GetMetaDataDictionary());
+      division.buffer->SetBufferedRegion(inputRegions[i]);
+      division.buffer->SetRequestedRegion(inputRegions[i]);
+      division.buffer->Allocate();
+
+      itk::ImageRegionConstIterator<ImageType> inIt(inputPtr, inputRegions[i]);
+      itk::ImageRegionIterator<ImageType>      outIt(division.buffer, inputRegions[i]);
+      for (inIt.GoToBegin(), outIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++outIt)
+        {
+        outIt.Set(inIt.Get());
+        }
+
+      bool failed = false;
+        {
+        itk::MutexLockHolder<itk::SimpleMutexLock> lockHolder(m_PipelineLock);
+        while (m_PipelineQueue.size() >= m_NumberOfPipelinedDivisions && !m_PipelineFailed)
+          {
+          m_PipelineNotFull->Wait(&m_PipelineLock);
+          }
+        failed = m_PipelineFailed;
+        if (!failed)
+          {
+          m_PipelineQueue.push_back(division);
+          }
+        }
+      m_PipelineNotEmpty->Signal();
+
+      if (failed)
+        {
+        break;
+        }
+
+      this->UpdateProgress(static_cast<float>(i + 1) / nbDivisions);
+      }
+    }
+  catch (itk::ExceptionObject & err)
+    {
+    upstreamFailed = true;
+    upstreamErrorMessage = err.GetDescription();
+    }
+  catch (std::exception & err)
+    {
+    upstreamFailed = true;
+    upstreamErrorMessage = err.what();
+    }
+  catch (...)
+    {
+    upstreamFailed = true;
+    upstreamErrorMessage = "unknown exception";
+    }
+
+  // Let the worker drain the queue and stop
+  m_PipelineLock.Lock();
+  if (upstreamFailed || this->GetAbortGenerateData())
+    {
+    m_PipelineQueue.clear();
+    }
+  m_PipelineInputDone = true;
+  m_PipelineLock.Unlock();
+  m_PipelineNotEmpty->Signal();
+  m_PipelineThreader->TerminateThread(threadId);
+
+  // Reconnect the filter to the upstream pipeline
+  m_Filter->SetInput(inputPtr);
+
+  if (upstreamFailed)
+    {
+    itkExceptionMacro(<< "Pipelined streaming failed while reading input: " << upstreamErrorMessage);
+    }
+  if (m_PipelineFailed)
+    {
+    itkExceptionMacro(<< "Pipelined streaming failed in " << m_Filter->GetNameOfClass() << ": " << m_PipelineErrorMessage);
+    }
+
+  if (!this->GetAbortGenerateData())
+    {
+    this->UpdateProgress(1.0);
+    }
+  this->InvokeEvent(itk::EndEvent());
+
+  // Synthetize data after the streaming of the whole image.
+  m_Filter->Synthetize();
+}
+
+template <class TFilter>
+void
+PersistentFilterStreamingDecorator<TFilter>
+::PipelinedProcessLoop()
+{
+  typename FilterType::OutputImageType * outputPtr = m_Filter->GetOutput();
+
+  while (true)
+    {
+    m_PipelineLock.Lock();
+    while (m_PipelineQueue.empty() && !m_PipelineInputDone)
+      {
+      m_PipelineNotEmpty->Wait(&m_PipelineLock);
+      }
+    if (m_PipelineQueue.empty())
+      {
+      m_PipelineLock.Unlock();
+      return;
+      }
+    PipelinedDivisionType division = m_PipelineQueue.front();
+    m_PipelineQueue.pop_front();
+    m_PipelineLock.Unlock();
+    m_PipelineNotFull->Signal();
+
+    try
+      {
+      m_Filter->SetInput(division.buffer);
+      outputPtr->UpdateOutputInformation();
+      outputPtr->SetRequestedRegion(division.outputRegion);
+      outputPtr->PropagateRequestedRegion();
+      outputPtr->UpdateOutputData();
+      }
+    catch (itk::ExceptionObject & err)
+      {
+      this->PipelinedProcessFailed(err.GetDescription());
+      return;
+      }
+    catch (std::exception & err)
+      {
+      this->PipelinedProcessFailed(err.what());
+      return;
+      }
+    catch (...)
+      {
+      this->PipelinedProcessFailed("unknown exception");
+      return;
+      }
+    }
+}
+
+template <class TFilter>
+void
+PersistentFilterStreamingDecorator<TFilter>
+::PipelinedProcessFailed(const std::string & message)
+{
+  m_PipelineLock.Lock();
+  m_PipelineFailed = true;
+  m_PipelineErrorMessage = message;
+  m_PipelineQueue.clear();
+  m_PipelineLock.Unlock();
+  m_PipelineNotFull->Broadcast();
+}
+
+template <class TFilter>
+ITK_THREAD_RETURN_TYPE
+PersistentFilterStreamingDecorator<TFilter>
+::PipelinedProcessThreadCallback(void * arg)
+{
+  typedef itk::MultiThreader::ThreadInfoStruct ThreadInfoType;
+  ThreadInfoType * threadInfo = static_cast<ThreadInfoType *>(arg);
+  Self * decorator = static_cast<Self *>(threadInfo->UserData);
+  decorator->PipelinedProcessLoop();
+  return ITK_THREAD_RETURN_VALUE;
+}
+
 template <class TFilter>
 void
 PersistentFilterStreamingDecorator<TFilter>
@@ -75,6 +335,7 @@ PersistentFilterStreamingDecorator<TFilter>
 ::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfPipelinedDivisions: " << m_NumberOfPipelinedDivisions << std::endl;
 }
 } // End namespace otb
 #endif
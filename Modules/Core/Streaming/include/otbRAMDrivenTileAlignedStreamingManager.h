@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRAMDrivenTileAlignedStreamingManager_h
+#define otbRAMDrivenTileAlignedStreamingManager_h
+
+#include "otbStreamingManager.h"
+
+namespace otb
+{
+
+/** \class RAMDrivenTileAlignedStreamingManager
+ *  \brief This class computes the divisions needed to stream an image
+ *  according to the input image tiling scheme, the neighborhood
+ *  padding required by the pipeline and a user-defined available RAM.
+ *
+ * Like RAMDrivenAdaptativeStreamingManager, this streaming manager
+ * uses the TileHint from the MetaDataDictionary to align the
+ * divisions on the input file tiling scheme.
+ *
+ * In addition, it estimates the padding added by neighborhood
+ * filters around each division: a small region is propagated through
+ * the pipeline and compared to the region requested to the
+ * pipeline sources. This padding is taken into account when computing
+ * the number of divisions (the padded divisions must fit the
+ * available RAM), and divisions are ordered as rows of tiles so that
+ * the tiles read twice because of the padding are read in a row.
+ *
+ * The padding can also be set by the user with SetPadding, in which
+ * case no estimation is done.
+ *
+ * \sa ImageRegionAdaptativeSplitter
+ * \sa RAMDrivenAdaptativeStreamingManager
+ * \sa ImageFileWriter
+ *
+ * \ingroup OTBStreaming
+ */
+template<class TImage>
+class ITK_EXPORT RAMDrivenTileAlignedStreamingManager : public StreamingManager<TImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef RAMDrivenTileAlignedStreamingManager Self;
+  typedef StreamingManager<TImage>             Superclass;
+  typedef itk::SmartPointer<Self>              Pointer;
+  typedef itk::SmartPointer<const Self>        ConstPointer;
+
+  typedef TImage                          ImageType;
+  typedef typename Superclass::RegionType RegionType;
+  typedef typename Superclass::SizeType   SizeType;
+  typedef typename Superclass::IndexType  IndexType;
+
+  /** Creation through object factory macro */
+  itkNewMacro(Self);
+
+  /** Type macro */
+  itkTypeMacro(RAMDrivenTileAlignedStreamingManager, itk::LightObject);
+
+  /** Dimension of input image. */
+  itkStaticConstMacro(ImageDimension, unsigned int, ImageType::ImageDimension);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkSetMacro(AvailableRAMInMB, unsigned int);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkGetConstMacro(AvailableRAMInMB, unsigned int);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkSetMacro(Bias, double);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkGetConstMacro(Bias, double);
+
+  /** The padding added by the pipeline around each division. If not
+   * set (null padding), it is estimated from the pipeline */
+  void SetPadding(const SizeType & padding)
+  {
+    m_Padding = padding;
+    m_UserPadding = true;
+  }
+
+  /** The padding used to compute the divisions (user-defined or
+   * estimated by the last call to PrepareStreaming) */
+  itkGetConstReferenceMacro(Padding, SizeType);
+
+  /** Actually computes the stream divisions, according to the specified streaming mode,
+   * eventually using the input parameter to estimate memory consumption */
+  void PrepareStreaming(itk::DataObject * input, const RegionType &region) ITK_OVERRIDE;
+
+protected:
+  RAMDrivenTileAlignedStreamingManager();
+  ~RAMDrivenTileAlignedStreamingManager() ITK_OVERRIDE;
+
+  /** Estimate the padding added by the pipeline around region */
+  virtual SizeType EstimatePadding(itk::DataObject * input, const RegionType &region);
+
+  /** The number of MegaBytes of RAM available */
+  unsigned int m_AvailableRAMInMB;
+
+  /** The multiplier to apply to the memory print estimation */
+  double m_Bias;
+
+  /** The padding added by the pipeline around each division */
+  SizeType m_Padding;
+
+  /** True if the padding has been set by the user */
+  bool m_UserPadding;
+
+private:
+  RAMDrivenTileAlignedStreamingManager(const RAMDrivenTileAlignedStreamingManager &);
+  void operator =(const RAMDrivenTileAlignedStreamingManager&);
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbRAMDrivenTileAlignedStreamingManager.txx"
+#endif
+
+#endif
+
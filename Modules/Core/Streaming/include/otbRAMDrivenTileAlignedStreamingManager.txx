@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRAMDrivenTileAlignedStreamingManager_txx
+#define otbRAMDrivenTileAlignedStreamingManager_txx
+
+#include "otbRAMDrivenTileAlignedStreamingManager.h"
+#include "otbMacro.h"
+#include "otbImageRegionAdaptativeSplitter.h"
+#include "itkMetaDataObject.h"
+#include "otbMetaDataKey.h"
+#include "itkImageBase.h"
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <vector>
+
+namespace otb
+{
+
+template <class TImage>
+RAMDrivenTileAlignedStreamingManager<TImage>::RAMDrivenTileAlignedStreamingManager()
+  : m_AvailableRAMInMB(0),
+    m_Bias(1.0),
+    m_UserPadding(false)
+{
+  m_Padding.Fill(0);
+}
+
+template <class TImage>
+RAMDrivenTileAlignedStreamingManager<TImage>::~RAMDrivenTileAlignedStreamingManager()
+{
+}
+
+template <class TImage>
+typename RAMDrivenTileAlignedStreamingManager<TImage>::SizeType
+RAMDrivenTileAlignedStreamingManager<TImage>::EstimatePadding( itk::DataObject * input, const RegionType &region )
+{
+  typedef itk::ImageBase<itkGetStaticConstMacro(ImageDimension)> ImageBaseType;
+
+  SizeType padding;
+  padding.Fill(0);
+
+  ImageType* inputImage = dynamic_cast<ImageType*>(input);
+
+  if (!inputImage)
+    {
+    return padding;
+    }
+
+  // Small region around the image center, far enough from the image
+  // borders for the padding not to be cropped
+  RegionType probeRegion;
+  SizeType   probeSize;
+  IndexType  probeIndex;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+    probeSize[dim] = std::min(static_cast<typename SizeType::SizeValueType>(10), region.GetSize()[dim]);
+    probeIndex[dim] = region.GetIndex()[dim] + (region.GetSize()[dim] - probeSize[dim]) / 2;
+    }
+  probeRegion.SetSize(probeSize);
+  probeRegion.SetIndex(probeIndex);
+
+  const RegionType largestRegion = inputImage->GetLargestPossibleRegion();
+
+  inputImage->SetRequestedRegion(probeRegion);
+  inputImage->PropagateRequestedRegion();
+
+  // Walk up the pipeline to the sources, and compare their requested
+  // region to the probe region
+  std::vector<itk::DataObject*> toVisit;
+  std::set<itk::DataObject*>    visited;
+  toVisit.push_back(input);
+
+  while (!toVisit.empty())
+    {
+    itk::DataObject * current = toVisit.back();
+    toVisit.pop_back();
+
+    if (current == ITK_NULLPTR || !visited.insert(current).second)
+      {
+      continue;
+      }
+
+    itk::ProcessObject * source = current->GetSource();
+
+    if (source != ITK_NULLPTR && !source->GetInputs().empty())
+      {
+      itk::ProcessObject::DataObjectPointerArray inputs = source->GetInputs();
+      for (unsigned int i = 0; i < inputs.size(); ++i)
+        {
+        toVisit.push_back(inputs[i]);
+        }
+      continue;
+      }
+
+    // This is a pipeline source output
+    ImageBaseType * leaf = dynamic_cast<ImageBaseType *>(current);
+
+    // Only consider sources sharing the geometry of the output
+    if (leaf == ITK_NULLPTR || leaf == inputImage || leaf->GetLargestPossibleRegion() != largestRegion)
+      {
+      continue;
+      }
+
+    const RegionType & leafRegion = leaf->GetRequestedRegion();
+
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+      const long before = probeRegion.GetIndex()[dim] - leafRegion.GetIndex()[dim];
+      const long after = (leafRegion.GetIndex()[dim] + static_cast<long>(leafRegion.GetSize()[dim]))
+        - (probeRegion.GetIndex()[dim] + static_cast<long>(probeRegion.GetSize()[dim]));
+      const long margin = std::max(before, after);
+
+      if (margin > static_cast<long>(padding[dim]))
+        {
+        padding[dim] = margin;
+        }
+      }
+    }
+
+  otbMsgDevMacro(<< "Estimated pipeline padding: " << padding)
+
+  return padding;
+}
+
+template <class TImage>
+void
+RAMDrivenTileAlignedStreamingManager<TImage>::PrepareStreaming( itk::DataObject * input, const RegionType &region )
+{
+  unsigned long nbDivisions =
+      this->EstimateOptimalNumberOfDivisions(input, region, m_AvailableRAMInMB, m_Bias);
+
+  if (!m_UserPadding)
+    {
+    m_Padding = this->EstimatePadding(input, region);
+    }
+
+  // Divisions are rows of tiles: each division requests
+  // 2*padding extra lines, which must also fit in the available RAM.
+  const unsigned long height = region.GetSize()[1];
+  const unsigned long paddingLines = 2 * m_Padding[1];
+
+  if (nbDivisions > 1 && paddingLines > 0)
+    {
+    if (height > paddingLines * nbDivisions)
+      {
+      nbDivisions = static_cast<unsigned long>(
+        std::ceil(static_cast<double>(nbDivisions * height) / static_cast<double>(height - paddingLines * nbDivisions)));
+      }
+    else
+      {
+      // Padding dominates: use the smallest divisions
+      nbDivisions = height;
+      }
+    nbDivisions = std::min(nbDivisions, height);
+    otbMsgDevMacro(<< "Number of divisions accounting for padding: " << nbDivisions)
+    }
+
+  typename otb::ImageRegionAdaptativeSplitter<itkGetStaticConstMacro(ImageDimension)>::SizeType tileHint;
+
+  unsigned int tileHintX(0), tileHintY(0);
+
+  itk::ExposeMetaData<unsigned int>(input->GetMetaDataDictionary(),
+                                    MetaDataKey::TileHintX,
+                                    tileHintX);
+
+  itk::ExposeMetaData<unsigned int>(input->GetMetaDataDictionary(),
+                                    MetaDataKey::TileHintY,
+                                    tileHintY);
+
+  tileHint[0] = tileHintX;
+  tileHint[1] = tileHintY;
+
+  typename otb::ImageRegionAdaptativeSplitter<itkGetStaticConstMacro(ImageDimension)>::Pointer splitter =
+      otb::ImageRegionAdaptativeSplitter<itkGetStaticConstMacro(ImageDimension)>::New();
+
+  splitter->SetTileHint(tileHint);
+  splitter->SetPadding(m_Padding);
+
+  this->m_Splitter = splitter;
+
+  this->m_ComputedNumberOfSplits = this->m_Splitter->GetNumberOfSplits(region, nbDivisions);
+  otbMsgDevMacro(<< "Number of split : " << this->m_ComputedNumberOfSplits)
+  this->m_Region = region;
+}
+
+} // End namespace otb
+
+#endif
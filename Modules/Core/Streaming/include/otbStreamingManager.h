@@ -88,6 +88,13 @@ public:
    * GetNumberOfSplits() returns. */
   virtual RegionType GetSplit(unsigned int i);
 
+  /** Number of additional division buffers kept alive next to the
+   * pipeline (for instance divisions queued for writing by a pipelined
+   * ImageFileWriter). Their footprint is added to the pipeline memory
+   * print when estimating the number of divisions. Default is 0. */
+  itkSetMacro(NumberOfBufferedDivisions, unsigned int);
+  itkGetConstMacro(NumberOfBufferedDivisions, unsigned int);
+
 protected:
   StreamingManager();
   ~StreamingManager() ITK_OVERRIDE;
@@ -102,6 +109,9 @@ protected:
   /** The region to stream */
   RegionType m_Region;
 
+  /** Number of extra division buffers to account for */
+  unsigned int m_NumberOfBufferedDivisions;
+
   /** The splitter used to compute the different strips */
   typedef itk::ImageRegionSplitterBase           AbstractSplitterType;
   typedef typename AbstractSplitterType::Pointer AbstractSplitterPointerType;
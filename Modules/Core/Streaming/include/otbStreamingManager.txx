@@ -30,7 +30,8 @@ namespace otb
 
 template <class TImage>
 StreamingManager<TImage>::StreamingManager()
-  : m_ComputedNumberOfSplits(0)
+  : m_ComputedNumberOfSplits(0),
+    m_NumberOfBufferedDivisions(0)
 {
 }
 
@@ -132,6 +133,15 @@ StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::DataObject * inp
           memoryPrintCalculator->EvaluateDataObjectPrint(extractFilter->GetOutput());
 
       pipelineMemoryPrint -= extractContrib;
+
+      // account for the division buffers held outside of the pipeline
+      pipelineMemoryPrint += m_NumberOfBufferedDivisions
+        * static_cast<MemoryPrintType>(extractContrib * regionTrickFactor);
+      }
+    else
+      {
+      pipelineMemoryPrint += m_NumberOfBufferedDivisions
+        * memoryPrintCalculator->EvaluateDataObjectPrint(input);
       }
     }
   else
@@ -120,6 +120,10 @@ public:
   /**  Method to transform a point. */
   SecondTransformOutputPointType TransformPoint(const FirstTransformInputPointType&) const ITK_OVERRIDE;
 
+  /**  Method to transform a batch of points, through the batch path of
+   * both transforms. */
+  void TransformPoints(const TScalarType * in, TScalarType * out, size_t n) const ITK_OVERRIDE;
+
   /**  Method to transform a vector. */
   //  virtual OutputVectorType TransformVector(const InputVectorType &) const;
 
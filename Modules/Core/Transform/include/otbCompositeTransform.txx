@@ -28,6 +28,8 @@
 #include "otbInverseSensorModel.h"
 #include "itkIdentityTransform.h"
 
+#include <vector>
+
 namespace otb
 {
 
@@ -89,6 +91,29 @@ CompositeTransform<TFirstTransform,
   return outputPoint;
 }
 
+template<class TFirstTransform,
+    class TSecondTransform,
+    class TScalarType,
+    unsigned int NInputDimensions,
+    unsigned int NOutputDimensions>
+void
+CompositeTransform<TFirstTransform,
+    TSecondTransform,
+    TScalarType,
+    NInputDimensions,
+    NOutputDimensions>
+::TransformPoints(const TScalarType * in, TScalarType * out, size_t n) const
+{
+  if (n == 0)
+    {
+    return;
+    }
+
+  std::vector<TScalarType> geoPoints(n * TFirstTransform::OutputSpaceDimension);
+  otb::TransformPoints(m_FirstTransform.GetPointer(), in, &geoPoints[0], n);
+  otb::TransformPoints(m_SecondTransform.GetPointer(), &geoPoints[0], out, n);
+}
+
 /*template<class TFirstTransform, class TSecondTransform, class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
   typename CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>::OutputVectorType
   CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>
@@ -76,6 +76,9 @@ public:
   /** Compute the world coordinates. */
   OutputPointType TransformPoint(const InputPointType& point) const ITK_OVERRIDE;
 
+  /** Compute the world coordinates of a batch of packed points. */
+  void TransformPoints(const TScalarType * in, TScalarType * out, size_t n) const ITK_OVERRIDE;
+
 protected:
   ForwardSensorModel();
   ~ForwardSensorModel() ITK_OVERRIDE;
@@ -24,6 +24,9 @@
 #include "otbForwardSensorModel.h"
 #include "otbMacro.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace otb
 {
 
@@ -69,6 +72,23 @@ ForwardSensorModel<TScalarType, NInputDimensions, NOutputDimensions>
   return outputPoint;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void
+ForwardSensorModel<TScalarType, NInputDimensions, NOutputDimensions>
+::TransformPoints(const TScalarType * in, TScalarType * out, size_t n) const
+{
+  std::vector<double> inputPoints(in, in + n * NInputDimensions);
+  std::vector<double> outputPoints(n * NOutputDimensions);
+
+  if (n > 0)
+    {
+    this->m_Model->ForwardTransformPoints(&inputPoints[0], NInputDimensions,
+                                          &outputPoints[0], NOutputDimensions, n);
+    }
+
+  std::copy(outputPoints.begin(), outputPoints.end(), out);
+}
+
 template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
 void
 ForwardSensorModel<TScalarType, NInputDimensions, NOutputDimensions>
@@ -100,6 +100,9 @@ public:
 
   OutputPointType TransformPoint(const InputPointType& point) const ITK_OVERRIDE;
 
+  /** Transform a batch of packed points. */
+  void TransformPoints(const TScalarType * in, TScalarType * out, size_t n) const ITK_OVERRIDE;
+
   virtual bool InstantiateProjection();
 
   const MapProjectionAdapter* GetMapProjection() const;
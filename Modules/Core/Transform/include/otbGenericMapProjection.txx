@@ -24,6 +24,9 @@
 #include "otbGenericMapProjection.h"
 #include "otbMacro.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace otb
 {
 
@@ -118,6 +121,34 @@ GenericMapProjection<TDirectionOfMapping, TScalarType, NInputDimensions, NOutput
   return outputPoint;
 }
 
+template<TransformDirection::TransformationDirection TDirectionOfMapping, class TScalarType, unsigned int NInputDimensions,
+    unsigned int NOutputDimensions>
+void
+GenericMapProjection<TDirectionOfMapping, TScalarType, NInputDimensions, NOutputDimensions>
+::TransformPoints(const TScalarType * in, TScalarType * out, size_t n) const
+{
+  if (n == 0)
+    {
+    return;
+    }
+
+  std::vector<double> inputPoints(in, in + n * NInputDimensions);
+  std::vector<double> outputPoints(n * NOutputDimensions);
+
+  if (DirectionOfMapping == TransformDirection::INVERSE)
+    {
+    m_MapProjection->InverseTransform(&inputPoints[0], NInputDimensions,
+                                      &outputPoints[0], NOutputDimensions, n);
+    }
+  if (DirectionOfMapping == TransformDirection::FORWARD)
+    {
+    m_MapProjection->ForwardTransform(&inputPoints[0], NInputDimensions,
+                                      &outputPoints[0], NOutputDimensions, n);
+    }
+
+  std::copy(outputPoints.begin(), outputPoints.end(), out);
+}
+
 template<TransformDirection::TransformationDirection TDirectionOfMapping, class TScalarType, unsigned int NInputDimensions,
     unsigned int NOutputDimensions>
 void
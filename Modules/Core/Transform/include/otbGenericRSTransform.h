@@ -156,6 +156,12 @@ public:
   itkSetMacro(OutputSpacing, SpacingType);
   itkGetConstReferenceMacro(OutputSpacing, SpacingType);
 
+  /** Evaluate RPC sensor models natively instead of through OSSIM
+   * \sa SensorModelAdapter::SetUseNativeRPCModel() */
+  itkSetMacro(UseNativeRPCModel, bool);
+  itkGetConstMacro(UseNativeRPCModel, bool);
+  itkBooleanMacro(UseNativeRPCModel);
+
   /** Check if the transform is up to date */
   virtual bool IsUpToDate()
   {
@@ -170,6 +176,9 @@ public:
 
   OutputPointType TransformPoint(const InputPointType& point) const ITK_OVERRIDE;
 
+  /** Transform a batch of packed points */
+  void TransformPoints(const TScalarType * in, TScalarType * out, size_t n) const ITK_OVERRIDE;
+
   virtual void  InstantiateTransform();
   
   // Get inverse methods
@@ -218,6 +227,7 @@ private:
   GenericTransformPointerType   m_OutputTransform;
   mutable bool                  m_TransformUpToDate;
   Projection::TransformAccuracy m_TransformAccuracy;
+  bool                          m_UseNativeRPCModel;
 };
 
 } // namespace otb
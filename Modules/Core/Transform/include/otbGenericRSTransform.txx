@@ -30,6 +30,9 @@
 
 #include "ogr_spatialref.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace otb
 {
 
@@ -51,6 +54,7 @@ GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>
   m_OutputTransform = ITK_NULLPTR;
   m_TransformUpToDate = false;
   m_TransformAccuracy = Projection::UNKNOWN;
+  m_UseNativeRPCModel = false;
 }
 
 template<class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
@@ -146,6 +150,7 @@ GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>
     typedef otb::ForwardSensorModel<double, InputSpaceDimension, InputSpaceDimension> ForwardSensorModelType;
     typename ForwardSensorModelType::Pointer sensorModel = ForwardSensorModelType::New();
 
+    sensorModel->SetUseNativeRPCModel(m_UseNativeRPCModel);
     sensorModel->SetImageGeometry(m_InputKeywordList);
 
     if (sensorModel->IsValidSensorModel())
@@ -207,6 +212,7 @@ GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>
     typedef otb::InverseSensorModel<double, InputSpaceDimension, OutputSpaceDimension> InverseSensorModelType;
     typename InverseSensorModelType::Pointer sensorModel = InverseSensorModelType::New();
 
+    sensorModel->SetUseNativeRPCModel(m_UseNativeRPCModel);
     sensorModel->SetImageGeometry(m_OutputKeywordList);
 
     if (sensorModel->IsValidSensorModel())
@@ -280,6 +286,39 @@ GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>
   return outputPoint;
 }
 
+template<class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void
+GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>
+::TransformPoints(const TScalarType * in, TScalarType * out, size_t n) const
+{
+  if (n == 0)
+    {
+    return;
+    }
+
+  typedef typename TransformType::ScalarType InternalScalarType;
+
+  // Apply input origin/spacing
+  std::vector<InternalScalarType> inputPoints(in, in + n * NInputDimensions);
+  for (size_t i = 0; i < inputPoints.size(); i += NInputDimensions)
+    {
+    inputPoints[i] = inputPoints[i] * m_InputSpacing[0] + m_InputOrigin[0];
+    inputPoints[i + 1] = inputPoints[i + 1] * m_InputSpacing[1] + m_InputOrigin[1];
+    }
+
+  // Transform points
+  std::vector<InternalScalarType> outputPoints(n * NOutputDimensions);
+  this->GetTransform()->TransformPoints(&inputPoints[0], &outputPoints[0], n);
+
+  // Apply output origin/spacing
+  for (size_t i = 0; i < outputPoints.size(); i += NOutputDimensions)
+    {
+    outputPoints[i] = (outputPoints[i] - m_OutputOrigin[0]) / m_OutputSpacing[0];
+    outputPoints[i + 1] = (outputPoints[i + 1] - m_OutputOrigin[1]) / m_OutputSpacing[1];
+    }
+  std::copy(outputPoints.begin(), outputPoints.end(), out);
+}
+
 template<class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
 bool
 GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>
@@ -311,6 +350,8 @@ GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>
   inverseTransform->SetInputOrigin(m_OutputOrigin);
   inverseTransform->SetOutputOrigin(m_InputOrigin);
 
+  inverseTransform->SetUseNativeRPCModel(m_UseNativeRPCModel);
+
   // Instantiate transform
   inverseTransform->InstantiateTransform();
 
@@ -342,6 +383,7 @@ GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Up to date: " << m_TransformUpToDate << std::endl;
+  os << indent << "Use native RPC model: " << m_UseNativeRPCModel << std::endl;
   if (m_TransformUpToDate)
     {
     os << indent << "Input transform: "<< std::endl;
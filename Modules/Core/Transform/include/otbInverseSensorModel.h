@@ -75,6 +75,9 @@ public:
 
   // Transform of geographic point in image sensor index
   OutputPointType TransformPoint(const InputPointType& point) const ITK_OVERRIDE;
+
+  /** Compute the image coordinates of a batch of packed points. */
+  void TransformPoints(const TScalarType * in, TScalarType * out, size_t n) const ITK_OVERRIDE;
   // Transform of geographic point in image sensor index -- Backward Compatibility
   //  OutputPointType TransformPoint(const InputPointType &point, double height) const;
 
@@ -24,6 +24,9 @@
 #include "otbInverseSensorModel.h"
 #include "otbMacro.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace otb
 {
 
@@ -73,6 +76,23 @@ InverseSensorModel<TScalarType, NInputDimensions, NOutputDimensions>
 }
 
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void
+InverseSensorModel<TScalarType, NInputDimensions, NOutputDimensions>
+::TransformPoints(const TScalarType * in, TScalarType * out, size_t n) const
+{
+  std::vector<double> inputPoints(in, in + n * NInputDimensions);
+  std::vector<double> outputPoints(n * NOutputDimensions);
+
+  if (n > 0)
+    {
+    this->m_Model->InverseTransformPoints(&inputPoints[0], NInputDimensions,
+                                          &outputPoints[0], NOutputDimensions, n);
+    }
+
+  std::copy(outputPoints.begin(), outputPoints.end(), out);
+}
+
 template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
 void
 InverseSensorModel<TScalarType, NInputDimensions, NOutputDimensions>
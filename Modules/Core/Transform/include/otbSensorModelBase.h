@@ -84,6 +84,19 @@ public:
    */
   virtual void SetImageGeometry(const ImageKeywordlist& image_kwl);
 
+  /** Evaluate RPC sensor models natively instead of through OSSIM
+   * \sa SensorModelAdapter::SetUseNativeRPCModel() */
+  void SetUseNativeRPCModel(bool value)
+  {
+    m_Model->SetUseNativeRPCModel(value);
+    this->Modified();
+  }
+
+  bool GetUseNativeRPCModel() const
+  {
+    return m_Model->GetUseNativeRPCModel();
+  }
+
   /** Is sensor model valid method. return false if the sensor model is null */
   bool IsValidSensorModel()
   {
@@ -100,6 +100,29 @@ public:
 
   OutputPointType TransformPoint(const InputPointType  & ) const ITK_OVERRIDE
     { return OutputPointType(); }
+
+  /**  Method to transform a batch of points. The coordinates of the
+   * points are packed: in holds n * NInputDimensions values and out
+   * n * NOutputDimensions values. Subclasses override it when they
+   * can process several points faster than one by one; the default
+   * implementation calls TransformPoint() for each point. in and out
+   * may be the same buffer when NInputDimensions == NOutputDimensions. */
+  virtual void TransformPoints(const TScalarType * in, TScalarType * out, size_t n) const
+  {
+    InputPointType inputPoint;
+    for (size_t i = 0; i < n; ++i, in += NInputDimensions, out += NOutputDimensions)
+      {
+      for (unsigned int dim = 0; dim < NInputDimensions; ++dim)
+        {
+        inputPoint[dim] = in[dim];
+        }
+      const OutputPointType outputPoint = this->TransformPoint(inputPoint);
+      for (unsigned int dim = 0; dim < NOutputDimensions; ++dim)
+        {
+        out[dim] = outputPoint[dim];
+        }
+      }
+  }
   
   using Superclass::TransformVector;
   /**  Method to transform a vector. */
@@ -229,6 +252,39 @@ private:
   Transform(const Self &);      //purposely not implemented
   void operator=(const Self &); //purposely not implemented
 };
+
+/** Transform a batch of packed points with any transform, through
+ * otb::Transform::TransformPoints() when the transform is an
+ * otb::Transform and point by point otherwise. */
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void TransformPoints(const itk::Transform<TScalarType, NInputDimensions, NOutputDimensions> * transform,
+                     const TScalarType * in, TScalarType * out, size_t n)
+{
+  typedef Transform<TScalarType, NInputDimensions, NOutputDimensions> OTBTransformType;
+  typedef itk::Transform<TScalarType, NInputDimensions, NOutputDimensions> ITKTransformType;
+
+  const OTBTransformType * otbTransform = dynamic_cast<const OTBTransformType *>(transform);
+  if (otbTransform != ITK_NULLPTR)
+    {
+    otbTransform->TransformPoints(in, out, n);
+    return;
+    }
+
+  typename ITKTransformType::InputPointType inputPoint;
+  for (size_t i = 0; i < n; ++i, in += NInputDimensions, out += NOutputDimensions)
+    {
+    for (unsigned int dim = 0; dim < NInputDimensions; ++dim)
+      {
+      inputPoint[dim] = in[dim];
+      }
+    const typename ITKTransformType::OutputPointType outputPoint = transform->TransformPoint(inputPoint);
+    for (unsigned int dim = 0; dim < NOutputDimensions; ++dim)
+      {
+      out[dim] = outputPoint[dim];
+      }
+    }
+}
+
 } // end namespace otb
 
 #endif
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "otbGenericRSTransform.h"
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "itkTimeProbe.h"
+#include <ogr_spatialref.h>
+
+typedef otb::GenericRSTransform<> TransformType;
+
+// Transform the points one by one and in a single batch, check that
+// both give the same result and report the timings
+bool otbGenericRSTransformBatchCompare(const TransformType * transform,
+                                       const std::vector<double>& points,
+                                       const char * name)
+{
+  const size_t n = points.size() / 2;
+
+  std::vector<double> pointByPoint(points.size());
+  itk::TimeProbe chrono;
+  chrono.Start();
+  for (size_t i = 0; i < n; ++i)
+    {
+    TransformType::InputPointType inputPoint;
+    inputPoint[0] = points[2 * i];
+    inputPoint[1] = points[2 * i + 1];
+    const TransformType::OutputPointType outputPoint = transform->TransformPoint(inputPoint);
+    pointByPoint[2 * i] = outputPoint[0];
+    pointByPoint[2 * i + 1] = outputPoint[1];
+    }
+  chrono.Stop();
+  const double pointByPointTime = chrono.GetTotal();
+
+  std::vector<double> batch(points.size());
+  chrono.Reset();
+  chrono.Start();
+  transform->TransformPoints(&points[0], &batch[0], n);
+  chrono.Stop();
+  const double batchTime = chrono.GetTotal();
+
+  std::cout << name << ": " << n << " points, TransformPoint(): " << pointByPointTime
+            << " s, TransformPoints(): " << batchTime << " s" << std::endl;
+
+  bool ok = true;
+  for (size_t i = 0; i < points.size(); ++i)
+    {
+    if (std::abs(pointByPoint[i] - batch[i]) > 1e-9 * std::max(1.0, std::abs(pointByPoint[i])))
+      {
+      std::cerr << name << ": point " << i / 2 << " differs, TransformPoint() gives "
+                << pointByPoint[i] << ", TransformPoints() gives " << batch[i] << std::endl;
+      ok = false;
+      }
+    }
+  return ok;
+}
+
+int otbGenericRSTransformBatch(int argc, char* argv[])
+{
+  if (argc != 3)
+    {
+    std::cout << argv[0] << " <input filename> <points per line>" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  typedef otb::Image<unsigned short, 2>   ImageType;
+  typedef otb::ImageFileReader<ImageType> ReaderType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+  reader->UpdateOutputInformation();
+  ImageType::Pointer image = reader->GetOutput();
+
+  const unsigned int pointsPerLine = atoi(argv[2]);
+
+  // Build UTM ref
+  OGRSpatialReference oSRS;
+  oSRS.SetProjCS("UTM");
+  oSRS.SetWellKnownGeogCS("WGS84");
+  oSRS.SetUTM(31, true);
+  char * utmRef = ITK_NULLPTR;
+  oSRS.exportToWkt(&utmRef);
+
+  // Image to WGS84
+  TransformType::Pointer img2wgs = TransformType::New();
+  img2wgs->SetInputKeywordList(image->GetImageKeywordlist());
+  img2wgs->SetInputProjectionRef(image->GetProjectionRef());
+  img2wgs->InstantiateTransform();
+
+  // WGS84 to image
+  TransformType::Pointer wgs2img = TransformType::New();
+  img2wgs->GetInverse(wgs2img);
+
+  // WGS84 to UTM
+  TransformType::Pointer wgs2utm = TransformType::New();
+  wgs2utm->SetOutputProjectionRef(utmRef);
+  wgs2utm->InstantiateTransform();
+
+  // Grid of image points
+  const ImageType::SizeType size = image->GetLargestPossibleRegion().GetSize();
+  std::vector<double> imagePoints;
+  imagePoints.reserve(2 * pointsPerLine * pointsPerLine);
+  for (unsigned int y = 0; y < pointsPerLine; ++y)
+    {
+    for (unsigned int x = 0; x < pointsPerLine; ++x)
+      {
+      imagePoints.push_back(x * static_cast<double>(size[0]) / pointsPerLine);
+      imagePoints.push_back(y * static_cast<double>(size[1]) / pointsPerLine);
+      }
+    }
+
+  std::vector<double> geoPoints(imagePoints.size());
+  img2wgs->TransformPoints(&imagePoints[0], &geoPoints[0], imagePoints.size() / 2);
+
+  bool ok = otbGenericRSTransformBatchCompare(img2wgs, imagePoints, "Image to WGS84");
+  ok = otbGenericRSTransformBatchCompare(wgs2img, geoPoints, "WGS84 to image") && ok;
+  ok = otbGenericRSTransformBatchCompare(wgs2utm, geoPoints, "WGS84 to UTM") && ok;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
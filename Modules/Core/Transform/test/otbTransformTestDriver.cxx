@@ -42,4 +42,5 @@ void RegisterTests()
   REGISTER_TEST(otbInverseLogPolarTransformNew);
   REGISTER_TEST(otbInverseLogPolarTransformResample);
   REGISTER_TEST(otbStreamingResampleImageFilterWithAffineTransform);
+  REGISTER_TEST(otbGenericRSTransformBatch);
 }
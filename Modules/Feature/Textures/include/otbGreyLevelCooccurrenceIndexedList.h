@@ -129,6 +129,20 @@ public:
   //m_InputImageMaximum. If so add to m_Vector via AddPairToVector method */
   void AddPixelPair(const PixelValueType& pixelvalue1, const PixelValueType& pixelvalue2);
 
+  /** Get the bin of a pixel value. Returns false if the value is out of
+    * [m_InputImageMinimum, m_InputImageMaximum]. */
+  bool GetBinIndex(const PixelValueType& pixelvalue, IndexValueType& bin) const;
+
+  /** Add a co-occurrence of the bins i and j (and j and i if m_Symmetry is
+    * true). Bins are given by GetBinIndex(). */
+  void AddBinPair(IndexValueType i, IndexValueType j);
+
+  /** Remove a co-occurrence previously added with AddBinPair() or
+    * AddPixelPair(). Pairs whose frequency falls to zero are removed from
+    * the vector, so that the co-occurrences of a sliding window can be
+    * updated incrementally. */
+  void RemoveBinPair(IndexValueType i, IndexValueType j);
+
   /* Get the frequency value from Vector with index =[j,i] */
   RelativeFrequencyType GetFrequency(IndexValueType i, IndexValueType j);
 
@@ -146,6 +160,11 @@ protected:
     * co-occurrence pair is added again with index values swapped */
   void AddPairToVector(IndexType index);
 
+  /** Decrement the frequency of the given index, and remove it from the
+    * vector when the frequency falls to zero. The last element of the
+    * vector is moved in the freed position. */
+  void RemovePairFromVector(IndexType index);
+
   void SetBinMin(const unsigned int dimension, const InstanceIdentifier nbin,
                  PixelValueType min);
 
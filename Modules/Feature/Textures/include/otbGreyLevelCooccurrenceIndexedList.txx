@@ -235,17 +235,64 @@ AddPixelPair(const PixelValueType& pixelvalue1, const PixelValueType& pixelvalue
   this->GetIndex(ppair, index);
   //Add the index and set/update the frequency of the pixel pair. if m_Symmetry
   //is true the index is swapped and added to vector again.
+  this->AddBinPair(index[0], index[1]);
+}
+
+template <class TPixel >
+bool
+GreyLevelCooccurrenceIndexedList<TPixel>::
+GetBinIndex(const PixelValueType& pixelvalue, IndexValueType& bin) const
+{
+  if ( pixelvalue < m_InputImageMinimum
+       || pixelvalue > m_InputImageMaximum )
+    {
+    return false;
+    }
+
+  // Both axes share the same bins
+  IndexType index;
+  PixelPairType ppair( PixelPairSize);
+  ppair[0] = pixelvalue;
+  ppair[1] = pixelvalue;
+  this->GetIndex(ppair, index);
+  bin = index[0];
+  return true;
+}
+
+template <class TPixel >
+void
+GreyLevelCooccurrenceIndexedList<TPixel>::
+AddBinPair(IndexValueType i, IndexValueType j)
+{
+  IndexType index;
+  index[0] = i;
+  index[1] = j;
   this->AddPairToVector(index);
   if(m_Symmetry)
     {
-    IndexValueType temp;
-    temp = index[0];
-    index[0] = index[1];
-    index[1] = temp;
+    index[0] = j;
+    index[1] = i;
     this->AddPairToVector(index);
     }
 }
 
+template <class TPixel >
+void
+GreyLevelCooccurrenceIndexedList<TPixel>::
+RemoveBinPair(IndexValueType i, IndexValueType j)
+{
+  IndexType index;
+  index[0] = i;
+  index[1] = j;
+  this->RemovePairFromVector(index);
+  if(m_Symmetry)
+    {
+    index[0] = j;
+    index[1] = i;
+    this->RemovePairFromVector(index);
+    }
+}
+
 template <class TPixel>
 typename GreyLevelCooccurrenceIndexedList<TPixel>::RelativeFrequencyType
 GreyLevelCooccurrenceIndexedList<TPixel>::
@@ -309,6 +356,30 @@ GreyLevelCooccurrenceIndexedList<TPixel>
   m_TotalFrequency = m_TotalFrequency + 1;
 }
 
+template <class TPixel>
+void
+GreyLevelCooccurrenceIndexedList<TPixel>
+::RemovePairFromVector(IndexType index)
+{
+  InstanceIdentifier instanceId = index[1] * m_Size[0] + index[0];
+  int vindex = m_LookupArray[instanceId];
+  if( vindex < 0)
+    {
+    return;
+    }
+
+  m_Vector[vindex].second--;
+  if (m_Vector[vindex].second == 0)
+    {
+    const CooccurrencePairType last = m_Vector.back();
+    m_LookupArray[last.first[1] * m_Size[0] + last.first[0]] = vindex;
+    m_Vector[vindex] = last;
+    m_Vector.pop_back();
+    m_LookupArray[instanceId] = -1;
+    }
+  m_TotalFrequency = m_TotalFrequency - 1;
+}
+
 template <class TPixel>
 void
 GreyLevelCooccurrenceIndexedList<TPixel>
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGreyLevelCooccurrenceSlidingWindow_h
+#define otbGreyLevelCooccurrenceSlidingWindow_h
+
+#include "otbGreyLevelCooccurrenceIndexedList.h"
+#include "itkImage.h"
+
+namespace otb
+{
+/** \class GreyLevelCooccurrenceSlidingWindow
+ * \brief Maintains the co-occurrences of a window sliding along the rows
+ * of an image.
+ *
+ * The pixels of the input image are binned once, on the region covered by
+ * all the windows of a thread. When the window moves to the next pixel of a
+ * row, only the pairs of the leaving columns are removed from the
+ * GreyLevelCooccurrenceIndexedList and the pairs of the entering columns are
+ * added, instead of re-building the whole list. The list is re-built when
+ * the window changes rows, or when two consecutive windows do not overlap.
+ *
+ * A pair (center, center + offset) is counted when the center is inside the
+ * window and the neighbor is inside the buffered region of the input image,
+ * which gives the same co-occurrences as a neighborhood iteration over the
+ * window.
+ *
+ * \sa GreyLevelCooccurrenceIndexedList
+ *
+ * \ingroup OTBTextures
+ */
+template <class TInputImage>
+class ITK_EXPORT GreyLevelCooccurrenceSlidingWindow : public itk::LightObject
+{
+public:
+  /** Standard typedefs */
+  typedef GreyLevelCooccurrenceSlidingWindow Self;
+  typedef itk::LightObject                   Superclass;
+  typedef itk::SmartPointer<Self>            Pointer;
+  typedef itk::SmartPointer<const Self>      ConstPointer;
+
+  /** Creation through the object factory */
+  itkNewMacro(Self);
+
+  /** RTTI */
+  itkTypeMacro(GreyLevelCooccurrenceSlidingWindow, itk::LightObject);
+
+  typedef TInputImage                          InputImageType;
+  typedef typename InputImageType::PixelType   InputPixelType;
+  typedef typename InputImageType::RegionType  RegionType;
+  typedef typename InputImageType::IndexType   IndexType;
+  typedef typename InputImageType::OffsetType  OffsetType;
+  typedef typename IndexType::IndexValueType   IndexValueType;
+
+  itkStaticConstMacro(ImageDimension, unsigned int, InputImageType::ImageDimension);
+
+  typedef GreyLevelCooccurrenceIndexedList<InputPixelType>    CooccurrenceIndexedListType;
+  typedef typename CooccurrenceIndexedListType::Pointer      CooccurrenceIndexedListPointerType;
+  typedef typename CooccurrenceIndexedListType::PixelValueType PixelValueType;
+
+  /** Image of the bins of the input pixels, -1 for values out of range */
+  typedef itk::Image<int, ImageDimension> BinImageType;
+
+  /** Bin the pixels of the input image needed by the windows included in
+   * region, and clear the co-occurrences. */
+  void Initialize(const InputImageType* image, const RegionType& region,
+                  const OffsetType& offset, const unsigned int nbins,
+                  const PixelValueType min, const PixelValueType max);
+
+  /** Update the co-occurrences to the given window, which must be included
+   * in the region given to Initialize(). */
+  void MoveTo(const RegionType& window);
+
+  /** Get the co-occurrences of the current window */
+  CooccurrenceIndexedListType* GetCooccurrenceIndexedList()
+  {
+    return m_CooccurrenceIndexedList;
+  }
+
+protected:
+  GreyLevelCooccurrenceSlidingWindow();
+  ~GreyLevelCooccurrenceSlidingWindow() ITK_OVERRIDE {}
+
+  /** Add or remove the pairs of the columns [first, last] of window */
+  void UpdateColumns(const RegionType& window, IndexValueType first,
+                     IndexValueType last, bool add);
+
+  /** Add or remove the pairs whose center is in region */
+  void UpdateRegion(const RegionType& region, bool add);
+
+private:
+  GreyLevelCooccurrenceSlidingWindow(const Self&); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  CooccurrenceIndexedListPointerType m_CooccurrenceIndexedList;
+
+  typename BinImageType::Pointer m_BinImage;
+
+  OffsetType m_Offset;
+
+  /** Current window, empty until the first call to MoveTo() */
+  RegionType m_Window;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbGreyLevelCooccurrenceSlidingWindow.txx"
+#endif
+
+#endif
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGreyLevelCooccurrenceSlidingWindow_txx
+#define otbGreyLevelCooccurrenceSlidingWindow_txx
+
+#include "otbGreyLevelCooccurrenceSlidingWindow.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include <algorithm>
+
+namespace otb
+{
+template <class TInputImage>
+GreyLevelCooccurrenceSlidingWindow<TInputImage>
+::GreyLevelCooccurrenceSlidingWindow()
+{
+  m_CooccurrenceIndexedList = CooccurrenceIndexedListType::New();
+  m_BinImage = BinImageType::New();
+  m_Offset.Fill(0);
+}
+
+template <class TInputImage>
+void
+GreyLevelCooccurrenceSlidingWindow<TInputImage>
+::Initialize(const InputImageType* image, const RegionType& region,
+             const OffsetType& offset, const unsigned int nbins,
+             const PixelValueType min, const PixelValueType max)
+{
+  m_Offset = offset;
+  m_CooccurrenceIndexedList->Initialize(nbins, min, max);
+
+  // Empty window: the next call to MoveTo() builds the whole list
+  m_Window = RegionType();
+
+  // Neighbors of the centers may lie outside region
+  typename RegionType::SizeType padding;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+    padding[dim] = vcl_abs(offset[dim]);
+    }
+  RegionType binRegion = region;
+  binRegion.PadByRadius(padding);
+  binRegion.Crop(image->GetBufferedRegion());
+
+  m_BinImage->SetRegions(binRegion);
+  m_BinImage->Allocate();
+
+  itk::ImageRegionConstIterator<InputImageType> inIt(image, binRegion);
+  itk::ImageRegionIterator<BinImageType>        binIt(m_BinImage, binRegion);
+  for (inIt.GoToBegin(), binIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++binIt)
+    {
+    typename CooccurrenceIndexedListType::IndexValueType bin;
+    if (m_CooccurrenceIndexedList->GetBinIndex(static_cast<PixelValueType>(inIt.Get()), bin))
+      {
+      binIt.Set(static_cast<int>(bin));
+      }
+    else
+      {
+      binIt.Set(-1);
+      }
+    }
+}
+
+template <class TInputImage>
+void
+GreyLevelCooccurrenceSlidingWindow<TInputImage>
+::MoveTo(const RegionType& window)
+{
+  // The window slides if only its columns changed and if it overlaps the
+  // current one
+  bool slide = m_Window.GetNumberOfPixels() > 0;
+  for (unsigned int dim = 1; slide && dim < ImageDimension; ++dim)
+    {
+    slide = window.GetIndex(dim) == m_Window.GetIndex(dim)
+      && window.GetSize(dim) == m_Window.GetSize(dim);
+    }
+
+  const IndexValueType oldFirst = m_Window.GetIndex(0);
+  const IndexValueType oldLast = oldFirst + static_cast<IndexValueType>(m_Window.GetSize(0)) - 1;
+  const IndexValueType newFirst = window.GetIndex(0);
+  const IndexValueType newLast = newFirst + static_cast<IndexValueType>(window.GetSize(0)) - 1;
+
+  if (slide && newFirst <= oldLast && oldFirst <= newLast)
+    {
+    // Remove the leaving columns, add the entering ones
+    UpdateColumns(m_Window, oldFirst, std::min(oldLast, newFirst - 1), false);
+    UpdateColumns(m_Window, std::max(oldFirst, newLast + 1), oldLast, false);
+    UpdateColumns(window, newFirst, std::min(newLast, oldFirst - 1), true);
+    UpdateColumns(window, std::max(newFirst, oldLast + 1), newLast, true);
+    }
+  else
+    {
+    if (m_Window.GetNumberOfPixels() > 0)
+      {
+      UpdateRegion(m_Window, false);
+      }
+    UpdateRegion(window, true);
+    }
+  m_Window = window;
+}
+
+template <class TInputImage>
+void
+GreyLevelCooccurrenceSlidingWindow<TInputImage>
+::UpdateColumns(const RegionType& window, IndexValueType first,
+                IndexValueType last, bool add)
+{
+  if (first > last)
+    {
+    return;
+    }
+  RegionType columns = window;
+  columns.SetIndex(0, first);
+  columns.SetSize(0, last - first + 1);
+  UpdateRegion(columns, add);
+}
+
+template <class TInputImage>
+void
+GreyLevelCooccurrenceSlidingWindow<TInputImage>
+::UpdateRegion(const RegionType& region, bool add)
+{
+  const RegionType& binRegion = m_BinImage->GetBufferedRegion();
+
+  itk::ImageRegionConstIteratorWithIndex<BinImageType> it(m_BinImage, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    const int centerBin = it.Get();
+    if (centerBin < 0)
+      {
+      continue;
+      }
+    const IndexType neighbor = it.GetIndex() + m_Offset;
+    if (!binRegion.IsInside(neighbor))
+      {
+      continue; // same as an out of bounds neighbor of the input image
+      }
+    const int neighborBin = m_BinImage->GetPixel(neighbor);
+    if (neighborBin < 0)
+      {
+      continue;
+      }
+    if (add)
+      {
+      m_CooccurrenceIndexedList->AddBinPair(centerBin, neighborBin);
+      }
+    else
+      {
+      m_CooccurrenceIndexedList->RemoveBinPair(centerBin, neighborBin);
+      }
+    }
+}
+
+} // End namespace otb
+
+#endif
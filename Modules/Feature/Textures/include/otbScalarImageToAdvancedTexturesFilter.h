@@ -22,6 +22,7 @@
 #define otbScalarImageToAdvancedTexturesFilter_h
 
 #include "otbGreyLevelCooccurrenceIndexedList.h"
+#include "otbGreyLevelCooccurrenceSlidingWindow.h"
 #include "itkImageToImageFilter.h"
 
 namespace otb
@@ -135,6 +136,9 @@ public:
   typedef typename CooccurrenceIndexedListType::RelativeFrequencyType  RelativeFrequencyType;
   typedef typename CooccurrenceIndexedListType::VectorType             VectorType;
 
+  typedef GreyLevelCooccurrenceSlidingWindow< InputImageType > CooccurrenceSlidingWindowType;
+  typedef typename CooccurrenceSlidingWindowType::Pointer      CooccurrenceSlidingWindowPointerType;
+
   typedef typename VectorType::iterator                    VectorIteratorType;
   typedef typename VectorType::const_iterator              VectorConstIteratorType;
 
@@ -23,7 +23,6 @@
 
 #include "otbScalarImageToAdvancedTexturesFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
-#include "itkConstNeighborhoodIterator.h"
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include "itkNumericTraits.h"
@@ -360,6 +359,23 @@ ScalarImageToAdvancedTexturesFilter<TInputImage, TOutputImage>
 
   InputRegionType inputLargest = inputPtr->GetLargestPossibleRegion();
 
+  // Region covered by the windows of all the outputs of this thread
+  InputRegionType threadInputRegion;
+  for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+    {
+    threadInputRegion.SetIndex(dim, outputRegionForThread.GetIndex(dim) * m_SubsampleFactor[dim]
+                               + m_SubsampleOffset[dim] + inputLargest.GetIndex(dim) - m_Radius[dim]);
+    threadInputRegion.SetSize(dim, (outputRegionForThread.GetSize(dim) - 1) * m_SubsampleFactor[dim]
+                              + 2 * m_Radius[dim] + 1);
+    }
+  threadInputRegion.Crop(inputPtr->GetRequestedRegion());
+
+  // The co-occurrences are updated incrementally as the window slides
+  // along the rows of the output region
+  CooccurrenceSlidingWindowPointerType slidingWindow = CooccurrenceSlidingWindowType::New();
+  slidingWindow->Initialize(inputPtr, threadInputRegion, m_Offset, m_NumberOfBinsPerAxis,
+                            m_InputImageMinimum, m_InputImageMaximum);
+
   // Set-up progress reporting
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
@@ -398,24 +414,8 @@ ScalarImageToAdvancedTexturesFilter<TInputImage, TOutputImage>
     inputRegion.SetSize(inputSize);
     inputRegion.Crop(inputPtr->GetRequestedRegion());
 
-    CooccurrenceIndexedListPointerType GLCIList = CooccurrenceIndexedListType::New();
-    GLCIList->Initialize(m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
-
-    typedef itk::ConstNeighborhoodIterator< InputImageType > NeighborhoodIteratorType;
-    NeighborhoodIteratorType neighborIt;
-    neighborIt = NeighborhoodIteratorType(m_NeighborhoodRadius, inputPtr, inputRegion);
-    for ( neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt )
-    {
-    const InputPixelType centerPixelIntensity = neighborIt.GetCenterPixel();
-    bool pixelInBounds;
-    const InputPixelType pixelIntensity =  neighborIt.GetPixel(m_Offset, pixelInBounds);
-    if ( !pixelInBounds )
-      {
-      continue; // don't put a pixel in the co-occurrence list if the value is
-               // out of bounds
-      }
-    GLCIList->AddPixelPair(centerPixelIntensity, pixelIntensity);
-    }
+    slidingWindow->MoveTo(inputRegion);
+    CooccurrenceIndexedListType* GLCIList = slidingWindow->GetCooccurrenceIndexedList();
 
     PixelValueType m_Mean                    = itk::NumericTraits< PixelValueType >::Zero;
     PixelValueType m_Variance                = itk::NumericTraits< PixelValueType >::Zero;
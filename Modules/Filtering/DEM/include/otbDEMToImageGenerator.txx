@@ -117,63 +117,59 @@ DEMToImageGenerator<TDEMImage>
   // support progress methods/callbacks
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
-  // Walk the output image, evaluating the height at each pixel
-  IndexType currentindex;
+  // Walk the output image line by line, evaluating the heights of
+  // each line with a single DEMHandler query
+  const unsigned long lineLength = outputRegionForThread.GetSize()[0];
+  std::vector<typename DEMHandlerType::PointType> geoPoints(lineLength);
+  std::vector<double> heights;
   PointType phyPoint;
-  double    height;
-  PointType geoPoint;
 
-  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  outIt.GoToBegin();
+  while (!outIt.IsAtEnd())
     {
-    currentindex = outIt.GetIndex();
-    DEMImage->TransformIndexToPhysicalPoint(currentindex, phyPoint);
+    ImageIteratorType lineIt = outIt;
 
-
-    if(m_Transform.IsNotNull())
+    for (unsigned long i = 0; i < lineLength; ++i, ++outIt)
       {
-        geoPoint = m_Transform->TransformPoint(phyPoint);
-        if(m_AboveEllipsoid)
-          {
-          height = m_DEMHandler->GetHeightAboveEllipsoid(geoPoint); // Altitude
-                                                              // calculation
-          }
-        else
-          {
-          height = m_DEMHandler->GetHeightAboveMSL(geoPoint); // Altitude
-                                                              // calculation
-          }
+      DEMImage->TransformIndexToPhysicalPoint(outIt.GetIndex(), phyPoint);
+
+      if(m_Transform.IsNotNull())
+        {
+        geoPoints[i] = m_Transform->TransformPoint(phyPoint);
+        }
+      else
+        {
+        geoPoints[i] = phyPoint;
+        }
       }
-    else
+
+    if(m_AboveEllipsoid)
       {
- if(m_AboveEllipsoid)
-          {
-          height = m_DEMHandler->GetHeightAboveEllipsoid(phyPoint); // Altitude
-                                                                    // calculation
-          }
-        else
-          {
-          height = m_DEMHandler->GetHeightAboveMSL(phyPoint); // Altitude
-                                                              // calculation
-          }
+      m_DEMHandler->GetHeightAboveEllipsoid(geoPoints, heights); // Altitude
+                                                                 // calculation
       }
-/*    otbMsgDevMacro(<< "Index : (" << currentindex[0]<< "," << currentindex[1] << ") -> PhyPoint : ("
-                   << phyPoint[0] << "," << phyPoint[1] << ") -> GeoPoint: ("
-                   << geoPoint[0] << "," << geoPoint[1] << ") -> height" << height);
-*/
-//       otbMsgDevMacro(<< "height" << height);
-    // DEM sets a default value (-32768) at point where it doesn't have altitude information.
-    // OSSIM has chosen to change this default value in OSSIM_DBL_NAN (-4.5036e15).
-    if (!vnl_math_isnan(height))
+    else
       {
-      // Fill the image
-      DEMImage->SetPixel(currentindex, static_cast<PixelType>(height));
+      m_DEMHandler->GetHeightAboveMSL(geoPoints, heights); // Altitude
+                                                           // calculation
       }
-    else
+
+    for (unsigned long i = 0; i < lineLength; ++i, ++lineIt)
       {
-      // Back to the MNT default value
-      DEMImage->SetPixel(currentindex, m_DefaultUnknownValue);
+      // DEM sets a default value (-32768) at point where it doesn't have altitude information.
+      // OSSIM has chosen to change this default value in OSSIM_DBL_NAN (-4.5036e15).
+      if (!vnl_math_isnan(heights[i]))
+        {
+        // Fill the image
+        lineIt.Set(static_cast<PixelType>(heights[i]));
+        }
+      else
+        {
+        // Back to the MNT default value
+        lineIt.Set(m_DefaultUnknownValue);
+        }
+      progress.CompletedPixel();
       }
-    progress.CompletedPixel();
     }
 }
 
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDisplacementFieldCache_h
+#define otbDisplacementFieldCache_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkFastMutexLock.h"
+
+#include <string>
+#include <vector>
+
+#include "OTBImageManipulationExport.h"
+
+namespace otb
+{
+
+/** \class DisplacementFieldCache
+ * \brief Persistent on-disk cache of resampling displacement fields.
+ *
+ * Computing the displacement field of a sensor model resampling
+ * requires an inverse sensor model evaluation (and DEM lookups) for
+ * each node of the grid. This singleton stores the computed fields
+ * in a directory so that they can be reused by later resamplings
+ * with the same transform and the same grid, across applications
+ * and runs.
+ *
+ * A field is identified by a textual description, which must contain
+ * everything the field depends on (models, elevation settings, grid
+ * geometry). The cache file name is a hash of this description, and
+ * the full description is stored in the file and checked on loading,
+ * so that hash collisions and stale files are treated as misses.
+ *
+ * The cache directory defaults to the OTB_GRID_CACHE_DIRECTORY
+ * environment variable (see ConfigurationManager). The cache is
+ * disabled when the directory is empty.
+ *
+ * \sa StreamingResampleImageFilter
+ *
+ * \ingroup OTBImageManipulation
+ */
+class OTBImageManipulation_EXPORT DisplacementFieldCache : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef DisplacementFieldCache        Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Retrieve the singleton instance */
+  static Pointer Instance();
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(DisplacementFieldCache, itk::Object);
+
+  /** Set the cache directory. An empty string disables the cache. */
+  void SetDirectory(const std::string & directory);
+
+  /** Get the cache directory */
+  std::string GetDirectory() const;
+
+  /** Return true if a cache directory is set */
+  bool IsEnabled() const;
+
+  /** Read the field matching the description into values. Returns
+   * false if it is not in the cache. Updates the hit/miss counters. */
+  bool Load(const std::string & description, std::vector<double> & values);
+
+  /** Store the field matching the description. The file is written
+   * under a temporary name and then renamed, so that concurrent
+   * processes never read a partial field. Returns false on failure. */
+  bool Save(const std::string & description, const std::vector<double> & values);
+
+  /** Remove the field matching the description from the cache */
+  void Invalidate(const std::string & description);
+
+  /** Remove all the cached fields from the cache directory */
+  void Clear();
+
+  /** Hit and miss counters of Load() */
+  unsigned long GetNumberOfHits() const;
+  unsigned long GetNumberOfMisses() const;
+  void ResetCounters();
+
+  /** Path of the cache file of a description */
+  std::string GetFileName(const std::string & description) const;
+
+  /** Hash key of a description (16 hexadecimal digits) */
+  static std::string ComputeKey(const std::string & description);
+
+protected:
+  DisplacementFieldCache();
+  ~DisplacementFieldCache() ITK_OVERRIDE {}
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  DisplacementFieldCache(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  std::string m_Directory;
+
+  unsigned long m_NumberOfHits;
+  unsigned long m_NumberOfMisses;
+
+  mutable itk::SimpleFastMutexLock m_Lock;
+
+  static Pointer m_Singleton;
+};
+
+} // namespace otb
+
+#endif
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingMultiShrinkImageFilter_h
+#define otbStreamingMultiShrinkImageFilter_h
+
+#include "otbStreamingShrinkImageFilter.h"
+#include <algorithm>
+#include <vector>
+
+namespace otb
+{
+
+/** \class PersistentMultiShrinkImageFilter
+ * \brief Computes several shrunk versions of the input image in a single pass
+ *
+ * Each shrunk output is sampled exactly as the output of
+ * PersistentShrinkImageFilter with the same shrink factor, but the input is
+ * only read once for all the shrink factors. This is useful to build the
+ * levels of an image pyramid.
+ *
+ * \sa PersistentShrinkImageFilter
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBImageManipulation
+ */
+template<class TInputImage, class TOutputImage = TInputImage>
+class ITK_EXPORT PersistentMultiShrinkImageFilter :
+  public PersistentImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentMultiShrinkImageFilter                 Self;
+  typedef PersistentImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>                          Pointer;
+  typedef itk::SmartPointer<const Self>                    ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentMultiShrinkImageFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TInputImage                             InputImageType;
+  typedef typename TInputImage::Pointer           InputImagePointer;
+  typedef typename TInputImage::RegionType        RegionType;
+  typedef typename TInputImage::SizeType          SizeType;
+  typedef typename TInputImage::IndexType         IndexType;
+  typedef typename TInputImage::PixelType         PixelType;
+
+  /** Image related typedefs. */
+  typedef TOutputImage                             OutputImageType;
+  typedef typename TOutputImage::Pointer           OutputImagePointer;
+
+  itkStaticConstMacro(InputImageDimension, unsigned int, TInputImage::ImageDimension);
+
+  typedef std::vector<unsigned int> ShrinkFactorsType;
+
+  /** Set the shrink factors, one per shrunk output */
+  void SetShrinkFactors(const ShrinkFactorsType& factors)
+  {
+    m_ShrinkFactors = factors;
+    this->Modified();
+  }
+
+  const ShrinkFactorsType& GetShrinkFactors() const
+  {
+    return m_ShrinkFactors;
+  }
+
+  /** Get the output shrunk with the i-th shrink factor */
+  OutputImageType * GetShrunkOutput(unsigned int i)
+  {
+    return m_ShrunkOutputs[i];
+  }
+
+  void Synthetize(void) ITK_OVERRIDE;
+
+  void Reset(void) ITK_OVERRIDE;
+
+protected:
+  PersistentMultiShrinkImageFilter();
+
+  ~PersistentMultiShrinkImageFilter() ITK_OVERRIDE {}
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+  /** Multi-thread version GenerateData. */
+  void  ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) ITK_OVERRIDE;
+
+  /** Pass the input through unmodified. Do this by Grafting in the
+   *  AllocateOutputs method.
+   */
+  void AllocateOutputs() ITK_OVERRIDE;
+
+  void GenerateOutputInformation() ITK_OVERRIDE;
+
+private:
+  PersistentMultiShrinkImageFilter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  /** The shrink factors */
+  ShrinkFactorsType m_ShrinkFactors;
+
+  /** The output shrunk images */
+  std::vector<OutputImagePointer> m_ShrunkOutputs;
+
+  /** The offsets to get the cell centers */
+  std::vector<IndexType> m_Offsets;
+}; // end of class PersistentMultiShrinkImageFilter
+
+
+/** \class StreamingMultiShrinkImageFilter
+ * \brief Generates several quicklooks of the input image in a single pass
+ *
+ * This filter computes subsampled versions of the input image with
+ * streaming capabilities, one for each factor given with SetShrinkFactors().
+ * The input image is streamed only once, whatever the number of factors.
+ *
+ * \sa StreamingShrinkImageFilter
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBImageManipulation
+ */
+template<class TInputImage, class TOutputImage = TInputImage>
+class ITK_EXPORT StreamingMultiShrinkImageFilter :
+  public PersistentFilterStreamingDecorator< PersistentMultiShrinkImageFilter<TInputImage, TOutputImage> >
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingMultiShrinkImageFilter           Self;
+  typedef PersistentFilterStreamingDecorator
+    <PersistentMultiShrinkImageFilter<TInputImage, TOutputImage> >  Superclass;
+  typedef itk::SmartPointer<Self>                   Pointer;
+  typedef itk::SmartPointer<const Self>             ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingMultiShrinkImageFilter, PersistentFilterStreamingDecorator);
+
+  typedef TInputImage                                 InputImageType;
+  typedef TOutputImage                                OutputImageType;
+  typedef typename Superclass::FilterType             PersistentFilterType;
+  typedef typename PersistentFilterType::ShrinkFactorsType ShrinkFactorsType;
+
+  typedef StreamingShrinkStreamingManager<InputImageType>       StreamingShrinkStreamingManagerType;
+  typedef typename StreamingShrinkStreamingManagerType::Pointer StreamingShrinkStreamingManagerPointerType;
+
+  using Superclass::SetInput;
+  void SetInput(InputImageType * input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+
+  const InputImageType * GetInput()
+  {
+    return this->GetFilter()->GetInput();
+  }
+
+  /** Set the shrink factors, one per shrunk output */
+  void SetShrinkFactors(const ShrinkFactorsType& factors)
+  {
+    this->GetFilter()->SetShrinkFactors(factors);
+    this->Modified();
+  }
+
+  const ShrinkFactorsType& GetShrinkFactors() const
+  {
+    return this->GetFilter()->GetShrinkFactors();
+  }
+
+  /** Get the output shrunk with the i-th shrink factor */
+  OutputImageType * GetShrunkOutput(unsigned int i)
+  {
+    return this->GetFilter()->GetShrunkOutput(i);
+  }
+
+  void Update(void) ITK_OVERRIDE
+  {
+    // Split the input as for the smallest factor
+    const ShrinkFactorsType& factors = this->GetFilter()->GetShrinkFactors();
+    unsigned int minFactor = 1;
+    if (!factors.empty())
+      {
+      minFactor = *std::min_element(factors.begin(), factors.end());
+      }
+    m_StreamingManager->SetShrinkFactor(minFactor);
+    Superclass::Update();
+  }
+
+protected:
+  /** Constructor */
+  StreamingMultiShrinkImageFilter()
+  {
+    // Use a specific StreamingManager implementation
+    m_StreamingManager = StreamingShrinkStreamingManagerType::New();
+    this->GetStreamer()->SetStreamingManager( m_StreamingManager );
+  }
+
+  /** Destructor */
+  ~StreamingMultiShrinkImageFilter() ITK_OVERRIDE {}
+
+private:
+  StreamingMultiShrinkImageFilter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  StreamingShrinkStreamingManagerPointerType m_StreamingManager;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingMultiShrinkImageFilter.txx"
+#endif
+
+#endif
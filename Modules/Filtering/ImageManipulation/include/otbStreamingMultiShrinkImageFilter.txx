@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingMultiShrinkImageFilter_txx
+#define otbStreamingMultiShrinkImageFilter_txx
+
+#include "otbStreamingMultiShrinkImageFilter.h"
+#include "itkProgressReporter.h"
+
+namespace otb
+{
+
+/** Constructor */
+template <class TInputImage, class TOutputImage>
+PersistentMultiShrinkImageFilter<TInputImage, TOutputImage>
+::PersistentMultiShrinkImageFilter()
+{
+  this->SetNumberOfRequiredInputs(1);
+  this->SetNumberOfRequiredOutputs(1);
+}
+
+template<class TInputImage, class TOutputImage>
+void
+PersistentMultiShrinkImageFilter<TInputImage, TOutputImage>
+::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  const InputImageType*  input = this->GetInput();
+
+  OutputImageType* output = this->GetOutput();
+
+  if (input)
+    {
+    output->CopyInformation(input);
+    output->SetLargestPossibleRegion(input->GetLargestPossibleRegion());
+
+    if (output->GetRequestedRegion().GetNumberOfPixels() == 0)
+      {
+      output->SetRequestedRegion(output->GetLargestPossibleRegion());
+      }
+    }
+}
+
+template<class TInputImage, class TOutputImage>
+void
+PersistentMultiShrinkImageFilter<TInputImage, TOutputImage>
+::AllocateOutputs()
+{
+  // Nothing to allocate: the shrunk outputs are allocated in Reset()
+}
+
+template<class TInputImage, class TOutputImage>
+void
+PersistentMultiShrinkImageFilter<TInputImage, TOutputImage>
+::Reset()
+{
+  // Get pointers to the input and output
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  inputPtr->UpdateOutputInformation();
+
+  const typename InputImageType::SpacingType&
+                                           inputSpacing = inputPtr->GetSpacing();
+  const typename InputImageType::SizeType& inputSize
+    = inputPtr->GetLargestPossibleRegion().GetSize();
+  const typename InputImageType::IndexType& inputIndex
+    = inputPtr->GetLargestPossibleRegion().GetIndex();
+
+  m_ShrunkOutputs.resize(m_ShrinkFactors.size());
+  m_Offsets.resize(m_ShrinkFactors.size());
+
+  // Same geometry as the output of PersistentShrinkImageFilter
+  for (unsigned int level = 0; level < m_ShrinkFactors.size(); ++level)
+    {
+    const unsigned int shrinkFactor = m_ShrinkFactors[level];
+    if (shrinkFactor == 0)
+      {
+      itkExceptionMacro(<< "Shrink factors must be positive");
+      }
+
+    OutputImagePointer shrunkOutput = OutputImageType::New();
+    shrunkOutput->CopyInformation(inputPtr);
+
+    typename InputImageType::IndexType    startIndex;
+    typename OutputImageType::SpacingType shrunkOutputSpacing;
+    typename OutputImageType::RegionType  shrunkOutputLargestPossibleRegion;
+    typename OutputImageType::SizeType    shrunkOutputSize;
+    typename OutputImageType::IndexType   shrunkOutputStartIndex;
+    typename OutputImageType::PointType   shrunkOutputOrigin;
+
+    for (unsigned int i = 0; i < OutputImageType::ImageDimension; ++i)
+      {
+      startIndex[i] = inputIndex[i] + (shrinkFactor - 1) / 2;
+      if (shrinkFactor > inputSize[i])
+        startIndex[i] = inputIndex[i] + (inputSize[i] - 1) / 2;
+      m_Offsets[level][i] = startIndex[i] % shrinkFactor;
+      shrunkOutputSpacing[i] = inputSpacing[i] * static_cast<double>(shrinkFactor);
+      shrunkOutputSize[i] = inputSize[i] > shrinkFactor ? inputSize[i] / shrinkFactor : 1;
+
+      shrunkOutputOrigin[i] = inputPtr->GetOrigin()[i] + inputSpacing[i] * startIndex[i];
+      shrunkOutputStartIndex[i] = 0;
+      }
+
+    shrunkOutput->SetSpacing(shrunkOutputSpacing);
+    shrunkOutput->SetOrigin(shrunkOutputOrigin);
+
+    shrunkOutputLargestPossibleRegion.SetSize(shrunkOutputSize);
+    shrunkOutputLargestPossibleRegion.SetIndex(shrunkOutputStartIndex);
+
+    shrunkOutput->SetRegions(shrunkOutputLargestPossibleRegion);
+    shrunkOutput->Allocate();
+
+    m_ShrunkOutputs[level] = shrunkOutput;
+    }
+}
+
+template<class TInputImage, class TOutputImage>
+void
+PersistentMultiShrinkImageFilter<TInputImage, TOutputImage>
+::Synthetize()
+{
+}
+
+template<class TInputImage, class TOutputImage>
+void
+PersistentMultiShrinkImageFilter<TInputImage, TOutputImage>
+::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  itk::ProgressReporter progress(this, threadId, m_ShrinkFactors.size());
+  const InputImageType*  inputPtr = this->GetInput();
+
+  const IndexType& regionIndex = outputRegionForThread.GetIndex();
+  const SizeType&  regionSize = outputRegionForThread.GetSize();
+
+  for (unsigned int level = 0; level < m_ShrinkFactors.size(); ++level, progress.CompletedPixel())
+    {
+    const long shrinkFactor = m_ShrinkFactors[level];
+    const IndexType& offset = m_Offsets[level];
+    OutputImageType* shrunkOutput = m_ShrunkOutputs[level];
+    const RegionType& shrunkRegion = shrunkOutput->GetLargestPossibleRegion();
+
+    // Only visit the sampled input pixels of the region
+    IndexType first;
+    IndexType end;
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+      {
+      const long shift = ((offset[i] - regionIndex[i]) % shrinkFactor + shrinkFactor) % shrinkFactor;
+      first[i] = regionIndex[i] + shift;
+      end[i] = regionIndex[i] + static_cast<long>(regionSize[i]);
+      }
+
+    IndexType inIndex;
+    IndexType shrunkIndex;
+    for (inIndex[1] = first[1]; inIndex[1] < end[1]; inIndex[1] += shrinkFactor)
+      {
+      shrunkIndex[1] = (inIndex[1] - offset[1]) / shrinkFactor;
+      for (inIndex[0] = first[0]; inIndex[0] < end[0]; inIndex[0] += shrinkFactor)
+        {
+        shrunkIndex[0] = (inIndex[0] - offset[0]) / shrinkFactor;
+        if (shrunkRegion.IsInside(shrunkIndex))
+          {
+          shrunkOutput->SetPixel(shrunkIndex, inputPtr->GetPixel(inIndex));
+          }
+        }
+      }
+    }
+}
+
+template <class TImage, class TOutputImage>
+void
+PersistentMultiShrinkImageFilter<TImage, TOutputImage>
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Shrink factors:";
+  for (unsigned int level = 0; level < m_ShrinkFactors.size(); ++level)
+    {
+    os << " " << m_ShrinkFactors[level];
+    }
+  os << std::endl;
+}
+
+} // End namespace otb
+#endif
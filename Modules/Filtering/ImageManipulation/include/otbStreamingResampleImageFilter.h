@@ -47,6 +47,12 @@ namespace otb
  * the  interpolator (SetInterpolator()) and the origin (SetOrigin())
  * can be set using the method between brackets.
  *
+ * If a description of the transform is set with
+ * SetDisplacementFieldCacheDescription() and the DisplacementFieldCache
+ * is enabled, the whole displacement grid is computed once, stored in
+ * the cache, and read back by later resamplings with the same
+ * description and grid.
+ *
  *
  *
  * \ingroup Projection
@@ -168,6 +174,23 @@ public:
   /** Import output parameters from a given image */
   void SetOutputParametersFromImage(const ImageBaseType * image);
 
+  /** Description of the transform, used with the displacement field
+   * grid parameters as the key of the DisplacementFieldCache. It must
+   * identify the transform completely. An empty description (the
+   * default) disables the cache. */
+  void SetDisplacementFieldCacheDescription(const std::string & description)
+  {
+    if (description != m_DisplacementFieldCacheDescription)
+      {
+      m_DisplacementFieldCacheDescription = description;
+      this->Modified();
+      }
+  }
+  const std::string & GetDisplacementFieldCacheDescription() const
+  {
+    return m_DisplacementFieldCacheDescription;
+  }
+
   /* Set number of threads for Deformation field generator*/
   void SetDisplacementFilterNumberOfThreads(unsigned int nbThread)
   {
@@ -189,12 +212,19 @@ protected:
 
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
 
+  /** Load the displacement field from the cache, or compute and store it */
+  void UpdateCachedDisplacementField();
+
 private:
   StreamingResampleImageFilter(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
 
   typename DisplacementFieldGeneratorType::Pointer   m_DisplacementFilter;
   typename WarpImageFilterType::Pointer             m_WarpFilter;
+
+  std::string                                       m_DisplacementFieldCacheDescription;
+  std::string                                       m_CachedFieldKey;
+  typename DisplacementFieldType::Pointer           m_CachedDisplacementField;
 };
 
 } // namespace otb
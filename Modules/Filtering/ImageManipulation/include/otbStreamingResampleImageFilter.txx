@@ -23,6 +23,11 @@
 
 #include "otbStreamingResampleImageFilter.h"
 #include "itkProgressAccumulator.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "otbDisplacementFieldCache.h"
+
+#include <sstream>
 
 namespace otb
 {
@@ -94,6 +99,17 @@ StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionTy
   m_DisplacementFilter->SetOutputSize(displacementFieldLargestSize);
   m_DisplacementFilter->SetOutputIndex(this->GetOutputStartIndex());
 
+  if (!m_DisplacementFieldCacheDescription.empty()
+      && DisplacementFieldCache::Instance()->IsEnabled())
+    {
+    this->UpdateCachedDisplacementField();
+    m_WarpFilter->SetDisplacementField(m_CachedDisplacementField);
+    }
+  else
+    {
+    m_WarpFilter->SetDisplacementField(m_DisplacementFilter->GetOutput());
+    }
+
   m_WarpFilter->SetInput(this->GetInput());
   m_WarpFilter->GraftOutput(this->GetOutput());
   m_WarpFilter->UpdateOutputInformation();
@@ -111,6 +127,84 @@ StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionTy
   m_WarpFilter->GetOutput()->PropagateRequestedRegion();
 }
 
+template <class TInputImage, class TOutputImage, class TInterpolatorPrecisionType>
+void
+StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>
+::UpdateCachedDisplacementField()
+{
+  // The key is the transform description completed by the grid geometry
+  std::ostringstream oss;
+  oss.precision(17);
+  oss << m_DisplacementFieldCacheDescription << std::endl;
+  oss << "DisplacementFieldOrigin: " << m_DisplacementFilter->GetOutputOrigin() << std::endl;
+  oss << "DisplacementFieldSpacing: " << m_DisplacementFilter->GetOutputSpacing() << std::endl;
+  oss << "DisplacementFieldIndex: " << m_DisplacementFilter->GetOutputIndex() << std::endl;
+  oss << "DisplacementFieldSize: " << m_DisplacementFilter->GetOutputSize() << std::endl;
+  oss << "DisplacementFieldDirection: " << m_DisplacementFilter->GetOutputDirection() << std::endl;
+  const std::string key = oss.str();
+
+  // The field in memory is still valid
+  if (m_CachedDisplacementField.IsNotNull() && key == m_CachedFieldKey)
+    {
+    return;
+    }
+
+  const unsigned int nbComponents = DisplacementType::Dimension;
+
+  RegionType region;
+  region.SetIndex(m_DisplacementFilter->GetOutputIndex());
+  region.SetSize(m_DisplacementFilter->GetOutputSize());
+
+  DisplacementFieldCache::Pointer cache = DisplacementFieldCache::Instance();
+  std::vector<double> values;
+
+  typename DisplacementFieldType::Pointer field;
+  if (cache->Load(key, values) && values.size() == region.GetNumberOfPixels() * nbComponents)
+    {
+    field = DisplacementFieldType::New();
+    field->SetRegions(region);
+    field->SetOrigin(m_DisplacementFilter->GetOutputOrigin());
+    field->SetSpacing(m_DisplacementFilter->GetOutputSpacing());
+    field->SetDirection(m_DisplacementFilter->GetOutputDirection());
+    field->Allocate();
+
+    std::vector<double>::const_iterator valueIt = values.begin();
+    itk::ImageRegionIterator<DisplacementFieldType> it(field, region);
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+      {
+      DisplacementType displacement;
+      for (unsigned int i = 0; i < nbComponents; ++i, ++valueIt)
+        {
+        displacement[i] = *valueIt;
+        }
+      it.Set(displacement);
+      }
+    }
+  else
+    {
+    m_DisplacementFilter->UpdateLargestPossibleRegion();
+    field = m_DisplacementFilter->GetOutput();
+    // Keep the computed field out of the mini-pipeline
+    field->DisconnectPipeline();
+
+    values.clear();
+    values.reserve(region.GetNumberOfPixels() * nbComponents);
+    itk::ImageRegionConstIterator<DisplacementFieldType> it(field, region);
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+      {
+      const DisplacementType & displacement = it.Get();
+      for (unsigned int i = 0; i < nbComponents; ++i)
+        {
+        values.push_back(displacement[i]);
+        }
+      }
+    cache->Save(key, values);
+    }
+
+  m_CachedDisplacementField = field;
+  m_CachedFieldKey = key;
+}
+
 /**
  * Method used to copy the parameters of the input image
  *
@@ -137,6 +231,7 @@ StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionTy
   os << indent << "OutputSpacing: " << this->GetOutputSpacing() << std::endl;
   os << indent << "OutputStartIndex: " << this->GetOutputStartIndex() << std::endl;
   os << indent << "OutputSize: " << this->GetOutputSize() << std::endl;
+  os << indent << "DisplacementFieldCacheDescription: " << m_DisplacementFieldCacheDescription << std::endl;
 }
 
 
@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbDisplacementFieldCache.h"
+
+#include "otbConfigurationManager.h"
+#include "otbMacro.h"
+
+#include "itksys/SystemTools.hxx"
+#include "itksys/Directory.hxx"
+
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#ifdef _WIN32
+#include <process.h>
+#define otbGetPid _getpid
+#else
+#include <unistd.h>
+#define otbGetPid getpid
+#endif
+
+namespace otb
+{
+
+namespace
+{
+const char CacheFileMagic[8] = {'O', 'T', 'B', 'D', 'F', 'C', '0', '1'};
+const char CacheFileExtension[] = ".dfc";
+}
+
+/** Initialize the singleton */
+DisplacementFieldCache::Pointer DisplacementFieldCache::m_Singleton = ITK_NULLPTR;
+
+DisplacementFieldCache::Pointer DisplacementFieldCache::Instance()
+{
+  if(m_Singleton.GetPointer() == ITK_NULLPTR)
+    {
+    m_Singleton = itk::ObjectFactory<Self>::Create();
+
+    if(m_Singleton.GetPointer() == ITK_NULLPTR)
+      {
+      m_Singleton = new DisplacementFieldCache;
+      }
+    m_Singleton->UnRegister();
+    }
+
+  return m_Singleton;
+}
+
+DisplacementFieldCache
+::DisplacementFieldCache()
+  : m_Directory(ConfigurationManager::GetGridCacheDirectory()),
+    m_NumberOfHits(0),
+    m_NumberOfMisses(0)
+{
+}
+
+void
+DisplacementFieldCache
+::SetDirectory(const std::string & directory)
+{
+  m_Lock.Lock();
+  m_Directory = directory;
+  m_Lock.Unlock();
+  this->Modified();
+}
+
+std::string
+DisplacementFieldCache
+::GetDirectory() const
+{
+  m_Lock.Lock();
+  std::string directory = m_Directory;
+  m_Lock.Unlock();
+  return directory;
+}
+
+bool
+DisplacementFieldCache
+::IsEnabled() const
+{
+  return !this->GetDirectory().empty();
+}
+
+std::string
+DisplacementFieldCache
+::ComputeKey(const std::string & description)
+{
+  // 64 bits FNV-1a hash
+  boost::uint64_t hash = 14695981039346656037ULL;
+  for (std::string::const_iterator it = description.begin(); it != description.end(); ++it)
+    {
+    hash ^= static_cast<unsigned char>(*it);
+    hash *= 1099511628211ULL;
+    }
+
+  std::ostringstream oss;
+  oss << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return oss.str();
+}
+
+std::string
+DisplacementFieldCache
+::GetFileName(const std::string & description) const
+{
+  std::string directory = this->GetDirectory();
+  if (directory.empty())
+    {
+    return std::string();
+    }
+  return directory + "/" + ComputeKey(description) + CacheFileExtension;
+}
+
+bool
+DisplacementFieldCache
+::Load(const std::string & description, std::vector<double> & values)
+{
+  const std::string filename = this->GetFileName(description);
+
+  bool found = false;
+  if (!filename.empty() && itksys::SystemTools::FileExists(filename.c_str(), true))
+    {
+    std::ifstream ifs(filename.c_str(), std::ios::in | std::ios::binary);
+
+    char magic[sizeof(CacheFileMagic)];
+    boost::uint64_t descriptionLength = 0;
+    ifs.read(magic, sizeof(magic));
+    ifs.read(reinterpret_cast<char *>(&descriptionLength), sizeof(descriptionLength));
+
+    if (ifs.good()
+        && std::equal(magic, magic + sizeof(magic), CacheFileMagic)
+        && descriptionLength == description.size())
+      {
+      std::string storedDescription(descriptionLength, '\0');
+      boost::uint64_t nbValues = 0;
+      ifs.read(&storedDescription[0], descriptionLength);
+      ifs.read(reinterpret_cast<char *>(&nbValues), sizeof(nbValues));
+
+      if (ifs.good() && storedDescription == description)
+        {
+        values.resize(nbValues);
+        if (nbValues > 0)
+          {
+          ifs.read(reinterpret_cast<char *>(&values[0]), nbValues * sizeof(double));
+          }
+        found = !ifs.fail();
+        }
+      }
+    }
+
+  m_Lock.Lock();
+  if (found)
+    {
+    ++m_NumberOfHits;
+    }
+  else
+    {
+    ++m_NumberOfMisses;
+    }
+  m_Lock.Unlock();
+
+  otbMsgDevMacro(<< "Displacement field cache " << (found ? "hit" : "miss") << ": " << filename);
+  return found;
+}
+
+bool
+DisplacementFieldCache
+::Save(const std::string & description, const std::vector<double> & values)
+{
+  const std::string directory = this->GetDirectory();
+  if (directory.empty())
+    {
+    return false;
+    }
+
+  if (!itksys::SystemTools::FileIsDirectory(directory.c_str())
+      && !itksys::SystemTools::MakeDirectory(directory.c_str()))
+    {
+    otbWarningMacro(<< "Unable to create the displacement field cache directory " << directory);
+    return false;
+    }
+
+  const std::string filename = this->GetFileName(description);
+  std::ostringstream tmpFilename;
+  tmpFilename << filename << "." << otbGetPid() << ".tmp";
+
+  bool success = false;
+    {
+    std::ofstream ofs(tmpFilename.str().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+    const boost::uint64_t descriptionLength = description.size();
+    const boost::uint64_t nbValues = values.size();
+    ofs.write(CacheFileMagic, sizeof(CacheFileMagic));
+    ofs.write(reinterpret_cast<const char *>(&descriptionLength), sizeof(descriptionLength));
+    ofs.write(description.data(), descriptionLength);
+    ofs.write(reinterpret_cast<const char *>(&nbValues), sizeof(nbValues));
+    if (nbValues > 0)
+      {
+      ofs.write(reinterpret_cast<const char *>(&values[0]), nbValues * sizeof(double));
+      }
+    ofs.close();
+    success = !ofs.fail();
+    }
+
+  // An other process may have stored the same field in the meantime:
+  // the rename may then fail, but the cached field is valid
+  if (!success || std::rename(tmpFilename.str().c_str(), filename.c_str()) != 0)
+    {
+    itksys::SystemTools::RemoveFile(tmpFilename.str().c_str());
+    if (!success)
+      {
+      otbWarningMacro(<< "Unable to write the displacement field cache file " << filename);
+      }
+    }
+  return success;
+}
+
+void
+DisplacementFieldCache
+::Invalidate(const std::string & description)
+{
+  const std::string filename = this->GetFileName(description);
+  if (!filename.empty() && itksys::SystemTools::FileExists(filename.c_str(), true))
+    {
+    itksys::SystemTools::RemoveFile(filename.c_str());
+    }
+}
+
+void
+DisplacementFieldCache
+::Clear()
+{
+  const std::string directory = this->GetDirectory();
+  itksys::Directory dir;
+  if (directory.empty() || !dir.Load(directory.c_str()))
+    {
+    return;
+    }
+
+  for (unsigned long i = 0; i < dir.GetNumberOfFiles(); ++i)
+    {
+    const std::string file = dir.GetFile(i);
+    if (itksys::SystemTools::GetFilenameLastExtension(file) == CacheFileExtension)
+      {
+      itksys::SystemTools::RemoveFile((directory + "/" + file).c_str());
+      }
+    }
+}
+
+unsigned long
+DisplacementFieldCache
+::GetNumberOfHits() const
+{
+  m_Lock.Lock();
+  unsigned long hits = m_NumberOfHits;
+  m_Lock.Unlock();
+  return hits;
+}
+
+unsigned long
+DisplacementFieldCache
+::GetNumberOfMisses() const
+{
+  m_Lock.Lock();
+  unsigned long misses = m_NumberOfMisses;
+  m_Lock.Unlock();
+  return misses;
+}
+
+void
+DisplacementFieldCache
+::ResetCounters()
+{
+  m_Lock.Lock();
+  m_NumberOfHits = 0;
+  m_NumberOfMisses = 0;
+  m_Lock.Unlock();
+}
+
+void
+DisplacementFieldCache
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Directory: " << this->GetDirectory() << std::endl;
+  os << indent << "NumberOfHits: " << this->GetNumberOfHits() << std::endl;
+  os << indent << "NumberOfMisses: " << this->GetNumberOfMisses() << std::endl;
+}
+
+} // namespace otb
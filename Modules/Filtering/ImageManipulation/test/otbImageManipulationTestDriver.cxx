@@ -32,12 +32,14 @@ void RegisterTests()
   REGISTER_TEST(otbSqrtSpectralAngleImageFilter);
   REGISTER_TEST(otbUnaryFunctorNeighborhoodImageFilterNew);
   REGISTER_TEST(otbStreamingShrinkImageFilter);
+  REGISTER_TEST(otbStreamingMultiShrinkImageFilter);
   REGISTER_TEST(otbUnaryFunctorWithIndexImageFilterNew);
   REGISTER_TEST(otbUnaryFunctorImageFilterNew);
   REGISTER_TEST(otbUnaryImageFunctorWithVectorImageFilter);
   REGISTER_TEST(otbImageToVectorImageCastFilterNew);
   REGISTER_TEST(otbPrintableImageFilterWithMask);
   REGISTER_TEST(otbStreamingResampleImageFilter);
+  REGISTER_TEST(otbStreamingResampleImageFilterWithCache);
   REGISTER_TEST(otbUnaryFunctorNeighborhoodWithOffsetImageFilterNew);
   REGISTER_TEST(otbBoxAndWhiskerImageFilterNew);
   REGISTER_TEST(otbVectorImageToAmplitudeImageFilter);
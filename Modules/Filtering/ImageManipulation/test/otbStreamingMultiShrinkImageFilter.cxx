@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "otbVectorImage.h"
+#include "otbStreamingMultiShrinkImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+int otbStreamingMultiShrinkImageFilter(int argc, char * argv[])
+{
+  char *             inputFilename = argv[1];
+  char *             outputFilename = argv[2];
+  const unsigned int Dimension = 2;
+
+  typedef unsigned int                                               PixelType;
+  typedef otb::VectorImage<PixelType, Dimension>                     ImageType;
+  typedef otb::ImageFileReader<ImageType>                            ReaderType;
+  typedef otb::ImageFileWriter<ImageType>                            WriterType;
+  typedef otb::StreamingMultiShrinkImageFilter<ImageType, ImageType> MultiShrinkType;
+  typedef otb::StreamingShrinkImageFilter<ImageType, ImageType>      ShrinkType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+
+  MultiShrinkType::ShrinkFactorsType factors;
+  for (int i = 3; i < argc; ++i)
+    {
+    factors.push_back(atoi(argv[i]));
+    }
+
+  MultiShrinkType::Pointer multiShrink = MultiShrinkType::New();
+  multiShrink->SetShrinkFactors(factors);
+  multiShrink->SetInput(reader->GetOutput());
+  multiShrink->Update();
+
+  // Write the output of the first factor
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(outputFilename);
+  writer->SetInput(multiShrink->GetShrunkOutput(0));
+  writer->Update();
+
+  // Each output must match the output of StreamingShrinkImageFilter
+  for (unsigned int level = 0; level < factors.size(); ++level)
+    {
+    ShrinkType::Pointer shrink = ShrinkType::New();
+    shrink->SetShrinkFactor(factors[level]);
+    shrink->SetInput(reader->GetOutput());
+    shrink->Update();
+
+    ImageType * reference = shrink->GetOutput();
+    ImageType * output = multiShrink->GetShrunkOutput(level);
+    if (reference->GetLargestPossibleRegion() != output->GetLargestPossibleRegion()
+        || reference->GetOrigin() != output->GetOrigin()
+        || reference->GetSpacing() != output->GetSpacing())
+      {
+      std::cerr << "Shrink factor " << factors[level] << ": geometry differs" << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    itk::ImageRegionConstIterator<ImageType> refIt(reference, reference->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> outIt(output, output->GetLargestPossibleRegion());
+    for (refIt.GoToBegin(), outIt.GoToBegin(); !refIt.IsAtEnd(); ++refIt, ++outIt)
+      {
+      if (refIt.Get() != outIt.Get())
+        {
+        std::cerr << "Shrink factor " << factors[level] << ": pixel " << refIt.GetIndex()
+                  << " differs" << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
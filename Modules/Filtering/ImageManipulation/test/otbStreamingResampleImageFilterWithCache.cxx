@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbStreamingResampleImageFilter.h"
+#include "otbDisplacementFieldCache.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "itkTranslationTransform.h"
+#include "itkImageRegionConstIterator.h"
+
+int otbStreamingResampleImageFilterWithCache(int itkNotUsed(argc), char * argv[])
+{
+  const char* inputFilename = argv[1];
+  const char* outputFilename = argv[2];
+  const char* cacheDirectory = argv[3];
+
+  const unsigned int Dimension = 2;
+  typedef double        InputPixelType;
+  typedef unsigned char OutputPixelType;
+  typedef double        InterpolatorPrecisionType;
+
+  typedef otb::Image<InputPixelType, Dimension>                InputImageType;
+  typedef otb::Image<OutputPixelType, Dimension>               OutputImageType;
+  typedef otb::ImageFileReader<InputImageType>                 ReaderType;
+  typedef otb::ImageFileWriter<OutputImageType>                WriterType;
+  typedef itk::TranslationTransform<InputPixelType, Dimension> TransformType;
+  typedef otb::StreamingResampleImageFilter<InputImageType, OutputImageType,
+      InterpolatorPrecisionType> StreamingResampleImageFilterType;
+
+  otb::DisplacementFieldCache::Pointer cache = otb::DisplacementFieldCache::Instance();
+  cache->SetDirectory(cacheDirectory);
+  cache->Clear();
+  cache->ResetCounters();
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+
+  TransformType::Pointer transform = TransformType::New();
+  TransformType::OutputVectorType translation;
+  translation[0] = 10;
+  translation[1] = 20;
+  transform->SetOffset(translation);
+
+  StreamingResampleImageFilterType::SizeType size;
+  size[0] = 600;
+  size[1] = 600;
+
+  // First resampling: the displacement field is computed and stored
+  StreamingResampleImageFilterType::Pointer resampler = StreamingResampleImageFilterType::New();
+  resampler->SetInput(reader->GetOutput());
+  resampler->SetOutputSize(size);
+  resampler->SetTransform(transform);
+  resampler->SetDisplacementFieldCacheDescription("Translation 10 20");
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput(resampler->GetOutput());
+  writer->SetNumberOfDivisionsStrippedStreaming(4);
+  writer->SetFileName(outputFilename);
+  writer->Update();
+
+  if (cache->GetNumberOfHits() != 0 || cache->GetNumberOfMisses() != 1)
+    {
+    std::cerr << "Expected 0 hit and 1 miss, got " << cache->GetNumberOfHits()
+              << " hits and " << cache->GetNumberOfMisses() << " misses" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Second resampling: the displacement field is read from the cache.
+  // Its transform is the identity, so the output only matches the
+  // first one if the cached field is used.
+  StreamingResampleImageFilterType::Pointer cachedResampler = StreamingResampleImageFilterType::New();
+  cachedResampler->SetInput(reader->GetOutput());
+  cachedResampler->SetOutputSize(size);
+  cachedResampler->SetTransform(TransformType::New());
+  cachedResampler->SetDisplacementFieldCacheDescription("Translation 10 20");
+  cachedResampler->Update();
+
+  if (cache->GetNumberOfHits() != 1 || cache->GetNumberOfMisses() != 1)
+    {
+    std::cerr << "Expected 1 hit and 1 miss, got " << cache->GetNumberOfHits()
+              << " hits and " << cache->GetNumberOfMisses() << " misses" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  resampler->UpdateLargestPossibleRegion();
+  itk::ImageRegionConstIterator<OutputImageType> it(resampler->GetOutput(),
+                                                    resampler->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<OutputImageType> cachedIt(cachedResampler->GetOutput(),
+                                                          cachedResampler->GetOutput()->GetLargestPossibleRegion());
+  for (it.GoToBegin(), cachedIt.GoToBegin(); !it.IsAtEnd(); ++it, ++cachedIt)
+    {
+    if (it.Get() != cachedIt.Get())
+      {
+      std::cerr << "Outputs differ at index " << it.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // An other description is a miss, and so is a cleared field
+  StreamingResampleImageFilterType::Pointer otherResampler = StreamingResampleImageFilterType::New();
+  otherResampler->SetInput(reader->GetOutput());
+  otherResampler->SetOutputSize(size);
+  otherResampler->SetTransform(TransformType::New());
+  otherResampler->SetDisplacementFieldCacheDescription("Identity");
+  otherResampler->UpdateOutputInformation();
+
+  cache->Clear();
+  StreamingResampleImageFilterType::Pointer clearedResampler = StreamingResampleImageFilterType::New();
+  clearedResampler->SetInput(reader->GetOutput());
+  clearedResampler->SetOutputSize(size);
+  clearedResampler->SetTransform(transform);
+  clearedResampler->SetDisplacementFieldCacheDescription("Translation 10 20");
+  clearedResampler->UpdateOutputInformation();
+
+  if (cache->GetNumberOfHits() != 1 || cache->GetNumberOfMisses() != 3)
+    {
+    std::cerr << "Expected 1 hit and 3 misses, got " << cache->GetNumberOfHits()
+              << " hits and " << cache->GetNumberOfMisses() << " misses" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  cache->Clear();
+  cache->SetDirectory("");
+
+  return EXIT_SUCCESS;
+}
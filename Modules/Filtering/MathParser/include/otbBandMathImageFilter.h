@@ -28,6 +28,7 @@
 #include "itkArray.h"
 
 #include "otbParser.h"
+#include "otbVectorizedParser.h"
 
 namespace otb
 {
@@ -69,6 +70,11 @@ namespace otb
  * This functionality assumes that all the band involved have the same
  * spacing and origin.
  *
+ * By default, the expression is compiled by VectorizedParser and
+ * evaluated on whole lines of pixels. If the expression is not
+ * supported by VectorizedParser, or if UseVectorizedParser is off,
+ * the expression is evaluated pixel by pixel by muParser.
+ *
  *
  * \sa Parser
  *
@@ -104,6 +110,7 @@ public:
   typedef typename ImageType::PointType           OrigineType;
   typedef typename ImageType::SpacingType         SpacingType;
   typedef Parser                                  ParserType;
+  typedef VectorizedParser                        VectorizedParserType;
   typedef itk::ProcessObject::DataObjectPointerArraySizeType DataObjectPointerArraySizeType;
 
   /** Set the nth filter input with or without a specified associated variable name */
@@ -126,6 +133,12 @@ public:
   /** Return a pointer on the nth filter input */
   ImageType * GetNthInput(DataObjectPointerArraySizeType idx);
 
+  /** Use the vectorized parser when the expression allows it (default
+   * is on) */
+  itkSetMacro(UseVectorizedParser, bool);
+  itkGetConstMacro(UseVectorizedParser, bool);
+  itkBooleanMacro(UseVectorizedParser);
+
 protected :
   BandMathImageFilter();
   ~BandMathImageFilter() ITK_OVERRIDE;
@@ -135,12 +148,19 @@ protected :
   void ThreadedGenerateData(const ImageRegionType& outputRegionForThread, itk::ThreadIdType threadId ) ITK_OVERRIDE;
   void AfterThreadedGenerateData() ITK_OVERRIDE;
 
+  /** Evaluate the expression line by line with the vectorized parser */
+  void VectorizedThreadedGenerateData(const ImageRegionType& outputRegionForThread, itk::ThreadIdType threadId);
+
 private :
   BandMathImageFilter(const Self&); //purposely not implemented
   void operator=(const Self&); //purposely not implemented
 
   std::string                           m_Expression;
   std::vector<ParserType::Pointer>      m_VParser;
+  std::vector<VectorizedParserType::Pointer> m_VVectorizedParser;
+  std::vector< std::vector< std::vector<double> > > m_ALine;
+  bool                                  m_UseVectorizedParser;
+  bool                                  m_IsVectorized;
   std::vector< std::vector<double> >    m_AImage;
   std::vector< std::string >            m_VVarName;
   unsigned int                          m_NbVar;
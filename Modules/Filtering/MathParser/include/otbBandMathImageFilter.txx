@@ -24,11 +24,14 @@
 #include "otbBandMathImageFilter.h"
 
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 #include "otbMacro.h"
 
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -47,6 +50,8 @@ BandMathImageFilter<TImage>
 
   m_UnderflowCount = 0;
   m_OverflowCount = 0;
+  m_UseVectorizedParser = true;
+  m_IsVectorized = false;
   m_ThreadUnderflow.SetSize(1);
   m_ThreadOverflow.SetSize(1);
 }
@@ -65,6 +70,7 @@ void BandMathImageFilter<TImage>
   Superclass::PrintSelf(os, indent);
 
   os << indent << "Expression: "      << m_Expression                  << std::endl;
+  os << indent << "UseVectorizedParser: " << m_UseVectorizedParser     << std::endl;
   os << indent << "Computed values follow:"                            << std::endl;
   os << indent << "UnderflowCount: "  << m_UnderflowCount              << std::endl;
   os << indent << "OverflowCount: "   << m_OverflowCount               << std::endl;
@@ -215,6 +221,39 @@ void BandMathImageFilter<TImage>
       m_VParser[i]->DefineVar(m_VVarName[j], &(m_AImage[i][j]));
       }
     }
+
+  // Compile the expression for line by line evaluation if possible
+  m_IsVectorized = false;
+  m_VVectorizedParser.clear();
+  m_ALine.clear();
+
+  if(m_UseVectorizedParser)
+    {
+    m_IsVectorized = true;
+    m_VVectorizedParser.resize(nbThreads);
+    m_ALine.resize(nbThreads);
+
+    for(i = 0; i < nbThreads && m_IsVectorized; ++i)
+      {
+      m_VVectorizedParser[i] = VectorizedParserType::New();
+      m_VVectorizedParser[i]->SetExpr(m_Expression);
+
+      for(j=0; j < m_NbVar; ++j)
+        {
+        m_VVectorizedParser[i]->DefineVar(m_VVarName[j], j);
+        }
+
+      m_IsVectorized = m_VVectorizedParser[i]->Compile();
+
+      // One line buffer per variable, plus one for the result
+      m_ALine[i].resize(m_NbVar+1);
+      }
+
+    if(!m_IsVectorized)
+      {
+      otbMsgDevMacro(<< "Expression " << m_Expression << " is not supported by the vectorized parser, using muParser");
+      }
+    }
 }
 
 template< typename TImage >
@@ -249,6 +288,12 @@ void BandMathImageFilter<TImage>
 ::ThreadedGenerateData(const ImageRegionType& outputRegionForThread,
            itk::ThreadIdType threadId)
 {
+  if(m_IsVectorized)
+    {
+    this->VectorizedThreadedGenerateData(outputRegionForThread, threadId);
+    return;
+    }
+
   double value;
   unsigned int j;
   unsigned int nbInputImages = this->GetNumberOfInputs();
@@ -332,6 +377,126 @@ void BandMathImageFilter<TImage>
     }
 }
 
+template< typename TImage >
+void BandMathImageFilter<TImage>
+::VectorizedThreadedGenerateData(const ImageRegionType& outputRegionForThread,
+           itk::ThreadIdType threadId)
+{
+  unsigned int j;
+  unsigned long k;
+  unsigned int nbInputImages = this->GetNumberOfInputs();
+  const unsigned long lineLength = outputRegionForThread.GetSize(0);
+
+  if(lineLength == 0)
+    {
+    return;
+    }
+
+  typedef itk::ImageScanlineConstIterator<TImage> ImageScanlineConstIteratorType;
+
+  assert(nbInputImages);
+  std::vector< ImageScanlineConstIteratorType > Vit(nbInputImages);
+
+  for(j=0; j < nbInputImages; ++j)
+    {
+    Vit[j] = ImageScanlineConstIteratorType (this->GetNthInput(j), outputRegionForThread);
+    }
+
+  itk::ImageScanlineIterator<TImage> ot (this->GetOutput(), outputRegionForThread);
+
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  VectorizedParserType::Pointer const& threadParser = m_VVectorizedParser[threadId];
+  std::vector< std::vector<double> > & threadLines  = m_ALine[threadId];
+  long                               & threadUnderflow = m_ThreadUnderflow[threadId];
+  long                               & threadOverflow  = m_ThreadOverflow[threadId];
+
+  // Only fill the buffers of the variables used by the expression
+  std::vector<bool>           used(m_NbVar);
+  std::vector<const double *> vars(m_NbVar);
+  for(j=0; j < m_NbVar+1; ++j)
+    {
+    threadLines[j].resize(lineLength);
+    }
+  for(j=0; j < m_NbVar; ++j)
+    {
+    used[j] = threadParser->IsVariableUsed(j);
+    vars[j] = &(threadLines[j][0]);
+    }
+  double * result = &(threadLines[m_NbVar][0]);
+
+  // Image indexes along the lines do not change from one line to another
+  const IndexType startIndex = outputRegionForThread.GetIndex();
+  for(k=0; k < lineLength; ++k)
+    {
+    threadLines[nbInputImages][k]   = static_cast<double>(startIndex[0] + k);
+    threadLines[nbInputImages+2][k] = static_cast<double>(m_Origin[0])
+      + static_cast<double>(startIndex[0] + k) * static_cast<double>(m_Spacing[0]);
+    }
+
+  ImageScanlineConstIteratorType & firstImageRegion = Vit.front(); // alias for better perfs
+  while(!firstImageRegion.IsAtEnd())
+    {
+    const IndexType lineIndex = firstImageRegion.GetIndex();
+
+    for(j=0; j < nbInputImages; ++j)
+      {
+      if(used[j])
+        {
+        double * line = &(threadLines[j][0]);
+        for(k=0; !Vit[j].IsAtEndOfLine(); ++k, ++Vit[j])
+          {
+          line[k] = static_cast<double>(Vit[j].Get());
+          }
+        }
+      }
+
+    // Image indexes along the columns
+    if(used[nbInputImages+1])
+      {
+      std::fill(threadLines[nbInputImages+1].begin(), threadLines[nbInputImages+1].end(),
+                static_cast<double>(lineIndex[1]));
+      }
+    if(used[nbInputImages+3])
+      {
+      std::fill(threadLines[nbInputImages+3].begin(), threadLines[nbInputImages+3].end(),
+                static_cast<double>(m_Origin[1]) + static_cast<double>(lineIndex[1]) * static_cast<double>(m_Spacing[1]));
+      }
+
+    threadParser->Eval(&(vars[0]), lineLength, result);
+
+    for(k=0; k < lineLength; ++k, ++ot)
+      {
+      const double value = result[k];
+
+      // Same handling of under/overflows as in ThreadedGenerateData
+      if (value < double(itk::NumericTraits<PixelType>::NonpositiveMin()))
+        {
+        ot.Set(itk::NumericTraits<PixelType>::NonpositiveMin());
+        threadUnderflow++;
+        }
+      else if (value > double(itk::NumericTraits<PixelType>::max()))
+        {
+        ot.Set(itk::NumericTraits<PixelType>::max());
+        threadOverflow++;
+        }
+      else
+        {
+        ot.Set(static_cast<PixelType>(value));
+        }
+
+      progress.CompletedPixel();
+      }
+
+    for(j=0; j < nbInputImages; ++j)
+      {
+      Vit[j].NextLine();
+      }
+    ot.NextLine();
+    }
+}
+
 }// end namespace otb
 
 #endif
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbVectorizedParser_h
+#define otbVectorizedParser_h
+
+#include "itkLightObject.h"
+#include "itkObjectFactory.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class VectorizedParser
+ * \brief Compiles a mathematical expression into a program evaluated
+ * on blocks of pixels.
+ *
+ * The expression is parsed once by Compile() into a stack based
+ * program. Each instruction of this program is then applied on a
+ * whole block of values (for instance a line of pixels), so that
+ * the inner loops are simple element-wise loops that the compiler
+ * can vectorize, instead of interpreting the expression for each
+ * pixel as Parser does.
+ *
+ * Only a subset of the muParser syntax is supported: numbers,
+ * constants, variables, arithmetic and comparison operators, and
+ * the usual mathematical functions (including ndvi, atan2, min,
+ * max, sum and avg). As in the muParser version OTB is built with,
+ * conditions use &&, || and the ternary operator with muParser
+ * 2.0.0 and later, and the if() function with older versions, so
+ * that an expression is never accepted by this parser only.
+ * Compile() returns false if the expression uses anything else, in
+ * which case the caller should fall back to Parser.
+ *
+ * Evaluation uses internal buffers: use one instance per thread.
+ *
+ * \sa Parser
+ * \sa BandMathImageFilter
+ *
+ * \ingroup OTBMathParser
+ */
+class ITK_EXPORT VectorizedParser : public itk::LightObject
+{
+public:
+  /** Standard class typedefs. */
+  typedef VectorizedParser                         Self;
+  typedef itk::LightObject                         Superclass;
+  typedef itk::SmartPointer<Self>                  Pointer;
+  typedef itk::SmartPointer<const Self>            ConstPointer;
+
+  /** New macro for creation of through a Smart Pointer */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods) */
+  itkTypeMacro(VectorizedParser, itk::LightObject);
+
+  /** Convenient type definitions */
+  typedef double                                   ValueType;
+
+  /** Number of values processed by each instruction at once */
+  itkStaticConstMacro(BlockSize, unsigned int, 256);
+
+  /** Set the expression to be compiled */
+  void SetExpr(const std::string & expression);
+
+  /** Return the expression to be compiled */
+  const std::string& GetExpr() const;
+
+  /** Define a variable: its values will be read in the idx-th
+   * buffer given to Eval() */
+  void DefineVar(const std::string & name, unsigned int idx);
+
+  /** Clear all the defined variables */
+  void ClearVar();
+
+  /** Compile the expression. Return false if the expression can not
+   * be handled by this parser */
+  bool Compile();
+
+  /** Return true if the expression has been successfully compiled */
+  bool IsCompiled() const
+  {
+    return m_Compiled;
+  }
+
+  /** Return true if the compiled expression reads the idx-th variable */
+  bool IsVariableUsed(unsigned int idx) const;
+
+  /** Evaluate the compiled expression on n values: vars[k] points to
+   * the n values of the variable defined with index k, and the
+   * results are written to out. */
+  void Eval(const ValueType * const * vars, unsigned long n, ValueType * out);
+
+protected:
+  VectorizedParser();
+  ~VectorizedParser() ITK_OVERRIDE;
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  VectorizedParser(const Self &);   //purposely not implemented
+  void operator =(const Self &);    //purposely not implemented
+
+  /** Program instruction */
+  struct Instruction
+  {
+    int          m_OpCode;
+    unsigned int m_Arg;
+    ValueType    m_Value;
+  };
+
+  class Compiler;
+  friend class Compiler;
+
+  std::string                          m_Expression;
+  std::map<std::string, unsigned int>  m_Variables;
+  std::vector<Instruction>             m_Program;
+  unsigned int                         m_StackDepth;
+  std::vector<ValueType>               m_Stack;
+  bool                                 m_Compiled;
+}; // end class
+
+}//end namespace otb
+
+#endif
@@ -0,0 +1,679 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbVectorizedParser.h"
+#include "otbMath.h"
+#include "itkMacro.h"
+#include "otb_muparser.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace otb
+{
+
+namespace
+{
+
+/** Instructions of the compiled program */
+enum OpCodeType
+{
+  OpVar, OpConst,
+  OpAdd, OpSub, OpMul, OpDiv, OpPow,
+  OpLt, OpGt, OpLe, OpGe, OpEq, OpNe, OpAnd, OpOr,
+  OpNeg, OpSelect,
+  OpSin, OpCos, OpTan, OpAsin, OpAcos, OpAtan, OpSinh, OpCosh, OpTanh,
+  OpExp, OpLog, OpLog2, OpLog10, OpSqrt, OpAbs, OpSign, OpRint,
+  OpNdvi, OpAtan2,
+  OpMin, OpMax, OpSum, OpAvg
+};
+
+typedef VectorizedParser::ValueType ValueType;
+
+//----------  Element-wise operations  ----------//BEGIN
+// Small functors, so that the loops below are inlined and can be
+// vectorized by the compiler
+struct AddOp   { ValueType operator()(ValueType a, ValueType b) const { return a + b; } };
+struct SubOp   { ValueType operator()(ValueType a, ValueType b) const { return a - b; } };
+struct MulOp   { ValueType operator()(ValueType a, ValueType b) const { return a * b; } };
+struct DivOp   { ValueType operator()(ValueType a, ValueType b) const { return a / b; } };
+struct PowOp   { ValueType operator()(ValueType a, ValueType b) const { return vcl_pow(a, b); } };
+struct LtOp    { ValueType operator()(ValueType a, ValueType b) const { return a < b; } };
+struct GtOp    { ValueType operator()(ValueType a, ValueType b) const { return a > b; } };
+struct LeOp    { ValueType operator()(ValueType a, ValueType b) const { return a <= b; } };
+struct GeOp    { ValueType operator()(ValueType a, ValueType b) const { return a >= b; } };
+struct EqOp    { ValueType operator()(ValueType a, ValueType b) const { return a == b; } };
+struct NeOp    { ValueType operator()(ValueType a, ValueType b) const { return a != b; } };
+struct AndOp   { ValueType operator()(ValueType a, ValueType b) const { return (a != 0) && (b != 0); } };
+struct OrOp    { ValueType operator()(ValueType a, ValueType b) const { return (a != 0) || (b != 0); } };
+struct MinOp   { ValueType operator()(ValueType a, ValueType b) const { return std::min(a, b); } };
+struct MaxOp   { ValueType operator()(ValueType a, ValueType b) const { return std::max(a, b); } };
+struct Atan2Op { ValueType operator()(ValueType a, ValueType b) const { return vcl_atan2(a, b); } };
+struct NdviOp
+{
+  ValueType operator()(ValueType r, ValueType niri) const
+  {
+    if ( vcl_abs(r + niri) < 1E-6 )
+      {
+      return 0.;
+      }
+    return (niri-r)/(niri+r);
+  }
+};
+
+struct NegOp   { ValueType operator()(ValueType a) const { return -a; } };
+struct SinOp   { ValueType operator()(ValueType a) const { return vcl_sin(a); } };
+struct CosOp   { ValueType operator()(ValueType a) const { return vcl_cos(a); } };
+struct TanOp   { ValueType operator()(ValueType a) const { return vcl_tan(a); } };
+struct AsinOp  { ValueType operator()(ValueType a) const { return vcl_asin(a); } };
+struct AcosOp  { ValueType operator()(ValueType a) const { return vcl_acos(a); } };
+struct AtanOp  { ValueType operator()(ValueType a) const { return vcl_atan(a); } };
+struct SinhOp  { ValueType operator()(ValueType a) const { return vcl_sinh(a); } };
+struct CoshOp  { ValueType operator()(ValueType a) const { return vcl_cosh(a); } };
+struct TanhOp  { ValueType operator()(ValueType a) const { return vcl_tanh(a); } };
+struct ExpOp   { ValueType operator()(ValueType a) const { return vcl_exp(a); } };
+struct LogOp   { ValueType operator()(ValueType a) const { return vcl_log(a); } };
+struct Log2Op  { ValueType operator()(ValueType a) const { return vcl_log(a) / CONST_LN2; } };
+struct Log10Op { ValueType operator()(ValueType a) const { return vcl_log10(a); } };
+struct SqrtOp  { ValueType operator()(ValueType a) const { return vcl_sqrt(a); } };
+struct AbsOp   { ValueType operator()(ValueType a) const { return vcl_abs(a); } };
+struct SignOp  { ValueType operator()(ValueType a) const { return (a < 0) ? -1 : ((a > 0) ? 1 : 0); } };
+struct RintOp  { ValueType operator()(ValueType a) const { return vcl_floor(a + 0.5); } };
+
+template <class TOp>
+inline void ApplyBinary(ValueType * a, const ValueType * b, unsigned int n, TOp op)
+{
+  for (unsigned int i = 0; i < n; ++i)
+    {
+    a[i] = op(a[i], b[i]);
+    }
+}
+
+template <class TOp>
+inline void ApplyUnary(ValueType * a, unsigned int n, TOp op)
+{
+  for (unsigned int i = 0; i < n; ++i)
+    {
+    a[i] = op(a[i]);
+    }
+}
+//----------  Element-wise operations  ----------//END
+
+/** Function table: name, opcode, number of arguments (0 for variadic) */
+struct FunctionDefinition
+{
+  const char * m_Name;
+  OpCodeType   m_OpCode;
+  unsigned int m_NbArgs;
+};
+
+const FunctionDefinition Functions[] =
+{
+  { "sin", OpSin, 1 },     { "cos", OpCos, 1 },     { "tan", OpTan, 1 },
+  { "asin", OpAsin, 1 },   { "acos", OpAcos, 1 },   { "atan", OpAtan, 1 },
+  { "sinh", OpSinh, 1 },   { "cosh", OpCosh, 1 },   { "tanh", OpTanh, 1 },
+  { "exp", OpExp, 1 },     { "log", OpLog, 1 },     { "ln", OpLog, 1 },
+  { "log2", OpLog2, 1 },   { "log10", OpLog10, 1 }, { "sqrt", OpSqrt, 1 },
+  { "abs", OpAbs, 1 },     { "sign", OpSign, 1 },   { "rint", OpRint, 1 },
+  { "ndvi", OpNdvi, 2 },   { "NDVI", OpNdvi, 2 },   { "atan2", OpAtan2, 2 },
+#ifndef OTB_MUPARSER_HAS_CXX_LOGICAL_OPERATORS
+  // muParser >= 2.0.0 replaces if() with the ternary operator
+  { "if", OpSelect, 3 },
+#endif
+  { "min", OpMin, 0 },     { "max", OpMax, 0 },     { "sum", OpSum, 0 },
+  { "avg", OpAvg, 0 }
+};
+
+/** Constants known by otb::Parser */
+struct ConstantDefinition
+{
+  const char * m_Name;
+  ValueType    m_Value;
+};
+
+const ConstantDefinition Constants[] =
+{
+  { "e", CONST_E },          { "_e", CONST_E },
+  { "log2e", CONST_LOG2E },  { "log10e", CONST_LOG10E },
+  { "ln2", CONST_LN2 },      { "ln10", CONST_LN10 },
+  { "pi", CONST_PI },        { "_pi", CONST_PI },
+  { "euler", CONST_EULER }
+};
+
+} // end anonymous namespace
+
+/** \class VectorizedParser::Compiler
+ * Recursive descent parser following the muParser operator
+ * precedence, emitting the program in postfix order.
+ * Each method returns false if the expression is not supported.
+ */
+class VectorizedParser::Compiler
+{
+public:
+  Compiler(VectorizedParser & parser)
+    : m_Parser(parser), m_Expr(parser.m_Expression), m_Pos(0), m_Depth(0)
+  {
+  }
+
+  bool Run()
+  {
+    m_Parser.m_Program.clear();
+    m_Parser.m_StackDepth = 0;
+    if (!ParseTernary())
+      {
+      return false;
+      }
+    SkipSpaces();
+    return m_Pos == m_Expr.size() && m_Depth == 1;
+  }
+
+private:
+  void SkipSpaces()
+  {
+    while (m_Pos < m_Expr.size() && std::isspace(static_cast<unsigned char>(m_Expr[m_Pos])))
+      {
+      ++m_Pos;
+      }
+  }
+
+  /** Consume the given token if it is next */
+  bool Accept(const char * token)
+  {
+    SkipSpaces();
+    const std::string::size_type len = std::string(token).size();
+    if (m_Expr.compare(m_Pos, len, token) == 0)
+      {
+      m_Pos += len;
+      return true;
+      }
+    return false;
+  }
+
+  /** Check that the next token is not the given one */
+  bool Peek(const char * token)
+  {
+    SkipSpaces();
+    return m_Expr.compare(m_Pos, std::string(token).size(), token) == 0;
+  }
+
+  void Emit(OpCodeType op, int stackChange, unsigned int arg = 0, ValueType value = 0.)
+  {
+    Instruction instr;
+    instr.m_OpCode = op;
+    instr.m_Arg = arg;
+    instr.m_Value = value;
+    m_Parser.m_Program.push_back(instr);
+
+    m_Depth += stackChange;
+    m_Parser.m_StackDepth = std::max(m_Parser.m_StackDepth, static_cast<unsigned int>(m_Depth));
+  }
+
+  bool ParseTernary()
+  {
+    if (!ParseOr())
+      {
+      return false;
+      }
+#ifdef OTB_MUPARSER_HAS_CXX_LOGICAL_OPERATORS
+    if (Accept("?"))
+      {
+      if (!ParseTernary() || !Accept(":") || !ParseTernary())
+        {
+        return false;
+        }
+      Emit(OpSelect, -2);
+      }
+#endif
+    return true;
+  }
+
+  bool ParseOr()
+  {
+    if (!ParseAnd())
+      {
+      return false;
+      }
+#ifdef OTB_MUPARSER_HAS_CXX_LOGICAL_OPERATORS
+    while (Accept("||"))
+      {
+      if (!ParseAnd())
+        {
+        return false;
+        }
+      Emit(OpOr, -1);
+      }
+#endif
+    return true;
+  }
+
+  bool ParseAnd()
+  {
+    if (!ParseComparison())
+      {
+      return false;
+      }
+#ifdef OTB_MUPARSER_HAS_CXX_LOGICAL_OPERATORS
+    while (Accept("&&"))
+      {
+      if (!ParseComparison())
+        {
+        return false;
+        }
+      Emit(OpAnd, -1);
+      }
+#endif
+    return true;
+  }
+
+  bool ParseComparison()
+  {
+    if (!ParseAdditive())
+      {
+      return false;
+      }
+    for (;;)
+      {
+      OpCodeType op;
+      // Two characters operators first
+      if (Accept("<="))      op = OpLe;
+      else if (Accept(">=")) op = OpGe;
+      else if (Accept("==")) op = OpEq;
+      else if (Accept("!=")) op = OpNe;
+      else if (Accept("<"))  op = OpLt;
+      else if (Accept(">"))  op = OpGt;
+      else return true;
+
+      if (!ParseAdditive())
+        {
+        return false;
+        }
+      Emit(op, -1);
+      }
+  }
+
+  bool ParseAdditive()
+  {
+    if (!ParseMultiplicative())
+      {
+      return false;
+      }
+    for (;;)
+      {
+      OpCodeType op;
+      if (Accept("+"))      op = OpAdd;
+      else if (Accept("-")) op = OpSub;
+      else return true;
+
+      if (!ParseMultiplicative())
+        {
+        return false;
+        }
+      Emit(op, -1);
+      }
+  }
+
+  bool ParseMultiplicative()
+  {
+    if (!ParseUnary())
+      {
+      return false;
+      }
+    for (;;)
+      {
+      OpCodeType op;
+      if (Accept("*"))      op = OpMul;
+      else if (Accept("/")) op = OpDiv;
+      else return true;
+
+      if (!ParseUnary())
+        {
+        return false;
+        }
+      Emit(op, -1);
+      }
+  }
+
+  // Like in muParser, the sign binds less than the power: -a^b = -(a^b)
+  bool ParseUnary()
+  {
+    if (Accept("-"))
+      {
+      if (!ParseUnary())
+        {
+        return false;
+        }
+      Emit(OpNeg, 0);
+      return true;
+      }
+    if (Accept("+"))
+      {
+      return ParseUnary();
+      }
+    return ParsePower();
+  }
+
+  // Right associative power
+  bool ParsePower()
+  {
+    if (!ParsePrimary())
+      {
+      return false;
+      }
+    if (Accept("^"))
+      {
+      if (!ParseUnary())
+        {
+        return false;
+        }
+      Emit(OpPow, -1);
+      }
+    return true;
+  }
+
+  bool ParsePrimary()
+  {
+    SkipSpaces();
+    if (m_Pos >= m_Expr.size())
+      {
+      return false;
+      }
+
+    if (Accept("("))
+      {
+      return ParseTernary() && Accept(")");
+      }
+
+    const char c = m_Expr[m_Pos];
+
+    // Numbers
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+      {
+      const char * begin = m_Expr.c_str() + m_Pos;
+      char * end = ITK_NULLPTR;
+      const ValueType value = std::strtod(begin, &end);
+      if (end == begin)
+        {
+        return false;
+        }
+      m_Pos += end - begin;
+      Emit(OpConst, 1, 0, value);
+      return true;
+      }
+
+    // Identifiers
+    if (!std::isalpha(static_cast<unsigned char>(c)) && c != '_')
+      {
+      return false;
+      }
+    std::string::size_type start = m_Pos;
+    while (m_Pos < m_Expr.size()
+           && (std::isalnum(static_cast<unsigned char>(m_Expr[m_Pos])) || m_Expr[m_Pos] == '_'))
+      {
+      ++m_Pos;
+      }
+    const std::string name = m_Expr.substr(start, m_Pos - start);
+
+    if (Peek("("))
+      {
+      return ParseFunction(name);
+      }
+
+    std::map<std::string, unsigned int>::const_iterator varIt = m_Parser.m_Variables.find(name);
+    if (varIt != m_Parser.m_Variables.end())
+      {
+      Emit(OpVar, 1, varIt->second);
+      return true;
+      }
+
+    for (unsigned int i = 0; i < sizeof(Constants) / sizeof(Constants[0]); ++i)
+      {
+      if (name == Constants[i].m_Name)
+        {
+        Emit(OpConst, 1, 0, Constants[i].m_Value);
+        return true;
+        }
+      }
+
+    // Unknown name
+    return false;
+  }
+
+  bool ParseFunction(const std::string & name)
+  {
+    const FunctionDefinition * fun = ITK_NULLPTR;
+    for (unsigned int i = 0; i < sizeof(Functions) / sizeof(Functions[0]); ++i)
+      {
+      if (name == Functions[i].m_Name)
+        {
+        fun = &Functions[i];
+        break;
+        }
+      }
+    if (fun == ITK_NULLPTR || !Accept("("))
+      {
+      return false;
+      }
+
+    unsigned int nbArgs = 0;
+    if (!Peek(")"))
+      {
+      do
+        {
+        if (!ParseTernary())
+          {
+          return false;
+          }
+        ++nbArgs;
+        }
+      while (Accept(","));
+      }
+    if (!Accept(")") || nbArgs == 0 || (fun->m_NbArgs != 0 && nbArgs != fun->m_NbArgs))
+      {
+      return false;
+      }
+
+    Emit(fun->m_OpCode, 1 - static_cast<int>(nbArgs), nbArgs);
+    return true;
+  }
+
+  VectorizedParser &     m_Parser;
+  const std::string &    m_Expr;
+  std::string::size_type m_Pos;
+  int                    m_Depth;
+};
+
+VectorizedParser::VectorizedParser()
+  : m_StackDepth(0),
+    m_Compiled(false)
+{
+}
+
+VectorizedParser::~VectorizedParser()
+{
+}
+
+void VectorizedParser::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Expression: " << m_Expression << std::endl;
+  os << indent << "Compiled: " << (m_Compiled ? "true" : "false") << std::endl;
+  os << indent << "Program size: " << m_Program.size() << std::endl;
+  os << indent << "Stack depth: " << m_StackDepth << std::endl;
+}
+
+void VectorizedParser::SetExpr(const std::string & expression)
+{
+  m_Expression = expression;
+  m_Compiled = false;
+}
+
+const std::string& VectorizedParser::GetExpr() const
+{
+  return m_Expression;
+}
+
+void VectorizedParser::DefineVar(const std::string & name, unsigned int idx)
+{
+  m_Variables[name] = idx;
+  m_Compiled = false;
+}
+
+void VectorizedParser::ClearVar()
+{
+  m_Variables.clear();
+  m_Compiled = false;
+}
+
+bool VectorizedParser::Compile()
+{
+  Compiler compiler(*this);
+  m_Compiled = compiler.Run();
+
+  if (!m_Compiled)
+    {
+    m_Program.clear();
+    m_StackDepth = 0;
+    }
+  m_Stack.resize(m_StackDepth * BlockSize);
+
+  return m_Compiled;
+}
+
+bool VectorizedParser::IsVariableUsed(unsigned int idx) const
+{
+  for (std::vector<Instruction>::const_iterator it = m_Program.begin(); it != m_Program.end(); ++it)
+    {
+    if (it->m_OpCode == OpVar && it->m_Arg == idx)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+void VectorizedParser::Eval(const ValueType * const * vars, unsigned long n, ValueType * out)
+{
+  if (!m_Compiled)
+    {
+    itkExceptionMacro(<< "Expression " << m_Expression << " has not been compiled");
+    }
+
+  ValueType * stack = &m_Stack[0];
+
+  for (unsigned long offset = 0; offset < n; offset += BlockSize)
+    {
+    const unsigned int len = static_cast<unsigned int>(std::min(static_cast<unsigned long>(BlockSize), n - offset));
+
+    // Number of blocks in the stack
+    unsigned int sp = 0;
+
+    for (std::vector<Instruction>::const_iterator it = m_Program.begin(); it != m_Program.end(); ++it)
+      {
+      ValueType * top = stack + (sp > 0 ? sp - 1 : 0) * BlockSize;
+      ValueType * prev = stack + (sp > 1 ? sp - 2 : 0) * BlockSize;
+
+      switch (it->m_OpCode)
+        {
+        case OpVar:
+          std::copy(vars[it->m_Arg] + offset, vars[it->m_Arg] + offset + len, stack + sp * BlockSize);
+          ++sp;
+          break;
+        case OpConst:
+          std::fill(stack + sp * BlockSize, stack + sp * BlockSize + len, it->m_Value);
+          ++sp;
+          break;
+        case OpAdd:   ApplyBinary(prev, top, len, AddOp());   --sp; break;
+        case OpSub:   ApplyBinary(prev, top, len, SubOp());   --sp; break;
+        case OpMul:   ApplyBinary(prev, top, len, MulOp());   --sp; break;
+        case OpDiv:   ApplyBinary(prev, top, len, DivOp());   --sp; break;
+        case OpPow:   ApplyBinary(prev, top, len, PowOp());   --sp; break;
+        case OpLt:    ApplyBinary(prev, top, len, LtOp());    --sp; break;
+        case OpGt:    ApplyBinary(prev, top, len, GtOp());    --sp; break;
+        case OpLe:    ApplyBinary(prev, top, len, LeOp());    --sp; break;
+        case OpGe:    ApplyBinary(prev, top, len, GeOp());    --sp; break;
+        case OpEq:    ApplyBinary(prev, top, len, EqOp());    --sp; break;
+        case OpNe:    ApplyBinary(prev, top, len, NeOp());    --sp; break;
+        case OpAnd:   ApplyBinary(prev, top, len, AndOp());   --sp; break;
+        case OpOr:    ApplyBinary(prev, top, len, OrOp());    --sp; break;
+        case OpNdvi:  ApplyBinary(prev, top, len, NdviOp());  --sp; break;
+        case OpAtan2: ApplyBinary(prev, top, len, Atan2Op()); --sp; break;
+        case OpNeg:   ApplyUnary(top, len, NegOp());   break;
+        case OpSin:   ApplyUnary(top, len, SinOp());   break;
+        case OpCos:   ApplyUnary(top, len, CosOp());   break;
+        case OpTan:   ApplyUnary(top, len, TanOp());   break;
+        case OpAsin:  ApplyUnary(top, len, AsinOp());  break;
+        case OpAcos:  ApplyUnary(top, len, AcosOp());  break;
+        case OpAtan:  ApplyUnary(top, len, AtanOp());  break;
+        case OpSinh:  ApplyUnary(top, len, SinhOp());  break;
+        case OpCosh:  ApplyUnary(top, len, CoshOp());  break;
+        case OpTanh:  ApplyUnary(top, len, TanhOp());  break;
+        case OpExp:   ApplyUnary(top, len, ExpOp());   break;
+        case OpLog:   ApplyUnary(top, len, LogOp());   break;
+        case OpLog2:  ApplyUnary(top, len, Log2Op());  break;
+        case OpLog10: ApplyUnary(top, len, Log10Op()); break;
+        case OpSqrt:  ApplyUnary(top, len, SqrtOp());  break;
+        case OpAbs:   ApplyUnary(top, len, AbsOp());   break;
+        case OpSign:  ApplyUnary(top, len, SignOp());  break;
+        case OpRint:  ApplyUnary(top, len, RintOp());  break;
+        case OpSelect:
+          {
+          ValueType * cond = stack + (sp - 3) * BlockSize;
+          for (unsigned int i = 0; i < len; ++i)
+            {
+            cond[i] = (cond[i] != 0) ? prev[i] : top[i];
+            }
+          sp -= 2;
+          break;
+          }
+        default:
+          {
+          // Variadic functions: the arguments are the m_Arg last
+          // blocks of the stack
+          const unsigned int nbArgs = it->m_Arg;
+          ValueType * first = stack + (sp - nbArgs) * BlockSize;
+          for (ValueType * arg = first + BlockSize; arg <= top; arg += BlockSize)
+            {
+            switch (it->m_OpCode)
+              {
+              case OpMin: ApplyBinary(first, arg, len, MinOp()); break;
+              case OpMax: ApplyBinary(first, arg, len, MaxOp()); break;
+              default:    ApplyBinary(first, arg, len, AddOp()); break;
+              }
+            }
+          if (it->m_OpCode == OpAvg)
+            {
+            const ValueType factor = 1. / static_cast<ValueType>(nbArgs);
+            for (unsigned int i = 0; i < len; ++i)
+              {
+              first[i] *= factor;
+              }
+            }
+          sp -= nbArgs - 1;
+          break;
+          }
+        }
+      }
+
+    std::copy(stack, stack + len, out + offset);
+    }
+}
+
+}//end namespace otb
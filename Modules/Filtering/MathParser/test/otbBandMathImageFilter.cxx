@@ -28,6 +28,7 @@
 #include "otbImage.h"
 #include "otbBandMathImageFilter.h"
 #include "otbImageFileWriter.h"
+#include "itkTimeProbe.h"
 
 int otbBandMathImageFilterNew( int itkNotUsed(argc), char* itkNotUsed(argv) [])
 {
@@ -285,3 +286,129 @@ int otbBandMathImageFilterWithIdx( int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbBandMathImageFilterVectorized( int itkNotUsed(argc), char* itkNotUsed(argv) [])
+{
+  typedef float                                             PixelType;
+  typedef otb::Image<PixelType, 2>                          ImageType;
+  typedef otb::BandMathImageFilter<ImageType>               FilterType;
+
+  const unsigned int N = 1000;
+  unsigned int FAIL_FLAG = 0;
+
+  ImageType::SizeType size;
+  size.Fill(N);
+  ImageType::IndexType index;
+  index.Fill(0);
+  ImageType::RegionType region;
+  region.SetSize(size);
+  region.SetIndex(index);
+
+  ImageType::Pointer image1 = ImageType::New();
+  ImageType::Pointer image2 = ImageType::New();
+
+  image1->SetRegions( region );
+  image1->Allocate();
+  image2->SetRegions( region );
+  image2->Allocate();
+
+  typedef itk::ImageRegionIteratorWithIndex<ImageType> IteratorType;
+  IteratorType it1(image1, region);
+  IteratorType it2(image2, region);
+
+  for (it1.GoToBegin(), it2.GoToBegin(); !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    ImageType::IndexType i1 = it1.GetIndex();
+
+    it1.Set( (i1[0] * 7 + i1[1] * 13) % 256 );
+    it2.Set( (i1[0] * 3 + i1[1] * 5) % 512 );
+  }
+
+  // The last expression is only supported by muParser and checks the
+  // fallback of the vectorized mode
+  const char * expressions[] =
+    {
+    "ndvi(b1, b2)",
+    "(b2 - b1) / (b2 + b1 + 1E-3)",
+    "cos(2 * pi * b1)/(2 * pi * b2 + 1E-3) + sqrt(b1) * -b2^2",
+    "min(b1, b2, 128) + max(b1, b2) - abs(b1 - b2) + idxX * idxPhyY",
+#ifdef OTB_MUPARSER_HAS_CXX_LOGICAL_OPERATORS
+    "b1 > 100 && b2 < 300 ? b1 : b2",
+#else
+    "if(b1 > 100, b1, b2)",
+#endif
+    "b1 and b2"
+    };
+  const unsigned int nbExpressions = sizeof(expressions) / sizeof(expressions[0]);
+
+  for (unsigned int e = 0; e < nbExpressions; ++e)
+    {
+    ImageType::Pointer outputs[2];
+    itk::TimeProbe     chrono[2];
+
+    for (unsigned int mode = 0; mode < 2; ++mode)
+      {
+      FilterType::Pointer filter = FilterType::New();
+      filter->SetNthInput(0, image1);
+      filter->SetNthInput(1, image2);
+      filter->SetExpression(expressions[e]);
+      filter->SetUseVectorizedParser(mode == 1);
+
+      chrono[mode].Start();
+      filter->Update();
+      chrono[mode].Stop();
+
+      outputs[mode] = filter->GetOutput();
+      }
+
+    std::cout << expressions[e] << std::endl
+              << "  muParser:   " << chrono[0].GetTotal() << " s" << std::endl
+              << "  vectorized: " << chrono[1].GetTotal() << " s" << std::endl;
+
+    IteratorType itRef(outputs[0], region);
+    IteratorType itVec(outputs[1], region);
+    for (itRef.GoToBegin(), itVec.GoToBegin(); !itRef.IsAtEnd(); ++itRef, ++itVec)
+      {
+      const double ref = itRef.Get();
+      const double vec = itVec.Get();
+      const bool bothNaN = vnl_math_isnan(ref) && vnl_math_isnan(vec);
+      if ( !bothNaN && vcl_abs(ref - vec) > 1E-6 * std::max(1., vcl_abs(ref)) )
+        {
+        std::cout << "Expression " << expressions[e] << " at " << itRef.GetIndex()
+                  << ": muParser = " << ref << " vectorized = " << vec << " -> TEST FAILLED" << std::endl;
+        FAIL_FLAG++;
+        break;
+        }
+      }
+    }
+
+  // The vectorized mode must reject the syntax that muParser rejects
+#ifdef OTB_MUPARSER_HAS_CXX_LOGICAL_OPERATORS
+  const char * invalidExpression = "if(b1 > 100, b1, b2)";
+#else
+  const char * invalidExpression = "b1 > 100 && b2 < 300 ? b1 : b2";
+#endif
+  FilterType::Pointer invalidFilter = FilterType::New();
+  invalidFilter->SetNthInput(0, image1);
+  invalidFilter->SetNthInput(1, image2);
+  invalidFilter->SetExpression(invalidExpression);
+  invalidFilter->SetUseVectorizedParser(true);
+  try
+    {
+    invalidFilter->Update();
+    std::cout << "Expression " << invalidExpression << " accepted in vectorized mode -> TEST FAILLED" << std::endl;
+    FAIL_FLAG++;
+    }
+  catch (itk::ExceptionObject &)
+    {
+    }
+
+  if (FAIL_FLAG)
+    {
+    std::cout << "[FAILLED]" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "[PASSED]" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -33,4 +33,5 @@ void RegisterTests()
   REGISTER_TEST(otbBandMathImageFilterNew);
   REGISTER_TEST(otbBandMathImageFilter);
   REGISTER_TEST(otbBandMathImageFilterWithIdx);
+  REGISTER_TEST(otbBandMathImageFilterVectorized);
 }
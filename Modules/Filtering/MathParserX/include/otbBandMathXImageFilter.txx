@@ -25,14 +25,11 @@
 
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionConstIterator.h"
-#include "itkImageScanlineConstIterator.h"
-#include "itkImageScanlineIterator.h"
-#include "itkImageRegionConstIteratorWithOnlyIndex.h"
-#include "itkConstNeighborhoodIterator.h"
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 #include "otbMacro.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -1044,45 +1041,45 @@ void BandMathXImageFilter<TImage>
 ::ThreadedGenerateData(const ImageRegionType& outputRegionForThread,
            itk::ThreadIdType threadId)
 {
+  // The expressions are evaluated line by line: pixel values are read
+  // directly from the input buffers, neighborhoods are gathered once
+  // per line into preallocated blocks, and results are written
+  // directly to the output buffers. This way, there is no iterator,
+  // boundary condition or pixel allocation overhead for each pixel.
+
+  typedef typename ImageType::InternalPixelType InternalPixelType;
 
-  ValueType value;
   unsigned int nbInputImages = this->GetNumberOfInputs();
+  const unsigned int nbExpressions = m_Expression.size();
+  const long lineLength = outputRegionForThread.GetSize(0);
 
-  //----------------- --------- -----------------//
-  //----------------- Iterators -----------------//
-  //----------------- --------- -----------------//
-  typedef itk::ImageScanlineConstIterator<TImage> ImageScanlineConstIteratorType;
-  typedef itk::ImageScanlineIterator<TImage> ImageScanlineIteratorType;
-  typedef itk::ImageRegionConstIteratorWithOnlyIndex<TImage> IndexIteratorType;
-  std::vector< ImageScanlineConstIteratorType > Vit;
-  Vit.resize(nbInputImages);
-  for(unsigned int j=0; j < nbInputImages; ++j)
-    Vit[j] = ImageScanlineConstIteratorType (this->GetNthInput(j), outputRegionForThread);
-    
+  if (lineLength == 0)
+    {
+    return;
+    }
 
-  std::vector< ImageScanlineIteratorType > VoutIt;
-  VoutIt.resize(m_Expression.size());
-  for(unsigned int j=0; j < VoutIt.size(); ++j)
-    VoutIt[j] = ImageScanlineIteratorType (this->GetOutput(j), outputRegionForThread);
-    
+  //----------------- --------------- -----------------//
+  //----------------- Buffers access  -----------------//
+  //----------------- --------------- -----------------//
+  std::vector<const InternalPixelType *> inputBuffers(nbInputImages);
+  std::vector<unsigned int>              inputNbComp(nbInputImages);
+  std::vector<ImageRegionType>           inputBufferedRegions(nbInputImages);
+  std::vector<long>                      inputLineOffsets(nbInputImages);
 
-  //Special case : neighborhoods
-  std::vector< itk::ConstNeighborhoodIterator<TImage> > VNit;
-  for(unsigned int j=0; j<m_VVarName.size(); ++j)
-    if (m_VVarName[j].type == 6)
-     {
-        RadiusType radius;
-        radius[0]=(int) ((m_VVarName[j].info[2]-1)/2); // Size x direction (otb convention)
-        radius[1]=(int) ((m_VVarName[j].info[3]-1)/2); // Size y direction (otb convention)
-        VNit.push_back( itk::ConstNeighborhoodIterator<TImage>(radius, this->GetNthInput(m_VVarName[j].info[0]),outputRegionForThread)); // info[0] = Input image ID
-        VNit.back().NeedToUseBoundaryConditionOn();
-     }
-
-  // Index only iterator
-  IndexIteratorType indexIterator(this->GetNthInput(0), outputRegionForThread);
+  for(unsigned int j=0; j < nbInputImages; ++j)
+    {
+    const ImageType * input = this->GetNthInput(j);
+    inputBuffers[j] = input->GetBufferPointer();
+    inputNbComp[j] = input->GetNumberOfComponentsPerPixel();
+    inputBufferedRegions[j] = input->GetBufferedRegion();
+    }
 
-  // Support progress methods/callbacks
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+  std::vector<InternalPixelType *> outputBuffers(nbExpressions);
+  std::vector<long>                outputLineOffsets(nbExpressions);
+  for(unsigned int j=0; j < nbExpressions; ++j)
+    {
+    outputBuffers[j] = this->GetOutput(j)->GetBufferPointer();
+    }
 
   // iterator on variables
   typename std::vector<adhocStruct>::iterator iterVarStart =
@@ -1092,36 +1089,93 @@ void BandMathXImageFilter<TImage>
   typename std::vector<adhocStruct>::iterator iterVar =
     iterVarStart;
 
-  // temporary output vectors
-  std::vector<PixelType> tmpOutputs(m_Expression.size());
-  for(unsigned int k=0; k<m_Expression.size(); ++k)
-    tmpOutputs[k].SetSize(m_outputsDimensions[k]);
+  // Neighborhood blocks: for each neighborhood variable, the rows of
+  // its band covering the neighborhoods of all the pixels of the line
+  std::vector< std::vector<double> > neighborhoodBlocks(m_AImage[threadId].size());
+  for(iterVar = iterVarStart; iterVar != iterVarEnd; ++iterVar)
+    {
+    if (iterVar->type == 6)
+      {
+      // info[2] : Size x direction, info[3] : Size y direction
+      neighborhoodBlocks[iterVar - iterVarStart].resize(iterVar->info[3] * (lineLength + iterVar->info[2] - 1));
+      }
+    }
 
-  //----------------- --------------------- -----------------//
-  //----------------- Variable affectations -----------------//
-  //----------------- --------------------- -----------------//
-  for(unsigned int j=0; j < nbInputImages; ++j)       {  Vit[j].GoToBegin();     }
-  for(unsigned int j=0; j < m_Expression.size(); ++j) {  VoutIt[j].GoToBegin();  }
-  for(unsigned int j=0; j < VNit.size(); ++j)         {  VNit[j].GoToBegin();    }
-  indexIterator.GoToBegin();
+  // Support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
-  while(!Vit[0].IsAtEnd()) // For each pixel
+  const double minValue = static_cast<double>(itk::NumericTraits<PixelValueType>::NonpositiveMin());
+  const double maxValue = static_cast<double>(itk::NumericTraits<PixelValueType>::max());
+
+  IndexType lineIndex = outputRegionForThread.GetIndex();
+  const long lastLine = lineIndex[1] + static_cast<long>(outputRegionForThread.GetSize(1));
+
+  for(; lineIndex[1] < lastLine; ++lineIndex[1]) // For each line
     {
-    while(!Vit[0].IsAtEndOfLine()) // For each line
+    for(unsigned int j=0; j < nbInputImages; ++j)
       {
-      int ngbhNameIndex=0; int index;
+      inputLineOffsets[j] = this->GetNthInput(j)->ComputeOffset(lineIndex);
+      }
+    for(unsigned int j=0; j < nbExpressions; ++j)
+      {
+      outputLineOffsets[j] = this->GetOutput(j)->ComputeOffset(lineIndex);
+      }
+
+    //----------------- Neighborhoods gathering -----------------//
+    for(iterVar = iterVarStart; iterVar != iterVarEnd; ++iterVar)
+      {
+      if (iterVar->type != 6)
+        {
+        continue;
+        }
 
-      iterVar = iterVarStart;
-      while (iterVar != iterVarEnd)
+      // iterVar->info[0] : Input image #ID, iterVar->info[1] : Band #ID
+      const unsigned int imageId = iterVar->info[0];
+      const ImageType * input = this->GetNthInput(imageId);
+      const ImageRegionType & bufferedRegion = inputBufferedRegions[imageId];
+      const long radiusX = (iterVar->info[2]-1)/2;
+      const long radiusY = (iterVar->info[3]-1)/2;
+      const long blockWidth = lineLength + 2 * radiusX;
+      double * block = &(neighborhoodBlocks[iterVar - iterVarStart][0]);
+
+      // Pixels outside of the buffered region are replaced by the
+      // nearest pixel inside (zero flux Neumann boundary condition)
+      const long minX = bufferedRegion.GetIndex(0);
+      const long maxX = minX + static_cast<long>(bufferedRegion.GetSize(0)) - 1;
+      const long minY = bufferedRegion.GetIndex(1);
+      const long maxY = minY + static_cast<long>(bufferedRegion.GetSize(1)) - 1;
+
+      for(long row = 0; row < iterVar->info[3]; ++row)
+        {
+        IndexType rowIndex;
+        rowIndex[0] = minX;
+        rowIndex[1] = std::min(std::max(static_cast<long>(lineIndex[1]) + row - radiusY, minY), maxY);
+        const InternalPixelType * rowBuffer = inputBuffers[imageId]
+          + input->ComputeOffset(rowIndex) * inputNbComp[imageId] + iterVar->info[1];
+
+        for(long col = 0; col < blockWidth; ++col)
+          {
+          const long x = std::min(std::max(static_cast<long>(lineIndex[0]) + col - radiusX, minX), maxX) - minX;
+          block[row * blockWidth + col] = static_cast<double>(rowBuffer[x * inputNbComp[imageId]]);
+          }
+        }
+      }
+
+    for(long x = 0; x < lineLength; ++x) // For each pixel
+      {
+      //----------------- --------------------- -----------------//
+      //----------------- Variable affectations -----------------//
+      //----------------- --------------------- -----------------//
+      for(iterVar = iterVarStart; iterVar != iterVarEnd; ++iterVar)
         {
         switch (iterVar->type)
           {
           case 0 : //idxX
-            iterVar->value = static_cast<double>(indexIterator.GetIndex()[0]);
+            iterVar->value = static_cast<double>(lineIndex[0] + x);
           break;
 
           case 1 : //idxY
-            iterVar->value = static_cast<double>(indexIterator.GetIndex()[1]);
+            iterVar->value = static_cast<double>(lineIndex[1]);
           break;
 
           case 2 : //Spacing X (imiPhyX)
@@ -1133,32 +1187,33 @@ void BandMathXImageFilter<TImage>
           break;
 
           case 4 : //vector
+            {
             // iterVar->info[0] : Input image #ID
+            const unsigned int imageId = iterVar->info[0];
+            const InternalPixelType * pixel = inputBuffers[imageId] + (inputLineOffsets[imageId] + x) * inputNbComp[imageId];
             for(int p=0; p < iterVar->value.GetCols(); ++p)
-              iterVar->value.At(0,p) = Vit[iterVar->info[0]].Get()[p];
+              iterVar->value.At(0,p) = static_cast<double>(pixel[p]);
+            }
           break;
 
           case 5 : //pixel
+            {
             // iterVar->info[0] : Input image #ID
             // iterVar->info[1] : Band #ID
-            iterVar->value = Vit[iterVar->info[0]].Get()[iterVar->info[1]];
+            const unsigned int imageId = iterVar->info[0];
+            iterVar->value = static_cast<double>(
+              inputBuffers[imageId][(inputLineOffsets[imageId] + x) * inputNbComp[imageId] + iterVar->info[1]]);
+            }
           break;
 
           case 6 : //neighborhood
-    
-          // iterVar->info[1] : Band #ID
-          if (iterVar->info[2]*iterVar->info[3] != (int) VNit[ngbhNameIndex].Size() )
-            itkExceptionMacro(<< "Size of muparserx variable is different from its related otb neighborhood iterator")
-
-          index=0;
-          for(int rows=0; rows<iterVar->info[3]; ++rows)
-            for(int cols=0; cols<iterVar->info[2]; ++cols)
-              {
-                iterVar->value.At(rows,cols) = VNit[ngbhNameIndex].GetPixel(index)[iterVar->info[1]];
-                index++;
-              }
-
-          ngbhNameIndex++;
+            {
+            const double * block = &(neighborhoodBlocks[iterVar - iterVarStart][0]);
+            const long blockWidth = lineLength + iterVar->info[2] - 1;
+            for(int rows=0; rows<iterVar->info[3]; ++rows)
+              for(int cols=0; cols<iterVar->info[2]; ++cols)
+                iterVar->value.At(rows,cols) = block[rows * blockWidth + x + cols];
+            }
           break;
 
           case 7 :
@@ -1173,74 +1228,71 @@ void BandMathXImageFilter<TImage>
             itkExceptionMacro(<< "Type of the variable is unknown");
           break;
           }
-
-        iterVar++;
-        }//End while on vars
+        }//End for on vars
 
       //----------------- ----------- -----------------//
       //----------------- Evaluations -----------------//
       //----------------- ----------- -----------------//
-      for(unsigned int IDExpression=0; IDExpression<m_Expression.size(); ++IDExpression)
+      for(unsigned int IDExpression=0; IDExpression<nbExpressions; ++IDExpression)
         {
-        value = m_VParser[threadId][IDExpression]->EvalRef();
+        const ValueType & value = m_VParser[threadId][IDExpression]->EvalRef();
+        InternalPixelType * outPixel = outputBuffers[IDExpression]
+          + (outputLineOffsets[IDExpression] + x) * m_outputsDimensions[IDExpression];
 
-        switch (value.GetType())
-          {   //ValueType
-          case 'i':
-          tmpOutputs[IDExpression][0] = value.GetInteger();
-          break;
+        for(unsigned int p=0; p<m_outputsDimensions[IDExpression]; ++p)
+          {
+          double result = 0.;
 
-          case 'f':
-          tmpOutputs[IDExpression][0] = value.GetFloat();
-          break;
+          switch (value.GetType())
+            {   //ValueType
+            case 'i':
+            result = value.GetInteger();
+            break;
 
-          case 'c':
-          itkExceptionMacro(<< "Complex numbers are not supported." << std::endl);
-          break;
+            case 'f':
+            result = value.GetFloat();
+            break;
 
-          case 'm':
-            {
-            const mup::matrix_type &vect = value.GetArray();
-  
-            if ( vect.GetRows() == 1 ) //Vector
-              for(int p=0; p<vect.GetCols(); ++p)
-                tmpOutputs[IDExpression][p] = vect.At(0,p).GetFloat();
-            else //Matrix
-              itkExceptionMacro(<< "Result of the evaluation can't be a matrix." << std::endl);
+            case 'c':
+            itkExceptionMacro(<< "Complex numbers are not supported." << std::endl);
+            break;
+
+            case 'm':
+              {
+              const mup::matrix_type &vect = value.GetArray();
+
+              if ( vect.GetRows() == 1 ) //Vector
+                result = vect.At(0,p).GetFloat();
+              else //Matrix
+                itkExceptionMacro(<< "Result of the evaluation can't be a matrix." << std::endl);
+              }
+            break;
             }
-          break;
-          }
- 
-        //----------------- Pixel affectations -----------------//
-        for(unsigned int p=0; p<m_outputsDimensions[IDExpression]; ++p)
-          {
+
+          //----------------- Pixel affectations -----------------//
           // Case value is equal to -inf or inferior to the minimum value
           // allowed by the PixelValueType cast
-          if (tmpOutputs[IDExpression][p] < double(itk::NumericTraits<PixelValueType>::NonpositiveMin()))
+          if (result < minValue)
             {
-            tmpOutputs[IDExpression][p] = itk::NumericTraits<PixelValueType>::NonpositiveMin();
+            outPixel[p] = itk::NumericTraits<PixelValueType>::NonpositiveMin();
             m_ThreadUnderflow[threadId]++;
             }
           // Case value is equal to inf or superior to the maximum value
           // allowed by the PixelValueType cast
-          else if (tmpOutputs[IDExpression][p] > double(itk::NumericTraits<PixelValueType>::max()))
+          else if (result > maxValue)
             {
-            tmpOutputs[IDExpression][p] = itk::NumericTraits<PixelValueType>::max();
+            outPixel[p] = itk::NumericTraits<PixelValueType>::max();
             m_ThreadOverflow[threadId]++;
             }
+          else
+            {
+            outPixel[p] = static_cast<PixelValueType>(result);
+            }
           }
-        VoutIt[IDExpression].Set(tmpOutputs[IDExpression]);
         }
 
-      for(unsigned int j=0; j < nbInputImages; ++j)        {   ++Vit[j];    }
-      for(unsigned int j=0; j < m_Expression.size(); ++j)  {   ++VoutIt[j]; }
-      for(unsigned int j=0; j < VNit.size(); ++j)          {   ++VNit[j];   }
-      ++indexIterator;
-
       progress.CompletedPixel();
       }
-    for(unsigned int j=0; j < nbInputImages; ++j)        {   Vit[j].NextLine();    }
-    for(unsigned int j=0; j < m_Expression.size(); ++j)  {   VoutIt[j].NextLine(); }
     }
 
 }
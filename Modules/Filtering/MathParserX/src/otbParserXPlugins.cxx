@@ -63,7 +63,7 @@ void dotpr::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      mup::matrix_type m1 = a_pArg[0]->GetArray();
+      const mup::matrix_type &m1 = a_pArg[0]->GetArray();
       
 
       int nbrows = m1.GetRows();
@@ -77,7 +77,7 @@ void dotpr::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_
         float sum=0.0;
 
         assert(a_pArg[k]->GetType()=='m');
-        mup::matrix_type m2 = a_pArg[k]->GetArray();
+        const mup::matrix_type &m2 = a_pArg[k]->GetArray();
 
         assert(m2.GetRows() == nbrows);
         assert(m2.GetCols() == nbcols);
@@ -101,8 +101,8 @@ void ElementWiseDivision::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *
       assert(a_pArg[0]->GetType()=='m');
       assert(a_pArg[1]->GetType()=='m');
 
-      const mup::matrix_type a = a_pArg[0]->GetArray();
-      const mup::matrix_type b = a_pArg[1]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
+      const mup::matrix_type &b = a_pArg[1]->GetArray();
 
       
       int nbrows = a.GetRows();
@@ -130,7 +130,7 @@ void DivisionByScalar::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_p
     {
 
       assert(a_pArg[0]->GetType()=='m');
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
       mup::matrix_type b;
 
       double scalar = 0;
@@ -175,8 +175,8 @@ void ElementWiseMultiplication::Eval(mup::ptr_val_type &ret, const mup::ptr_val_
       assert(a_pArg[0]->GetType()=='m');
       assert(a_pArg[1]->GetType()=='m');
 
-      const mup::matrix_type a = a_pArg[0]->GetArray();
-      const mup::matrix_type b = a_pArg[1]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
+      const mup::matrix_type &b = a_pArg[1]->GetArray();
       
       int nbrows = a.GetRows();
       int nbcols = a.GetCols();
@@ -198,7 +198,7 @@ void MultiplicationByScalar::Eval(mup::ptr_val_type &ret, const mup::ptr_val_typ
     {
 
       assert(a_pArg[0]->GetType()=='m');
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
       mup::matrix_type b;
 
       double scalar(1.);
@@ -242,8 +242,8 @@ void ElementWisePower::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_p
       assert(a_pArg[1]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
-      const mup::matrix_type b = a_pArg[1]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
+      const mup::matrix_type &b = a_pArg[1]->GetArray();
 
       int nbrows = a.GetRows();
       int nbcols = a.GetCols();
@@ -269,7 +269,7 @@ void PowerByScalar::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg
     {
 
       assert(a_pArg[0]->GetType()=='m');
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
       mup::matrix_type b;
 
       double scalar(1.);
@@ -330,7 +330,7 @@ void cat::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_iA
 
       std::vector<double> vect;
       int nbcols;
-      mup::matrix_type m1;
+      const mup::matrix_type * m1 = ITK_NULLPTR;
 
       for (int k=0; k<a_iArgc; ++k)
       {
@@ -340,15 +340,15 @@ void cat::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_iA
         {
           case 'm':
 
-              m1 = a_pArg[k]->GetArray();
+              m1 = &(a_pArg[k]->GetArray());
 
              
-              nbcols = m1.GetCols();
+              nbcols = m1->GetCols();
 
-              assert(m1.GetRows()==1);
+              assert(m1->GetRows()==1);
 
               for (int j=0; j<nbcols; j++)
-                  vect.push_back( m1.At(0,j).GetFloat());
+                  vect.push_back( m1->At(0,j).GetFloat());
 
           break;
     
@@ -375,7 +375,7 @@ void mean::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_i
 
       std::vector<double> vect;
       int nbrows,nbcols;
-      mup::matrix_type m1;
+      const mup::matrix_type * m1 = ITK_NULLPTR;
       double sum;
 
       for (int k=0; k<a_iArgc; ++k)
@@ -386,16 +386,16 @@ void mean::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_i
         {
           case 'm':
 
-            m1 = a_pArg[k]->GetArray();
+            m1 = &(a_pArg[k]->GetArray());
 
-            nbrows = m1.GetRows();
-            nbcols = m1.GetCols();
+            nbrows = m1->GetRows();
+            nbcols = m1->GetCols();
           
             sum=0.0;
 
             for (int i=0; i<nbrows; i++)
               for (int j=0; j<nbcols; j++)
-                sum += m1.At(i,j).GetFloat();
+                sum += m1->At(i,j).GetFloat();
 
             vect.push_back( sum / (double) (nbrows*nbcols) );
 
@@ -425,7 +425,7 @@ void var::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_iA
 
       std::vector<double> vect;
       int nbrows,nbcols;
-      mup::matrix_type m1;
+      const mup::matrix_type * m1 = ITK_NULLPTR;
       double sum,mean;
 
       for (int k=0; k<a_iArgc; ++k)
@@ -436,16 +436,16 @@ void var::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_iA
         {
           case 'm':
 
-            m1 = a_pArg[k]->GetArray();
+            m1 = &(a_pArg[k]->GetArray());
 
-            nbrows = m1.GetRows();
-            nbcols = m1.GetCols();
+            nbrows = m1->GetRows();
+            nbcols = m1->GetCols();
           
             sum=0.0;
 
             for (int i=0; i<nbrows; i++)
               for (int j=0; j<nbcols; j++)
-               sum += m1.At(i,j).GetFloat();
+               sum += m1->At(i,j).GetFloat();
 
             mean = sum / (double) (nbrows*nbcols);
           
@@ -453,7 +453,7 @@ void var::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_iA
 
             for (int i=0; i<nbrows; i++)
               for (int j=0; j<nbcols; j++)
-                sum += vcl_pow(mean - m1.At(i,j).GetFloat(),2);
+                sum += vcl_pow(mean - m1->At(i,j).GetFloat(),2);
           
             vect.push_back( sum / (double) (nbrows*nbcols) );
     
@@ -484,8 +484,8 @@ void corr::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int itk
       assert(a_pArg[1]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
-      const mup::matrix_type b = a_pArg[1]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
+      const mup::matrix_type &b = a_pArg[1]->GetArray();
 
       int nbrows = a.GetRows();
       int nbcols = a.GetCols();
@@ -533,7 +533,7 @@ void median::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a
 
       std::vector<double> vect,tempvect;
       int nbrows,nbcols;
-      mup::matrix_type m1;
+      const mup::matrix_type * m1 = ITK_NULLPTR;
 
 
       for (int k=0; k<a_iArgc; ++k)
@@ -544,14 +544,14 @@ void median::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a
         {
           case 'm':
 
-            m1 = a_pArg[k]->GetArray();
+            m1 = &(a_pArg[k]->GetArray());
 
-            nbrows = m1.GetRows();
-            nbcols = m1.GetCols();
+            nbrows = m1->GetRows();
+            nbcols = m1->GetCols();
 
             for (int i=0; i<nbrows; i++)
               for (int j=0; j<nbcols; j++)
-                tempvect.push_back(m1.At(i,j).GetFloat());
+                tempvect.push_back(m1->At(i,j).GetFloat());
 
             std::sort(tempvect.begin(),tempvect.end());
 
@@ -582,7 +582,7 @@ void maj::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_iA
 
       std::vector<int> vect,tempvect;
       int nbrows,nbcols,score,bestScore,majElmt;
-      mup::matrix_type m1;
+      const mup::matrix_type * m1 = ITK_NULLPTR;
 
 
       for (int k=0; k<a_iArgc; ++k)
@@ -593,14 +593,14 @@ void maj::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_iA
         {
           case 'm':
 
-            m1 = a_pArg[k]->GetArray();
+            m1 = &(a_pArg[k]->GetArray());
 
-            nbrows = m1.GetRows();
-            nbcols = m1.GetCols();
+            nbrows = m1->GetRows();
+            nbcols = m1->GetCols();
 
             for (int i=0; i<nbrows; i++)
               for (int j=0; j<nbcols; j++)
-                tempvect.push_back( (int) (m1.At(i,j).GetFloat() + 0.5) );
+                tempvect.push_back( (int) (m1->At(i,j).GetFloat() + 0.5) );
 
             std::sort(tempvect.begin(),tempvect.end());
 
@@ -652,20 +652,20 @@ void vnorm::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_
         return;
 
       int nbrows,nbcols;
-      mup::matrix_type m1;
+      const mup::matrix_type * m1 = ITK_NULLPTR;
       double sum=0.0;
 
       assert( a_iArgc==1 );
       assert(a_pArg[0]->GetType()=='m');
 
-      m1 = a_pArg[0]->GetArray();
+      m1 = &(a_pArg[0]->GetArray());
 
-      nbrows = m1.GetRows();
-      nbcols = m1.GetCols();
+      nbrows = m1->GetRows();
+      nbcols = m1->GetCols();
 
       for (int i=0; i<nbrows; i++)
         for (int j=0; j<nbcols; j++)
-          sum += vcl_pow(m1.At(i,j).GetFloat(),2.0);
+          sum += vcl_pow(m1->At(i,j).GetFloat(),2.0);
 
 
       // The return value is passed by writing it to the reference ret
@@ -683,21 +683,21 @@ void vmin::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_i
       double min;
 
       int nbrows,nbcols;
-      mup::matrix_type m1;
+      const mup::matrix_type * m1 = ITK_NULLPTR;
 
       assert(a_pArg[0]->GetType()=='m');
 
       min = itk::NumericTraits<double>::max();
 
-      m1 = a_pArg[0]->GetArray();
+      m1 = &(a_pArg[0]->GetArray());
 
-      nbrows = m1.GetRows();
-      nbcols = m1.GetCols();
+      nbrows = m1->GetRows();
+      nbcols = m1->GetCols();
 
       for (int i=0; i<nbrows; i++)
         for (int j=0; j<nbcols; j++)
-          if (m1.At(i,j).GetFloat() < min )
-            min = m1.At(i,j).GetFloat();
+          if (m1->At(i,j).GetFloat() < min )
+            min = m1->At(i,j).GetFloat();
 
       // The return value is passed by writing it to the reference ret
       mup::matrix_type res(1,1,min);
@@ -714,22 +714,22 @@ void vmax::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_i
       double max;
 
       int nbrows,nbcols;
-      mup::matrix_type m1;
+      const mup::matrix_type * m1 = ITK_NULLPTR;
 
  
       assert(a_pArg[0]->GetType()=='m');
 
       max = itk::NumericTraits<double>::min();
 
-      m1 = a_pArg[0]->GetArray();
+      m1 = &(a_pArg[0]->GetArray());
 
-      nbrows = m1.GetRows();
-      nbcols = m1.GetCols();
+      nbrows = m1->GetRows();
+      nbcols = m1->GetCols();
 
       for (int i=0; i<nbrows; i++)
         for (int j=0; j<nbcols; j++)
-          if (m1.At(i,j).GetFloat() > max )
-            max = m1.At(i,j).GetFloat();
+          if (m1->At(i,j).GetFloat() > max )
+            max = m1->At(i,j).GetFloat();
 
       // The return value is passed by writing it to the reference ret
       mup::matrix_type res(1,1,max);
@@ -745,7 +745,7 @@ void vect2scal::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, in
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
       assert(a.GetRows() == 1);
       assert(a.GetCols() == 1);
@@ -768,7 +768,7 @@ void vcos::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_i
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
 
       int nbrows = a.GetRows();
@@ -794,7 +794,7 @@ void vacos::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
 
       int nbrows = a.GetRows();
@@ -820,7 +820,7 @@ void vsin::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_i
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
       int nbrows = a.GetRows();
       int nbcols = a.GetCols();
@@ -844,7 +844,7 @@ void vasin::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
 
       int nbrows = a.GetRows();
@@ -870,7 +870,7 @@ void vtan::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_i
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
       int nbrows = a.GetRows();
       int nbcols = a.GetCols();
@@ -894,7 +894,7 @@ void vatan::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
       int nbrows = a.GetRows();
       int nbcols = a.GetCols();
@@ -918,7 +918,7 @@ void vtanh::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
 
       int nbrows = a.GetRows();
@@ -943,7 +943,7 @@ void vsinh::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
 
       int nbrows = a.GetRows();
@@ -968,7 +968,7 @@ void vcosh::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
 
       int nbrows = a.GetRows();
@@ -993,7 +993,7 @@ void vlog::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_i
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
       int nbrows = a.GetRows();
       int nbcols = a.GetCols();
@@ -1017,7 +1017,7 @@ void vlog10::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
 
       int nbrows = a.GetRows();
@@ -1042,7 +1042,7 @@ void vabs::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_i
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
       int nbrows = a.GetRows();
       int nbcols = a.GetCols();
@@ -1066,7 +1066,7 @@ void vexp::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_i
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
 
       int nbrows = a.GetRows();
@@ -1091,7 +1091,7 @@ void vsqrt::Eval(mup::ptr_val_type &ret, const mup::ptr_val_type *a_pArg, int a_
       assert(a_pArg[0]->GetType()=='m');
 
       // Get the argument from the argument input vector
-      const mup::matrix_type a = a_pArg[0]->GetArray();
+      const mup::matrix_type &a = a_pArg[0]->GetArray();
 
       int nbrows = a.GetRows();
       int nbcols = a.GetCols();
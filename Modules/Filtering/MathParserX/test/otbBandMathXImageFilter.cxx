@@ -23,6 +23,7 @@
 #include "itkMacro.h"
 #include <iostream>
 #include <complex>  //only for the isnan() test line 148
+#include <algorithm>
 
 #include "otbMath.h"
 #include "otbVectorImage.h"
@@ -30,6 +31,7 @@
 #include "otbImageFileWriter.h"
 
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkTimeProbe.h"
 
 int otbBandMathXImageFilterNew( int itkNotUsed(argc), char* itkNotUsed(argv) [])
 {
@@ -562,3 +564,87 @@ int otbBandMathXImageFilterWithIdx( int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+
+int otbBandMathXImageFilterBenchmark( int itkNotUsed(argc), char* itkNotUsed(argv) [])
+{
+  typedef otb::VectorImage<double, 2>              ImageType;
+  typedef ImageType::PixelType                      PixelType;
+  typedef otb::BandMathXImageFilter<ImageType>      FilterType;
+
+  const unsigned int N = 500, D1 = 3;
+  const int radius = 2;
+
+  ImageType::SizeType size;
+  size.Fill(N);
+  ImageType::IndexType index;
+  index.Fill(0);
+  ImageType::RegionType region;
+  region.SetSize(size);
+  region.SetIndex(index);
+
+  ImageType::Pointer image1 = ImageType::New();
+  image1->SetRegions( region );
+  image1->SetNumberOfComponentsPerPixel(D1);
+  image1->Allocate();
+
+  typedef itk::ImageRegionIteratorWithIndex<ImageType> IteratorType;
+  IteratorType it1(image1, region);
+
+  PixelType val1;
+  val1.SetSize(D1);
+  for (it1.GoToBegin(); !it1.IsAtEnd(); ++it1)
+    {
+    ImageType::IndexType i1 = it1.GetIndex();
+    val1[0] = (i1[0] * 7 + i1[1] * 13) % 101;
+    val1[1] = i1[0] - i1[1];
+    val1[2] = 0.5 * i1[1];
+    it1.Set(val1);
+    }
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetNthInput(0, image1);
+  filter->SetExpression("mean(im1b1N5x5) + im1b2 * im1b3");
+
+  itk::TimeProbe chrono;
+  chrono.Start();
+  filter->Update();
+  chrono.Stop();
+
+  std::cout << "Expression: " << filter->GetExpression(0) << std::endl
+            << "Size: " << N << "x" << N << ", threads: " << filter->GetNumberOfThreads() << std::endl
+            << "Time: " << chrono.GetTotal() << " s ("
+            << static_cast<double>(N * N) / chrono.GetTotal() << " pixels/s)" << std::endl;
+
+  // Check against a direct computation (neighbors outside of the
+  // image are replaced by the nearest pixel inside)
+  ImageType::Pointer output = filter->GetOutput(0);
+  IteratorType itOut(output, region);
+  for (itOut.GoToBegin(); !itOut.IsAtEnd(); ++itOut)
+    {
+    ImageType::IndexType idx = itOut.GetIndex();
+
+    double sum = 0.;
+    for (int dy = -radius; dy <= radius; ++dy)
+      {
+      for (int dx = -radius; dx <= radius; ++dx)
+        {
+        ImageType::IndexType n;
+        n[0] = std::min(std::max(static_cast<long>(idx[0]) + dx, 0L), static_cast<long>(N) - 1);
+        n[1] = std::min(std::max(static_cast<long>(idx[1]) + dy, 0L), static_cast<long>(N) - 1);
+        sum += image1->GetPixel(n)[0];
+        }
+      }
+    const PixelType center = image1->GetPixel(idx);
+    const double expected = sum / ((2 * radius + 1) * (2 * radius + 1)) + center[1] * center[2];
+    const double result = itOut.Get()[0];
+
+    if (vcl_abs(result - expected) > 1E-9 * std::max(1., vcl_abs(expected)))
+      {
+      itkGenericExceptionMacro(<< "Error at " << idx << ": result = " << result
+                               << ", expected = " << expected << " -> TEST FAILLED");
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
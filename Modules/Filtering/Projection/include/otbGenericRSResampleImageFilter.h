@@ -45,6 +45,11 @@ namespace otb
  *  image parameters Size/Origin/Spacing so the hole image can be
  *  reprojected without setting any output parameter.
  *
+ *  The displacement grid is stored in the DisplacementFieldCache
+ *  when it is enabled (see OTB_GRID_CACHE_DIRECTORY), so that
+ *  resamplings of the same product on the same grid, for instance
+ *  of several bands, evaluate the sensor model only once.
+ *
  * \ingroup Projection
  *
  *
@@ -261,6 +266,19 @@ public:
   itkGetMacro(EstimateOutputRpcModel, bool);
   itkBooleanMacro(EstimateOutputRpcModel);
 
+  /** Evaluate RPC sensor models natively instead of through OSSIM
+   * \sa SensorModelAdapter::SetUseNativeRPCModel() */
+  void SetUseNativeRPCModel(bool value)
+  {
+    m_Transform->SetUseNativeRPCModel(value);
+    this->Modified();
+  }
+  bool GetUseNativeRPCModel() const
+  {
+    return m_Transform->GetUseNativeRPCModel();
+  }
+  itkBooleanMacro(UseNativeRPCModel);
+
   /** Set number of threads for Displacement field generator */
   void SetDisplacementFilterNumberOfThreads(unsigned int nbThread)
   {
@@ -281,6 +299,10 @@ protected:
 
   virtual void UpdateTransform();
 
+  /** Description of the transform and of the elevation settings,
+   * used as the key of the DisplacementFieldCache */
+  virtual std::string GetDisplacementFieldCacheDescription() const;
+
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
 
 private:
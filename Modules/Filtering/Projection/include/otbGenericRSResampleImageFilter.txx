@@ -35,6 +35,11 @@
 
 #include "otbGeoInformationConversion.h"
 #include "otbImageToGenericRSOutputParameters.h"
+#include "otbDEMHandler.h"
+
+#include "itksys/SystemTools.hxx"
+
+#include <sstream>
 
 namespace otb
 {
@@ -101,6 +106,7 @@ GenericRSResampleImageFilter<TInputImage, TOutputImage>
   m_Resampler->SetInput(this->GetInput());
   m_Resampler->SetTransform(m_Transform);
   m_Resampler->SetDisplacementFieldSpacing(this->GetDisplacementFieldSpacing());
+  m_Resampler->SetDisplacementFieldCacheDescription(this->GetDisplacementFieldCacheDescription());
   m_Resampler->GraftOutput(this->GetOutput());
   m_Resampler->UpdateOutputInformation();
   this->GraftOutput(m_Resampler->GetOutput());
@@ -116,6 +122,46 @@ GenericRSResampleImageFilter<TInputImage, TOutputImage>
     }
 }
 
+/**
+ * Describe the transform and the elevation settings it uses, to
+ * identify its displacement field in the DisplacementFieldCache
+ */
+template <class TInputImage, class TOutputImage>
+std::string
+GenericRSResampleImageFilter<TInputImage, TOutputImage>
+::GetDisplacementFieldCacheDescription() const
+{
+  std::ostringstream oss;
+  oss.precision(17);
+  oss << "GenericRSTransform" << std::endl;
+  oss << "InputProjectionRef: " << m_Transform->GetInputProjectionRef() << std::endl;
+  oss << "InputKeywordList: " << m_Transform->GetInputKeywordList() << std::endl;
+  oss << "InputOrigin: " << m_Transform->GetInputOrigin() << std::endl;
+  oss << "InputSpacing: " << m_Transform->GetInputSpacing() << std::endl;
+  oss << "OutputProjectionRef: " << m_Transform->GetOutputProjectionRef() << std::endl;
+  oss << "OutputKeywordList: " << m_Transform->GetOutputKeywordList() << std::endl;
+  oss << "OutputOrigin: " << m_Transform->GetOutputOrigin() << std::endl;
+  oss << "OutputSpacing: " << m_Transform->GetOutputSpacing() << std::endl;
+  oss << "UseNativeRPCModel: " << m_Transform->GetUseNativeRPCModel() << std::endl;
+
+  // Elevation settings, with the modification times of the DEM
+  // directories and of the geoid file so that the cached fields are
+  // invalidated when they are updated
+  DEMHandler::Pointer demHandler = DEMHandler::Instance();
+  for (unsigned int i = 0; i < demHandler->GetDEMCount(); ++i)
+    {
+    const std::string demDirectory = demHandler->GetDEMDirectory(i);
+    oss << "DEMDirectory: " << demDirectory << " "
+        << itksys::SystemTools::ModifiedTime(demDirectory.c_str()) << std::endl;
+    }
+  const std::string geoidFile = demHandler->GetGeoidFile();
+  oss << "GeoidFile: " << geoidFile << " "
+      << itksys::SystemTools::ModifiedTime(geoidFile.c_str()) << std::endl;
+  oss << "DefaultHeightAboveEllipsoid: " << demHandler->GetDefaultHeightAboveEllipsoid() << std::endl;
+
+  return oss.str();
+}
+
 /**
  * Method to estimate the rpc model of the output using a temporary image
  */
@@ -147,6 +147,44 @@ public:
     return outputPoint;
   }
 
+  /** Transform a batch of packed points. Each coordinate is evaluated
+   * with the Horner scheme, across all the points. */
+  void TransformPoints(const TScalarType * in, TScalarType * out, size_t n) const ITK_OVERRIDE
+  {
+    // Check for consistency
+    if(this->GetNumberOfParameters() != this->m_Parameters.size())
+      {
+      itkExceptionMacro(<<"Wrong number of parameters: found "<<this->m_Parameters.Size()<<", expected "<<this->GetNumberOfParameters());
+      }
+
+    unsigned int dimensionStride = (m_DenominatorDegree+1)+(m_NumeratorDegree+1);
+
+    for(unsigned int dim = 0; dim < SpaceDimension; ++dim)
+      {
+      const ParametersValueType * numCoefs = &this->m_Parameters[dim*dimensionStride];
+      const ParametersValueType * denomCoefs = numCoefs + m_NumeratorDegree + 1;
+
+      for(size_t i = 0; i < n; ++i)
+        {
+        const TScalarType x = in[i*SpaceDimension+dim];
+
+        TScalarType num = numCoefs[m_NumeratorDegree];
+        for(unsigned int numDegree = m_NumeratorDegree; numDegree > 0; --numDegree)
+          {
+          num = num*x + numCoefs[numDegree-1];
+          }
+
+        TScalarType denom = denomCoefs[m_DenominatorDegree];
+        for(unsigned int denomDegree = m_DenominatorDegree; denomDegree > 0; --denomDegree)
+          {
+          denom = denom*x + denomCoefs[denomDegree-1];
+          }
+
+        out[i*SpaceDimension+dim] = num/denom;
+        }
+      }
+  }
+
   /** Get the number of parameters */
   NumberOfParametersType GetNumberOfParameters() const ITK_OVERRIDE
   {
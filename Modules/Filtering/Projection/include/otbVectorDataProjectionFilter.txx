@@ -27,6 +27,8 @@
 #include "otbMetaDataKey.h"
 #include "itkTimeProbe.h"
 
+#include <vector>
+
 namespace otb
 {
 /**
@@ -203,18 +205,29 @@ VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>
   VertexListConstPointerType  vertexList = line->GetVertexList();
   VertexListConstIteratorType it = vertexList->Begin();
   typename OutputLineType::Pointer  newLine = OutputLineType::New();
+
+  // Transform all the vertices at once
+  std::vector<double> points;
+  points.reserve(2 * vertexList->Size());
   while (it != vertexList->End())
     {
-    itk::Point<double, 2>           point;
-    itk::ContinuousIndex<double, 2> index;
     typename InputLineType::VertexType   pointCoord = it.Value();
-    point = m_Transform->TransformPoint(pointCoord);
-    index[0] = point[0];
-    index[1] = point[1];
-//       otbMsgDevMacro(<< "Converting: " << it.Value() << " -> " << pointCoord << " -> " << point << " -> " << index);
-    newLine->AddVertex(index);
+    points.push_back(pointCoord[0]);
+    points.push_back(pointCoord[1]);
     ++it;
     }
+  if (!points.empty())
+    {
+    m_Transform->TransformPoints(&points[0], &points[0], points.size() / 2);
+    }
+
+  for (size_t i = 0; i < points.size(); i += 2)
+    {
+    itk::ContinuousIndex<double, 2> index;
+    index[0] = points[i];
+    index[1] = points[i + 1];
+    newLine->AddVertex(index);
+    }
 
   return newLine;
 }
@@ -232,17 +245,29 @@ VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>
   VertexListConstPointerType    vertexList = polygon->GetVertexList();
   VertexListConstIteratorType   it = vertexList->Begin();
   typename OutputPolygonType::Pointer newPolygon = OutputPolygonType::New();
+
+  // Transform all the vertices at once
+  std::vector<double> points;
+  points.reserve(2 * vertexList->Size());
   while (it != vertexList->End())
     {
-    itk::Point<double, 2>            point;
-    itk::ContinuousIndex<double, 2>  index;
     typename InputPolygonType::VertexType pointCoord = it.Value();
-    point = m_Transform->TransformPoint(pointCoord);
-    index[0] = point[0];
-    index[1] = point[1];
-    newPolygon->AddVertex(index);
+    points.push_back(pointCoord[0]);
+    points.push_back(pointCoord[1]);
     ++it;
     }
+  if (!points.empty())
+    {
+    m_Transform->TransformPoints(&points[0], &points[0], points.size() / 2);
+    }
+
+  for (size_t i = 0; i < points.size(); i += 2)
+    {
+    itk::ContinuousIndex<double, 2>  index;
+    index[0] = points[i];
+    index[1] = points[i + 1];
+    newPolygon->AddVertex(index);
+    }
   return newPolygon;
 }
 
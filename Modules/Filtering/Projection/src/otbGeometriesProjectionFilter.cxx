@@ -32,6 +32,7 @@
 #include "itkMetaDataObject.h"
 #include "otbOGRGeometryWrapper.h"
 #include "otbOGRGeometriesVisitor.h"
+#include <vector>
 
 
 /*===========================================================================*/
@@ -60,11 +61,27 @@ void otb::internal::ReprojectTransformationFunctor::do_transform(OGRPoint & g) c
 
 void otb::internal::ReprojectTransformationFunctor::do_transform(OGRLineString & g) const
 {
+  const int N = g.getNumPoints();
+  if (N == 0)
+    {
+    return;
+    }
+
+  // Transform all the points at once
+  std::vector<double> points(2 * N);
+  for (int i=0; i!=N; ++i)
+    {
+    points[2*i]   = g.getX(i);
+    points[2*i+1] = g.getY(i);
+    }
+  m_Transform->TransformPoints(&points[0], &points[0], N);
+
   OGRPoint point;
-  for (int i=0, N=g.getNumPoints(); i!=N; ++i)
+  for (int i=0; i!=N; ++i)
     {
     g.getPoint(i, &point);
-    do_transform(point); // no need to go through the redispatch cycle
+    point.setX(points[2*i]);
+    point.setY(points[2*i+1]);
     g.setPoint(i, &point);
     }
 }
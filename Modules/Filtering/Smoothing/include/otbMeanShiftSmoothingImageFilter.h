@@ -27,6 +27,7 @@
 #include "itkImageRegionConstIterator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include <vcl_algorithm.h>
+#include <vector>
 
 
 namespace otb
@@ -608,10 +609,19 @@ protected:
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
 
-  virtual void CalculateMeanShiftVector(const typename RealVectorImageType::Pointer inputImagePtr,
-                                        const RealVector& jointPixel, const OutputRegionType& outputRegion,
+  virtual void CalculateMeanShiftVector(const RealVector& jointPixel, const OutputRegionType& outputRegion,
                                         const RealVector& bandwidth,
                                         RealVector& meanShiftVector);
+
+  /** Mean shift vector computation for a number of range components known at
+   * compile time (0 if only known at run time) */
+  template<unsigned int VNumberOfComponents>
+  void CalculateMeanShiftVectorFixed(const RealVector& jointPixel, const OutputRegionType& outputRegion,
+                                     const RealVector& bandwidth,
+                                     RealVector& meanShiftVector) const;
+
+  /** Offset of a pixel in the planes of the joint image */
+  itk::OffsetValueType GetJointOffset(const InputIndexType & index) const;
 #if 0
   virtual void CalculateMeanShiftVectorBucket(const RealVector& jointPixel, RealVector& meanShiftVector);
 #endif
@@ -645,8 +655,13 @@ private:
   /** Number of components per pixel in the input image */
   unsigned int m_NumberOfComponentsPerPixel;
 
-  /** Input data in the joint spatial-range domain, scaled by the bandwidths */
-  typename RealVectorImageType::Pointer m_JointImage;
+  /** Range part of the input data in the joint spatial-range domain, stored
+   * as one plane per component over m_JointRegion (structure of arrays).
+   * Spatial components are computed from the pixel index. */
+  std::vector<RealType> m_JointPlanes;
+
+  /** Region covered by the joint image planes */
+  RegionType m_JointRegion;
 
   /** Image to store the status at each pixel:
    * 0 : no mode has been found yet
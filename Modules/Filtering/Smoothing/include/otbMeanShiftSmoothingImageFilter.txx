@@ -24,7 +24,6 @@
 
 #include "otbMeanShiftSmoothingImageFilter.h"
 #include "itkImageRegionIterator.h"
-#include "otbUnaryFunctorWithIndexWithOutputSizeImageFilter.h"
 #include "otbMacro.h"
 
 #include "itkProgressReporter.h"
@@ -241,21 +240,25 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
   zero.Fill(0);
   spatialOutput->FillBuffer(zero);
 
-  // m_JointImage is the input data expressed in the joint spatial-range
+  // The joint image is the input data expressed in the joint spatial-range
   // domain, i.e. spatial coordinates are concatenated to the range values.
-  // Moreover, pixel components in this image are normalized by their respective
-  // (spatial or range) bandwidth.
-  typedef Meanshift::SpatialRangeJointDomainTransform<InputImageType, RealVectorImageType> FunctionType;
-  typedef otb::UnaryFunctorWithIndexWithOutputSizeImageFilter<InputImageType, RealVectorImageType, FunctionType>
-      JointImageFunctorType;
-
-  typename JointImageFunctorType::Pointer jointImageFunctor = JointImageFunctorType::New();
-
-  jointImageFunctor->SetInput(inputPtr);
-  jointImageFunctor->GetFunctor().Initialize(ImageDimension, m_NumberOfComponentsPerPixel, m_GlobalShift);
-  jointImageFunctor->GetOutput()->SetRequestedRegion(this->GetInput()->GetBufferedRegion());
-  jointImageFunctor->Update();
-  m_JointImage = jointImageFunctor->GetOutput();
+  // Only range values are stored, one plane per component, so that the
+  // neighbors of a pixel along a line are contiguous for each component.
+  // Spatial coordinates are computed from the pixel index.
+  m_JointRegion = inputPtr->GetBufferedRegion();
+  const typename RegionType::SizeValueType nbJointPixels = m_JointRegion.GetNumberOfPixels();
+  m_JointPlanes.resize(m_NumberOfComponentsPerPixel * nbJointPixels);
+
+  itk::ImageRegionConstIterator<InputImageType> inputIt(inputPtr, m_JointRegion);
+  typename RegionType::SizeValueType jointOffset = 0;
+  for (inputIt.GoToBegin(); !inputIt.IsAtEnd(); ++inputIt, ++jointOffset)
+    {
+    const InputPixelType & inputPixel = inputIt.Get();
+    for (unsigned int comp = 0; comp < m_NumberOfComponentsPerPixel; ++comp)
+      {
+      m_JointPlanes[comp * nbJointPixels + jointOffset] = inputPixel[comp];
+      }
+    }
 
 #if 0
   if (m_BucketOptimization)
@@ -341,22 +344,69 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
 
 }
 
+template<class TInputImage, class TOutputImage, class TKernel, class TOutputIterationImage>
+itk::OffsetValueType
+MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIterationImage>
+::GetJointOffset(const InputIndexType & index) const
+{
+  itk::OffsetValueType offset = 0;
+  itk::OffsetValueType stride = 1;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+    offset += (index[dim] - m_JointRegion.GetIndex()[dim]) * stride;
+    stride *= m_JointRegion.GetSize()[dim];
+    }
+  return offset;
+}
+
 // Calculates the mean shift vector at the position given by jointPixel
 template<class TInputImage, class TOutputImage, class TKernel, class TOutputIterationImage>
 void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIterationImage>::CalculateMeanShiftVector(
-                                                                                                                        const typename RealVectorImageType::Pointer jointImage,
                                                                                                                         const RealVector& jointPixel,
                                                                                                                         const OutputRegionType& outputRegion,
                                                                                                                         const RealVector & bandwidth,
                                                                                                                         RealVector& meanShiftVector)
 {
-  const unsigned int jointDimension = ImageDimension + m_NumberOfComponentsPerPixel;
+  // Unroll the loops on range components for the most common band counts
+  switch (m_NumberOfComponentsPerPixel)
+    {
+    case 1:
+      this->template CalculateMeanShiftVectorFixed<1>(jointPixel, outputRegion, bandwidth, meanShiftVector);
+      break;
+    case 3:
+      this->template CalculateMeanShiftVectorFixed<3>(jointPixel, outputRegion, bandwidth, meanShiftVector);
+      break;
+    case 4:
+      this->template CalculateMeanShiftVectorFixed<4>(jointPixel, outputRegion, bandwidth, meanShiftVector);
+      break;
+    default:
+      this->template CalculateMeanShiftVectorFixed<0>(jointPixel, outputRegion, bandwidth, meanShiftVector);
+      break;
+    }
+}
+
+template<class TInputImage, class TOutputImage, class TKernel, class TOutputIterationImage>
+template<unsigned int VNumberOfComponents>
+void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIterationImage>::CalculateMeanShiftVectorFixed(
+                                                                                                                             const RealVector& jointPixel,
+                                                                                                                             const OutputRegionType& outputRegion,
+                                                                                                                             const RealVector & bandwidth,
+                                                                                                                             RealVector& meanShiftVector) const
+{
+  // Neighbors along a line are processed by blocks: squared norms and
+  // weights are computed for the whole block (vectorizable loops, one pixel
+  // per lane), then accumulated in the order of the neighborhood pixels.
+  // Each value is computed with the same operations as the per-pixel
+  // formulation, so results are identical.
+  const unsigned int BlockSize = 64;
+
+  const unsigned int numberOfComponents = VNumberOfComponents > 0 ? VNumberOfComponents : m_NumberOfComponentsPerPixel;
 
   InputIndexType inputIndex;
   InputIndexType regionIndex;
   InputSizeType regionSize;
 
-  assert(meanShiftVector.GetSize() == jointDimension);
+  assert(meanShiftVector.GetSize() == ImageDimension + numberOfComponents);
   meanShiftVector.Fill(0);
 
   // Calculates current pixel neighborhood region, restricted to the output image region
@@ -378,77 +428,116 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
   neighborhoodRegion.SetIndex(regionIndex);
   neighborhoodRegion.SetSize(regionSize);
 
+  const typename RegionType::SizeValueType nbNeighbors = neighborhoodRegion.GetNumberOfPixels();
+  if (nbNeighbors == 0)
+    {
+    return;
+    }
+
+  const RealType * const pixelRange = jointPixel.GetDataPointer() + ImageDimension;
+  const RealType * const bandwidthRange = bandwidth.GetDataPointer() + ImageDimension;
+  RealType * const shiftSpatial = meanShiftVector.GetDataPointer();
+  RealType * const shiftRange = shiftSpatial + ImageDimension;
+
+  const typename RegionType::SizeValueType nbJointPixels = m_JointRegion.GetNumberOfPixels();
+  const typename RegionType::SizeValueType lineLength = regionSize[0];
+  const typename RegionType::SizeValueType nbLines = nbNeighbors / lineLength;
+
   RealType weightSum = 0;
-  RealVector shifts(jointDimension);
+  RealType norm2[BlockSize];
+  RealType weights[BlockSize];
 
-  // An iterator on the neighborhood of the current pixel (in joint
-  // spatial-range domain)
-  otb::Meanshift::FastImageRegionConstIterator<RealVectorImageType> it(jointImage, neighborhoodRegion);
-  //itk::ImageRegionConstIterator<RealVectorImageType> it(jointImage, neighborhoodRegion);
+  // Spatial shifts and squared normalized shifts along the dimensions
+  // above 0, which are constant along a line
+  RealType lineShifts[ImageDimension];
+  RealType lineNorms[ImageDimension];
 
-  it.GoToBegin();
-  while (!it.IsAtEnd())
-    {
-    const RealType *jointNeighbor = it.GetPixelPointer();
+  InputIndexType lineIndex = regionIndex;
 
-    // Compute the squared norm of the difference
-    // This is the L2 norm, TODO: replace by the templated norm
-    RealType norm2 = 0;
-    for (unsigned int comp = 0; comp < jointDimension; comp++)
+  for (typename RegionType::SizeValueType line = 0; line < nbLines; ++line)
+    {
+    for (unsigned int dim = 1; dim < ImageDimension; ++dim)
       {
-      shifts[comp] = jointNeighbor[comp] - jointPixel[comp];
-      double d = shifts[comp] / bandwidth[comp];
-      norm2 += d*d;
+      lineShifts[dim] = static_cast<RealType>(lineIndex[dim] + m_GlobalShift[dim]) - jointPixel[dim];
+      const RealType d = lineShifts[dim] / bandwidth[dim];
+      lineNorms[dim] = d * d;
       }
 
-    // Compute pixel weight from kernel
-    const RealType weight = m_Kernel(norm2);
-    /*
-     // The following code is an alternative way to compute norm2 and weight
-     // It separates the norms of spatial and range elements
-     RealType spatialNorm2;
-     RealType rangeNorm2;
-     spatialNorm2 = 0;
-     for (unsigned int comp = 0; comp < ImageDimension; comp++)
-     {
-     RealType d;
-     d = jointNeighbor[comp] - jointPixel[comp];
-     spatialNorm2 += d*d;
-     }
-
-     if(spatialNorm2 >= 1.0)
-     {
-     weight = 0;
-     }
-     else
-     {
-     rangeNorm2 = 0;
-     for (unsigned int comp = 0; comp < m_NumberOfComponentsPerPixel; comp++)
-     {
-     RealType d;
-     d = jointNeighbor[ImageDimension + comp] - jointPixel[ImageDimension + comp];
-     rangeNorm2 += d*d;
-     }
-
-     weight = (rangeNorm2 <= 1.0)? 1.0 : 0.0;
-     }
-     */
-
-    // Update sum of weights
-    weightSum += weight;
-
-    // Update mean shift vector
-    for (unsigned int comp = 0; comp < jointDimension; comp++)
+    const itk::OffsetValueType lineOffset = this->GetJointOffset(lineIndex);
+    const InputIndexValueType firstX = lineIndex[0] + m_GlobalShift[0];
+
+    for (typename RegionType::SizeValueType blockStart = 0; blockStart < lineLength; blockStart += BlockSize)
       {
-      meanShiftVector[comp] += weight * shifts[comp];
+      const unsigned int blockLength = static_cast<unsigned int>(
+        vcl_min(static_cast<typename RegionType::SizeValueType>(BlockSize), lineLength - blockStart));
+
+      // Compute the squared norm of the normalized difference
+      // This is the L2 norm, TODO: replace by the templated norm
+      for (unsigned int i = 0; i < blockLength; ++i)
+        {
+        const RealType d = (static_cast<RealType>(firstX + static_cast<InputIndexValueType>(blockStart + i)) - jointPixel[0]) / bandwidth[0];
+        norm2[i] = d * d;
+        }
+
+      for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+        {
+        const RealType lineNorm = lineNorms[dim];
+        for (unsigned int i = 0; i < blockLength; ++i)
+          {
+          norm2[i] += lineNorm;
+          }
+        }
+
+      for (unsigned int comp = 0; comp < numberOfComponents; ++comp)
+        {
+        const RealType * const plane = &m_JointPlanes[comp * nbJointPixels + lineOffset + blockStart];
+        const RealType value = pixelRange[comp];
+        const RealType bw = bandwidthRange[comp];
+        for (unsigned int i = 0; i < blockLength; ++i)
+          {
+          const RealType d = (plane[i] - value) / bw;
+          norm2[i] += d * d;
+          }
+        }
+
+      // Compute pixel weights from kernel
+      for (unsigned int i = 0; i < blockLength; ++i)
+        {
+        weights[i] = m_Kernel(norm2[i]);
+        }
+
+      // Update sum of weights and mean shift vector
+      for (unsigned int i = 0; i < blockLength; ++i)
+        {
+        const RealType weight = weights[i];
+        weightSum += weight;
+
+        shiftSpatial[0] += weight * (static_cast<RealType>(firstX + static_cast<InputIndexValueType>(blockStart + i)) - jointPixel[0]);
+        for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+          {
+          shiftSpatial[dim] += weight * lineShifts[dim];
+          }
+        for (unsigned int comp = 0; comp < numberOfComponents; ++comp)
+          {
+          shiftRange[comp] += weight * (m_JointPlanes[comp * nbJointPixels + lineOffset + blockStart + i] - pixelRange[comp]);
+          }
+        }
       }
 
-    ++it;
+    // Move to the next line of the neighborhood
+    for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+      {
+      if (++lineIndex[dim] < regionIndex[dim] + static_cast<InputIndexValueType>(regionSize[dim]))
+        {
+        break;
+        }
+      lineIndex[dim] = regionIndex[dim];
+      }
     }
 
   if (weightSum > 0)
     {
-    for (unsigned int comp = 0; comp < jointDimension; comp++)
+    for (unsigned int comp = 0; comp < ImageDimension + numberOfComponents; comp++)
       {
       meanShiftVector[comp] = meanShiftVector[comp] / weightSum;
       }
@@ -568,8 +657,8 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
 
   RegionType const& requestedRegion = input->GetRequestedRegion();
 
-  typedef itk::ImageRegionConstIteratorWithIndex<RealVectorImageType> JointImageIteratorType;
-  JointImageIteratorType jointIt(m_JointImage, outputRegionForThread);
+  typedef itk::ImageRegionConstIteratorWithIndex<InputImageType> InputIteratorType;
+  InputIteratorType inputIt(input, outputRegionForThread);
 
   OutputIteratorType rangeIt(rangeOutput, outputRegionForThread);
   OutputSpatialIteratorType spatialIt(spatialOutput, outputRegionForThread);
@@ -579,7 +668,7 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
   typedef itk::ImageRegionIterator<ModeTableImageType> ModeTableImageIteratorType;
   ModeTableImageIteratorType modeTableIt(m_ModeTable, outputRegionForThread);
 
-  jointIt.GoToBegin();
+  inputIt.GoToBegin();
   rangeIt.GoToBegin();
   spatialIt.GoToBegin();
   iterationIt.GoToBegin();
@@ -601,7 +690,7 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
   // index of the current pixel updated during the mean shift loop
   InputIndexType modeCandidate;
 
-  for (; !jointIt.IsAtEnd(); ++jointIt, ++rangeIt, ++spatialIt, ++iterationIt, ++modeTableIt, ++labelIt, progress.CompletedPixel())
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++rangeIt, ++spatialIt, ++iterationIt, ++modeTableIt, ++labelIt, progress.CompletedPixel())
     {
 
     // if pixel has been already processed (by mode search optimization), skip
@@ -614,18 +703,19 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
 
     bool hasConverged = false;
 
-    // get input pixel in the joint spatial-range domain (with components
-    // normalized by bandwidth)
-    const RealVector &jointPixelVal = jointIt.Get(); // Pixel in the joint spatial-range domain
-    for (unsigned int comp = 0; comp < jointDimension; comp++)
-      jointPixel[comp] = jointPixelVal[comp];
+    // index of the currently processed output pixel
+    InputIndexType currentIndex = inputIt.GetIndex();
+
+    // get input pixel in the joint spatial-range domain
+    const InputPixelType & inputPixel = inputIt.Get();
+    for (unsigned int comp = 0; comp < ImageDimension; comp++)
+      jointPixel[comp] = currentIndex[comp] + m_GlobalShift[comp];
+    for (unsigned int comp = 0; comp < m_NumberOfComponentsPerPixel; comp++)
+      jointPixel[ImageDimension + comp] = inputPixel[comp];
 
     for (unsigned int comp = ImageDimension; comp < jointDimension; comp++)
       bandwidth[comp] = m_RangeBandwidthRamp*jointPixel[comp]+m_RangeBandwidth;
 
-    // index of the currently processed output pixel
-    InputIndexType currentIndex = jointIt.GetIndex();
-
     // Number of points currently in the pointList
     unsigned int pointCount = 0; // Note: used only in mode search optimization
     iteration = 0;
@@ -650,10 +740,12 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
           {
           // Obtain the data point to see if it close to jointPixel
           RealType diff = 0;
-          RealVector const& candidatePixel = m_JointImage->GetPixel(modeCandidate);
+          const itk::OffsetValueType candidateOffset = this->GetJointOffset(modeCandidate);
+          const typename RegionType::SizeValueType nbJointPixels = m_JointRegion.GetNumberOfPixels();
           for (unsigned int comp = ImageDimension; comp < jointDimension; comp++)
             {
-            const RealType d = (candidatePixel[comp] - jointPixel[comp])/bandwidth[comp];
+            const RealType d = (m_JointPlanes[(comp - ImageDimension) * nbJointPixels + candidateOffset]
+                                - jointPixel[comp])/bandwidth[comp];
             diff += d * d;
             }
 
@@ -697,7 +789,7 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
       else
         {
 #endif
-        this->CalculateMeanShiftVector(m_JointImage, jointPixel, requestedRegion, bandwidth, meanShiftVector);
+        this->CalculateMeanShiftVector(jointPixel, requestedRegion, bandwidth, meanShiftVector);
 
 #if 0
         }
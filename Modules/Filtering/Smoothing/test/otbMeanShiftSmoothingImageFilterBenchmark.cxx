@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include "itkTimeProbe.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "otbImageFileReader.h"
+#include "otbMeanShiftSmoothingImageFilter.h"
+
+#include <vector>
+
+/** Compares the output of the filter with a straightforward implementation
+ * of the mean shift smoothing working on an interleaved (pixel by pixel)
+ * joint image, and reports the computation times of both. */
+int otbMeanShiftSmoothingImageFilterBenchmark(int argc, char * argv[])
+{
+  if (argc != 5)
+    {
+    std::cerr << "Usage: " << argv[0] <<
+    " inputFileName spatialBandwidth rangeBandwidth maxIterationNumber"
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const char *       inputFileName      = argv[1];
+  const double       spatialBandwidth   = atof(argv[2]);
+  const double       rangeBandwidth     = atof(argv[3]);
+  const unsigned int maxIterationNumber = atoi(argv[4]);
+  const double       threshold          = 0.1;
+
+  const unsigned int Dimension = 2;
+  typedef double                                           PixelType;
+  typedef otb::VectorImage<PixelType, Dimension>           ImageType;
+  typedef otb::ImageFileReader<ImageType>                  ReaderType;
+  typedef otb::MeanShiftSmoothingImageFilter<ImageType, ImageType> FilterType;
+  typedef FilterType::OutputSpatialImageType               SpatialImageType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFileName);
+  reader->Update();
+
+  ImageType::Pointer input = reader->GetOutput();
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetSpatialBandwidth(spatialBandwidth);
+  filter->SetRangeBandwidth(rangeBandwidth);
+  filter->SetThreshold(threshold);
+  filter->SetMaxIterationNumber(maxIterationNumber);
+  filter->SetModeSearch(false);
+  filter->SetInput(input);
+
+  itk::TimeProbe filterProbe;
+  filterProbe.Start();
+  filter->Update();
+  filterProbe.Stop();
+
+  // Reference implementation: joint pixels stored contiguously, neighbors
+  // visited one after the other
+  const ImageType::RegionType region = input->GetLargestPossibleRegion();
+  const ImageType::IndexType origin = region.GetIndex();
+  const long sizeX = region.GetSize()[0];
+  const long sizeY = region.GetSize()[1];
+  const unsigned int nbComp = input->GetNumberOfComponentsPerPixel();
+  const unsigned int jointDimension = Dimension + nbComp;
+  const long radius = static_cast<long>(spatialBandwidth);
+
+  itk::TimeProbe referenceProbe;
+  referenceProbe.Start();
+
+  std::vector<double> jointImage(sizeX * sizeY * jointDimension);
+  itk::ImageRegionConstIteratorWithIndex<ImageType> inputIt(input, region);
+  for (inputIt.GoToBegin(); !inputIt.IsAtEnd(); ++inputIt)
+    {
+    const ImageType::IndexType index = inputIt.GetIndex();
+    double * joint = &jointImage[((index[1] - origin[1]) * sizeX + index[0] - origin[0]) * jointDimension];
+    joint[0] = index[0];
+    joint[1] = index[1];
+    for (unsigned int comp = 0; comp < nbComp; ++comp)
+      {
+      joint[Dimension + comp] = inputIt.Get()[comp];
+      }
+    }
+
+  std::vector<double> referenceOutput(jointImage.size());
+  std::vector<double> jointPixel(jointDimension);
+  std::vector<double> bandwidth(jointDimension, spatialBandwidth);
+  std::vector<double> meanShiftVector(jointDimension);
+  std::vector<double> shifts(jointDimension);
+
+  for (long pixel = 0; pixel < sizeX * sizeY; ++pixel)
+    {
+    std::copy(&jointImage[pixel * jointDimension], &jointImage[pixel * jointDimension] + jointDimension,
+              jointPixel.begin());
+    std::fill(bandwidth.begin() + Dimension, bandwidth.end(), rangeBandwidth);
+
+    bool hasConverged = false;
+    unsigned int iteration = 0;
+    while (iteration < maxIterationNumber && !hasConverged)
+      {
+      std::fill(meanShiftVector.begin(), meanShiftVector.end(), 0.);
+
+      long first[Dimension];
+      long last[Dimension];
+      for (unsigned int dim = 0; dim < Dimension; ++dim)
+        {
+        const long center = static_cast<long>(vcl_floor(jointPixel[dim] + 0.5));
+        const long size = dim == 0 ? sizeX : sizeY;
+        first[dim] = vcl_max(origin[dim], center - radius - 1);
+        last[dim] = vcl_min(origin[dim] + size - 1, center + radius + 1);
+        }
+
+      double weightSum = 0;
+      for (long y = first[1]; y <= last[1]; ++y)
+        {
+        for (long x = first[0]; x <= last[0]; ++x)
+          {
+          const double * neighbor = &jointImage[((y - origin[1]) * sizeX + x - origin[0]) * jointDimension];
+          double norm2 = 0;
+          for (unsigned int comp = 0; comp < jointDimension; ++comp)
+            {
+            shifts[comp] = neighbor[comp] - jointPixel[comp];
+            const double d = shifts[comp] / bandwidth[comp];
+            norm2 += d * d;
+            }
+          const double weight = (norm2 <= 1) ? 1.0 : 0.0;
+          weightSum += weight;
+          for (unsigned int comp = 0; comp < jointDimension; ++comp)
+            {
+            meanShiftVector[comp] += weight * shifts[comp];
+            }
+          }
+        }
+      if (weightSum > 0)
+        {
+        for (unsigned int comp = 0; comp < jointDimension; ++comp)
+          {
+          meanShiftVector[comp] = meanShiftVector[comp] / weightSum;
+          }
+        }
+
+      double meanShiftVectorSqNorm = 0;
+      for (unsigned int comp = 0; comp < jointDimension; ++comp)
+        {
+        meanShiftVectorSqNorm += meanShiftVector[comp] * meanShiftVector[comp];
+        jointPixel[comp] += meanShiftVector[comp];
+        }
+      hasConverged = meanShiftVectorSqNorm < threshold;
+      ++iteration;
+      }
+
+    std::copy(jointPixel.begin(), jointPixel.end(), &referenceOutput[pixel * jointDimension]);
+    }
+
+  referenceProbe.Stop();
+
+  std::cout << "Image size: " << region.GetSize() << ", " << nbComp << " components" << std::endl;
+  std::cout << "Filter:    " << filterProbe.GetTotal() << " s" << std::endl;
+  std::cout << "Reference: " << referenceProbe.GetTotal() << " s" << std::endl;
+
+  // Outputs have to be bit-identical
+  ImageType::ConstPointer rangeOutput = filter->GetRangeOutput();
+  SpatialImageType::ConstPointer spatialOutput = filter->GetSpatialOutput();
+  unsigned long nbErrors = 0;
+  for (inputIt.GoToBegin(); !inputIt.IsAtEnd(); ++inputIt)
+    {
+    const ImageType::IndexType index = inputIt.GetIndex();
+    const double * reference = &referenceOutput[((index[1] - origin[1]) * sizeX + index[0] - origin[0]) * jointDimension];
+    const ImageType::PixelType rangePixel = rangeOutput->GetPixel(index);
+    const SpatialImageType::PixelType spatialPixel = spatialOutput->GetPixel(index);
+
+    bool identical = true;
+    for (unsigned int dim = 0; dim < Dimension; ++dim)
+      {
+      identical = identical && (spatialPixel[dim] == reference[dim] - index[dim]);
+      }
+    for (unsigned int comp = 0; comp < nbComp; ++comp)
+      {
+      identical = identical && (rangePixel[comp] == reference[Dimension + comp]);
+      }
+    if (!identical)
+      {
+      if (nbErrors < 10)
+        {
+        std::cerr << "Output differs from reference at index " << index << std::endl;
+        }
+      ++nbErrors;
+      }
+    }
+
+  if (nbErrors > 0)
+    {
+    std::cerr << nbErrors << " pixels differ from the reference implementation" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -26,4 +26,5 @@ void RegisterTests()
   REGISTER_TEST(otbMeanShiftSmoothingImageFilterSpatialStability);
   REGISTER_TEST(otbMeanShiftSmoothingImageFilterNew);
   REGISTER_TEST(otbMeanShiftSmoothingImageFilterThreading);
+  REGISTER_TEST(otbMeanShiftSmoothingImageFilterBenchmark);
 }
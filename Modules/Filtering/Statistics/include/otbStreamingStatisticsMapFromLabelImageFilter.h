@@ -26,14 +26,124 @@
 #include "itkNumericTraits.h"
 #include "itkArray.h"
 #include "itkSimpleDataObjectDecorator.h"
+#include "itkIntTypes.h"
 #include "otbPersistentFilterStreamingDecorator.h"
+#include <map>
+#include <vector>
 
 
 namespace otb
 {
 
+/** \class LabelStatisticsAccumulator
+ * \brief Accumulates the count, sum, sum of squares, minimum and maximum of
+ * the components of the pixels of each label.
+ *
+ * Labels are stored in an open-addressing hash table with linear probing,
+ * which gives the position of the label statistics. The statistics of all
+ * the labels are stored contiguously, the components of a label being
+ * adjacent, which avoids an allocation per label.
+ *
+ * \sa PersistentStreamingStatisticsMapFromLabelImageFilter
+ *
+ * \ingroup OTBStatistics
+ */
+template<class TLabel>
+class LabelStatisticsAccumulator
+{
+public:
+  typedef TLabel LabelType;
+
+  LabelStatisticsAccumulator();
+
+  /** Set the number of components of the pixels. Has no effect if some
+   * pixels were already added. */
+  void SetNumberOfComponents(unsigned int nbComponents);
+
+  unsigned int GetNumberOfComponents() const
+  {
+    return m_NumberOfComponents;
+  }
+
+  /** Number of labels seen */
+  size_t GetNumberOfLabels() const
+  {
+    return m_Labels.size();
+  }
+
+  /** Remove all the labels */
+  void Clear();
+
+  /** Add the pixel value to the statistics of label */
+  template<class TPixel>
+  void AddPixel(const LabelType& label, const TPixel& value);
+
+  /** Add the statistics of another accumulator */
+  void Merge(const LabelStatisticsAccumulator& other);
+
+  /** Accessors to the statistics of the i-th label */
+  const LabelType& GetLabel(size_t i) const
+  {
+    return m_Labels[i];
+  }
+  double GetCount(size_t i) const
+  {
+    return m_Counts[i];
+  }
+  const double * GetSum(size_t i) const
+  {
+    return &m_Sums[i * m_NumberOfComponents];
+  }
+  const double * GetSquaredSum(size_t i) const
+  {
+    return &m_SquaredSums[i * m_NumberOfComponents];
+  }
+  const double * GetMin(size_t i) const
+  {
+    return &m_Min[i * m_NumberOfComponents];
+  }
+  const double * GetMax(size_t i) const
+  {
+    return &m_Max[i * m_NumberOfComponents];
+  }
+
+private:
+  /** Position of the statistics of label, added if needed */
+  size_t GetPosition(const LabelType& label);
+
+  /** Double the size of the hash table */
+  void Grow();
+
+  /** Fibonacci hashing: the slot is taken from the high bits of the
+   * product, which depend on all the bits of the label. Labels with a
+   * power of two stride would collide on the low bits. */
+  size_t Hash(const LabelType& label) const
+  {
+    const itk::uint64_t key = static_cast<itk::uint64_t>(static_cast<itk::int64_t>(label));
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> (64 - m_TableBits));
+  }
+
+  unsigned int m_NumberOfComponents;
+
+  /** Hash table holding the position of the labels, -1 for empty slots.
+   * Its size is 2^m_TableBits. */
+  std::vector<long> m_Table;
+  unsigned int      m_TableBits;
+
+  std::vector<LabelType> m_Labels;
+  std::vector<double>    m_Counts;
+  std::vector<double>    m_Sums;
+  std::vector<double>    m_SquaredSums;
+  std::vector<double>    m_Min;
+  std::vector<double>    m_Max;
+};
+
 /** \class PersistentStreamingStatisticsMapFromLabelImageFilter
- * \brief Computes mean radiometric value for each label of a label image, based on a support VectorImage
+ * \brief Computes radiometric statistics for each label of a label image, based on a support VectorImage
+ *
+ * The mean, standard deviation, minimum and maximum of each component, and the
+ * number of pixels are computed for each label. The statistics of each thread
+ * are accumulated separately, and merged by Synthetize().
  *
  * This filter persists its temporary data. It means that if you Update it n times on n different
  * requested regions, the output statistics will be the statitics of the whole set of n regions.
@@ -42,8 +152,6 @@ namespace otb
  *
  * To get the statistics once the regions have been processed via the pipeline, use the Synthetize() method.
  *
- * \todo Implement other statistics (min, max, stddev...)
- *
  * \sa StreamingStatisticsMapFromLabelImageFilter
  * \ingroup Streamed
  * \ingroup Multithreaded
@@ -78,6 +186,7 @@ public:
   typedef typename LabelImageType::PixelType                            LabelPixelType;
   typedef std::map<LabelPixelType, itk::VariableLengthVector<double> >  MeanValueMapType;
   typedef std::map<LabelPixelType, double>                              LabelPopulationMapType;
+  typedef LabelStatisticsAccumulator<LabelPixelType>                    AccumulatorType;
 
   itkStaticConstMacro(InputImageDimension, unsigned int,
                       TInputVectorImage::ImageDimension);
@@ -92,6 +201,7 @@ public:
 
   typedef itk::ImageBase<InputImageDimension> ImageBaseType;
   typedef typename ImageBaseType::RegionType InputImageRegionType;
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
 
   /** Type of DataObjects used for scalar outputs */
   typedef itk::SimpleDataObjectDecorator<MeanValueMapType>  MeanValueMapObjectType;
@@ -105,6 +215,15 @@ public:
   /** Return the computed Mean for each label in the input label image */
   MeanValueMapType GetMeanValueMap() const;
 
+  /** Return the computed standard deviation for each label in the input label image */
+  MeanValueMapType GetStandardDeviationValueMap() const;
+
+  /** Return the computed minimum for each label in the input label image */
+  MeanValueMapType GetMinValueMap() const;
+
+  /** Return the computed maximum for each label in the input label image */
+  MeanValueMapType GetMaxValueMap() const;
+
   /** Return the computed number of labeled pixels for each label in the input label image */
   LabelPopulationMapType GetLabelPopulationMap() const;
 
@@ -133,14 +252,23 @@ protected:
   ~PersistentStreamingStatisticsMapFromLabelImageFilter() ITK_OVERRIDE {}
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
 
-  /** GenerateData. */
-  void  GenerateData() ITK_OVERRIDE;
+  /** Allocate the accumulators of the threads */
+  void BeforeThreadedGenerateData() ITK_OVERRIDE;
+
+  /** Accumulate the statistics of the region of the thread */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                            itk::ThreadIdType threadId) ITK_OVERRIDE;
 
 private:
   PersistentStreamingStatisticsMapFromLabelImageFilter(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
 
-  MeanValueMapType                       m_RadiometricValueAccumulator;
+  std::vector<AccumulatorType>           m_ThreadAccumulators;
+
+  MeanValueMapType                       m_MeanValueMap;
+  MeanValueMapType                       m_StandardDeviationValueMap;
+  MeanValueMapType                       m_MinValueMap;
+  MeanValueMapType                       m_MaxValueMap;
   LabelPopulationMapType                 m_LabelPopulation;
 }; // end of class PersistentStreamingStatisticsMapFromLabelImageFilter
 
@@ -148,9 +276,10 @@ private:
 /*===========================================================================*/
 
 /** \class StreamingStatisticsMapFromLabelImageFilter
- * \brief Computes mean radiometric value for each label of a label image, based on a support VectorImage
+ * \brief Computes radiometric statistics for each label of a label image, based on a support VectorImage
  *
- * Currently the class only computes the mean value.
+ * The class computes the mean, standard deviation, minimum and maximum values
+ * and the population of each label.
  *
  * This class streams the whole input image through the PersistentStreamingStatisticsMapFromLabelImageFilter.
  *
@@ -176,9 +305,6 @@ private:
  * }
  * \endcode
  *
- * \todo Implement other statistics (min, max, stddev...)
- * \todo Reimplement as a multi-threaded filter
- *
  * \sa PersistentStatisticsImageFilter
  * \sa PersistentImageFilter
  * \sa PersistentFilterStreamingDecorator
@@ -248,6 +374,24 @@ public:
     return this->GetFilter()->GetMeanValueMap();
   }
 
+  /** Return the computed standard deviation for each label */
+  MeanValueMapType GetStandardDeviationValueMap() const
+  {
+    return this->GetFilter()->GetStandardDeviationValueMap();
+  }
+
+  /** Return the computed minimum for each label */
+  MeanValueMapType GetMinValueMap() const
+  {
+    return this->GetFilter()->GetMinValueMap();
+  }
+
+  /** Return the computed maximum for each label */
+  MeanValueMapType GetMaxValueMap() const
+  {
+    return this->GetFilter()->GetMaxValueMap();
+  }
+
   /** Return the computed number of labeled pixels for each label */
   LabelPopulationMapType GetLabelPopulationMap() const
   {
@@ -26,12 +26,145 @@
 #include "itkInputDataObjectIterator.h"
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
+#include "itkDefaultConvertPixelTraits.h"
 #include "otbMacro.h"
+#include <algorithm>
+#include <cmath>
 
 
 namespace otb
 {
 
+template<class TLabel>
+LabelStatisticsAccumulator<TLabel>
+::LabelStatisticsAccumulator()
+  : m_NumberOfComponents(0)
+{
+  this->Clear();
+}
+
+template<class TLabel>
+void
+LabelStatisticsAccumulator<TLabel>
+::SetNumberOfComponents(unsigned int nbComponents)
+{
+  if (m_Labels.empty())
+    {
+    m_NumberOfComponents = nbComponents;
+    }
+}
+
+template<class TLabel>
+void
+LabelStatisticsAccumulator<TLabel>
+::Clear()
+{
+  m_TableBits = 10;
+  m_Table.assign(size_t(1) << m_TableBits, -1);
+  m_Labels.clear();
+  m_Counts.clear();
+  m_Sums.clear();
+  m_SquaredSums.clear();
+  m_Min.clear();
+  m_Max.clear();
+}
+
+template<class TLabel>
+void
+LabelStatisticsAccumulator<TLabel>
+::Grow()
+{
+  ++m_TableBits;
+  m_Table.assign(size_t(1) << m_TableBits, -1);
+  for (size_t i = 0; i < m_Labels.size(); ++i)
+    {
+    size_t slot = Hash(m_Labels[i]);
+    while (m_Table[slot] >= 0)
+      {
+      slot = (slot + 1) & (m_Table.size() - 1);
+      }
+    m_Table[slot] = static_cast<long>(i);
+    }
+}
+
+template<class TLabel>
+size_t
+LabelStatisticsAccumulator<TLabel>
+::GetPosition(const LabelType& label)
+{
+  size_t slot = Hash(label);
+  while (m_Table[slot] >= 0)
+    {
+    if (m_Labels[m_Table[slot]] == label)
+      {
+      return m_Table[slot];
+      }
+    slot = (slot + 1) & (m_Table.size() - 1);
+    }
+
+  // New label
+  const size_t position = m_Labels.size();
+  m_Table[slot] = static_cast<long>(position);
+  m_Labels.push_back(label);
+  m_Counts.push_back(0.);
+  m_Sums.resize(m_Sums.size() + m_NumberOfComponents, 0.);
+  m_SquaredSums.resize(m_SquaredSums.size() + m_NumberOfComponents, 0.);
+  m_Min.resize(m_Min.size() + m_NumberOfComponents, itk::NumericTraits<double>::max());
+  m_Max.resize(m_Max.size() + m_NumberOfComponents, itk::NumericTraits<double>::NonpositiveMin());
+
+  // Keep the load factor of the table below one half
+  if (2 * m_Labels.size() > m_Table.size())
+    {
+    this->Grow();
+    }
+  return position;
+}
+
+template<class TLabel>
+template<class TPixel>
+void
+LabelStatisticsAccumulator<TLabel>
+::AddPixel(const LabelType& label, const TPixel& value)
+{
+  const size_t position = this->GetPosition(label);
+  const size_t offset = position * m_NumberOfComponents;
+  m_Counts[position] += 1.;
+  for (unsigned int c = 0; c < m_NumberOfComponents; ++c)
+    {
+    const double v = static_cast<double>(itk::DefaultConvertPixelTraits<TPixel>::GetNthComponent(c, value));
+    m_Sums[offset + c] += v;
+    m_SquaredSums[offset + c] += v * v;
+    m_Min[offset + c] = std::min(m_Min[offset + c], v);
+    m_Max[offset + c] = std::max(m_Max[offset + c], v);
+    }
+}
+
+template<class TLabel>
+void
+LabelStatisticsAccumulator<TLabel>
+::Merge(const LabelStatisticsAccumulator& other)
+{
+  if (m_Labels.empty())
+    {
+    m_NumberOfComponents = other.m_NumberOfComponents;
+    }
+
+  for (size_t i = 0; i < other.m_Labels.size(); ++i)
+    {
+    const size_t position = this->GetPosition(other.m_Labels[i]);
+    const size_t offset = position * m_NumberOfComponents;
+    const size_t otherOffset = i * m_NumberOfComponents;
+    m_Counts[position] += other.m_Counts[i];
+    for (unsigned int c = 0; c < m_NumberOfComponents; ++c)
+      {
+      m_Sums[offset + c] += other.m_Sums[otherOffset + c];
+      m_SquaredSums[offset + c] += other.m_SquaredSums[otherOffset + c];
+      m_Min[offset + c] = std::min(m_Min[offset + c], other.m_Min[otherOffset + c]);
+      m_Max[offset + c] = std::max(m_Max[offset + c], other.m_Max[otherOffset + c]);
+      }
+    }
+}
+
 template<class TInputVectorImage, class TLabelImage>
 PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>
 ::PersistentStreamingStatisticsMapFromLabelImageFilter()
@@ -94,7 +227,31 @@ typename PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage,
 PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>
 ::GetMeanValueMap() const
 {
-  return m_RadiometricValueAccumulator;
+  return m_MeanValueMap;
+}
+
+template<class TInputVectorImage, class TLabelImage>
+typename PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>::MeanValueMapType
+PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>
+::GetStandardDeviationValueMap() const
+{
+  return m_StandardDeviationValueMap;
+}
+
+template<class TInputVectorImage, class TLabelImage>
+typename PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>::MeanValueMapType
+PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>
+::GetMinValueMap() const
+{
+  return m_MinValueMap;
+}
+
+template<class TInputVectorImage, class TLabelImage>
+typename PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>::MeanValueMapType
+PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>
+::GetMaxValueMap() const
+{
+  return m_MaxValueMap;
 }
 
 template<class TInputVectorImage, class TLabelImage>
@@ -141,11 +298,48 @@ void
 PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>
 ::Synthetize()
 {
-   typename MeanValueMapType::iterator it;
-   for(it = m_RadiometricValueAccumulator.begin(); it != m_RadiometricValueAccumulator.end(); it++)
-   {
-      it->second = it->second / m_LabelPopulation[it->first];
-   }
+  // Merge the statistics of the threads
+  AccumulatorType accumulator;
+  for (typename std::vector<AccumulatorType>::const_iterator it = m_ThreadAccumulators.begin();
+       it != m_ThreadAccumulators.end(); ++it)
+    {
+    accumulator.Merge(*it);
+    }
+
+  m_MeanValueMap.clear();
+  m_StandardDeviationValueMap.clear();
+  m_MinValueMap.clear();
+  m_MaxValueMap.clear();
+  m_LabelPopulation.clear();
+
+  const unsigned int nbComponents = accumulator.GetNumberOfComponents();
+  itk::VariableLengthVector<double> mean(nbComponents);
+  itk::VariableLengthVector<double> stdDev(nbComponents);
+  itk::VariableLengthVector<double> minValue(nbComponents);
+  itk::VariableLengthVector<double> maxValue(nbComponents);
+
+  for (size_t i = 0; i < accumulator.GetNumberOfLabels(); ++i)
+    {
+    const double count = accumulator.GetCount(i);
+    const double * sum = accumulator.GetSum(i);
+    const double * squaredSum = accumulator.GetSquaredSum(i);
+    for (unsigned int c = 0; c < nbComponents; ++c)
+      {
+      mean[c] = sum[c] / count;
+      // Population variance, which may be slightly negative due to rounding
+      const double variance = squaredSum[c] / count - mean[c] * mean[c];
+      stdDev[c] = variance > 0. ? std::sqrt(variance) : 0.;
+      minValue[c] = accumulator.GetMin(i)[c];
+      maxValue[c] = accumulator.GetMax(i)[c];
+      }
+
+    const LabelPixelType label = accumulator.GetLabel(i);
+    m_MeanValueMap[label] = mean;
+    m_StandardDeviationValueMap[label] = stdDev;
+    m_MinValueMap[label] = minValue;
+    m_MaxValueMap[label] = maxValue;
+    m_LabelPopulation[label] = count;
+    }
 }
 
 template<class TInputVectorImage, class TLabelImage>
@@ -153,7 +347,12 @@ void
 PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>
 ::Reset()
 {
-  m_RadiometricValueAccumulator.clear();
+  m_ThreadAccumulators.assign(this->GetNumberOfThreads(), AccumulatorType());
+  m_MeanValueMap.clear();
+  m_StandardDeviationValueMap.clear();
+  m_MinValueMap.clear();
+  m_MaxValueMap.clear();
+  m_LabelPopulation.clear();
 }
 
 template<class TInputVectorImage, class TLabelImage>
@@ -189,7 +388,26 @@ PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelIm
 template<class TInputVectorImage, class TLabelImage>
 void
 PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>
-::GenerateData()
+::BeforeThreadedGenerateData()
+{
+  // Accumulators persist between the streamed regions
+  if (m_ThreadAccumulators.size() < this->GetNumberOfThreads())
+    {
+    m_ThreadAccumulators.resize(this->GetNumberOfThreads());
+    }
+
+  const unsigned int nbComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
+  for (typename std::vector<AccumulatorType>::iterator it = m_ThreadAccumulators.begin();
+       it != m_ThreadAccumulators.end(); ++it)
+    {
+    it->SetNumberOfComponents(nbComponents);
+    }
+}
+
+template<class TInputVectorImage, class TLabelImage>
+void
+PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>
+::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
 {
   /**
    * Grab the input
@@ -197,33 +415,20 @@ PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelIm
   InputVectorImagePointer inputPtr =  const_cast<TInputVectorImage *>(this->GetInput());
   LabelImagePointer labelInputPtr =  const_cast<TLabelImage *>(this->GetInputLabelImage());
 
-  itk::ImageRegionConstIterator<TInputVectorImage> inIt(inputPtr, inputPtr->GetRequestedRegion());
-  itk::ImageRegionConstIterator<TLabelImage> labelIt(labelInputPtr, labelInputPtr->GetRequestedRegion());
+  itk::ImageRegionConstIterator<TInputVectorImage> inIt(inputPtr, outputRegionForThread);
+  itk::ImageRegionConstIterator<TLabelImage> labelIt(labelInputPtr, outputRegionForThread);
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
-  itk::VariableLengthVector<double> zeroValue(inputPtr->GetNumberOfComponentsPerPixel());
-  zeroValue.Fill(0.0);
+  AccumulatorType& accumulator = m_ThreadAccumulators[threadId];
 
-  typename VectorImageType::PixelType value;
-  typename LabelImageType::PixelType label;
   // do the work
   for (inIt.GoToBegin(), labelIt.GoToBegin();
        !inIt.IsAtEnd() && !labelIt.IsAtEnd();
        ++inIt, ++labelIt)
     {
-      value = inIt.Get();
-      label = labelIt.Get();
-      if (m_RadiometricValueAccumulator.count(label)<=0) //add new element to the map
-      {
-        // use a zero pixel with the right number of components to support scalar images
-        m_RadiometricValueAccumulator[label] = (zeroValue + value);
-        m_LabelPopulation[label] = 1;
-      }
-      else
-      {
-        m_RadiometricValueAccumulator[label] += value;
-        m_LabelPopulation[label] ++;
-      }
-
+    accumulator.AddPixel(labelIt.Get(), inIt.Get());
+    progress.CompletedPixel();
     }
 }
 
@@ -31,6 +31,7 @@ void RegisterTests()
   REGISTER_TEST(otbStreamingHistogramVectorImageFilterNew);
   REGISTER_TEST(otbStreamingHistogramVectorImageFilterTest);
   REGISTER_TEST(otbStreamingStatisticsVectorImageFilterNew);
+  REGISTER_TEST(otbStreamingStatisticsVectorImageFilterPipelined);
   REGISTER_TEST(otbRealImageToComplexImageFilterTest);
   REGISTER_TEST(otbHistogramStatisticsFunction);
   REGISTER_TEST(otbGaussianAdditiveNoiseSampleListFilterNew);
@@ -209,6 +209,27 @@ int generic_StreamingStatisticsMapFromLabelImageFilterTest(int itkNotUsed(argc),
     return EXIT_FAILURE;
     }
 
+  // Each label has a constant color
+  if (m_StatisticsMapFromLabelImageFilter->GetMinValueMap() != labelToMeanIntensityMapBL
+      || m_StatisticsMapFromLabelImageFilter->GetMaxValueMap() != labelToMeanIntensityMapBL)
+    {
+    std::cout << "ERROR with m_StatisticsMapFromLabelImageFilter->GetMinValueMap() or GetMaxValueMap()" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  MeanValueMapType stdDevMap = m_StatisticsMapFromLabelImageFilter->GetStandardDeviationValueMap();
+  for (typename MeanValueMapType::const_iterator it = stdDevMap.begin(); it != stdDevMap.end(); ++it)
+    {
+    for (unsigned int i = 0; i < it->second.Size(); ++i)
+      {
+      if (it->second[i] > 1e-6)
+        {
+        std::cout << "ERROR with m_StatisticsMapFromLabelImageFilter->GetStandardDeviationValueMap()" << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
   return EXIT_SUCCESS;
 }
 
@@ -75,3 +75,45 @@ int otbStreamingStatisticsVectorImageFilter(int argc, char * argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbStreamingStatisticsVectorImageFilterPipelined(int itkNotUsed(argc), char * argv[])
+{
+  const char * infname = argv[1];
+  const char * outfname = argv[2];
+  const unsigned int nbPipelinedDivisions = atoi(argv[3]);
+
+  const unsigned int Dimension = 2;
+  typedef double PixelType;
+
+  typedef otb::VectorImage<PixelType, Dimension>               ImageType;
+  typedef otb::ImageFileReader<ImageType>                      ReaderType;
+  typedef otb::StreamingStatisticsVectorImageFilter<ImageType> StreamingStatisticsVectorImageFilterType;
+
+  StreamingStatisticsVectorImageFilterType::Pointer filter = StreamingStatisticsVectorImageFilterType::New();
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(infname);
+
+  // Upstream reading and statistics accumulation run concurrently
+  filter->GetStreamer()->SetNumberOfLinesStrippedStreaming( 10 );
+  filter->SetNumberOfPipelinedDivisions(nbPipelinedDivisions);
+  filter->SetInput(reader->GetOutput());
+  filter->Update();
+
+  std::ofstream file;
+  file.open(outfname);
+  file << "Minimum: " << filter->GetMinimum() << std::endl;
+  file << "Maximum: " << filter->GetMaximum() << std::endl;
+  file << std::fixed;
+  file.precision(5);
+  file << "Sum: " << filter->GetSum() << std::endl;
+  file << "Mean: " << filter->GetMean() << std::endl;
+  file << "Correlation: " << filter->GetCorrelation() << std::endl;
+  file << "Covariance: " << filter->GetCovariance() << std::endl;
+  file << "Component Mean: " << filter->GetComponentMean() << std::endl;
+  file << "Component Correlation: " << filter->GetComponentCorrelation() << std::endl;
+  file << "Component Covariance: " << filter->GetComponentCovariance() << std::endl;
+  file.close();
+
+  return EXIT_SUCCESS;
+}
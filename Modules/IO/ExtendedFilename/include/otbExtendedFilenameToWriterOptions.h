@@ -34,6 +34,7 @@ namespace otb
  * - &writegeom=ON : to activate the creation of an external geom file
  * - &gdal:co:<KEY>=<VALUE> : the gdal creation option <KEY>
  * - streaming modes
+ * - &streaming:pipeline=<N> : number of divisions queued for asynchronous writing
  * - box
  * See http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName
  *
@@ -71,6 +72,7 @@ public:
     std::pair<bool,  std::string>                streamingType;
     std::pair<bool,  std::string>                streamingSizeMode;
     std::pair<bool,  double>                     streamingSizeValue;
+    std::pair<bool,  unsigned int>               streamingPipeline;
     std::pair<bool,  std::string>                box;
     std::pair< bool, std::string>                bandRange;
     std::vector<std::string>                     optionList;
@@ -92,6 +94,8 @@ public:
   std::string GetStreamingSizeMode() const;
   bool StreamingSizeValueIsSet() const;
   double GetStreamingSizeValue() const;
+  bool StreamingPipelineIsSet() const;
+  unsigned int GetStreamingPipeline() const;
   std::string GetBandRange () const;
 
   bool BoxIsSet() const;
@@ -42,6 +42,8 @@ ExtendedFilenameToWriterOptions
   m_Options.streamingType.first       = false;
   m_Options.streamingSizeMode.first   = false;
   m_Options.streamingSizeValue.first  = false;
+  m_Options.streamingPipeline.first   = false;
+  m_Options.streamingPipeline.second  = 0;
 
   m_Options.bandRange.first = false;
   m_Options.bandRange.second = "";
@@ -51,6 +53,7 @@ ExtendedFilenameToWriterOptions
   m_Options.optionList.push_back("streaming:type");
   m_Options.optionList.push_back("streaming:sizemode");
   m_Options.optionList.push_back("streaming:sizevalue");
+  m_Options.optionList.push_back("streaming:pipeline");
   m_Options.optionList.push_back("box");
   m_Options.optionList.push_back("bands");
 }
@@ -111,6 +114,7 @@ ExtendedFilenameToWriterOptions
   if(!map["streaming:type"].empty())
     {
     if(map["streaming:type"] == "auto"
+       || map["streaming:type"] == "aligned"
        || map["streaming:type"] == "tiled"
        || map["streaming:type"] == "stripped"
        || map["streaming:type"] == "none")
@@ -120,7 +124,7 @@ ExtendedFilenameToWriterOptions
       }
     else
       {
-      itkWarningMacro("Unkwown value "<<map["streaming:type"]<<" for streaming:type option. Available values are auto,tiled,stripped.");
+      itkWarningMacro("Unkwown value "<<map["streaming:type"]<<" for streaming:type option. Available values are auto,aligned,tiled,stripped.");
       }
     }
 
@@ -145,6 +149,20 @@ ExtendedFilenameToWriterOptions
     m_Options.streamingSizeValue.second = atof(map["streaming:sizevalue"].c_str());
     }
 
+  if(!map["streaming:pipeline"].empty())
+    {
+    int depth = atoi(map["streaming:pipeline"].c_str());
+    if(depth >= 0)
+      {
+      m_Options.streamingPipeline.first=true;
+      m_Options.streamingPipeline.second = static_cast<unsigned int>(depth);
+      }
+    else
+      {
+      itkWarningMacro("Unkwown value "<<map["streaming:pipeline"]<<" for streaming:pipeline option. Expect a positive number of queued divisions (0 disables pipelining).");
+      }
+    }
+
   //Manage region size to write in output image
   if(!map["box"].empty())
     {
@@ -295,6 +313,20 @@ ExtendedFilenameToWriterOptions
   return m_Options.streamingSizeValue.second;
 }
 
+bool
+ExtendedFilenameToWriterOptions
+::StreamingPipelineIsSet() const
+{
+  return m_Options.streamingPipeline.first;
+}
+
+unsigned int
+ExtendedFilenameToWriterOptions
+::GetStreamingPipeline() const
+{
+  return m_Options.streamingPipeline.second;
+}
+
 bool
 ExtendedFilenameToWriterOptions
 ::BoxIsSet() const
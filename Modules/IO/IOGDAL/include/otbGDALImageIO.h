@@ -143,6 +143,14 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   void Read(void* buffer) ITK_OVERRIDE;
 
+  /** Reads the IORegion with a single RasterIO call, letting GDAL
+   * select the bands and convert the pixels into the output buffer.
+   * Only lossless conversions are accepted so that the result is the
+   * same as Read() followed by the reader conversion. */
+  bool ReadDirect(void* buffer, const std::type_info& componentType,
+                  unsigned int nbComponents,
+                  const std::vector<unsigned int>& bandList) ITK_OVERRIDE;
+
   /** Reads 3D data from multiple files assuming one slice per file. */
   virtual void ReadVolume(void* buffer);
 
@@ -226,6 +234,12 @@ private:
 
   std::string FilenameToGdalDriverShortName(const std::string& name) const;
 
+  /** Compute the window of the file to read for the current IORegion,
+   * taking into account the resolution factor */
+  void ComputeReadWindow(int& firstColumn, int& firstLine,
+                         int& nbColumns, int& nbLines,
+                         int& bufferColumns, int& bufferLines) const;
+
   /** Parse a GML box from a Jpeg2000 file and get the origin */
   bool GetOriginFromGMLBox(std::vector<double> &origin);
   
@@ -272,6 +286,11 @@ private:
    */
   unsigned int m_ResolutionFactor;
 
+  /**
+   * Index of the overview matching exactly the resolution factor, or
+   * -1 if the file has none (reads are then resampled by GDAL) */
+  int m_OverviewIndex;
+
   /**
    * Original dimension of the input image
    */
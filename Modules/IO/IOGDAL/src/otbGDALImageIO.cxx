@@ -162,6 +162,7 @@ GDALImageIO::GDALImageIO()
 
   m_NumberOfOverviews = 0;
   m_ResolutionFactor = 0;
+  m_OverviewIndex = -1;
   m_BytePerPixel = 0;
   m_WriteRPCTags = false;
 }
@@ -198,6 +199,56 @@ void GDALImageIO::ReadVolume(void*)
 {
 }
 
+namespace
+{
+// Read a window of the IO region from the overview level 'overview',
+// band by band, or from the full resolution dataset (decimated by GDAL
+// to the buffer size) if 'overview' is negative
+CPLErr ReadRasterWindow(GDALDataset* dataset, int overview,
+                        int firstColumn, int firstLine, int nbColumns, int nbLines,
+                        const itk::ImageIORegion& region,
+                        void* buffer, GDALDataType bufferType,
+                        int nbBands, int* bandMap,
+                        int pixelOffset, int lineOffset, int bandOffset)
+{
+  const int bufferColumns = region.GetSize()[0];
+  const int bufferLines = region.GetSize()[1];
+
+  if (overview < 0)
+    {
+    return dataset->RasterIO(GF_Read,
+                             firstColumn, firstLine, nbColumns, nbLines,
+                             buffer, bufferColumns, bufferLines, bufferType,
+                             nbBands, bandMap,
+                             pixelOffset, lineOffset, bandOffset);
+    }
+
+  for (int band = 0; band < nbBands; ++band)
+    {
+    GDALRasterBand* rasterBand =
+      dataset->GetRasterBand(bandMap != ITK_NULLPTR ? bandMap[band] : band + 1)->GetOverview(overview);
+
+    if (rasterBand == ITK_NULLPTR)
+      {
+      return CE_Failure;
+      }
+
+    CPLErr err = rasterBand->RasterIO(GF_Read,
+                                      region.GetIndex()[0], region.GetIndex()[1],
+                                      bufferColumns, bufferLines,
+                                      static_cast<unsigned char*>(buffer) + band * bandOffset,
+                                      bufferColumns, bufferLines, bufferType,
+                                      pixelOffset, lineOffset);
+    if (err == CE_Failure)
+      {
+      return err;
+      }
+    }
+
+  return CE_None;
+}
+}
+
 // Read image with GDAL
 void GDALImageIO::Read(void* buffer)
 {
@@ -211,35 +262,9 @@ void GDALImageIO::Read(void* buffer)
     return;
     }
 
-  // Get the origin of the region to read
-  int lFirstLineRegion   = this->GetIORegion().GetIndex()[1];
-  int lFirstColumnRegion = this->GetIORegion().GetIndex()[0];
-
-  // Get nb. of lines and columns of the region to read
-  int lNbLinesRegion   = this->GetIORegion().GetSize()[1];
-  int lNbColumnsRegion = this->GetIORegion().GetSize()[0];
-
-  //std::cout << "OriginBuffer= " <<  lFirstLineRegion << " x " << lFirstColumnRegion << std::endl;
-  //std::cout << "SizeBuffer= " <<  lNbLinesRegion << " x " << lNbColumnsRegion << std::endl;
-
-  // Compute the origin of the image region to read at the initial resolution
-  int lFirstLine   = lFirstLineRegion * (1 << m_ResolutionFactor);
-  int lFirstColumn = lFirstColumnRegion * (1 << m_ResolutionFactor);
-
-  //std::cout << "OriginImage= " <<  lFirstLine << " x " << lFirstColumn << std::endl;
-
-  // Compute the size of the image region to read at the initial resolution
-  int lNbLines     = lNbLinesRegion * (1 << m_ResolutionFactor);
-  int lNbColumns   = lNbColumnsRegion * (1 << m_ResolutionFactor);
-
-  // Check if the image region is correct
-  if (lFirstLine + lNbLines > static_cast<int>(m_OriginalDimensions[1]))
-    lNbLines = static_cast<int>(m_OriginalDimensions[1]-lFirstLine);
-  if (lFirstColumn + lNbColumns > static_cast<int>(m_OriginalDimensions[0]))
-    lNbColumns = static_cast<int>(m_OriginalDimensions[0]-lFirstColumn);
-
-  //std::cout << "SizeImage= " <<  lNbLines << " x " << lNbColumns << std::endl;
-
+  int lFirstColumn, lFirstLine, lNbColumns, lNbLines, lNbColumnsRegion, lNbLinesRegion;
+  this->ComputeReadWindow(lFirstColumn, lFirstLine, lNbColumns, lNbLines,
+                          lNbColumnsRegion, lNbLinesRegion);
 
   GDALDataset* dataset = m_Dataset->GetDataSet();
 
@@ -410,21 +435,21 @@ void GDALImageIO::Read(void* buffer)
 
     itk::TimeProbe chrono;
     chrono.Start();
-    CPLErr lCrGdal = m_Dataset->GetDataSet()->RasterIO(GF_Read,
-                                                       lFirstColumn,
-                                                       lFirstLine,
-                                                       lNbColumns,
-                                                       lNbLines,
-                                                       p,
-                                                       lNbColumnsRegion,
-                                                       lNbLinesRegion,
-                                                       m_PxType->pixType,
-                                                       nbBands,
-                                                       // We want to read all bands
-                                                       ITK_NULLPTR,
-                                                       pixelOffset,
-                                                       lineOffset,
-                                                       bandOffset);
+    CPLErr lCrGdal = ReadRasterWindow(m_Dataset->GetDataSet(),
+                                      m_OverviewIndex,
+                                      lFirstColumn,
+                                      lFirstLine,
+                                      lNbColumns,
+                                      lNbLines,
+                                      this->GetIORegion(),
+                                      p,
+                                      m_PxType->pixType,
+                                      nbBands,
+                                      // We want to read all bands
+                                      ITK_NULLPTR,
+                                      pixelOffset,
+                                      lineOffset,
+                                      bandOffset);
     chrono.Stop();
     otbMsgDevMacro(<< "RasterIO Read took " << chrono.GetTotal() << " sec")
 
@@ -439,6 +464,239 @@ void GDALImageIO::Read(void* buffer)
     }
 }
 
+void GDALImageIO::ComputeReadWindow(int& lFirstColumn, int& lFirstLine,
+                                    int& lNbColumns, int& lNbLines,
+                                    int& lNbColumnsRegion, int& lNbLinesRegion) const
+{
+  // Get the origin of the region to read
+  int lFirstLineRegion   = this->GetIORegion().GetIndex()[1];
+  int lFirstColumnRegion = this->GetIORegion().GetIndex()[0];
+
+  // Get nb. of lines and columns of the region to read
+  lNbLinesRegion   = this->GetIORegion().GetSize()[1];
+  lNbColumnsRegion = this->GetIORegion().GetSize()[0];
+
+  // Compute the origin of the image region to read at the initial resolution
+  lFirstLine   = lFirstLineRegion * (1 << m_ResolutionFactor);
+  lFirstColumn = lFirstColumnRegion * (1 << m_ResolutionFactor);
+
+  // Compute the size of the image region to read at the initial resolution
+  lNbLines     = lNbLinesRegion * (1 << m_ResolutionFactor);
+  lNbColumns   = lNbColumnsRegion * (1 << m_ResolutionFactor);
+
+  // Check if the image region is correct
+  if (lFirstLine + lNbLines > static_cast<int>(m_OriginalDimensions[1]))
+    lNbLines = static_cast<int>(m_OriginalDimensions[1]-lFirstLine);
+  if (lFirstColumn + lNbColumns > static_cast<int>(m_OriginalDimensions[0]))
+    lNbColumns = static_cast<int>(m_OriginalDimensions[0]-lFirstColumn);
+}
+
+namespace
+{
+// GDAL buffer type matching a component type of the output image
+bool TypeInfoToGDALDataType(const std::type_info& typeInfo, GDALDataType& gdalType)
+{
+  if (typeInfo == typeid(unsigned char))
+    gdalType = GDT_Byte;
+  else if (typeInfo == typeid(unsigned short))
+    gdalType = GDT_UInt16;
+  else if (typeInfo == typeid(short))
+    gdalType = GDT_Int16;
+  else if (typeInfo == typeid(unsigned int))
+    gdalType = GDT_UInt32;
+  else if (typeInfo == typeid(int))
+    gdalType = GDT_Int32;
+  else if (typeInfo == typeid(float))
+    gdalType = GDT_Float32;
+  else if (typeInfo == typeid(double))
+    gdalType = GDT_Float64;
+  else if (typeInfo == typeid(std::complex<short>))
+    gdalType = GDT_CInt16;
+  else if (typeInfo == typeid(std::complex<int>))
+    gdalType = GDT_CInt32;
+  else if (typeInfo == typeid(std::complex<float>))
+    gdalType = GDT_CFloat32;
+  else if (typeInfo == typeid(std::complex<double>))
+    gdalType = GDT_CFloat64;
+  else
+    return false;
+  return true;
+}
+
+// Complex GDAL type holding two components of the given real type
+bool RealToComplexGDALDataType(GDALDataType realType, GDALDataType& complexType)
+{
+  switch (realType)
+    {
+    case GDT_Int16:
+      complexType = GDT_CInt16;
+      return true;
+    case GDT_Int32:
+      complexType = GDT_CInt32;
+      return true;
+    case GDT_Float32:
+      complexType = GDT_CFloat32;
+      return true;
+    case GDT_Float64:
+      complexType = GDT_CFloat64;
+      return true;
+    default:
+      return false;
+    }
+}
+
+// Whether GDAL converts every value of type 'from' to type 'to' exactly
+// (GDAL rounds and clamps where a static_cast would truncate, so only
+// value-preserving conversions give the same result as the reader)
+bool IsLosslessConversion(GDALDataType from, GDALDataType to)
+{
+  if (from == to)
+    return true;
+
+  switch (to)
+    {
+    case GDT_UInt16:
+      return from == GDT_Byte;
+    case GDT_Int16:
+      return from == GDT_Byte;
+    case GDT_UInt32:
+      return from == GDT_Byte || from == GDT_UInt16;
+    case GDT_Int32:
+      return from == GDT_Byte || from == GDT_UInt16 || from == GDT_Int16;
+    case GDT_Float32:
+      return from == GDT_Byte || from == GDT_UInt16 || from == GDT_Int16;
+    case GDT_Float64:
+      return from == GDT_Byte || from == GDT_UInt16 || from == GDT_Int16
+        || from == GDT_UInt32 || from == GDT_Int32 || from == GDT_Float32;
+    case GDT_CInt32:
+      return from == GDT_CInt16;
+    case GDT_CFloat32:
+      return from == GDT_CInt16;
+    case GDT_CFloat64:
+      return from == GDT_CInt16 || from == GDT_CInt32 || from == GDT_CFloat32;
+    default:
+      return false;
+    }
+}
+}
+
+bool GDALImageIO::ReadDirect(void* buffer, const std::type_info& componentType,
+                             unsigned int nbComponents,
+                             const std::vector<unsigned int>& bandList)
+{
+  // Color tables are expanded by Read()
+  if (m_IsIndexed || buffer == ITK_NULLPTR || nbComponents == 0)
+    {
+    return false;
+    }
+
+  GDALDataType outputType;
+  if (!TypeInfoToGDALDataType(componentType, outputType))
+    {
+    return false;
+    }
+
+  const GDALDataType fileType = m_PxType->pixType;
+  const bool fileIsComplex = GDALDataTypeIsComplex(fileType);
+  const int componentSize = GDALGetDataTypeSize(outputType) / 8;
+
+  GDALDataType bufferType = outputType;
+  std::vector<int> bandMap;
+  int bandOffset = componentSize;
+
+  if (fileIsComplex && !GDALDataTypeIsComplex(outputType))
+    {
+    // Complex bands reinterpreted as (real, imaginary) pairs of
+    // components: only supported when reading all the bands
+    if (!bandList.empty() || nbComponents != 2 * static_cast<unsigned int>(m_NbBands))
+      {
+      return false;
+      }
+    if (!RealToComplexGDALDataType(outputType, bufferType))
+      {
+      return false;
+      }
+    for (int band = 1; band <= m_NbBands; ++band)
+      {
+      bandMap.push_back(band);
+      }
+    bandOffset = 2 * componentSize;
+    }
+  else
+    {
+    if (bandList.empty())
+      {
+      for (int band = 1; band <= m_NbBands; ++band)
+        {
+        bandMap.push_back(band);
+        }
+      }
+    else
+      {
+      for (unsigned int i = 0; i < bandList.size(); ++i)
+        {
+        if (bandList[i] >= static_cast<unsigned int>(m_NbBands))
+          {
+          return false;
+          }
+        bandMap.push_back(bandList[i] + 1);
+        }
+      }
+    // One file band per output component
+    if (bandMap.size() != nbComponents)
+      {
+      return false;
+      }
+    }
+
+  if (!IsLosslessConversion(fileType, bufferType))
+    {
+    return false;
+    }
+
+  int lFirstColumn, lFirstLine, lNbColumns, lNbLines, lNbColumnsRegion, lNbLinesRegion;
+  this->ComputeReadWindow(lFirstColumn, lFirstLine, lNbColumns, lNbLines,
+                          lNbColumnsRegion, lNbLinesRegion);
+
+  int pixelOffset = componentSize * static_cast<int>(nbComponents);
+  int lineOffset  = pixelOffset * lNbColumnsRegion;
+
+  otbMsgDevMacro(<< "Parameters RasterIO (direct read): \n"
+                 << " indX = " << lFirstColumn << "\n"
+                 << " indY = " << lFirstLine << "\n"
+                 << " sizeX = " << lNbColumns << "\n"
+                 << " sizeY = " << lNbLines << "\n"
+                 << " Buffer Size X = " << lNbColumnsRegion << "\n"
+                 << " Buffer Size Y = " << lNbLinesRegion << "\n"
+                 << " GDAL Buffer Type = " << GDALGetDataTypeName(bufferType) << "\n"
+                 << " nbBands = " << bandMap.size() << "\n"
+                 << " pixelOffset = " << pixelOffset << "\n"
+                 << " lineOffset = " << lineOffset << "\n"
+                 << " bandOffset = " << bandOffset );
+
+  CPLErr lCrGdal = ReadRasterWindow(m_Dataset->GetDataSet(),
+                                    m_OverviewIndex,
+                                    lFirstColumn,
+                                    lFirstLine,
+                                    lNbColumns,
+                                    lNbLines,
+                                    this->GetIORegion(),
+                                    buffer,
+                                    bufferType,
+                                    static_cast<int>(bandMap.size()),
+                                    &bandMap[0],
+                                    pixelOffset,
+                                    lineOffset,
+                                    bandOffset);
+
+  if (lCrGdal == CE_Failure)
+    {
+    itkExceptionMacro(<< "Error while reading image (GDAL format) '"
+      << m_FileName.c_str() << "' : " << CPLGetLastErrorMsg());
+    }
+  return true;
+}
+
 bool GDALImageIO::GetSubDatasetInfo(std::vector<std::string> &names, std::vector<std::string> &desc)
 {
   // Note: we assume that the subdatasets are in order : SUBDATASET_ID_NAME, SUBDATASET_ID_DESC, SUBDATASET_ID+1_NAME, SUBDATASET_ID+1_DESC
@@ -666,7 +924,25 @@ void GDALImageIO::InternalReadImageInformation()
                       <<  m_OverviewsSize.back().first << " x " << m_OverviewsSize.back().second);
   }
 
+  // Read the requested resolution straight from the matching
+  // overview, rather than letting GDAL pick the best level or decimate
+  // the full resolution image
+  m_OverviewIndex = -1;
+  if (m_ResolutionFactor > 0)
+    {
+    for (unsigned int iOverview = 0; iOverview < m_NumberOfOverviews; iOverview++)
+      {
+      if (m_OverviewsSize[iOverview].first == m_Dimensions[0]
+          && m_OverviewsSize[iOverview].second == m_Dimensions[1])
+        {
+        m_OverviewIndex = static_cast<int>(iOverview);
+        break;
+        }
+      }
+    }
+
   otbMsgDevMacro(<< "Number of Overviews inside input file: " << m_NumberOfOverviews);
+  otbMsgDevMacro(<< "Overview matching resolution factor: " << m_OverviewIndex);
   otbMsgDevMacro(<< "Input file dimension: " << m_Dimensions[0] << ", " << m_Dimensions[1]);
   otbMsgDevMacro(<< "Number of bands inside input file: " << m_NbBands);
 
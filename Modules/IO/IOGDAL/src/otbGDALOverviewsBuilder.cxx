@@ -43,7 +43,8 @@ extern "C"
   {
     otb::GDALOverviewsBuilder* _this = (otb::GDALOverviewsBuilder*)pProgressArg;
     _this->UpdateProgress(dfComplete);
-    return 1;
+    // Returning FALSE makes GDAL cancel the overviews generation
+    return _this->GetAbortGenerateData() ? 0 : 1;
   }
 }
 
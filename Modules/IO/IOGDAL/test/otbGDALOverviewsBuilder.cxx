@@ -22,6 +22,8 @@
 #include "otbGDALDriverManagerWrapper.h"
 #include "otbGDALImageIO.h"
 #include "otbStandardOneLineFilterWatcher.h"
+#include "otbImageFileReader.h"
+#include "otbVectorImage.h"
 
 using namespace otb;
 
@@ -74,5 +76,56 @@ int otbGDALOverviewsBuilder(int itkNotUsed(argc), char* argv[])
     return EXIT_FAILURE;
     }
 
+  if (nbResolution < 2)
+    {
+    return EXIT_SUCCESS;
+    }
+
+  // The first resolution level must be read from the first overview
+  typedef otb::VectorImage<double, 2> ImageType;
+  typedef otb::ImageFileReader<ImageType> ReaderType;
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(filename + "?&resol=1");
+  reader->Update();
+
+  GDALDatasetWrapper::Pointer dataset = GDALDriverManagerWrapper::GetInstance().Open(filename);
+  const ImageType * image = reader->GetOutput();
+  const ImageType::SizeType size = image->GetLargestPossibleRegion().GetSize();
+  const unsigned int nbBands = image->GetNumberOfComponentsPerPixel();
+
+  std::vector<double> overview(size[0] * size[1]);
+
+  for (unsigned int band = 0; band < nbBands; ++band)
+    {
+    GDALRasterBand * ovrBand = dataset->GetDataSet()->GetRasterBand(band + 1)->GetOverview(0);
+
+    if (static_cast<unsigned int>(ovrBand->GetXSize()) != size[0]
+        || static_cast<unsigned int>(ovrBand->GetYSize()) != size[1])
+      {
+      std::cout << "Resolution 1 size " << size << " does not match overview size "
+                << ovrBand->GetXSize() << "x" << ovrBand->GetYSize() << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    if (ovrBand->RasterIO(GF_Read, 0, 0, size[0], size[1], &overview[0],
+                          size[0], size[1], GDT_Float64, 0, 0) == CE_Failure)
+      {
+      std::cout << "Failed to read overview of band " << band + 1 << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    const double * buffer = image->GetBufferPointer();
+
+    for (unsigned int i = 0; i < overview.size(); ++i)
+      {
+      if (buffer[i * nbBands + band] != overview[i])
+        {
+        std::cout << "Pixel " << i << " of band " << band + 1 << " is " << buffer[i * nbBands + band]
+                  << ", expected overview value " << overview[i] << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
   return EXIT_SUCCESS;
 }
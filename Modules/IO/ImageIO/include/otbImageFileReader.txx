@@ -182,6 +182,22 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>
   typedef otb::DefaultConvertPixelTraits<typename TOutputImage::IOPixelType> ConvertIOPixelTraits;
   typedef otb::DefaultConvertPixelTraits<typename TOutputImage::PixelType>   ConvertOutputPixelTraits;
 
+  // First let the ImageIO fill the output buffer by itself, including the
+  // band selection and the pixel conversion, if it supports it
+  unsigned int nbOutputComponents = 1;
+  if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+    {
+    nbOutputComponents = output->GetNumberOfComponentsPerPixel();
+    }
+
+  if (this->m_ImageIO->ReadDirect(buffer,
+                                  typeid(typename TOutputImage::InternalPixelType),
+                                  nbOutputComponents,
+                                  m_BandList))
+    {
+    return;
+    }
+
   if (this->m_ImageIO->GetComponentTypeInfo()
       == typeid(typename ConvertOutputPixelTraits::ComponentType)
       && (this->m_ImageIO->GetNumberOfComponents()
@@ -25,6 +25,10 @@
 #include "itkProcessObject.h"
 #include "otbStreamingManager.h"
 #include "otbExtendedFilenameToWriterOptions.h"
+#include "itkMultiThreader.h"
+#include "itkMutexLock.h"
+#include "itkConditionVariable.h"
+#include <deque>
 
 namespace otb
 {
@@ -46,6 +50,15 @@ namespace otb
  * ImageFileWriter will write directly the streaming buffer in the image file, so
  * that the output image never needs to be completely allocated
  *
+ * When a number of pipelined divisions is set (either with
+ * SetNumberOfPipelinedDivisions() or with the &streaming:pipeline=N
+ * extended filename option), the writing of each division is delegated
+ * to a dedicated I/O thread: division k+1 is computed by the upstream
+ * pipeline while division k is encoded and written to disk. At most N
+ * computed divisions wait in the queue, and their memory footprint is
+ * reported to the streaming manager so that the number of divisions still
+ * fits the available RAM.
+ *
  * ImageFileWriter supports extended filenames, which allow controlling
  * some properties of the output file. See
  * http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName for more
@@ -159,6 +172,20 @@ public:
    *   is set from the CMake configuration option */
   void SetAutomaticAdaptativeStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /**  Set the streaming mode to 'aligned' and configure the number of MB
+   *   available. Like the 'adaptative' mode, divisions match the input
+   *   file tile scheme, but the padding required by neighborhood filters
+   *   is estimated and accounted for, and divisions are rows of tiles.
+   *   Setting the availableRAM parameter to 0 means that the available RAM
+   *   is set from the CMake configuration option */
+  void SetAutomaticTileAlignedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
+  /** Set the maximum number of computed divisions waiting to be written
+   *  by the I/O thread. 0 (the default) disables pipelined writing: each
+   *  division is written before the next one is computed. */
+  itkSetMacro(NumberOfPipelinedDivisions, unsigned int);
+  itkGetConstMacro(NumberOfPipelinedDivisions, unsigned int);
+
   /** Set the only input of the writer */
   using Superclass::SetInput;
   virtual void SetInput(const InputImageType *input);
@@ -232,6 +259,38 @@ private:
     this->UpdateProgress( (m_DivisionProgress + m_CurrentDivision) / m_NumberOfDivisions );
   }
 
+  /** Set pixel type and number of components of the ImageIO from the input */
+  void ConfigureImageIOPixelType(const InputImageType * input);
+
+  /** Write the geom file if requested */
+  void WriteGeomFileIfNeeded();
+
+  /** A computed division waiting to be written */
+  struct PipelinedDivisionType
+  {
+    itk::ImageIORegion ioRegion;
+    InputImagePointer  buffer;
+  };
+
+  /** Start the I/O thread used in pipelined mode */
+  void StartPipelinedWriting();
+
+  /** Copy the current division out of the pipeline and queue it for
+   *  writing. Blocks while the queue is full. */
+  void EnqueueDivision(const InputImageRegionType & streamRegion);
+
+  /** Wait for the queued divisions to be written and stop the I/O thread.
+   *  Rethrows any error raised while writing. */
+  void StopPipelinedWriting();
+
+  /** Write one queued division (called from the I/O thread) */
+  void WriteDivision(PipelinedDivisionType & division);
+
+  /** Body of the I/O thread */
+  void PipelinedWriteLoop();
+
+  static ITK_THREAD_RETURN_TYPE PipelinedWriteThreadCallback(void * arg);
+
   unsigned int m_NumberOfDivisions;
   unsigned int m_CurrentDivision;
   float m_DivisionProgress;
@@ -270,6 +329,19 @@ private:
    *  This variable can be the number of components in m_ImageIO or the
    *  number of components in the m_BandList (if used) */
   unsigned int m_IOComponents;
+
+  /** Pipelined writing */
+  unsigned int                          m_NumberOfPipelinedDivisions;
+  bool                                  m_UsePipelinedWriting;
+  std::deque<PipelinedDivisionType>     m_PipelineQueue;
+  itk::SimpleMutexLock                  m_PipelineLock;
+  itk::ConditionVariable::Pointer       m_PipelineNotEmpty;
+  itk::ConditionVariable::Pointer       m_PipelineNotFull;
+  bool                                  m_PipelineInputDone;
+  bool                                  m_PipelineFailed;
+  std::string                           m_PipelineErrorMessage;
+  itk::MultiThreader::Pointer           m_PipelineThreader;
+  itk::ThreadIdType                     m_PipelineThreadId;
 };
 
 } // end namespace otb
@@ -44,6 +44,7 @@
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbRAMDrivenTileAlignedStreamingManager.h"
 
 #include "otb_boost_tokenizer_header.h"
 
@@ -70,7 +71,12 @@ ImageFileWriter<TInputImage>
     m_FilenameHelper(),
     m_IsObserving(true),
     m_ObserverID(0),
-    m_IOComponents(0)
+    m_IOComponents(0),
+    m_NumberOfPipelinedDivisions(0),
+    m_UsePipelinedWriting(false),
+    m_PipelineInputDone(false),
+    m_PipelineFailed(false),
+    m_PipelineThreadId(0)
 {
   //Init output index shift
   m_ShiftOutputIndex.Fill(0);
@@ -80,6 +86,10 @@ ImageFileWriter<TInputImage>
   this->SetAutomaticAdaptativeStreaming();
 
   m_FilenameHelper = FNameHelperType::New();
+
+  m_PipelineNotEmpty = itk::ConditionVariable::New();
+  m_PipelineNotFull = itk::ConditionVariable::New();
+  m_PipelineThreader = itk::MultiThreader::New();
 }
 
 /**
@@ -176,6 +186,18 @@ ImageFileWriter<TInputImage>
   m_StreamingManager = streamingManager;
 }
 
+template <class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::SetAutomaticTileAlignedStreaming(unsigned int availableRAM, double bias)
+{
+  typedef RAMDrivenTileAlignedStreamingManager<TInputImage> RAMDrivenTileAlignedStreamingManagerType;
+  typename RAMDrivenTileAlignedStreamingManagerType::Pointer streamingManager = RAMDrivenTileAlignedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+  m_StreamingManager = streamingManager;
+}
+
 #ifndef ITK_LEGACY_REMOVE
 
 #endif // ITK_LEGACY_REMOVE
@@ -230,6 +252,8 @@ ImageFileWriter<TInputImage>
     {
     os << indent << "FactorySpecifiedmageIO: Off\n";
     }
+
+  os << indent << "NumberOfPipelinedDivisions: " << m_NumberOfPipelinedDivisions << "\n";
 }
 
 //---------------------------------------------------------
@@ -319,6 +343,18 @@ ImageFileWriter<TInputImage>
         }
       this->SetAutomaticAdaptativeStreaming(sizevalue);
       }
+    else if(type == "aligned")
+      {
+      if(sizemode != "auto")
+        {
+        itkWarningMacro(<<"In aligned streaming type, the sizemode option will be ignored.");
+        }
+      if(sizevalue == 0.)
+        {
+        itkWarningMacro("sizemode is auto but sizevalue is 0. Value will be fetched from the OTB_MAX_RAM_HINT environment variable if set, or else use the default value");
+        }
+      this->SetAutomaticTileAlignedStreaming(sizevalue);
+      }
     else if(type == "tiled")
       {
       if(sizemode == "auto")
@@ -393,6 +429,11 @@ ImageFileWriter<TInputImage>
       }
     }
 
+  if(m_FilenameHelper->StreamingPipelineIsSet())
+    {
+    this->SetNumberOfPipelinedDivisions(m_FilenameHelper->GetStreamingPipeline());
+    }
+
   this->SetAbortGenerateData(0);
   this->SetProgress(0.0);
 
@@ -540,10 +581,18 @@ ImageFileWriter<TInputImage>
     otbMsgDevMacro(<< "Buffered region is the largest possible region, there is no need for streaming.");
     this->SetNumberOfDivisionsStrippedStreaming(1);
     }
+
+  // In pipelined mode, the queued divisions plus the one being written
+  // are kept in memory next to the pipeline
+  m_StreamingManager->SetNumberOfBufferedDivisions(
+    m_NumberOfPipelinedDivisions > 0 ? m_NumberOfPipelinedDivisions + 1 : 0);
   m_StreamingManager->PrepareStreaming(inputPtr, inputRegion);
   m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
   otbMsgDebugMacro(<< "Number Of Stream Divisions : " << m_NumberOfDivisions);
 
+  // Pipelining is pointless without streaming
+  m_UsePipelinedWriting = (m_NumberOfPipelinedDivisions > 0 && m_NumberOfDivisions > 1);
+
   /**
    * Loop over the number of pieces, execute the upstream pipeline on each
    * piece, and copy the results into the output image.
@@ -611,30 +660,78 @@ ImageFileWriter<TInputImage>
     itkWarningMacro(<< "Could not get the source process object. Progress report might be buggy");
     }
 
-  for (m_CurrentDivision = 0;
-       m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
-       m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
+  if (m_UsePipelinedWriting)
+    {
+    this->ConfigureImageIOPixelType(inputPtr);
+    this->StartPipelinedWriting();
+    }
+
+  try
     {
-    streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+    for (m_CurrentDivision = 0;
+         m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
+         m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
+      {
+      streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
 
-    inputPtr->SetRequestedRegion(streamRegion);
-    inputPtr->PropagateRequestedRegion();
-    inputPtr->UpdateOutputData();
+      inputPtr->SetRequestedRegion(streamRegion);
+      inputPtr->PropagateRequestedRegion();
+      inputPtr->UpdateOutputData();
+
+      // Write the whole image
+      itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
+      for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+        {
+        ioRegion.SetSize(i, streamRegion.GetSize(i));
+        ioRegion.SetIndex(i, streamRegion.GetIndex(i));
+        //Set the ioRegion index using the shifted index ( (0,0 without box parameter))
+        ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
+        }
+      this->SetIORegion(ioRegion);
+
+      if (m_UsePipelinedWriting)
+        {
+        // Hand the division over to the I/O thread
+        this->EnqueueDivision(streamRegion);
+        }
+      else
+        {
+        m_ImageIO->SetIORegion(m_IORegion);
 
-    // Write the whole image
-    itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
-    for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+        // Start writing stream region in the image file
+        this->GenerateData();
+        }
+      }
+    }
+  catch (...)
+    {
+    if (m_UsePipelinedWriting)
       {
-      ioRegion.SetSize(i, streamRegion.GetSize(i));
-      ioRegion.SetIndex(i, streamRegion.GetIndex(i));
-      //Set the ioRegion index using the shifted index ( (0,0 without box parameter))
-      ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
+      // Make sure the I/O thread is not left running, then report the
+      // original error
+      m_PipelineLock.Lock();
+      m_PipelineQueue.clear();
+      m_PipelineLock.Unlock();
+      try
+        {
+        this->StopPipelinedWriting();
+        }
+      catch (...)
+        {
+        }
       }
-    this->SetIORegion(ioRegion);
-    m_ImageIO->SetIORegion(m_IORegion);
+    if (m_IsObserving)
+      {
+      m_IsObserving = false;
+      source->RemoveObserver(m_ObserverID);
+      }
+    throw;
+    }
 
-    // Start writing stream region in the image file
-    this->GenerateData();
+  if (m_UsePipelinedWriting)
+    {
+    this->StopPipelinedWriting();
+    this->WriteGeomFileIfNeeded();
     }
 
   /**
@@ -687,36 +784,7 @@ ImageFileWriter<TInputImage>
   const InputImageType * input = this->GetInput();
   InputImagePointer cacheImage;
 
-  // Make sure that the image is the right type and no more than
-  // four components.
-  typedef typename InputImageType::PixelType ImagePixelType;
-
-  if (strcmp(input->GetNameOfClass(), "VectorImage") == 0)
-    {
-    typedef typename InputImageType::InternalPixelType VectorImagePixelType;
-    m_ImageIO->SetPixelTypeInfo(typeid(VectorImagePixelType));
-
-    typedef typename InputImageType::AccessorFunctorType AccessorFunctorType;
-    m_ImageIO->SetNumberOfComponents(AccessorFunctorType::GetVectorLength(input));
-
-    m_IOComponents = m_ImageIO->GetNumberOfComponents();
-    m_BandList.clear();
-    if (m_FilenameHelper->BandRangeIsSet())
-      {
-      // get band range
-      bool retBandRange = m_FilenameHelper->ResolveBandRange(m_FilenameHelper->GetBandRange(), m_IOComponents, m_BandList);
-      if (retBandRange == false || m_BandList.empty())
-        {
-        // invalid range
-        itkGenericExceptionMacro("The given band range is either empty or invalid for a " << m_IOComponents <<" bands input image!");
-        }
-      }
-    }
-  else
-    {
-    // Set the pixel and component type; the number of components.
-    m_ImageIO->SetPixelTypeInfo(typeid(ImagePixelType));
-    }
+  this->ConfigureImageIOPixelType(input);
 
   // Setup the image IO for writing.
   //
@@ -803,6 +871,51 @@ ImageFileWriter<TInputImage>
 
   m_ImageIO->Write(dataPtr);
 
+  this->WriteGeomFileIfNeeded();
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::ConfigureImageIOPixelType(const InputImageType * input)
+{
+  // Make sure that the image is the right type and no more than
+  // four components.
+  typedef typename InputImageType::PixelType ImagePixelType;
+
+  if (strcmp(input->GetNameOfClass(), "VectorImage") == 0)
+    {
+    typedef typename InputImageType::InternalPixelType VectorImagePixelType;
+    m_ImageIO->SetPixelTypeInfo(typeid(VectorImagePixelType));
+
+    typedef typename InputImageType::AccessorFunctorType AccessorFunctorType;
+    m_ImageIO->SetNumberOfComponents(AccessorFunctorType::GetVectorLength(input));
+
+    m_IOComponents = m_ImageIO->GetNumberOfComponents();
+    m_BandList.clear();
+    if (m_FilenameHelper->BandRangeIsSet())
+      {
+      // get band range
+      bool retBandRange = m_FilenameHelper->ResolveBandRange(m_FilenameHelper->GetBandRange(), m_IOComponents, m_BandList);
+      if (retBandRange == false || m_BandList.empty())
+        {
+        // invalid range
+        itkGenericExceptionMacro("The given band range is either empty or invalid for a " << m_IOComponents <<" bands input image!");
+        }
+      }
+    }
+  else
+    {
+    // Set the pixel and component type; the number of components.
+    m_ImageIO->SetPixelTypeInfo(typeid(ImagePixelType));
+    }
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::WriteGeomFileIfNeeded()
+{
   if (m_WriteGeomFile  || m_FilenameHelper->GetWriteGEOMFile())
     {
     ImageKeywordlist otb_kwl;
@@ -812,6 +925,192 @@ ImageFileWriter<TInputImage>
     }
 }
 
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::StartPipelinedWriting()
+{
+  m_PipelineQueue.clear();
+  m_PipelineInputDone = false;
+  m_PipelineFailed = false;
+  m_PipelineErrorMessage = "";
+
+  m_PipelineThreadId = m_PipelineThreader->SpawnThread(&Self::PipelinedWriteThreadCallback, this);
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::EnqueueDivision(const InputImageRegionType & streamRegion)
+{
+  const InputImageType * input = this->GetInput();
+
+  // The upstream buffer will be reused by the next division: copy the
+  // division into a buffer owned by the queue
+  const bool extendComponents = m_FilenameHelper->BandRangeIsSet()
+    && (m_IOComponents < m_BandList.size());
+
+  PipelinedDivisionType division;
+  division.ioRegion = m_IORegion;
+  division.buffer = InputImageType::New();
+  division.buffer->CopyInformation(input);
+
+  // Leave enough room for the band remapping done before writing
+  if (extendComponents)
+    {
+    division.buffer->SetNumberOfComponentsPerPixel(m_BandList.size());
+    }
+
+  division.buffer->SetBufferedRegion(streamRegion);
+  division.buffer->Allocate();
+
+  if (extendComponents)
+    {
+    division.buffer->SetNumberOfComponentsPerPixel(m_IOComponents);
+    }
+
+  typedef itk::ImageRegionConstIterator<TInputImage> ConstIteratorType;
+  typedef itk::ImageRegionIterator<TInputImage>      IteratorType;
+
+  ConstIteratorType in(input, streamRegion);
+  IteratorType out(division.buffer, streamRegion);
+
+  for (in.GoToBegin(), out.GoToBegin(); !in.IsAtEnd(); ++in, ++out)
+    {
+    out.Set(in.Get());
+    }
+
+  m_PipelineLock.Lock();
+  while (m_PipelineQueue.size() >= m_NumberOfPipelinedDivisions && !m_PipelineFailed)
+    {
+    m_PipelineNotFull->Wait(&m_PipelineLock);
+    }
+  const bool failed = m_PipelineFailed;
+  if (!failed)
+    {
+    m_PipelineQueue.push_back(division);
+    }
+  m_PipelineLock.Unlock();
+
+  if (failed)
+    {
+    // The error is reported by StopPipelinedWriting()
+    this->StopPipelinedWriting();
+    }
+
+  m_PipelineNotEmpty->Signal();
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::StopPipelinedWriting()
+{
+  m_PipelineLock.Lock();
+  const bool alreadyStopped = m_PipelineInputDone;
+  m_PipelineInputDone = true;
+  m_PipelineLock.Unlock();
+
+  if (!alreadyStopped)
+    {
+    m_PipelineNotEmpty->Signal();
+    m_PipelineThreader->TerminateThread(m_PipelineThreadId);
+    }
+
+  if (m_PipelineFailed)
+    {
+    itk::ImageFileWriterException e(__FILE__, __LINE__);
+    std::ostringstream msg;
+    msg << "Pipelined writing of " << m_FileName << " failed: " << m_PipelineErrorMessage;
+    e.SetDescription(msg.str().c_str());
+    e.SetLocation(ITK_LOCATION);
+    throw e;
+    }
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::WriteDivision(PipelinedDivisionType & division)
+{
+  void * dataPtr = division.buffer->GetBufferPointer();
+
+  m_ImageIO->SetIORegion(division.ioRegion);
+
+  if (m_FilenameHelper->BandRangeIsSet() && (!m_BandList.empty()))
+    {
+    m_ImageIO->SetNumberOfComponents(m_IOComponents);
+    m_ImageIO->DoMapBuffer(dataPtr, division.buffer->GetBufferedRegion().GetNumberOfPixels(), this->m_BandList);
+    m_ImageIO->SetNumberOfComponents(m_BandList.size());
+    }
+
+  m_ImageIO->Write(dataPtr);
+}
+
+template<class TInputImage>
+void
+ImageFileWriter<TInputImage>
+::PipelinedWriteLoop()
+{
+  while (true)
+    {
+    m_PipelineLock.Lock();
+    while (m_PipelineQueue.empty() && !m_PipelineInputDone)
+      {
+      m_PipelineNotEmpty->Wait(&m_PipelineLock);
+      }
+    if (m_PipelineQueue.empty())
+      {
+      // Input is done and everything has been written
+      m_PipelineLock.Unlock();
+      return;
+      }
+    PipelinedDivisionType division = m_PipelineQueue.front();
+    m_PipelineQueue.pop_front();
+    m_PipelineLock.Unlock();
+
+    // Room has been made in the queue
+    m_PipelineNotFull->Signal();
+
+    try
+      {
+      this->WriteDivision(division);
+      }
+    catch (itk::ExceptionObject & err)
+      {
+      m_PipelineLock.Lock();
+      m_PipelineFailed = true;
+      m_PipelineErrorMessage = err.GetDescription();
+      m_PipelineQueue.clear();
+      m_PipelineLock.Unlock();
+      m_PipelineNotFull->Broadcast();
+      return;
+      }
+    catch (std::exception & err)
+      {
+      m_PipelineLock.Lock();
+      m_PipelineFailed = true;
+      m_PipelineErrorMessage = err.what();
+      m_PipelineQueue.clear();
+      m_PipelineLock.Unlock();
+      m_PipelineNotFull->Broadcast();
+      return;
+      }
+    }
+}
+
+template<class TInputImage>
+ITK_THREAD_RETURN_TYPE
+ImageFileWriter<TInputImage>
+::PipelinedWriteThreadCallback(void * arg)
+{
+  typedef itk::MultiThreader::ThreadInfoStruct ThreadInfoType;
+  ThreadInfoType * threadInfo = static_cast<ThreadInfoType *>(arg);
+  Self * writer = static_cast<Self *>(threadInfo->UserData);
+  writer->PipelinedWriteLoop();
+  return ITK_THREAD_RETURN_VALUE;
+}
+
 template <class TInputImage>
 void
 ImageFileWriter<TInputImage>
@@ -34,7 +34,7 @@
 #include "otbImageFileWriter.h"
 #include "otbVectorRescaleIntensityImageFilter.h"
 #include "otbGenericRSTransform.h"
-#include "otbStreamingShrinkImageFilter.h"
+#include "otbStreamingMultiShrinkImageFilter.h"
 #include "itkCastImageFilter.h"
 
 // Possibility to includes vectordatas necessary includes
@@ -104,7 +104,7 @@ public:
   typedef ImageFileWriter< VectorImage<OutputPixelType> >             VectorWriterType;
 
   // Resampler
-  typedef StreamingShrinkImageFilter<InputImageType, InputImageType > StreamingShrinkImageFilterType;
+  typedef StreamingMultiShrinkImageFilter<InputImageType, InputImageType > StreamingMultiShrinkImageFilterType;
 
   // Intensity Rescale
   typedef VectorRescaleIntensityImageFilter<InputImageType,
@@ -271,7 +271,7 @@ private:
   typename VectorWriterType::Pointer                m_VectorWriter;
 
   // Resampler
-  typename StreamingShrinkImageFilterType::Pointer m_StreamingShrinkImageFilter;
+  typename StreamingMultiShrinkImageFilterType::Pointer m_StreamingMultiShrinkImageFilter;
 
   // Rescale intensity
   typename VectorRescaleIntensityImageFilterType::Pointer m_VectorRescaleIntensityImageFilter;
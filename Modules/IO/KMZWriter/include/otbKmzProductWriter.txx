@@ -306,6 +306,22 @@ KmzProductWriter<TInputImage>
   SizeType  extractSize;
   IndexType extractIndex;
 
+  // Resample the image to all the depths in a single pass over the input
+  typename StreamingMultiShrinkImageFilterType::ShrinkFactorsType shrinkFactors;
+  for (unsigned int depth = 0; depth < maxDepth; depth++)
+    {
+    shrinkFactors.push_back(1 << (maxDepth - depth));
+    }
+
+  m_StreamingMultiShrinkImageFilter = StreamingMultiShrinkImageFilterType::New();
+  if (!shrinkFactors.empty())
+    {
+    m_StreamingMultiShrinkImageFilter->SetShrinkFactors(shrinkFactors);
+    m_StreamingMultiShrinkImageFilter->SetInput(m_VectorImage);
+    m_StreamingMultiShrinkImageFilter->GetStreamer()->SetAutomaticStrippedStreaming(0);
+    m_StreamingMultiShrinkImageFilter->Update();
+    }
+
   for (unsigned int depth = 0; depth <= maxDepth; depth++)
     {
     // update the attribute value Current Depth
@@ -316,15 +332,8 @@ KmzProductWriter<TInputImage>
 
     if (sampleRatioValue > 1)
       {
-      m_StreamingShrinkImageFilter = StreamingShrinkImageFilterType::New();
-
-      m_StreamingShrinkImageFilter->SetShrinkFactor(sampleRatioValue);
-      m_StreamingShrinkImageFilter->SetInput(m_VectorImage);
-      m_StreamingShrinkImageFilter->GetStreamer()->SetAutomaticStrippedStreaming(0);
-      m_StreamingShrinkImageFilter->Update();
-
       m_VectorRescaleIntensityImageFilter = VectorRescaleIntensityImageFilterType::New();
-      m_VectorRescaleIntensityImageFilter->SetInput(m_StreamingShrinkImageFilter->GetOutput());
+      m_VectorRescaleIntensityImageFilter->SetInput(m_StreamingMultiShrinkImageFilter->GetShrunkOutput(depth));
       m_VectorRescaleIntensityImageFilter->SetOutputMinimum(outMin);
       m_VectorRescaleIntensityImageFilter->SetOutputMaximum(outMax);
 
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbContiguousSampleStore_h
+#define otbContiguousSampleStore_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkListSample.h"
+#include "itkVariableLengthVector.h"
+#include "itkFixedArray.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#pragma GCC diagnostic pop
+#else
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#endif
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class ContiguousSampleStore
+ * \brief Training samples stored in a single row-major matrix with a label
+ * column
+ *
+ * The features of all the samples are stored contiguously, sample after
+ * sample, and the labels in a separate array. Appending a sample does not
+ * allocate memory per sample, and the models can read the matrix directly.
+ *
+ * A store can be filled in memory with PushBack(), or loaded from a file
+ * written by Save() or by ContiguousSampleStoreWriter. Loaded files are
+ * memory-mapped, so that the samples are paged in by the system when read
+ * and stores larger than the available memory can be used. The mapping is
+ * copy-on-write: samples can be modified in place (for instance to
+ * normalize them) without modifying the file.
+ *
+ * File layout: a 32 bytes header ("OTBSTORE", format version, number of
+ * features, size of a feature value, size of a label, number of samples),
+ * the feature matrix, then the labels, starting on an 8 bytes boundary.
+ *
+ * \sa ContiguousSampleStoreWriter
+ *
+ * \ingroup OTBLearningBase
+ */
+template <class TInputValue, class TTargetValue>
+class ITK_EXPORT ContiguousSampleStore : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef ContiguousSampleStore         Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ContiguousSampleStore, itk::Object);
+
+  typedef TInputValue                                           InputValueType;
+  typedef TTargetValue                                          TargetValueType;
+  typedef unsigned long long                                    SizeType;
+  typedef itk::VariableLengthVector<InputValueType>             InputSampleType;
+  typedef itk::Statistics::ListSample<InputSampleType>          InputListSampleType;
+  typedef itk::FixedArray<TargetValueType, 1>                   TargetSampleType;
+  typedef itk::Statistics::ListSample<TargetSampleType>         TargetListSampleType;
+
+  /** Size of the file header */
+  static const SizeType HeaderSize = 32;
+
+  /** Version of the file format */
+  static const unsigned int FormatVersion = 1;
+
+  /** Empty the store and set the number of features of the samples */
+  void Initialize(unsigned int nbFeatures);
+
+  /** Reserve memory for nbSamples samples */
+  void Reserve(SizeType nbSamples);
+
+  /** Append a sample with the given label, and return a pointer to its
+   * features, to be filled by the caller */
+  InputValueType * PushBack(TargetValueType label);
+
+  /** Append a sample */
+  void PushBack(const InputValueType * sample, TargetValueType label);
+
+  /** Number of samples */
+  SizeType Size() const
+  {
+    return m_Size;
+  }
+
+  unsigned int GetNumberOfFeatures() const
+  {
+    return m_NumberOfFeatures;
+  }
+
+  /** Features of a sample */
+  const InputValueType * GetSample(SizeType id) const
+  {
+    return m_Samples + id * m_NumberOfFeatures;
+  }
+
+  InputValueType * GetSample(SizeType id)
+  {
+    return m_Samples + id * m_NumberOfFeatures;
+  }
+
+  TargetValueType GetLabel(SizeType id) const
+  {
+    return m_Labels[id];
+  }
+
+  /** Row-major matrix of the features of all the samples */
+  const InputValueType * GetSamples() const
+  {
+    return m_Samples;
+  }
+
+  /** Labels of all the samples */
+  const TargetValueType * GetLabels() const
+  {
+    return m_Labels;
+  }
+
+  /** Is the store mapped from a file */
+  bool IsMapped() const
+  {
+    return m_Region.get_address() != ITK_NULLPTR;
+  }
+
+  /** Write the store to a file */
+  void Save(const std::string & filename) const;
+
+  /** Map a store file */
+  void Load(const std::string & filename);
+
+  /** Fill a target list sample with the labels. Labels are fixed size
+   * measurements, so this does not allocate memory per sample. */
+  void ExportLabels(TargetListSampleType * labels) const;
+
+  /** Fill an input list sample with the features (one allocation per
+   * sample), for the code which can only read list samples */
+  void ExportSamples(InputListSampleType * samples) const;
+
+  /** Fill a header of HeaderSize bytes */
+  static void EncodeHeader(char * header, unsigned int nbFeatures, SizeType nbSamples);
+
+  /** Offset of the labels in a store file */
+  static SizeType GetLabelsOffset(unsigned int nbFeatures, SizeType nbSamples);
+
+protected:
+  ContiguousSampleStore();
+  ~ContiguousSampleStore() ITK_OVERRIDE {}
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  ContiguousSampleStore(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  /** Release the mapping or the memory buffers */
+  void Release();
+
+  unsigned int m_NumberOfFeatures;
+  SizeType     m_Size;
+
+  /** Pointers on the memory buffers, or on the mapped file */
+  InputValueType  * m_Samples;
+  TargetValueType * m_Labels;
+
+  std::vector<InputValueType>  m_SampleBuffer;
+  std::vector<TargetValueType> m_LabelBuffer;
+
+  boost::interprocess::file_mapping  m_FileMapping;
+  boost::interprocess::mapped_region m_Region;
+};
+
+/** \class ContiguousSampleStoreWriter
+ * \brief Write a ContiguousSampleStore file sample by sample
+ *
+ * The features are written to the file as they come, so that stores larger
+ * than the available memory can be produced. Only the labels are kept in
+ * memory until Close().
+ *
+ * \sa ContiguousSampleStore
+ *
+ * \ingroup OTBLearningBase
+ */
+template <class TInputValue, class TTargetValue>
+class ITK_EXPORT ContiguousSampleStoreWriter : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef ContiguousSampleStoreWriter   Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ContiguousSampleStoreWriter, itk::Object);
+
+  typedef ContiguousSampleStore<TInputValue, TTargetValue> StoreType;
+  typedef typename StoreType::InputValueType               InputValueType;
+  typedef typename StoreType::TargetValueType              TargetValueType;
+  typedef typename StoreType::SizeType                     SizeType;
+
+  /** Create the file */
+  void Open(const std::string & filename, unsigned int nbFeatures);
+
+  /** Append a sample */
+  void Write(const InputValueType * sample, TargetValueType label);
+
+  /** Write the labels and the final header */
+  void Close();
+
+  SizeType GetNumberOfSamples() const
+  {
+    return m_Labels.size();
+  }
+
+protected:
+  ContiguousSampleStoreWriter();
+  ~ContiguousSampleStoreWriter() ITK_OVERRIDE;
+
+private:
+  ContiguousSampleStoreWriter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  std::string   m_FileName;
+  std::ofstream m_File;
+  unsigned int  m_NumberOfFeatures;
+
+  std::vector<TargetValueType> m_Labels;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbContiguousSampleStore.txx"
+#endif
+
+#endif
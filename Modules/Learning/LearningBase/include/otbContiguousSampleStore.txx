@@ -0,0 +1,374 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbContiguousSampleStore_txx
+#define otbContiguousSampleStore_txx
+
+#include "otbContiguousSampleStore.h"
+#include "itkIntTypes.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace otb
+{
+
+template <class TInputValue, class TTargetValue>
+ContiguousSampleStore<TInputValue, TTargetValue>
+::ContiguousSampleStore()
+  : m_NumberOfFeatures(0),
+    m_Size(0),
+    m_Samples(ITK_NULLPTR),
+    m_Labels(ITK_NULLPTR)
+{
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStore<TInputValue, TTargetValue>
+::Release()
+{
+  boost::interprocess::mapped_region region;
+  m_Region.swap(region);
+  boost::interprocess::file_mapping mapping;
+  m_FileMapping.swap(mapping);
+
+  std::vector<InputValueType>().swap(m_SampleBuffer);
+  std::vector<TargetValueType>().swap(m_LabelBuffer);
+  m_Samples = ITK_NULLPTR;
+  m_Labels = ITK_NULLPTR;
+  m_Size = 0;
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStore<TInputValue, TTargetValue>
+::Initialize(unsigned int nbFeatures)
+{
+  this->Release();
+  m_NumberOfFeatures = nbFeatures;
+  this->Modified();
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStore<TInputValue, TTargetValue>
+::Reserve(SizeType nbSamples)
+{
+  if (this->IsMapped())
+    {
+    itkExceptionMacro(<< "Can not reserve memory in a mapped sample store");
+    }
+  m_SampleBuffer.reserve(nbSamples * m_NumberOfFeatures);
+  m_LabelBuffer.reserve(nbSamples);
+  m_Samples = m_SampleBuffer.empty() ? ITK_NULLPTR : &m_SampleBuffer[0];
+  m_Labels = m_LabelBuffer.empty() ? ITK_NULLPTR : &m_LabelBuffer[0];
+}
+
+template <class TInputValue, class TTargetValue>
+typename ContiguousSampleStore<TInputValue, TTargetValue>::InputValueType *
+ContiguousSampleStore<TInputValue, TTargetValue>
+::PushBack(TargetValueType label)
+{
+  if (this->IsMapped())
+    {
+    itkExceptionMacro(<< "Can not append samples to a mapped sample store");
+    }
+
+  m_SampleBuffer.resize(m_SampleBuffer.size() + m_NumberOfFeatures);
+  m_LabelBuffer.push_back(label);
+  m_Samples = m_SampleBuffer.empty() ? ITK_NULLPTR : &m_SampleBuffer[0];
+  m_Labels = &m_LabelBuffer[0];
+  ++m_Size;
+  return this->GetSample(m_Size - 1);
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStore<TInputValue, TTargetValue>
+::PushBack(const InputValueType * sample, TargetValueType label)
+{
+  InputValueType * newSample = this->PushBack(label);
+  std::copy(sample, sample + m_NumberOfFeatures, newSample);
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStore<TInputValue, TTargetValue>
+::EncodeHeader(char * header, unsigned int nbFeatures, SizeType nbSamples)
+{
+  const itk::uint32_t features = nbFeatures;
+  const itk::uint32_t valueSize = sizeof(InputValueType);
+  const itk::uint32_t labelSize = sizeof(TargetValueType);
+  const itk::uint64_t samples = nbSamples;
+
+  std::memcpy(header, "OTBSTORE", 8);
+  const itk::uint32_t version = FormatVersion;
+  std::memcpy(header + 8, &version, 4);
+  std::memcpy(header + 12, &features, 4);
+  std::memcpy(header + 16, &valueSize, 4);
+  std::memcpy(header + 20, &labelSize, 4);
+  std::memcpy(header + 24, &samples, 8);
+}
+
+template <class TInputValue, class TTargetValue>
+typename ContiguousSampleStore<TInputValue, TTargetValue>::SizeType
+ContiguousSampleStore<TInputValue, TTargetValue>
+::GetLabelsOffset(unsigned int nbFeatures, SizeType nbSamples)
+{
+  const SizeType end = HeaderSize + nbSamples * nbFeatures * sizeof(InputValueType);
+  return (end + 7) / 8 * 8;
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStore<TInputValue, TTargetValue>
+::Save(const std::string & filename) const
+{
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file)
+    {
+    itkExceptionMacro(<< "Can not create the sample store file " << filename);
+    }
+
+  char header[HeaderSize];
+  EncodeHeader(header, m_NumberOfFeatures, m_Size);
+  file.write(header, HeaderSize);
+
+  const SizeType samplesSize = m_Size * m_NumberOfFeatures * sizeof(InputValueType);
+  if (samplesSize > 0)
+    {
+    file.write(reinterpret_cast<const char *>(m_Samples), samplesSize);
+    }
+
+  const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  file.write(padding, GetLabelsOffset(m_NumberOfFeatures, m_Size) - HeaderSize - samplesSize);
+
+  if (m_Size > 0)
+    {
+    file.write(reinterpret_cast<const char *>(m_Labels), m_Size * sizeof(TargetValueType));
+    }
+
+  if (!file)
+    {
+    itkExceptionMacro(<< "Error while writing the sample store file " << filename);
+    }
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStore<TInputValue, TTargetValue>
+::Load(const std::string & filename)
+{
+  this->Release();
+
+  boost::interprocess::file_mapping mapping;
+  boost::interprocess::mapped_region region;
+  try
+    {
+    boost::interprocess::file_mapping fileMapping(filename.c_str(), boost::interprocess::read_only);
+    mapping.swap(fileMapping);
+    // Copy-on-write, so that the samples can be modified in memory only
+    boost::interprocess::mapped_region mappedRegion(mapping, boost::interprocess::copy_on_write);
+    region.swap(mappedRegion);
+    }
+  catch (boost::interprocess::interprocess_exception & err)
+    {
+    itkExceptionMacro(<< "Can not map the sample store file " << filename << ": " << err.what());
+    }
+
+  char * data = static_cast<char *>(region.get_address());
+  const SizeType fileSize = region.get_size();
+
+  itk::uint32_t version = 0;
+  itk::uint32_t features = 0;
+  itk::uint32_t valueSize = 0;
+  itk::uint32_t labelSize = 0;
+  itk::uint64_t samples = 0;
+  if (fileSize < HeaderSize || std::memcmp(data, "OTBSTORE", 8) != 0)
+    {
+    itkExceptionMacro(<< filename << " is not a sample store file");
+    }
+  std::memcpy(&version, data + 8, 4);
+  std::memcpy(&features, data + 12, 4);
+  std::memcpy(&valueSize, data + 16, 4);
+  std::memcpy(&labelSize, data + 20, 4);
+  std::memcpy(&samples, data + 24, 8);
+
+  if (version != FormatVersion || valueSize != sizeof(InputValueType) || labelSize != sizeof(TargetValueType))
+    {
+    itkExceptionMacro(<< "Sample store file " << filename << " has version " << version
+                      << ", features of " << valueSize << " bytes and labels of " << labelSize
+                      << " bytes, expected version " << FormatVersion << ", "
+                      << sizeof(InputValueType) << " and " << sizeof(TargetValueType) << " bytes");
+    }
+
+  const SizeType labelsOffset = GetLabelsOffset(features, samples);
+  if (fileSize < labelsOffset + samples * sizeof(TargetValueType))
+    {
+    itkExceptionMacro(<< "Sample store file " << filename << " is truncated");
+    }
+
+  m_FileMapping.swap(mapping);
+  m_Region.swap(region);
+  m_NumberOfFeatures = features;
+  m_Size = samples;
+  m_Samples = reinterpret_cast<InputValueType *>(data + HeaderSize);
+  m_Labels = reinterpret_cast<TargetValueType *>(data + labelsOffset);
+  this->Modified();
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStore<TInputValue, TTargetValue>
+::ExportLabels(TargetListSampleType * labels) const
+{
+  labels->Clear();
+  labels->SetMeasurementVectorSize(1);
+  labels->Resize(m_Size);
+
+  TargetSampleType label;
+  for (SizeType id = 0; id < m_Size; ++id)
+    {
+    label[0] = m_Labels[id];
+    labels->SetMeasurementVector(id, label);
+    }
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStore<TInputValue, TTargetValue>
+::ExportSamples(InputListSampleType * samples) const
+{
+  samples->Clear();
+  samples->SetMeasurementVectorSize(m_NumberOfFeatures);
+  samples->Resize(m_Size);
+
+  InputSampleType sample(m_NumberOfFeatures);
+  for (SizeType id = 0; id < m_Size; ++id)
+    {
+    std::copy(this->GetSample(id), this->GetSample(id) + m_NumberOfFeatures, sample.GetDataPointer());
+    samples->SetMeasurementVector(id, sample);
+    }
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStore<TInputValue, TTargetValue>
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of samples: " << m_Size << std::endl;
+  os << indent << "Number of features: " << m_NumberOfFeatures << std::endl;
+  os << indent << "Mapped: " << this->IsMapped() << std::endl;
+}
+
+template <class TInputValue, class TTargetValue>
+ContiguousSampleStoreWriter<TInputValue, TTargetValue>
+::ContiguousSampleStoreWriter()
+  : m_NumberOfFeatures(0)
+{
+}
+
+template <class TInputValue, class TTargetValue>
+ContiguousSampleStoreWriter<TInputValue, TTargetValue>
+::~ContiguousSampleStoreWriter()
+{
+  if (m_File.is_open())
+    {
+    try
+      {
+      this->Close();
+      }
+    catch (itk::ExceptionObject &)
+      {
+      }
+    }
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStoreWriter<TInputValue, TTargetValue>
+::Open(const std::string & filename, unsigned int nbFeatures)
+{
+  if (m_File.is_open())
+    {
+    this->Close();
+    }
+
+  m_FileName = filename;
+  m_NumberOfFeatures = nbFeatures;
+  m_Labels.clear();
+
+  m_File.clear();
+  m_File.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_File)
+    {
+    itkExceptionMacro(<< "Can not create the sample store file " << filename);
+    }
+
+  // The number of samples is written by Close()
+  char header[StoreType::HeaderSize];
+  StoreType::EncodeHeader(header, m_NumberOfFeatures, 0);
+  m_File.write(header, StoreType::HeaderSize);
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStoreWriter<TInputValue, TTargetValue>
+::Write(const InputValueType * sample, TargetValueType label)
+{
+  m_File.write(reinterpret_cast<const char *>(sample), m_NumberOfFeatures * sizeof(InputValueType));
+  m_Labels.push_back(label);
+}
+
+template <class TInputValue, class TTargetValue>
+void
+ContiguousSampleStoreWriter<TInputValue, TTargetValue>
+::Close()
+{
+  const SizeType nbSamples = m_Labels.size();
+  const SizeType samplesEnd = StoreType::HeaderSize + nbSamples * m_NumberOfFeatures * sizeof(InputValueType);
+
+  const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  m_File.write(padding, StoreType::GetLabelsOffset(m_NumberOfFeatures, nbSamples) - samplesEnd);
+  if (nbSamples > 0)
+    {
+    m_File.write(reinterpret_cast<const char *>(&m_Labels[0]), nbSamples * sizeof(TargetValueType));
+    }
+
+  char header[StoreType::HeaderSize];
+  StoreType::EncodeHeader(header, m_NumberOfFeatures, nbSamples);
+  m_File.seekp(0);
+  m_File.write(header, StoreType::HeaderSize);
+
+  const bool failed = !m_File;
+  m_File.close();
+  std::vector<TargetValueType>().swap(m_Labels);
+
+  if (failed)
+    {
+    itkExceptionMacro(<< "Error while writing the sample store file " << m_FileName);
+    }
+}
+
+} // end namespace otb
+
+#endif
@@ -24,6 +24,7 @@
 #include "itkObject.h"
 #include "itkListSample.h"
 #include "otbMachineLearningModelTraits.h"
+#include "otbContiguousSampleStore.h"
 
 namespace otb
 {
@@ -94,6 +95,9 @@ public:
   typedef itk::Statistics::ListSample<TargetSampleType>      TargetListSampleType;
   //@}
 
+  /** Contiguous storage of the training samples */
+  typedef ContiguousSampleStore<InputValueType, TargetValueType> SampleStoreType;
+
   /**\name Confidence value typedef */
   typedef typename MLMTargetTraits<TConfidenceValue>::ValueType  ConfidenceValueType;
   typedef typename MLMTargetTraits<TConfidenceValue>::SampleType ConfidenceSampleType;
@@ -165,6 +169,15 @@ public:
   //@}
 
   itkGetObjectMacro(ConfidenceListSample,ConfidenceListSampleType);
+
+  /**\name Contiguous training samples accessors */
+  //@{
+  /** Set the training samples and their labels from a contiguous store. The
+   * models reading the store directly use it instead of the input list
+   * sample, the target list sample is filled with the labels of the store. */
+  void SetInputSampleStore(const SampleStoreType * store);
+  itkGetConstObjectMacro(InputSampleStore,SampleStoreType);
+  //@}
   
   /**\name Use model in regression mode */
   //@{
@@ -189,6 +202,9 @@ protected:
   typename TargetListSampleType::Pointer m_TargetListSample;
 
   typename ConfidenceListSampleType::Pointer m_ConfidenceListSample;
+
+  /** Contiguous training samples */
+  typename SampleStoreType::ConstPointer m_InputSampleStore;
   
   /** flag to choose between classification and regression modes */
   bool m_RegressionMode;
@@ -63,6 +63,22 @@ MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
     }
 }
 
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+void
+MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
+::SetInputSampleStore(const SampleStoreType * store)
+{
+  m_InputSampleStore = store;
+  if (store != ITK_NULLPTR)
+    {
+    // Labels have a fixed size, so their list sample is cheap to build
+    typename TargetListSampleType::Pointer labels = TargetListSampleType::New();
+    store->ExportLabels(labels);
+    m_TargetListSample = labels;
+    }
+  this->Modified();
+}
+
 template <class TInputValue, class TOutputValue, class TConfidenceValue>
 typename MachineLearningModel<TInputValue,TOutputValue,TConfidenceValue>
 ::TargetSampleType
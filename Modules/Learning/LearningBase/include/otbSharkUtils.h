@@ -122,6 +122,118 @@ template <class T> void ListSampleToSharkVector(const T * listSample, std::vecto
   assert(listSample != ITK_NULLPTR);
   ListSampleRangeToSharkVector(listSample,output,0, static_cast<unsigned int>(listSample->Size()));
 }
+
+/** Converts a range of a list sample to shark data. The samples are copied
+ * in the batch matrices of the data, without a vector per sample. */
+template <class T> void ListSampleRangeToSharkData(const T * listSample, shark::Data<shark::RealVector> & output, unsigned int start, unsigned int size)
+{
+  assert(listSample != ITK_NULLPTR);
+
+  if(start+size>listSample->Size())
+    {
+    itkGenericExceptionMacro(<<"Requested range ["<<start<<", "<<start+size<<"[ is out of bound for input list sample (range [0, "<<listSample->Size()<<"[");
+    }
+
+  if(size == 0)
+    {
+    output = shark::Data<shark::RealVector>();
+    return;
+    }
+
+  const unsigned int sampleSize = listSample->GetMeasurementVectorSize();
+  output = shark::Data<shark::RealVector>(size, shark::RealVector(sampleSize));
+
+  unsigned int sampleIdx = start;
+  for (std::size_t batchIdx = 0; batchIdx < output.numberOfBatches(); ++batchIdx)
+    {
+    shark::RealMatrix & batch = output.batch(batchIdx);
+    for (std::size_t row = 0; row < batch.size1(); ++row, ++sampleIdx)
+      {
+      typename T::MeasurementVectorType const & sample = listSample->GetMeasurementVector(sampleIdx);
+      for (unsigned int i = 0; i < sampleSize; ++i)
+        {
+        batch(row,i) = sample[i];
+        }
+      }
+    }
+}
+
+/** Converts a range of a label list sample to shark data, with the same
+ * batches as ListSampleRangeToSharkData() */
+template <class T> void ListSampleRangeToSharkData(const T * listSample, shark::Data<unsigned int> & output, unsigned int start, unsigned int size)
+{
+  assert(listSample != ITK_NULLPTR);
+
+  if(start+size>listSample->Size())
+    {
+    itkGenericExceptionMacro(<<"Requested range ["<<start<<", "<<start+size<<"[ is out of bound for input list sample (range [0, "<<listSample->Size()<<"[");
+    }
+
+  if(size == 0)
+    {
+    output = shark::Data<unsigned int>();
+    return;
+    }
+
+  output = shark::Data<unsigned int>(size, 0U);
+
+  unsigned int sampleIdx = start;
+  for (std::size_t batchIdx = 0; batchIdx < output.numberOfBatches(); ++batchIdx)
+    {
+    shark::Batch<unsigned int>::type & batch = output.batch(batchIdx);
+    for (std::size_t row = 0; row < batch.size(); ++row, ++sampleIdx)
+      {
+      batch(row) = listSample->GetMeasurementVector(sampleIdx)[0];
+      }
+    }
+}
+
+template <class T> void ListSampleToSharkData(const T * listSample, shark::Data<shark::RealVector> & output)
+{
+  assert(listSample != ITK_NULLPTR);
+  ListSampleRangeToSharkData(listSample,output,0U,static_cast<unsigned int>(listSample->Size()));
+}
+
+template <class T> void ListSampleToSharkData(const T * listSample, shark::Data<unsigned int> & output)
+{
+  assert(listSample != ITK_NULLPTR);
+  ListSampleRangeToSharkData(listSample,output,0U,static_cast<unsigned int>(listSample->Size()));
+}
+
+/** Converts the training samples of a model to shark data: the rows of the
+ * contiguous sample store of the model if it is set, its input list sample
+ * otherwise. */
+template <class TModel> void InputSamplesToSharkData(const TModel * model, shark::Data<shark::RealVector> & output)
+{
+  const typename TModel::SampleStoreType * store = model->GetInputSampleStore();
+  if (store == ITK_NULLPTR)
+    {
+    ListSampleToSharkData(model->GetInputListSample(), output);
+    return;
+    }
+
+  if (store->Size() == 0)
+    {
+    output = shark::Data<shark::RealVector>();
+    return;
+    }
+
+  const unsigned int sampleSize = store->GetNumberOfFeatures();
+  output = shark::Data<shark::RealVector>(store->Size(), shark::RealVector(sampleSize));
+
+  const typename TModel::InputValueType * sample = store->GetSamples();
+  for (std::size_t batchIdx = 0; batchIdx < output.numberOfBatches(); ++batchIdx)
+    {
+    shark::RealMatrix & batch = output.batch(batchIdx);
+    for (std::size_t row = 0; row < batch.size1(); ++row, sample += sampleSize)
+      {
+      for (unsigned int i = 0; i < sampleSize; ++i)
+        {
+        batch(row,i) = sample[i];
+        }
+      }
+    }
+}
   
 }
 }
@@ -23,6 +23,7 @@ mainly based on OpenCV.")
 
 otb_module(OTBLearningBase
   DEPENDS
+    OTBBoost
     OTBCommon
     OTBITK
     OTBImageIO
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbContiguousSampleStore.h"
+
+typedef otb::ContiguousSampleStore<float, int>       StoreType;
+typedef otb::ContiguousSampleStoreWriter<float, int> StoreWriterType;
+
+bool CheckStore(const StoreType * store, const float * samples, const int * labels,
+                unsigned int nbSamples, unsigned int nbFeatures)
+{
+  if (store->Size() != nbSamples || store->GetNumberOfFeatures() != nbFeatures)
+    {
+    std::cerr << "Wrong store size: " << store->Size() << " samples of "
+              << store->GetNumberOfFeatures() << " features" << std::endl;
+    return false;
+    }
+  for (unsigned int i = 0; i < nbSamples; ++i)
+    {
+    if (store->GetLabel(i) != labels[i])
+      {
+      std::cerr << "Wrong label for sample " << i << ": " << store->GetLabel(i) << std::endl;
+      return false;
+      }
+    for (unsigned int j = 0; j < nbFeatures; ++j)
+      {
+      if (store->GetSample(i)[j] != samples[i * nbFeatures + j])
+        {
+        std::cerr << "Wrong value for sample " << i << " feature " << j << ": "
+                  << store->GetSample(i)[j] << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+int otbContiguousSampleStore(int itkNotUsed(argc), char * argv[])
+{
+  const std::string savedFile = std::string(argv[1]) + "_saved.store";
+  const std::string writtenFile = std::string(argv[1]) + "_written.store";
+
+  // 3 features, so that the labels need a padding to be aligned
+  const unsigned int nbSamples = 5;
+  const unsigned int nbFeatures = 3;
+  const float samples[nbSamples * nbFeatures] = {
+    0.f, 1.f, 2.f,
+    3.5f, -4.f, 5.f,
+    6.f, 7.f, 8.25f,
+    -9.f, 10.f, 11.f,
+    12.f, 13.f, -14.5f};
+  const int labels[nbSamples] = {1, 2, 1, 3, 2};
+
+  StoreType::Pointer store = StoreType::New();
+  store->Initialize(nbFeatures);
+  for (unsigned int i = 0; i < nbSamples; ++i)
+    {
+    store->PushBack(samples + i * nbFeatures, labels[i]);
+    }
+  if (!CheckStore(store, samples, labels, nbSamples, nbFeatures))
+    {
+    return EXIT_FAILURE;
+    }
+  store->Save(savedFile);
+
+  StoreWriterType::Pointer writer = StoreWriterType::New();
+  writer->Open(writtenFile, nbFeatures);
+  for (unsigned int i = 0; i < nbSamples; ++i)
+    {
+    writer->Write(samples + i * nbFeatures, labels[i]);
+    }
+  writer->Close();
+
+  // Both files are mapped back, and exported to list samples
+  const std::string files[2] = {savedFile, writtenFile};
+  for (unsigned int f = 0; f < 2; ++f)
+    {
+    StoreType::Pointer mapped = StoreType::New();
+    mapped->Load(files[f]);
+    if (!mapped->IsMapped() || !CheckStore(mapped, samples, labels, nbSamples, nbFeatures))
+      {
+      std::cerr << "Error while reading " << files[f] << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    StoreType::InputListSampleType::Pointer listSample = StoreType::InputListSampleType::New();
+    StoreType::TargetListSampleType::Pointer labelListSample = StoreType::TargetListSampleType::New();
+    mapped->ExportSamples(listSample);
+    mapped->ExportLabels(labelListSample);
+    if (listSample->Size() != nbSamples || labelListSample->Size() != nbSamples
+        || listSample->GetMeasurementVector(3)[1] != samples[3 * nbFeatures + 1]
+        || labelListSample->GetMeasurementVector(4)[0] != labels[4])
+      {
+      std::cerr << "Wrong list samples exported from " << files[f] << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    // Modifications of a mapped store are not written to the file
+    mapped->GetSample(0)[0] = 100.f;
+    }
+
+  StoreType::Pointer reloaded = StoreType::New();
+  reloaded->Load(savedFile);
+  if (!CheckStore(reloaded, samples, labels, nbSamples, nbFeatures))
+    {
+    std::cerr << "The store file has been modified" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // A mapped store can not be appended
+  bool caught = false;
+  try
+    {
+    reloaded->PushBack(samples, labels[0]);
+    }
+  catch (itk::ExceptionObject &)
+    {
+    caught = true;
+    }
+  if (!caught)
+    {
+    std::cerr << "Appending to a mapped store should fail" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
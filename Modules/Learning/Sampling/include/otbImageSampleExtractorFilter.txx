@@ -165,8 +165,6 @@ PersistentImageSampleExtractorFilter<TInputImage>
   TInputImage* inputImage = const_cast<TInputImage*>(this->GetInput());
   unsigned int nbBand = inputImage->GetNumberOfComponentsPerPixel();
 
-  ogr::Layer outputLayer = this->GetInMemoryOutput(threadid);
-
   itk::ProgressReporter progress( this, threadid, layerForThread.GetFeatureCount(true) );
 
   // Loop across the features in the layer (filtered by requested region in BeforeTGD already)
@@ -174,7 +172,6 @@ PersistentImageSampleExtractorFilter<TInputImage>
   PointType imgPoint;
   IndexType imgIndex;
   PixelType imgPixel;
-  double imgComp;
 
   ogr::Layer::const_iterator featIt = layerForThread.begin();
   for(; featIt!=layerForThread.end(); ++featIt)
@@ -196,16 +193,12 @@ PersistentImageSampleExtractorFilter<TInputImage>
         inputImage->TransformPhysicalPointToIndex(imgPoint,imgIndex);
         imgPixel = inputImage->GetPixel(imgIndex);
 
-        ogr::Feature dstFeature(outputLayer.GetLayerDefn());
-        dstFeature.SetFrom( *featIt, TRUE );
-        dstFeature.SetFID(featIt->GetFID());
+        // The sample fields are the additional fields, in the same order
+        double * values = this->AddSample(*featIt, threadid);
         for (unsigned int i=0 ; i<nbBand ; ++i)
           {
-          imgComp = static_cast<double>(itk::DefaultConvertPixelTraits<PixelType>::GetNthComponent(i,imgPixel));
-          // Fill the output OGRDataSource
-          dstFeature[m_SampleFieldNames[i]].SetValue(imgComp);
+          values[i] = static_cast<double>(itk::DefaultConvertPixelTraits<PixelType>::GetNthComponent(i,imgPixel));
           }
-        outputLayer.CreateFeature( dstFeature );
         break;
         }
       default:
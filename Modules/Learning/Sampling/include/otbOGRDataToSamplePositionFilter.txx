@@ -180,19 +180,11 @@ PersistentOGRDataToSamplePositionFilter<TInputImage,TMaskImage,TSampler>
     {
     if (m_Samplers[i][className]->TakeSample())
       {
-      OGRPoint ogrTmpPoint;
-      ogrTmpPoint.setX(imgPoint[0]);
-      ogrTmpPoint.setY(imgPoint[1]);
-
-      ogr::Layer outputLayer = this->GetInMemoryOutput(threadid,i);
-      ogr::Feature feat(outputLayer.GetLayerDefn());
-      feat.SetFrom(feature);
+      double * values = this->AddSample(feature, imgPoint, threadid, i);
       if (m_UseOriginField)
         {
-        feat[this->GetOriginFieldName()].SetValue(static_cast<int>(feature.GetFID()));
+        values[0] = static_cast<int>(feature.GetFID());
         }
-      feat.SetGeometry(&ogrTmpPoint);
-      outputLayer.CreateFeature(feat);
       break;
       }
     }
@@ -56,6 +56,7 @@ public:
   typedef TMaskImage   MaskImageType;
 
   typedef typename TInputImage::RegionType RegionType;
+  typedef typename TInputImage::PointType  PointType;
 
   typedef ogr::DataSource::Pointer OGRDataPointer;
 
@@ -110,7 +111,7 @@ protected:
   /** Generate data should thread over */
   void GenerateData(void) ITK_OVERRIDE;
 
-  /** Allocate in-memory layers for input and outputs */
+  /** Allocate in-memory layers for input and sample buffers for outputs */
   void AllocateOutputs(void) ITK_OVERRIDE;
 
   /** Start of main processing loop */
@@ -162,7 +163,7 @@ protected:
    *  each thread.*/
   virtual void DispatchInputVectors(void);
 
-  /** Gather the content of in-memory output layer into the filter outputs */
+  /** Write the samples buffered by each thread into the filter outputs */
   virtual void GatherOutputVectors(void);
 
   /** Utility method to add new fields on an output layer */
@@ -199,8 +200,21 @@ protected:
   /** Give access to in-memory input layers */
   ogr::Layer GetInMemoryInput(unsigned int threadId);
 
-  /** Give access to in-memory output layers */
-  ogr::Layer GetInMemoryOutput(unsigned int threadId, unsigned int index=0);
+  /** Append a sample to the buffer of a thread for the output data source
+   *  of the given index. The sample gets the fields and the geometry of its
+   *  input feature, which must come from the in-memory input layer of the
+   *  thread. Returns the values of the additional fields of the sample, to
+   *  be set by the caller. */
+  double* AddSample(const ogr::Feature& feature,
+                    itk::ThreadIdType threadid,
+                    unsigned int output = 0);
+
+  /** Same as above, the geometry of the sample being a point at the given
+   *  position. All the samples of an output must use the same method. */
+  double* AddSample(const ogr::Feature& feature,
+                    const PointType& position,
+                    itk::ThreadIdType threadid,
+                    unsigned int output = 0);
 
 private:
   PersistentSamplingFilterBase(const Self &); //purposely not implemented
@@ -227,8 +241,21 @@ private:
   /** In-memory containers storing input geometries for each thread*/
   std::vector<OGRDataPointer> m_InMemoryInputs;
 
-  /** In-memory containers storing position during iteration loop*/
-  std::vector<std::vector<OGRDataPointer> > m_InMemoryOutputs;
+  /** Samples found by a thread for one output, stored by columns. Samples
+   *  refer to their input feature in the in-memory input layer of the
+   *  thread, its fields are only copied when the output layer is written. */
+  struct SampleBuffer
+    {
+    /** FID of the input feature of each sample */
+    std::vector<long> FIDs;
+    /** Point coordinates (x,y) of each sample, empty to keep the input geometry */
+    std::vector<double> Positions;
+    /** Values of the additional fields of each sample */
+    std::vector<double> Values;
+    };
+
+  /** Sample buffers for each thread and each output data source */
+  std::vector<std::vector<SampleBuffer> > m_SampleBuffers;
 
 };
 } // End namespace otb
@@ -42,7 +42,7 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
   , m_OGRLayerCreationOptions()
   , m_AdditionalFields()
   , m_InMemoryInputs()
-  , m_InMemoryOutputs()
+  , m_SampleBuffers()
 {
   this->SetNthOutput(0,TInputImage::New());
 }
@@ -233,38 +233,45 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
     this->m_InMemoryInputs.push_back(tmpOgrDS);
     }
 
-  // Prepare in-memory outputs
-  this->m_InMemoryOutputs.clear();
-  this->m_InMemoryOutputs.reserve(numberOfThreads);
-  tmpLayerName = std::string("threadOut");
-  for (unsigned int i=0 ; i < numberOfThreads ; i++)
+  // Prepare sample buffers, one for each output data source
+  unsigned int numberOfVectorOutputs = 0;
+  for (unsigned int k=0 ; k < this->GetNumberOfOutputs() ; k++)
     {
-    std::vector<OGRDataPointer> tmpContainer;
-    // iterate over outputs, only process ogr::DataSource
-    for (unsigned int k=0 ; k < this->GetNumberOfOutputs() ; k++)
+    if (dynamic_cast<ogr::DataSource *>(this->itk::ProcessObject::GetOutput(k)))
       {
-      ogr::DataSource* realOutput = dynamic_cast<ogr::DataSource *>(
-        this->itk::ProcessObject::GetOutput(k));
-      if (realOutput)
-        {
-        ogr::Layer realLayer = realOutput->GetLayersCount() == 1
-                               ? realOutput->GetLayer(0)
-                               : realOutput->GetLayer(m_OutLayerName);
-        OGRFeatureDefn &outLayerDefn = realLayer.GetLayerDefn();
-        ogr::DataSource::Pointer tmpOutput = ogr::DataSource::New();
-        ogr::Layer tmpLayer = tmpOutput->CreateLayer(
-          tmpLayerName, oSRS,  realLayer.GetGeomType());
-        // add field definitions
-        for (int f=0 ; f < outLayerDefn.GetFieldCount() ; f++)
-          {
-          OGRFieldDefn originDefn(outLayerDefn.GetFieldDefn(f));
-          tmpLayer.CreateField(originDefn);
-          }
-        tmpContainer.push_back(tmpOutput);
-        }
+      numberOfVectorOutputs++;
       }
-    this->m_InMemoryOutputs.push_back(tmpContainer);
     }
+  this->m_SampleBuffers.clear();
+  this->m_SampleBuffers.resize(numberOfThreads, std::vector<SampleBuffer>(numberOfVectorOutputs));
+}
+
+template <class TInputImage, class TMaskImage>
+double*
+PersistentSamplingFilterBase<TInputImage,TMaskImage>
+::AddSample(const ogr::Feature& feature,
+            itk::ThreadIdType threadid,
+            unsigned int output)
+{
+  SampleBuffer & buffer = this->m_SampleBuffers[threadid][output];
+  const std::size_t nbValues = this->m_AdditionalFields.size();
+  buffer.FIDs.push_back(feature.GetFID());
+  buffer.Values.resize(buffer.Values.size() + nbValues, 0.);
+  return nbValues ? &buffer.Values[buffer.Values.size() - nbValues] : ITK_NULLPTR;
+}
+
+template <class TInputImage, class TMaskImage>
+double*
+PersistentSamplingFilterBase<TInputImage,TMaskImage>
+::AddSample(const ogr::Feature& feature,
+            const PointType& position,
+            itk::ThreadIdType threadid,
+            unsigned int output)
+{
+  SampleBuffer & buffer = this->m_SampleBuffers[threadid][output];
+  buffer.Positions.push_back(position[0]);
+  buffer.Positions.push_back(position[1]);
+  return this->AddSample(feature, threadid, output);
 }
 
 template <class TInputImage, class TMaskImage>
@@ -272,12 +279,10 @@ void
 PersistentSamplingFilterBase<TInputImage,TMaskImage>
 ::GatherOutputVectors(void)
 {
-  // clean temporary inputs
-  this->m_InMemoryInputs.clear();
-
   unsigned int numberOfThreads = this->GetNumberOfThreads();
-  
-  // gather temporary outputs and write to output
+  const std::size_t nbValues = this->m_AdditionalFields.size();
+
+  // gather the thread buffers and write to output
   const otb::ogr::DataSource* vectors = this->GetOGRData();
   itk::TimeProbe chrono;
   chrono.Start();
@@ -291,43 +296,71 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
       ogr::Layer outLayer = realOutput->GetLayersCount() == 1
                             ? realOutput->GetLayer(0)
                             : realOutput->GetLayer(m_OutLayerName);
+      OGRFeatureDefn &outLayerDefn = outLayer.GetLayerDefn();
+
+      // Field indexes are resolved once for all the samples
+      std::vector<int> valueFieldIndex(nbValues);
+      for (std::size_t v=0 ; v < nbValues ; ++v)
+        {
+        valueFieldIndex[v] = outLayerDefn.GetFieldIndex(this->m_AdditionalFields[v].Name.c_str());
+        }
+      std::vector<int> fieldMap;
+
+      // This test only uses 1 input, not compatible with multiple OGRData inputs
+      const bool updateMode = (vectors == realOutput);
 
       OGRErr err = outLayer.ogr().StartTransaction();
       if (err != OGRERR_NONE)
         {
         itkExceptionMacro(<< "Unable to start transaction for OGR layer " << outLayer.ogr().GetName() << ".");
         }
-  
+
       for (unsigned int thread=0 ; thread < numberOfThreads ; thread++)
         {
-        ogr::Layer inLayer = this->m_InMemoryOutputs[thread][count]->GetLayerChecked(0);
-        if (!inLayer)
+        const SampleBuffer & buffer = this->m_SampleBuffers[thread][count];
+        if (buffer.FIDs.empty())
           {
           continue;
           }
-  
-        ogr::Layer::const_iterator tmpIt = inLayer.begin();
-        // This test only uses 1 input, not compatible with multiple OGRData inputs
-        if (vectors == realOutput)
+        ogr::Layer inLayer = this->GetInMemoryInput(thread);
+        if (fieldMap.empty())
           {
-          // Update mode
-          for(; tmpIt!=inLayer.end(); ++tmpIt)
+          OGRFeatureDefn &inLayerDefn = inLayer.GetLayerDefn();
+          fieldMap.resize(inLayerDefn.GetFieldCount());
+          for (int f=0 ; f < inLayerDefn.GetFieldCount() ; f++)
             {
-            outLayer.SetFeature( *tmpIt );
+            fieldMap[f] = outLayerDefn.GetFieldIndex(inLayerDefn.GetFieldDefn(f)->GetNameRef());
             }
           }
-        else
+        const bool hasPositions = !buffer.Positions.empty();
+        const double * values = nbValues ? &buffer.Values[0] : ITK_NULLPTR;
+
+        for (std::size_t i=0 ; i < buffer.FIDs.size() ; ++i, values += nbValues)
           {
-          // Copy mode
-          for(; tmpIt!=inLayer.end(); ++tmpIt)
+          ogr::Feature srcFeature = inLayer.GetFeature(buffer.FIDs[i]);
+          ogr::Feature dstFeature(outLayerDefn);
+          dstFeature.SetFrom(srcFeature, fieldMap.empty() ? ITK_NULLPTR : &fieldMap[0], true);
+          if (hasPositions)
+            {
+            OGRPoint point(buffer.Positions[2*i], buffer.Positions[2*i+1]);
+            dstFeature.SetGeometry(&point);
+            }
+          for (std::size_t v=0 ; v < nbValues ; ++v)
+            {
+            dstFeature.ogr().SetField(valueFieldIndex[v], values[v]);
+            }
+          if (updateMode)
             {
-            ogr::Feature dstFeature(outLayer.GetLayerDefn());
-            dstFeature.SetFrom( *tmpIt, TRUE );
-            outLayer.CreateFeature( dstFeature );
+            dstFeature.SetFID(buffer.FIDs[i]);
+            outLayer.SetFeature(dstFeature);
+            }
+          else
+            {
+            outLayer.CreateFeature(dstFeature);
             }
           }
         }
-  
+
       err = outLayer.ogr().CommitTransaction();
       if (err != OGRERR_NONE)
         {
@@ -338,7 +371,10 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
     }
   chrono.Stop();
   otbMsgDebugMacro(<< "write ogr points took " << chrono.GetTotal() << " sec");
-  this->m_InMemoryOutputs.clear();
+
+  // clean temporary inputs and buffers
+  this->m_InMemoryInputs.clear();
+  this->m_SampleBuffers.clear();
 }
 
 template <class TInputImage, class TMaskImage>
@@ -740,7 +776,11 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
     dstFeature.SetFID(featIt->GetFID());
     tmpLayers[counter].CreateFeature( dstFeature );
     cptFeat++;
-    if (cptFeat > nbFeatThread) counter++; cptFeat=0;
+    if (cptFeat >= nbFeatThread && counter + 1 < numberOfThreads)
+      {
+      counter++;
+      cptFeat=0;
+      }
     }
 
   inLayer.SetSpatialFilter(ITK_NULLPTR);
@@ -888,22 +928,6 @@ PersistentSamplingFilterBase<TInputImage,TMaskImage>
   return m_InMemoryInputs[threadId]->GetLayerChecked(0);
 }
 
-template<class TInputImage, class TMaskImage>
-ogr::Layer
-PersistentSamplingFilterBase<TInputImage,TMaskImage>
-::GetInMemoryOutput(unsigned int threadId, unsigned int index)
-{
-  if (threadId >= m_InMemoryOutputs.size())
-    {
-    itkExceptionMacro(<< "Requested in-memory output layer not available " << threadId << " (total size : "<< m_InMemoryOutputs.size() <<").");
-    }
-  if (index >= m_InMemoryOutputs[threadId].size())
-    {
-    itkExceptionMacro(<< "Requested output dataset not available " << index << " (available : "<< m_InMemoryOutputs[threadId].size() <<").");
-    }
-  return m_InMemoryOutputs[threadId][index]->GetLayerChecked(0);
-}
-
 } // end namespace otb
 
 #endif
@@ -25,6 +25,8 @@
 #include "itkPhysicalPointImageSource.h"
 #include "itkTimeProbe.h"
 #include <fstream>
+#include <cmath>
+#include <cstdlib>
 
 int otbImageSampleExtractorFilterNew(int itkNotUsed(argc), char* itkNotUsed(argv) [])
 {
@@ -188,3 +190,122 @@ int otbImageSampleExtractorFilterUpdate(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbImageSampleExtractorFilterBenchmark(int argc, char* argv[])
+{
+  typedef otb::VectorImage<float> InputImageType;
+  typedef otb::ImageSampleExtractorFilter<InputImageType> FilterType;
+
+  if (argc < 3)
+    {
+    std::cout << "Usage : "<<argv[0]<< "  output  nb_points" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::string outputPath(argv[1]);
+  const unsigned long nbPoints = atol(argv[2]);
+
+  const unsigned int imageSize = 1000;
+  std::string classFieldName("class");
+  std::string outputPrefix("band_");
+
+  // Generate a synthetic point layer covering the image
+  otb::ogr::DataSource::Pointer output =
+    otb::ogr::DataSource::New(outputPath,otb::ogr::DataSource::Modes::Overwrite);
+  otb::ogr::Layer pointLayer = output->CreateLayer("points", ITK_NULLPTR, wkbPoint);
+  OGRFieldDefn classField(classFieldName.c_str(),OFTInteger);
+  pointLayer.CreateField(classField, true);
+
+  itk::TimeProbe chrono;
+  chrono.Start();
+
+  if (pointLayer.ogr().StartTransaction() != OGRERR_NONE)
+    {
+    std::cout << "Unable to start transaction for OGR layer " << pointLayer.ogr().GetName() << "." << std::endl;
+    return EXIT_FAILURE;
+    }
+  for (unsigned long i = 0; i < nbPoints; ++i)
+    {
+    // Deterministic spread of the points over the pixel centers
+    // (origin 0.5 and spacing (1,-1) : row r is centered on y = 0.5 - r)
+    const unsigned long pixel = (i * 7919UL) % (imageSize * imageSize);
+    OGRPoint point(static_cast<double>(pixel % imageSize) + 0.5,
+                   0.5 - static_cast<double>(pixel / imageSize));
+    otb::ogr::Feature feature(pointLayer.GetLayerDefn());
+    feature.SetGeometry(&point);
+    feature.ogr().SetField(0, static_cast<int>(i % 10));
+    pointLayer.CreateFeature(feature);
+    }
+  if (pointLayer.ogr().CommitTransaction() != OGRERR_NONE)
+    {
+    std::cout << "Unable to commit transaction for OGR layer " << pointLayer.ogr().GetName() << "." << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  chrono.Stop();
+  std::cout << "Generation of "<< nbPoints << " points took "<< chrono.GetTotal() << " sec" << std::endl;
+
+  output->Clear();
+
+  otb::ogr::DataSource::Pointer outputUpdate =
+    otb::ogr::DataSource::New(outputPath,otb::ogr::DataSource::Modes::Update_LayerUpdate);
+
+  InputImageType::SizeType size;
+  size.Fill(imageSize);
+
+  InputImageType::PointType origin;
+  origin.Fill(0.5);
+
+  InputImageType::SpacingType spacing;
+  spacing[0] = 1.0;
+  spacing[1] = -1.0;
+
+  typedef itk::PhysicalPointImageSource<InputImageType> ImageSourceType;
+  ImageSourceType::Pointer imgSource = ImageSourceType::New();
+  imgSource->SetSize(size);
+  imgSource->SetSpacing(spacing);
+  imgSource->SetOrigin(origin);
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(imgSource->GetOutput());
+  filter->SetLayerIndex(0);
+  filter->SetSamplePositions(outputUpdate);
+  filter->SetOutputSamples(outputUpdate);
+  filter->SetClassFieldName(classFieldName);
+  filter->SetOutputFieldPrefix(outputPrefix);
+
+  chrono.Reset();
+  chrono.Start();
+
+  filter->Update();
+
+  chrono.Stop();
+  std::cout << "Extraction of "<< nbPoints << " samples took "<< chrono.GetTotal() << " sec" << std::endl;
+
+  // Check that every point received its sample values
+  outputUpdate->Clear();
+  otb::ogr::DataSource::Pointer result = otb::ogr::DataSource::New(outputPath);
+  otb::ogr::Layer resultLayer = result->GetLayer(0);
+  if (resultLayer.GetFeatureCount(true) != static_cast<int>(nbPoints))
+    {
+    std::cout << "Wrong number of samples : " << resultLayer.GetFeatureCount(true) << std::endl;
+    return EXIT_FAILURE;
+    }
+  const int bandIdx = resultLayer.GetLayerDefn().GetFieldIndex((outputPrefix+"0").c_str());
+  if (bandIdx < 0)
+    {
+    std::cout << "Missing sample field " << outputPrefix << "0" << std::endl;
+    return EXIT_FAILURE;
+    }
+  for (otb::ogr::Layer::const_iterator featIt = resultLayer.begin(); featIt != resultLayer.end(); ++featIt)
+    {
+    const OGRPoint * point = dynamic_cast<const OGRPoint *>(featIt->GetGeometry());
+    if (point == ITK_NULLPTR || std::abs(featIt->ogr().GetFieldAsDouble(bandIdx) - point->getX()) > 1e-6)
+      {
+      std::cout << "Wrong sample value for feature " << featIt->GetFID() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -32,6 +32,7 @@ void RegisterTests()
   REGISTER_TEST(otbImageSampleExtractorFilterNew);
   REGISTER_TEST(otbImageSampleExtractorFilter);
   REGISTER_TEST(otbImageSampleExtractorFilterUpdate);
+  REGISTER_TEST(otbImageSampleExtractorFilterBenchmark);
   REGISTER_TEST(otbSamplingRateCalculatorListNew);
   REGISTER_TEST(otbSamplingRateCalculatorList);
 }
@@ -26,6 +26,7 @@
 #include "itkLightObject.h"
 #include "itkFixedArray.h"
 #include "otbMachineLearningModel.h"
+#include "otbFlatDecisionForest.h"
 
 #ifdef OTB_OPENCV_3
 #include "otbOpenCVUtils.h"
@@ -53,6 +54,7 @@ public:
   typedef typename Superclass::TargetSampleType           TargetSampleType;
   typedef typename Superclass::TargetListSampleType       TargetListSampleType;
   typedef typename Superclass::ConfidenceValueType        ConfidenceValueType;
+  typedef typename Superclass::ConfidenceListSampleType   ConfidenceListSampleType;
 
   /** Run-time type information (and related methods). */
   itkNewMacro(Self);
@@ -98,6 +100,12 @@ public:
   itkGetMacro(MaxDepth, int);
   itkSetMacro(MaxDepth, int);
 
+  /** If true (default), batch predictions are computed on a flattened copy
+   * of the weak trees, which gives the same labels and confidences as the
+   * OpenCV model. */
+  itkGetMacro(FlatPrediction, bool);
+  itkSetMacro(FlatPrediction, bool);
+
   /** Train the machine learning model */
   void Train() ITK_OVERRIDE;
 
@@ -126,7 +134,9 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType *quality=ITK_NULLPTR) const ITK_OVERRIDE;
 
-  
+  /** Predict a batch of samples, on the flattened weak trees if available */
+  void DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality = ITK_NULLPTR) const ITK_OVERRIDE;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
 
@@ -134,6 +144,9 @@ private:
   BoostMachineLearningModel(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
 
+  /** Flatten the weak trees of the OpenCV model, if possible */
+  void BuildFlatForest();
+
 #ifdef OTB_OPENCV_3
   cv::Ptr<cv::ml::Boost> m_BoostModel;
 #else
@@ -144,6 +157,12 @@ private:
   double m_WeightTrimRate;
   int m_SplitCrit;
   int m_MaxDepth;
+  /** Use the flattened weak trees for batch predictions */
+  bool m_FlatPrediction;
+  /** Flattened copy of the weak trees, empty if the model can not be flattened */
+  FlatDecisionForest<float> m_FlatForest;
+  /** Labels of the two classes */
+  std::vector<double> m_FlatClassLabels;
 };
 } // end namespace otb
 
@@ -25,7 +25,9 @@
 #include "otbOpenCVUtils.h"
 
 #include <fstream>
+#include <algorithm>
 #include "itkMacro.h"
+#include "otbMacro.h"
 
 namespace otb
 {
@@ -46,7 +48,8 @@ BoostMachineLearningModel<TInputValue,TOutputValue>
 #else
  m_SplitCrit(CvBoost::DEFAULT),
 #endif
- m_MaxDepth(1)
+ m_MaxDepth(1),
+ m_FlatPrediction(true)
 {
   this->m_ConfidenceIndex = true;
 }
@@ -69,14 +72,14 @@ BoostMachineLearningModel<TInputValue,TOutputValue>
 {
   //convert listsample to opencv matrix
   cv::Mat samples;
-  otb::ListSampleToMat<InputListSampleType>(this->GetInputListSample(), samples);
+  otb::InputSamplesToMat(this, samples);
 
   cv::Mat labels;
   otb::ListSampleToMat<TargetListSampleType>(this->GetTargetListSample(),labels);
 
-  cv::Mat var_type = cv::Mat(this->GetInputListSample()->GetMeasurementVectorSize() + 1, 1, CV_8U );
+  cv::Mat var_type = cv::Mat(samples.cols + 1, 1, CV_8U );
   var_type.setTo(cv::Scalar(CV_VAR_NUMERICAL) ); // all inputs are numerical
-  var_type.at<uchar>(this->GetInputListSample()->GetMeasurementVectorSize(), 0) = CV_VAR_CATEGORICAL;
+  var_type.at<uchar>(samples.cols, 0) = CV_VAR_CATEGORICAL;
 
 #ifdef OTB_OPENCV_3
   m_BoostModel->setBoostType(m_BoostType);
@@ -98,6 +101,56 @@ BoostMachineLearningModel<TInputValue,TOutputValue>
   params.split_criteria = m_SplitCrit;
   m_BoostModel->train(samples,CV_ROW_SAMPLE,labels,cv::Mat(),cv::Mat(),var_type,cv::Mat(),params);
 #endif
+
+  this->BuildFlatForest();
+}
+
+template <class TInputValue, class TOutputValue>
+void
+BoostMachineLearningModel<TInputValue,TOutputValue>
+::BuildFlatForest()
+{
+  m_FlatForest.Clear();
+  m_FlatClassLabels.clear();
+
+  // The prediction is the sign of the sum of the leaf values of the weak
+  // trees, taken in their order
+#ifdef OTB_OPENCV_3
+  bool flattened = m_BoostModel->isTrained()
+    && otb::GetCvTreesClassLabels(*m_BoostModel, m_FlatClassLabels)
+    && m_FlatClassLabels.size() == 2
+    && otb::FlattenCvTrees(*m_BoostModel, m_FlatForest);
+#else
+  CvSeq * weakTrees = m_BoostModel->get_weak_predictors();
+  bool flattened = weakTrees != ITK_NULLPTR && weakTrees->total > 0;
+  for (int k = 0; flattened && k < weakTrees->total; ++k)
+    {
+    // CvBoost::predict() walks the whole weak trees, whatever their pruning
+    const CvBoostTree * tree = *reinterpret_cast<CvBoostTree **>(cvGetSeqElem(weakTrees, k));
+    flattened = otb::FlattenCvTree(*tree, m_FlatForest, false);
+    }
+
+  // Labels of the two classes, as mapped by CvBoost::predict()
+  if (flattened)
+    {
+    const CvDTreeTrainData * data = (*reinterpret_cast<CvBoostTree **>(cvGetSeqElem(weakTrees, 0)))->get_data();
+    const int responseIdx = data->var_type->data.i[data->var_count];
+    flattened = data->var_idx == ITK_NULLPTR && responseIdx >= 0 && data->cat_map != ITK_NULLPTR && data->cat_ofs != ITK_NULLPTR
+      && data->cat_count->data.i[responseIdx] == 2;
+    if (flattened)
+      {
+      const int * classLabels = data->cat_map->data.i + data->cat_ofs->data.i[responseIdx];
+      m_FlatClassLabels.assign(classLabels, classLabels + 2);
+      }
+    }
+#endif
+
+  if (!flattened)
+    {
+    otbMsgDevMacro(<< "Boost model can not be flattened, batch predictions will use OpenCV");
+    m_FlatForest.Clear();
+    m_FlatClassLabels.clear();
+    }
 }
 
 template <class TInputValue, class TOutputValue>
@@ -137,6 +190,118 @@ BoostMachineLearningModel<TInputValue,TOutputValue>
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void
+BoostMachineLearningModel<TInputValue,TOutputValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  assert(input != ITK_NULLPTR);
+  assert(targets != ITK_NULLPTR);
+
+  if(startIndex+size>input->Size())
+    {
+    itkExceptionMacro(<<"requested range ["<<startIndex<<", "<<startIndex+size<<"[ partially outside input sample list range.[0,"<<input->Size()<<"[");
+    }
+
+  const unsigned int nbFeatures = input->GetMeasurementVectorSize();
+
+  if (!m_FlatPrediction || m_FlatForest.IsEmpty() || nbFeatures < m_FlatForest.GetNumberOfFeatures())
+    {
+    for (unsigned int id = startIndex; id < startIndex + size; ++id)
+      {
+      ConfidenceValueType confidence = 0;
+      const TargetSampleType target = this->DoPredict(input->GetMeasurementVector(id),
+                                                      quality != ITK_NULLPTR ? &confidence : ITK_NULLPTR);
+      if (quality != ITK_NULLPTR)
+        {
+        quality->SetMeasurementVector(id, confidence);
+        }
+      targets->SetMeasurementVector(id, target);
+      }
+    return;
+    }
+
+  // Samples are processed by blocks, each weak tree being evaluated on a
+  // whole block before the next one
+  const unsigned int blockSize = 64;
+  const unsigned int nbTrees = m_FlatForest.GetNumberOfTrees();
+
+  std::vector<float> samples(blockSize * nbFeatures);
+  std::vector<bool> missing(blockSize);
+  std::vector<typename FlatDecisionForest<float>::NodeIndexType> leaves(blockSize);
+  std::vector<double> sums(blockSize);
+
+  for (unsigned int blockStart = startIndex; blockStart < startIndex + size; blockStart += blockSize)
+    {
+    const unsigned int nbSamples = std::min(blockSize, startIndex + size - blockStart);
+
+    for (unsigned int i = 0; i < nbSamples; ++i)
+      {
+      const InputSampleType & sample = input->GetMeasurementVector(blockStart + i);
+      float * flatSample = &samples[i * nbFeatures];
+      missing[i] = false;
+      for (unsigned int f = 0; f < nbFeatures; ++f)
+        {
+        flatSample[f] = sample[f];
+#ifdef OTB_OPENCV_3
+        // Missing values follow the default direction of the nodes
+        missing[i] = missing[i] || flatSample[f] == cv::ml::TrainData::missingValue();
+#endif
+        }
+      }
+
+    // Same accumulation order as OpenCV, so that the sums are identical
+    std::fill(sums.begin(), sums.end(), 0.);
+    for (unsigned int tree = 0; tree < nbTrees; ++tree)
+      {
+      m_FlatForest.EvaluateTree(tree, &samples[0], nbSamples, nbFeatures, &leaves[0]);
+      for (unsigned int i = 0; i < nbSamples; ++i)
+        {
+        sums[i] += m_FlatForest.GetValue(leaves[i]);
+        }
+      }
+
+    for (unsigned int i = 0; i < nbSamples; ++i)
+      {
+      const unsigned int id = blockStart + i;
+      if (missing[i])
+        {
+        ConfidenceValueType confidence = 0;
+        const TargetSampleType target = this->DoPredict(input->GetMeasurementVector(id),
+                                                        quality != ITK_NULLPTR ? &confidence : ITK_NULLPTR);
+        if (quality != ITK_NULLPTR)
+          {
+          quality->SetMeasurementVector(id, confidence);
+          }
+        targets->SetMeasurementVector(id, target);
+        continue;
+        }
+
+#ifdef OTB_OPENCV_3
+      // Boost::predict() compares the float sum to 0, and its raw output
+      // is the class index
+      const unsigned int classIdx = static_cast<float>(sums[i]) > 0.f ? 1 : 0;
+      const float rawOutput = static_cast<float>(classIdx);
+#else
+      // CvBoost::predict() compares the double sum to 0, and its raw
+      // output is the sum
+      const unsigned int classIdx = sums[i] >= 0. ? 1 : 0;
+      const float rawOutput = static_cast<float>(sums[i]);
+#endif
+
+      const double result = static_cast<float>(m_FlatClassLabels[classIdx]);
+      TargetSampleType target;
+      target[0] = static_cast<TOutputValue>(result);
+      targets->SetMeasurementVector(id, target);
+
+      if (quality != ITK_NULLPTR)
+        {
+        quality->SetMeasurementVector(id, static_cast<ConfidenceValueType>(rawOutput));
+        }
+      }
+    }
+}
+
 template <class TInputValue, class TOutputValue>
 void
 BoostMachineLearningModel<TInputValue,TOutputValue>
@@ -170,6 +335,8 @@ BoostMachineLearningModel<TInputValue,TOutputValue>
   else
       m_BoostModel->load(filename.c_str(), name.c_str());
 #endif
+
+  this->BuildFlatForest();
 }
 
 template <class TInputValue, class TOutputValue>
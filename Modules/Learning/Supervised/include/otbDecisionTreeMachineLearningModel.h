@@ -26,6 +26,7 @@
 #include "itkLightObject.h"
 #include "itkFixedArray.h"
 #include "otbMachineLearningModel.h"
+#include "otbFlatDecisionForest.h"
 
 #ifdef OTB_OPENCV_3
 #include "otbOpenCVUtils.h"
@@ -53,6 +54,7 @@ public:
   typedef typename Superclass::TargetSampleType           TargetSampleType;
   typedef typename Superclass::TargetListSampleType       TargetListSampleType;
   typedef typename Superclass::ConfidenceValueType        ConfidenceValueType;
+  typedef typename Superclass::ConfidenceListSampleType   ConfidenceListSampleType;
 
   /** Run-time type information (and related methods). */
   itkNewMacro(Self);
@@ -132,6 +134,11 @@ public:
   itkGetMacro(TruncatePrunedTree, bool);
   itkSetMacro(TruncatePrunedTree, bool);
 
+  /** If true (default), batch predictions are computed on a flattened copy
+   * of the tree, which gives the same results as the OpenCV model. */
+  itkGetMacro(FlatPrediction, bool);
+  itkSetMacro(FlatPrediction, bool);
+
 
   /*  The array of a priori class probabilities, sorted by the class label
   * value. The parameter can be used to tune the decision tree preferences toward
@@ -181,6 +188,9 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType *quality=ITK_NULLPTR) const ITK_OVERRIDE;
 
+  /** Predict a batch of samples, on the flattened tree if available */
+  void DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality = ITK_NULLPTR) const ITK_OVERRIDE;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
 
@@ -188,6 +198,9 @@ private:
   DecisionTreeMachineLearningModel(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
 
+  /** Flatten the OpenCV tree, if possible */
+  void BuildFlatForest();
+
 #ifdef OTB_OPENCV_3
   cv::Ptr<cv::ml::DTrees> m_DTreeModel;
 #else
@@ -204,6 +217,12 @@ private:
   bool m_TruncatePrunedTree;
   std::vector<float> m_Priors;
 
+  /** Use the flattened tree for batch predictions */
+  bool m_FlatPrediction;
+  /** Flattened copy of the tree, empty if the model can not be flattened */
+  FlatDecisionForest<float> m_FlatForest;
+  /** Label of each class index of the leaves, empty in regression */
+  std::vector<double> m_FlatClassLabels;
 };
 } // end namespace otb
 
@@ -25,7 +25,9 @@
 #include "otbOpenCVUtils.h"
 
 #include <fstream>
+#include <algorithm>
 #include "itkMacro.h"
+#include "otbMacro.h"
 
 namespace otb
 {
@@ -51,7 +53,8 @@ DecisionTreeMachineLearningModel<TInputValue,TOutputValue>
  m_CVFolds(10),
 #endif
  m_Use1seRule(true),
- m_TruncatePrunedTree(true)
+ m_TruncatePrunedTree(true),
+ m_FlatPrediction(true)
 {
   this->m_IsRegressionSupported = true;
 }
@@ -73,16 +76,16 @@ DecisionTreeMachineLearningModel<TInputValue,TOutputValue>
 {
   //convert listsample to opencv matrix
   cv::Mat samples;
-  otb::ListSampleToMat<InputListSampleType>(this->GetInputListSample(), samples);
+  otb::InputSamplesToMat(this, samples);
 
   cv::Mat labels;
   otb::ListSampleToMat<TargetListSampleType>(this->GetTargetListSample(),labels);
 
-  cv::Mat var_type = cv::Mat(this->GetInputListSample()->GetMeasurementVectorSize() + 1, 1, CV_8U );
+  cv::Mat var_type = cv::Mat(samples.cols + 1, 1, CV_8U );
   var_type.setTo(cv::Scalar(CV_VAR_NUMERICAL) ); // all inputs are numerical
 
   if (!this->m_RegressionMode) //Classification
-    var_type.at<uchar>(this->GetInputListSample()->GetMeasurementVectorSize(), 0) = CV_VAR_CATEGORICAL;
+    var_type.at<uchar>(samples.cols, 0) = CV_VAR_CATEGORICAL;
 
 #ifdef OTB_OPENCV_3
   m_DTreeModel->setMaxDepth(m_MaxDepth);
@@ -111,6 +114,44 @@ DecisionTreeMachineLearningModel<TInputValue,TOutputValue>
   //train the Decision Tree model
   m_DTreeModel->train(samples,CV_ROW_SAMPLE,labels,cv::Mat(),cv::Mat(),var_type,cv::Mat(),params);
 #endif
+
+  this->BuildFlatForest();
+}
+
+template <class TInputValue, class TOutputValue>
+void
+DecisionTreeMachineLearningModel<TInputValue,TOutputValue>
+::BuildFlatForest()
+{
+  m_FlatForest.Clear();
+  m_FlatClassLabels.clear();
+
+#ifdef OTB_OPENCV_3
+  // The prediction of a classifier is the label of the class index
+  bool flattened = m_DTreeModel->isTrained()
+    && (!m_DTreeModel->isClassifier() || otb::GetCvTreesClassLabels(*m_DTreeModel, m_FlatClassLabels))
+    && otb::FlattenCvTrees(*m_DTreeModel, m_FlatForest)
+    && m_FlatForest.GetNumberOfTrees() == 1;
+
+  for (unsigned int node = 0; flattened && !m_FlatClassLabels.empty() && node < m_FlatForest.GetNumberOfNodes(); ++node)
+    {
+    if (m_FlatForest.IsLeaf(node))
+      {
+      const int classIdx = m_FlatForest.GetClassIndex(node);
+      flattened = classIdx >= 0 && static_cast<unsigned int>(classIdx) < m_FlatClassLabels.size();
+      }
+    }
+#else
+  // The prediction is the value of the leaf
+  const bool flattened = otb::FlattenCvTree(*m_DTreeModel, m_FlatForest);
+#endif
+
+  if (!flattened)
+    {
+    otbMsgDevMacro(<< "Decision tree can not be flattened, batch predictions will use OpenCV");
+    m_FlatForest.Clear();
+    m_FlatClassLabels.clear();
+    }
 }
 
 template <class TInputValue, class TOutputValue>
@@ -144,6 +185,90 @@ DecisionTreeMachineLearningModel<TInputValue,TOutputValue>
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void
+DecisionTreeMachineLearningModel<TInputValue,TOutputValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  assert(input != ITK_NULLPTR);
+  assert(targets != ITK_NULLPTR);
+
+  if(startIndex+size>input->Size())
+    {
+    itkExceptionMacro(<<"requested range ["<<startIndex<<", "<<startIndex+size<<"[ partially outside input sample list range.[0,"<<input->Size()<<"[");
+    }
+
+  const unsigned int nbFeatures = input->GetMeasurementVectorSize();
+
+  // The confidence index is not available, DoPredict() reports it
+  if (!m_FlatPrediction || m_FlatForest.IsEmpty() || quality != ITK_NULLPTR
+      || nbFeatures < m_FlatForest.GetNumberOfFeatures())
+    {
+    for (unsigned int id = startIndex; id < startIndex + size; ++id)
+      {
+      ConfidenceValueType confidence = 0;
+      const TargetSampleType target = this->DoPredict(input->GetMeasurementVector(id),
+                                                      quality != ITK_NULLPTR ? &confidence : ITK_NULLPTR);
+      if (quality != ITK_NULLPTR)
+        {
+        quality->SetMeasurementVector(id, confidence);
+        }
+      targets->SetMeasurementVector(id, target);
+      }
+    return;
+    }
+
+  const unsigned int blockSize = 64;
+
+  std::vector<float> samples(blockSize * nbFeatures);
+  std::vector<bool> missing(blockSize);
+  std::vector<typename FlatDecisionForest<float>::NodeIndexType> leaves(blockSize);
+
+  for (unsigned int blockStart = startIndex; blockStart < startIndex + size; blockStart += blockSize)
+    {
+    const unsigned int nbSamples = std::min(blockSize, startIndex + size - blockStart);
+
+    for (unsigned int i = 0; i < nbSamples; ++i)
+      {
+      const InputSampleType & sample = input->GetMeasurementVector(blockStart + i);
+      float * flatSample = &samples[i * nbFeatures];
+      missing[i] = false;
+      for (unsigned int f = 0; f < nbFeatures; ++f)
+        {
+        flatSample[f] = sample[f];
+#ifdef OTB_OPENCV_3
+        // Missing values follow the default direction of the nodes
+        missing[i] = missing[i] || flatSample[f] == cv::ml::TrainData::missingValue();
+#endif
+        }
+      }
+
+    m_FlatForest.EvaluateTree(0, &samples[0], nbSamples, nbFeatures, &leaves[0]);
+
+    for (unsigned int i = 0; i < nbSamples; ++i)
+      {
+      const unsigned int id = blockStart + i;
+      if (missing[i])
+        {
+        targets->SetMeasurementVector(id, this->DoPredict(input->GetMeasurementVector(id)));
+        continue;
+        }
+
+#ifdef OTB_OPENCV_3
+      const double result = static_cast<float>(m_FlatClassLabels.empty() ?
+                                               m_FlatForest.GetValue(leaves[i]) :
+                                               m_FlatClassLabels[m_FlatForest.GetClassIndex(leaves[i])]);
+#else
+      const double result = m_FlatForest.GetValue(leaves[i]);
+#endif
+
+      TargetSampleType target;
+      target[0] = static_cast<TOutputValue>(result);
+      targets->SetMeasurementVector(id, target);
+      }
+    }
+}
+
 template <class TInputValue, class TOutputValue>
 void
 DecisionTreeMachineLearningModel<TInputValue,TOutputValue>
@@ -177,6 +302,8 @@ DecisionTreeMachineLearningModel<TInputValue,TOutputValue>
   else
     m_DTreeModel->load(filename.c_str(), name.c_str());
 #endif
+
+  this->BuildFlatForest();
 }
 
 template <class TInputValue, class TOutputValue>
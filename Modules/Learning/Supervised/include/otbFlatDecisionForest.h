@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFlatDecisionForest_h
+#define otbFlatDecisionForest_h
+
+#include <vector>
+
+namespace otb
+{
+
+/** \class FlatDecisionForest
+ * \brief Decision trees stored in flat arrays for fast batch evaluation
+ *
+ * The nodes of all the trees are stored in parallel arrays (feature index,
+ * threshold, left and right children), so that evaluating a tree only reads
+ * a few contiguous arrays instead of following pointers.
+ *
+ * A split node sends a sample to its left child if the feature value is
+ * lower or equal to the threshold, and to its right child otherwise. Leaves
+ * are their own children, so that a tree can be evaluated on a block of
+ * samples by moving all the samples down one level at a time, for as many
+ * levels as the depth of the tree, without any test on the node type. The
+ * inner loop on samples has no branch and can be vectorized.
+ *
+ * Leaves hold a class index and a value, whose meaning is given by the
+ * model which built the forest.
+ *
+ * \ingroup OTBSupervised
+ */
+template <class TValue>
+class FlatDecisionForest
+{
+public:
+  typedef TValue ValueType;
+  typedef int    NodeIndexType;
+
+  FlatDecisionForest();
+
+  /** Remove all the trees */
+  void Clear();
+
+  bool IsEmpty() const
+  {
+    return m_Roots.empty();
+  }
+
+  unsigned int GetNumberOfTrees() const
+  {
+    return m_Roots.size();
+  }
+
+  unsigned int GetNumberOfNodes() const
+  {
+    return m_Features.size();
+  }
+
+  bool IsLeaf(NodeIndexType node) const
+  {
+    return m_Left[node] == node;
+  }
+
+  /** Number of features a sample must have to be evaluated */
+  unsigned int GetNumberOfFeatures() const
+  {
+    return m_NumberOfFeatures;
+  }
+
+  /** Add a leaf and return its index */
+  NodeIndexType AddLeaf(int classIndex, double value);
+
+  /** Add a split node and return its index. Its children have to be set
+   * with SetChildren() before the tree is added. */
+  NodeIndexType AddSplit(unsigned int feature, ValueType threshold);
+
+  void SetChildren(NodeIndexType node, NodeIndexType left, NodeIndexType right);
+
+  /** Add the tree starting at the given root node */
+  void AddTree(NodeIndexType root);
+
+  int GetClassIndex(NodeIndexType leaf) const
+  {
+    return m_ClassIndices[leaf];
+  }
+
+  double GetValue(NodeIndexType leaf) const
+  {
+    return m_Values[leaf];
+  }
+
+  /** Evaluate a tree on nbSamples samples. The features of sample i start at
+   * samples + i * stride. The reached leaf of each sample is written in
+   * leaves. */
+  void EvaluateTree(unsigned int tree,
+                    const ValueType * samples,
+                    unsigned int nbSamples,
+                    unsigned int stride,
+                    NodeIndexType * leaves) const;
+
+private:
+  std::vector<unsigned int>  m_Features;
+  std::vector<ValueType>     m_Thresholds;
+  std::vector<NodeIndexType> m_Left;
+  std::vector<NodeIndexType> m_Right;
+  std::vector<int>           m_ClassIndices;
+  std::vector<double>        m_Values;
+
+  std::vector<NodeIndexType> m_Roots;
+  std::vector<unsigned int>  m_Depths;
+
+  unsigned int m_NumberOfFeatures;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbFlatDecisionForest.txx"
+#endif
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFlatDecisionForest_txx
+#define otbFlatDecisionForest_txx
+
+#include "otbFlatDecisionForest.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace otb
+{
+
+template <class TValue>
+FlatDecisionForest<TValue>
+::FlatDecisionForest()
+  : m_NumberOfFeatures(0)
+{
+}
+
+template <class TValue>
+void
+FlatDecisionForest<TValue>
+::Clear()
+{
+  m_Features.clear();
+  m_Thresholds.clear();
+  m_Left.clear();
+  m_Right.clear();
+  m_ClassIndices.clear();
+  m_Values.clear();
+  m_Roots.clear();
+  m_Depths.clear();
+  m_NumberOfFeatures = 0;
+}
+
+template <class TValue>
+typename FlatDecisionForest<TValue>::NodeIndexType
+FlatDecisionForest<TValue>
+::AddLeaf(int classIndex, double value)
+{
+  const NodeIndexType node = static_cast<NodeIndexType>(m_Features.size());
+  // Any feature can be read by a leaf, as the sample stays on the leaf
+  m_Features.push_back(0);
+  m_Thresholds.push_back(ValueType());
+  m_Left.push_back(node);
+  m_Right.push_back(node);
+  m_ClassIndices.push_back(classIndex);
+  m_Values.push_back(value);
+  return node;
+}
+
+template <class TValue>
+typename FlatDecisionForest<TValue>::NodeIndexType
+FlatDecisionForest<TValue>
+::AddSplit(unsigned int feature, ValueType threshold)
+{
+  const NodeIndexType node = static_cast<NodeIndexType>(m_Features.size());
+  m_Features.push_back(feature);
+  m_Thresholds.push_back(threshold);
+  m_Left.push_back(node);
+  m_Right.push_back(node);
+  m_ClassIndices.push_back(-1);
+  m_Values.push_back(0.);
+  m_NumberOfFeatures = std::max(m_NumberOfFeatures, feature + 1);
+  return node;
+}
+
+template <class TValue>
+void
+FlatDecisionForest<TValue>
+::SetChildren(NodeIndexType node, NodeIndexType left, NodeIndexType right)
+{
+  m_Left[node] = left;
+  m_Right[node] = right;
+}
+
+template <class TValue>
+void
+FlatDecisionForest<TValue>
+::AddTree(NodeIndexType root)
+{
+  // The depth of the tree is the number of levels to go through
+  unsigned int depth = 0;
+  std::vector<std::pair<NodeIndexType, unsigned int> > stack;
+  stack.push_back(std::make_pair(root, 0u));
+  while (!stack.empty())
+    {
+    const NodeIndexType node = stack.back().first;
+    const unsigned int level = stack.back().second;
+    stack.pop_back();
+    if (this->IsLeaf(node))
+      {
+      depth = std::max(depth, level);
+      }
+    else
+      {
+      stack.push_back(std::make_pair(m_Left[node], level + 1));
+      stack.push_back(std::make_pair(m_Right[node], level + 1));
+      }
+    }
+
+  m_Roots.push_back(root);
+  m_Depths.push_back(depth);
+  m_NumberOfFeatures = std::max(m_NumberOfFeatures, 1u);
+}
+
+template <class TValue>
+void
+FlatDecisionForest<TValue>
+::EvaluateTree(unsigned int tree,
+               const ValueType * samples,
+               unsigned int nbSamples,
+               unsigned int stride,
+               NodeIndexType * leaves) const
+{
+  const NodeIndexType root = m_Roots[tree];
+  for (unsigned int i = 0; i < nbSamples; ++i)
+    {
+    leaves[i] = root;
+    }
+
+  const unsigned int * features = &m_Features[0];
+  const ValueType * thresholds = &m_Thresholds[0];
+  const NodeIndexType * left = &m_Left[0];
+  const NodeIndexType * right = &m_Right[0];
+
+  for (unsigned int level = 0; level < m_Depths[tree]; ++level)
+    {
+    for (unsigned int i = 0; i < nbSamples; ++i)
+      {
+      const NodeIndexType node = leaves[i];
+      const ValueType value = samples[i * stride + features[node]];
+      leaves[i] = value <= thresholds[node] ? left[node] : right[node];
+      }
+    }
+}
+
+} // end namespace otb
+
+#endif
@@ -65,7 +65,7 @@ KNearestNeighborsMachineLearningModel<TInputValue,TTargetValue>
 {
   //convert listsample to opencv matrix
   cv::Mat samples;
-  otb::ListSampleToMat<InputListSampleType>(this->GetInputListSample(), samples);
+  otb::InputSamplesToMat(this, samples);
 
   cv::Mat labels;
   otb::ListSampleToMat<TargetListSampleType>(this->GetTargetListSample(), labels);
@@ -185,6 +185,23 @@ KNearestNeighborsMachineLearningModel<TInputValue,TTargetValue>
     }
 
   //Save the samples. First column is the Label and other columns are the sample data.
+  if (this->GetInputSampleStore() != ITK_NULLPTR)
+  {
+    const typename Superclass::SampleStoreType * store = this->GetInputSampleStore();
+    const unsigned int sampleSize = store->GetNumberOfFeatures();
+    for (typename Superclass::SampleStoreType::SizeType id = 0; id < store->Size(); ++id)
+    {
+      const InputValueType * sample = store->GetSample(id);
+      ofs << store->GetLabel(id);
+      for(unsigned int i = 0; i < sampleSize; ++i)
+      {
+        ofs << " " << sample[i];
+      }
+      ofs << "\n";
+    }
+    ofs.close();
+    return;
+  }
   typename InputListSampleType::ConstIterator sampleIt = this->GetInputListSample()->Begin();
   typename TargetListSampleType::ConstIterator labelIt = this->GetTargetListSample()->Begin();
   const unsigned int sampleSize = this->GetInputListSample()->GetMeasurementVectorSize();
@@ -47,6 +47,7 @@ public:
   typedef typename Superclass::TargetSampleType           TargetSampleType;
   typedef typename Superclass::TargetListSampleType       TargetListSampleType;
   typedef typename Superclass::ConfidenceValueType        ConfidenceValueType;
+  typedef typename Superclass::SampleStoreType            SampleStoreType;
 
   /** enum to choose the way confidence is computed
    *   CM_INDEX : compute the difference between highest and second highest probability
@@ -304,9 +304,10 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
 ::BuildProblem()
 {
   // Get number of samples
+  const SampleStoreType * store = this->GetInputSampleStore();
   typename InputListSampleType::Pointer samples = this->GetInputListSample();
   typename TargetListSampleType::Pointer target = this->GetTargetListSample();
-  int probl = samples->Size();
+  int probl = (store != ITK_NULLPTR ? static_cast<int>(store->Size()) : samples->Size());
 
   if (probl < 1)
     {
@@ -315,7 +316,7 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
   otbMsgDebugMacro(<< "Building problem ...");
 
   // Get the size of the samples
-  long int elements = samples->GetMeasurementVectorSize();
+  long int elements = (store != ITK_NULLPTR ? store->GetNumberOfFeatures() : samples->GetMeasurementVectorSize());
 
   // Allocate the problem
   m_Problem.l = probl;
@@ -326,28 +327,48 @@ LibSVMMachineLearningModel<TInputValue,TOutputValue>
     m_Problem.x[i] = new struct svm_node[elements+1];
     }
 
-  // Iterate on the samples
-  typename InputListSampleType::ConstIterator sIt = samples->Begin();
-  typename TargetListSampleType::ConstIterator tIt = target->Begin();
-  int sampleIndex = 0;
-
-  while (sIt != samples->End() && tIt != target->End())
+  if (store != ITK_NULLPTR)
     {
-    // Set the label
-    m_Problem.y[sampleIndex] = tIt.GetMeasurementVector()[0];
-    const InputSampleType &sample = sIt.GetMeasurementVector();
-    for (int k = 0 ; k < elements ; ++k)
+    // Read the contiguous samples directly
+    for (int sampleIndex = 0; sampleIndex < probl; ++sampleIndex)
       {
-      m_Problem.x[sampleIndex][k].index = k + 1;
-      m_Problem.x[sampleIndex][k].value = sample[k];
+      m_Problem.y[sampleIndex] = store->GetLabel(sampleIndex);
+      const InputValueType * sample = store->GetSample(sampleIndex);
+      for (int k = 0 ; k < elements ; ++k)
+        {
+        m_Problem.x[sampleIndex][k].index = k + 1;
+        m_Problem.x[sampleIndex][k].value = sample[k];
+        }
+      // terminate node
+      m_Problem.x[sampleIndex][elements].index = -1;
+      m_Problem.x[sampleIndex][elements].value = 0;
       }
-    // terminate node
-    m_Problem.x[sampleIndex][elements].index = -1;
-    m_Problem.x[sampleIndex][elements].value = 0;
+    }
+  else
+    {
+    // Iterate on the samples
+    typename InputListSampleType::ConstIterator sIt = samples->Begin();
+    typename TargetListSampleType::ConstIterator tIt = target->Begin();
+    int sampleIndex = 0;
 
-    ++sampleIndex;
-    ++sIt;
-    ++tIt;
+    while (sIt != samples->End() && tIt != target->End())
+      {
+      // Set the label
+      m_Problem.y[sampleIndex] = tIt.GetMeasurementVector()[0];
+      const InputSampleType &sample = sIt.GetMeasurementVector();
+      for (int k = 0 ; k < elements ; ++k)
+        {
+        m_Problem.x[sampleIndex][k].index = k + 1;
+        m_Problem.x[sampleIndex][k].value = sample[k];
+        }
+      // terminate node
+      m_Problem.x[sampleIndex][elements].index = -1;
+      m_Problem.x[sampleIndex][elements].value = 0;
+
+      ++sampleIndex;
+      ++sIt;
+      ++tIt;
+      }
     }
 
   // Compute the kernel gamma from number of elements if necessary
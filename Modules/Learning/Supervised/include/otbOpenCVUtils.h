@@ -47,6 +47,8 @@
 
 #include "itkListSample.h"
 
+#include <limits>
+
 #ifdef OTB_OPENCV_3
 #define CV_TYPE_NAME_ML_SVM         "opencv-ml-svm"
 #define CV_TYPE_NAME_ML_RTREES      "opencv-ml-random-trees"
@@ -125,6 +127,48 @@ namespace otb
     return ListSampleToMat(listSample.GetPointer(), output);
   }
 
+  /** Converts a row-major matrix of samples to a cv::Mat */
+  template <class T> void SamplesToMat(const T * samples, int sampleCount, int sampleSize, cv::Mat & output)
+  {
+    output.create(sampleCount,sampleSize,CV_32FC1);
+    for(int sampleIdx = 0; sampleIdx < sampleCount; ++sampleIdx, samples += sampleSize)
+      {
+      for(int i = 0; i < sampleSize; ++i)
+        {
+        output.at<float>(sampleIdx,i) = samples[i];
+        }
+      }
+  }
+
+  /** Float samples are wrapped in the cv::Mat without copy, they must
+   *  stay valid as long as the cv::Mat is used. */
+  inline void SamplesToMat(const float * samples, int sampleCount, int sampleSize, cv::Mat & output)
+  {
+    output = cv::Mat(sampleCount,sampleSize,CV_32FC1,const_cast<float *>(samples));
+  }
+
+  /** Converts the training samples of a model to a cv::Mat: the contiguous
+   *  sample store of the model if it is set, its input list sample
+   *  otherwise. */
+  template <class TModel> void InputSamplesToMat(const TModel * model, cv::Mat & output)
+  {
+    typedef typename TModel::SampleStoreType     SampleStoreType;
+    typedef typename TModel::InputListSampleType InputListSampleType;
+
+    const SampleStoreType * store = model->GetInputSampleStore();
+    if (store != ITK_NULLPTR)
+      {
+      SamplesToMat(store->GetSamples(),
+                   static_cast<int>(store->Size()),
+                   static_cast<int>(store->GetNumberOfFeatures()),
+                   output);
+      }
+    else
+      {
+      ListSampleToMat<InputListSampleType>(model->GetInputListSample(), output);
+      }
+  }
+
   template <typename T> typename T::Pointer MatToListSample(const cv::Mat & cvmat)
     {
       // Build output type
@@ -157,6 +201,149 @@ namespace otb
       return output;
     }
 
+
+#ifdef OTB_OPENCV_3
+  /** Add the subtree starting at an OpenCV node to a FlatDecisionForest.
+   *  Returns -1 if a split is not a simple threshold on a feature. */
+  template <class TForest>
+  int FlattenCvNode(const std::vector<cv::ml::DTrees::Node> & nodes,
+                    const std::vector<cv::ml::DTrees::Split> & splits,
+                    int nodeIdx,
+                    TForest & forest)
+  {
+    const cv::ml::DTrees::Node & node = nodes[nodeIdx];
+    if (node.split < 0)
+      {
+      return forest.AddLeaf(node.classIdx, node.value);
+      }
+
+    const cv::ml::DTrees::Split & split = splits[node.split];
+    if (split.inversed || split.varIdx < 0)
+      {
+      return -1;
+      }
+
+    const int flatNode = forest.AddSplit(split.varIdx, split.c);
+    const int left = FlattenCvNode(nodes, splits, node.left, forest);
+    const int right = FlattenCvNode(nodes, splits, node.right, forest);
+    if (left < 0 || right < 0)
+      {
+      return -1;
+      }
+    forest.SetChildren(flatNode, left, right);
+    return flatNode;
+  }
+
+  /** Add the trees of an OpenCV decision tree model to a FlatDecisionForest.
+   *  Returns false if the trees can not be flattened (categorical splits). */
+  template <class TForest>
+  bool FlattenCvTrees(const cv::ml::DTrees & model, TForest & forest)
+  {
+    if (!model.getSubsets().empty())
+      {
+      return false;
+      }
+
+    const std::vector<cv::ml::DTrees::Node> & nodes = model.getNodes();
+    const std::vector<cv::ml::DTrees::Split> & splits = model.getSplits();
+    const std::vector<int> & roots = model.getRoots();
+
+    for (std::vector<int>::const_iterator it = roots.begin(); it != roots.end(); ++it)
+      {
+      const int root = FlattenCvNode(nodes, splits, *it, forest);
+      if (root < 0)
+        {
+        return false;
+        }
+      forest.AddTree(root);
+      }
+    return true;
+  }
+
+  /** Read the class labels of an OpenCV decision tree classifier, which are
+   *  not exposed by the API. Returns false if the model has no class labels
+   *  or if it only uses a subset of the sample features. */
+  inline bool GetCvTreesClassLabels(const cv::ml::DTrees & model, std::vector<double> & classLabels)
+  {
+    cv::FileStorage fs(".xml", cv::FileStorage::WRITE + cv::FileStorage::MEMORY);
+    fs << "model" << "{";
+    model.write(fs);
+    fs << "}";
+
+    cv::FileStorage rfs(fs.releaseAndGetString(), cv::FileStorage::READ + cv::FileStorage::MEMORY);
+    const cv::FileNode params = rfs["model"];
+    if (!params["var_idx"].empty() || params["class_labels"].empty())
+      {
+      return false;
+      }
+
+    cv::Mat labels;
+    params["class_labels"] >> labels;
+    labels.convertTo(labels, CV_64F);
+    classLabels.assign(labels.begin<double>(), labels.end<double>());
+    return !classLabels.empty();
+  }
+#else
+  /** Add the subtree starting at an OpenCV node to a FlatDecisionForest,
+   *  following the pruned tree used by CvDTree::predict().
+   *  Returns -1 if a split is not a simple threshold on a feature. */
+  template <class TForest>
+  int FlattenCvNode(const CvDTreeNode * node, int prunedTreeIdx, const int * varType, TForest & forest)
+  {
+    if (!(node->Tn > prunedTreeIdx) || !node->left)
+      {
+      return forest.AddLeaf(node->class_idx, node->value);
+      }
+
+    const CvDTreeSplit * split = node->split;
+    if (varType[split->var_idx] >= 0)
+      {
+      return -1;
+      }
+
+    const int flatNode = forest.AddSplit(split->var_idx, split->ord.c);
+    const int left = FlattenCvNode(node->left, prunedTreeIdx, varType, forest);
+    const int right = FlattenCvNode(node->right, prunedTreeIdx, varType, forest);
+    if (left < 0 || right < 0)
+      {
+      return -1;
+      }
+    // An inversed split sends the samples below the threshold to the right
+    if (split->inversed)
+      {
+      forest.SetChildren(flatNode, right, left);
+      }
+    else
+      {
+      forest.SetChildren(flatNode, left, right);
+      }
+    return flatNode;
+  }
+
+  /** Add an OpenCV decision tree to a FlatDecisionForest. If followPruning
+   *  is false, the whole tree is added, as walked by CvBoost::predict().
+   *  Returns false if the tree can not be flattened (categorical splits). */
+  template <class TForest>
+  bool FlattenCvTree(const CvDTree & tree, TForest & forest, bool followPruning = true)
+  {
+    const CvDTreeTrainData * data = tree.get_data();
+    if (data == ITK_NULLPTR || tree.get_root() == ITK_NULLPTR
+        || data->var_type == ITK_NULLPTR || data->var_idx != ITK_NULLPTR)
+      {
+      return false;
+      }
+
+    const int prunedTreeIdx = followPruning ? tree.get_pruned_tree_idx() : std::numeric_limits<int>::min();
+    const int root = FlattenCvNode(tree.get_root(), prunedTreeIdx, data->var_type->data.i, forest);
+    if (root < 0)
+      {
+      return false;
+      }
+    forest.AddTree(root);
+    return true;
+  }
+#endif
+
 }
 
 #endif
@@ -28,6 +28,7 @@
 #include "otbMachineLearningModel.h"
 #include "itkVariableSizeMatrix.h"
 #include "otbCvRTreesWrapper.h"
+#include "otbFlatDecisionForest.h"
 
 class CvRTreesWrapper;
 
@@ -51,6 +52,7 @@ public:
   typedef typename Superclass::TargetSampleType           TargetSampleType;
   typedef typename Superclass::TargetListSampleType       TargetListSampleType;
   typedef typename Superclass::ConfidenceValueType        ConfidenceValueType;
+  typedef typename Superclass::ConfidenceListSampleType   ConfidenceListSampleType;
   
   // Other
   typedef itk::VariableSizeMatrix<float>                VariableImportanceMatrixType;
@@ -125,6 +127,12 @@ public:
   itkGetMacro(ComputeMargin, bool);
   itkSetMacro(ComputeMargin, bool);
 
+  /** If true (default), batch predictions of a classification forest are
+   * computed on a flattened copy of the trees, which gives the same labels
+   * and confidences as the OpenCV model. */
+  itkGetMacro(FlatPrediction, bool);
+  itkSetMacro(FlatPrediction, bool);
+
   /** Returns a matrix containing variable importance */
   VariableImportanceMatrixType GetVariableImportance();
   
@@ -140,6 +148,8 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType *quality=ITK_NULLPTR) const ITK_OVERRIDE;
 
+  /** Predict a batch of samples, on the flattened forest if available */
+  void DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality = ITK_NULLPTR) const ITK_OVERRIDE;
   
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
@@ -154,6 +164,9 @@ private:
   RandomForestsMachineLearningModel(const Self &); //purposely not implemented
   void operator =(const Self&); //purposely not implemented
 
+  /** Flatten the trees of the OpenCV model, if possible */
+  void BuildFlatForest();
+
 #ifdef OTB_OPENCV_3
   cv::Ptr<CvRTreesWrapper> m_RFModel;
 #else
@@ -222,6 +235,12 @@ private:
    * 2 most voted classes) instead of confidence (probability of the most
    * voted class) in prediction*/
   bool m_ComputeMargin;
+  /** Use the flattened forest for batch predictions */
+  bool m_FlatPrediction;
+  /** Flattened copy of the trees, empty if the model can not be flattened */
+  FlatDecisionForest<float> m_FlatForest;
+  /** Label of each class index of the leaves */
+  std::vector<double> m_FlatClassLabels;
 };
 } // end namespace otb
 
@@ -22,7 +22,9 @@
 #define otbRandomForestsMachineLearningModel_txx
 
 #include <fstream>
+#include <algorithm>
 #include "itkMacro.h"
+#include "otbMacro.h"
 #include "otbRandomForestsMachineLearningModel.h"
 #include "otbOpenCVUtils.h"
 
@@ -47,7 +49,8 @@ RandomForestsMachineLearningModel<TInputValue,TOutputValue>
   m_MaxNumberOfTrees(100),
   m_ForestAccuracy(0.01),
   m_TerminationCriteria(CV_TERMCRIT_ITER | CV_TERMCRIT_EPS), // identic for v3 ?
-  m_ComputeMargin(false)
+  m_ComputeMargin(false),
+  m_FlatPrediction(true)
 {
   this->m_ConfidenceIndex = true;
   this->m_IsRegressionSupported = true;
@@ -71,18 +74,18 @@ RandomForestsMachineLearningModel<TInputValue,TOutputValue>
 #ifdef OTB_OPENCV_3
   // TODO
   cv::Mat samples;
-  otb::ListSampleToMat<InputListSampleType>(this->GetInputListSample(), samples);
+  otb::InputSamplesToMat(this, samples);
 
   cv::Mat labels;
   otb::ListSampleToMat<TargetListSampleType>(this->GetTargetListSample(),labels);
 
-  cv::Mat var_type = cv::Mat(this->GetInputListSample()->GetMeasurementVectorSize() + 1, 1, CV_8U );
+  cv::Mat var_type = cv::Mat(samples.cols + 1, 1, CV_8U );
   var_type.setTo(cv::Scalar(CV_VAR_NUMERICAL) ); // all inputs are numerical
 
   if(this->m_RegressionMode)
-    var_type.at<uchar>(this->GetInputListSample()->GetMeasurementVectorSize(), 0) = CV_VAR_NUMERICAL;
+    var_type.at<uchar>(samples.cols, 0) = CV_VAR_NUMERICAL;
   else
-    var_type.at<uchar>(this->GetInputListSample()->GetMeasurementVectorSize(), 0) = CV_VAR_CATEGORICAL;
+    var_type.at<uchar>(samples.cols, 0) = CV_VAR_CATEGORICAL;
 
   return m_RFModel->calcError(
     cv::ml::TrainData::create(
@@ -108,18 +111,18 @@ RandomForestsMachineLearningModel<TInputValue,TOutputValue>
 {
   //convert listsample to opencv matrix
   cv::Mat samples;
-  otb::ListSampleToMat<InputListSampleType>(this->GetInputListSample(), samples);
+  otb::InputSamplesToMat(this, samples);
 
   cv::Mat labels;
   otb::ListSampleToMat<TargetListSampleType>(this->GetTargetListSample(),labels);
 
-  cv::Mat var_type = cv::Mat(this->GetInputListSample()->GetMeasurementVectorSize() + 1, 1, CV_8U );
+  cv::Mat var_type = cv::Mat(samples.cols + 1, 1, CV_8U );
   var_type.setTo(cv::Scalar(CV_VAR_NUMERICAL) ); // all inputs are numerical
 
   if(this->m_RegressionMode)
-    var_type.at<uchar>(this->GetInputListSample()->GetMeasurementVectorSize(), 0) = CV_VAR_NUMERICAL;
+    var_type.at<uchar>(samples.cols, 0) = CV_VAR_NUMERICAL;
   else
-    var_type.at<uchar>(this->GetInputListSample()->GetMeasurementVectorSize(), 0) = CV_VAR_CATEGORICAL;
+    var_type.at<uchar>(samples.cols, 0) = CV_VAR_CATEGORICAL;
 
   //Mat var_type = Mat(ATTRIBUTES_PER_SAMPLE + 1, 1, CV_8U );
   //std::cout << "priors " << m_Priors[0] << std::endl;
@@ -165,6 +168,62 @@ RandomForestsMachineLearningModel<TInputValue,TOutputValue>
   m_RFModel->train(samples, CV_ROW_SAMPLE, labels,
                    cv::Mat(), cv::Mat(), var_type, cv::Mat(), params);
 #endif
+
+  this->BuildFlatForest();
+}
+
+template <class TInputValue, class TOutputValue>
+void
+RandomForestsMachineLearningModel<TInputValue,TOutputValue>
+::BuildFlatForest()
+{
+  m_FlatForest.Clear();
+  m_FlatClassLabels.clear();
+
+  // Only the vote of a classification forest is flattened
+#ifdef OTB_OPENCV_3
+  bool flattened = m_RFModel->isTrained() && m_RFModel->isClassifier()
+    && otb::GetCvTreesClassLabels(*m_RFModel, m_FlatClassLabels)
+    && otb::FlattenCvTrees(*m_RFModel, m_FlatForest);
+#else
+  bool flattened = m_RFModel->get_tree_count() > 0
+    && m_RFModel->get_tree(0)->get_data() != ITK_NULLPTR
+    && m_RFModel->get_tree(0)->get_data()->is_classifier;
+  for (int k = 0; flattened && k < m_RFModel->get_tree_count(); ++k)
+    {
+    flattened = otb::FlattenCvTree(*m_RFModel->get_tree(k), m_FlatForest);
+    }
+
+  // The value of the leaves is the label of their class
+  for (unsigned int node = 0; flattened && node < m_FlatForest.GetNumberOfNodes(); ++node)
+    {
+    if (m_FlatForest.IsLeaf(node) && m_FlatForest.GetClassIndex(node) >= 0)
+      {
+      const unsigned int classIdx = m_FlatForest.GetClassIndex(node);
+      if (classIdx >= m_FlatClassLabels.size())
+        {
+        m_FlatClassLabels.resize(classIdx + 1, 0.);
+        }
+      m_FlatClassLabels[classIdx] = m_FlatForest.GetValue(node);
+      }
+    }
+#endif
+
+  for (unsigned int node = 0; flattened && node < m_FlatForest.GetNumberOfNodes(); ++node)
+    {
+    if (m_FlatForest.IsLeaf(node))
+      {
+      const int classIdx = m_FlatForest.GetClassIndex(node);
+      flattened = classIdx >= 0 && static_cast<unsigned int>(classIdx) < m_FlatClassLabels.size();
+      }
+    }
+
+  if (!flattened)
+    {
+    otbMsgDevMacro(<< "Random forest can not be flattened, batch predictions will use OpenCV");
+    m_FlatForest.Clear();
+    m_FlatClassLabels.clear();
+    }
 }
 
 template <class TInputValue, class TOutputValue>
@@ -193,6 +252,158 @@ RandomForestsMachineLearningModel<TInputValue,TOutputValue>
   return target[0];
 }
 
+template <class TInputValue, class TOutputValue>
+void
+RandomForestsMachineLearningModel<TInputValue,TOutputValue>
+::DoPredictBatch(const InputListSampleType * input, const unsigned int & startIndex, const unsigned int & size, TargetListSampleType * targets, ConfidenceListSampleType * quality) const
+{
+  assert(input != ITK_NULLPTR);
+  assert(targets != ITK_NULLPTR);
+
+  if(startIndex+size>input->Size())
+    {
+    itkExceptionMacro(<<"requested range ["<<startIndex<<", "<<startIndex+size<<"[ partially outside input sample list range.[0,"<<input->Size()<<"[");
+    }
+
+  const unsigned int nbFeatures = input->GetMeasurementVectorSize();
+
+  if (!m_FlatPrediction || m_FlatForest.IsEmpty() || nbFeatures < m_FlatForest.GetNumberOfFeatures())
+    {
+    for (unsigned int id = startIndex; id < startIndex + size; ++id)
+      {
+      ConfidenceValueType confidence = 0;
+      const TargetSampleType target = this->DoPredict(input->GetMeasurementVector(id),
+                                                      quality != ITK_NULLPTR ? &confidence : ITK_NULLPTR);
+      if (quality != ITK_NULLPTR)
+        {
+        quality->SetMeasurementVector(id, confidence);
+        }
+      targets->SetMeasurementVector(id, target);
+      }
+    return;
+    }
+
+  // Samples are processed by blocks, each tree being evaluated on a whole
+  // block before the next one
+  const unsigned int blockSize = 64;
+  const unsigned int nbTrees = m_FlatForest.GetNumberOfTrees();
+  const unsigned int nbClasses = std::max(static_cast<unsigned int>(m_FlatClassLabels.size()), 2u);
+
+  std::vector<float> samples(blockSize * nbFeatures);
+  std::vector<bool> missing(blockSize);
+  std::vector<typename FlatDecisionForest<float>::NodeIndexType> leaves(blockSize);
+  std::vector<unsigned int> votes(blockSize * nbClasses);
+  std::vector<unsigned int> maxVotes(blockSize);
+  std::vector<unsigned int> bestClass(blockSize);
+
+  for (unsigned int blockStart = startIndex; blockStart < startIndex + size; blockStart += blockSize)
+    {
+    const unsigned int nbSamples = std::min(blockSize, startIndex + size - blockStart);
+
+    for (unsigned int i = 0; i < nbSamples; ++i)
+      {
+      const InputSampleType & sample = input->GetMeasurementVector(blockStart + i);
+      float * flatSample = &samples[i * nbFeatures];
+      missing[i] = false;
+      for (unsigned int f = 0; f < nbFeatures; ++f)
+        {
+        flatSample[f] = sample[f];
+#ifdef OTB_OPENCV_3
+        // Missing values follow the default direction of the nodes
+        missing[i] = missing[i] || flatSample[f] == cv::ml::TrainData::missingValue();
+#endif
+        }
+      }
+
+    std::fill(votes.begin(), votes.end(), 0u);
+    std::fill(maxVotes.begin(), maxVotes.end(), 0u);
+    std::fill(bestClass.begin(), bestClass.end(), 0u);
+
+    for (unsigned int tree = 0; tree < nbTrees; ++tree)
+      {
+      m_FlatForest.EvaluateTree(tree, &samples[0], nbSamples, nbFeatures, &leaves[0]);
+      for (unsigned int i = 0; i < nbSamples; ++i)
+        {
+        const unsigned int classIdx = m_FlatForest.GetClassIndex(leaves[i]);
+        const unsigned int nbVotes = ++votes[i * nbClasses + classIdx];
+#ifndef OTB_OPENCV_3
+        // CvRTrees::predict() keeps the first class reaching the maximum
+        if (nbVotes > maxVotes[i])
+          {
+          maxVotes[i] = nbVotes;
+          bestClass[i] = classIdx;
+          }
+#else
+        (void) nbVotes;
+#endif
+        }
+      }
+
+    for (unsigned int i = 0; i < nbSamples; ++i)
+      {
+      const unsigned int id = blockStart + i;
+      if (missing[i])
+        {
+        ConfidenceValueType confidence = 0;
+        const TargetSampleType target = this->DoPredict(input->GetMeasurementVector(id),
+                                                        quality != ITK_NULLPTR ? &confidence : ITK_NULLPTR);
+        if (quality != ITK_NULLPTR)
+          {
+          quality->SetMeasurementVector(id, confidence);
+          }
+        targets->SetMeasurementVector(id, target);
+        continue;
+        }
+
+      const unsigned int * sampleVotes = &votes[i * nbClasses];
+#ifdef OTB_OPENCV_3
+      // RTrees::predict() keeps the smallest class index among the maxima
+      for (unsigned int k = 1; k < nbClasses; ++k)
+        {
+        if (sampleVotes[k] > sampleVotes[bestClass[i]])
+          {
+          bestClass[i] = k;
+          }
+        }
+      maxVotes[i] = sampleVotes[bestClass[i]];
+#endif
+
+      const double result = static_cast<float>(m_FlatClassLabels[bestClass[i]]);
+      TargetSampleType target;
+      target[0] = static_cast<TOutputValue>(result);
+      targets->SetMeasurementVector(id, target);
+
+      if (quality != ITK_NULLPTR)
+        {
+        ConfidenceValueType confidence = 0;
+        if (m_ComputeMargin)
+          {
+          unsigned int first = 0;
+          unsigned int second = 0;
+          for (unsigned int k = 0; k < nbClasses; ++k)
+            {
+            if (sampleVotes[k] > first)
+              {
+              second = first;
+              first = sampleVotes[k];
+              }
+            else if (sampleVotes[k] > second)
+              {
+              second = sampleVotes[k];
+              }
+            }
+          confidence = static_cast<float>(first - second) / static_cast<int>(nbTrees);
+          }
+        else
+          {
+          confidence = static_cast<float>(maxVotes[i]) / static_cast<int>(nbTrees);
+          }
+        quality->SetMeasurementVector(id, confidence);
+        }
+      }
+    }
+}
+
 template <class TInputValue, class TOutputValue>
 void
 RandomForestsMachineLearningModel<TInputValue,TOutputValue>
@@ -226,6 +437,8 @@ RandomForestsMachineLearningModel<TInputValue,TOutputValue>
   else
     m_RFModel->load(filename.c_str(), name.c_str());
 #endif
+
+  this->BuildFlatForest();
 }
 
 template <class TInputValue, class TOutputValue>
@@ -71,12 +71,12 @@ SharkRandomForestsMachineLearningModel<TInputValue,TOutputValue>
   omp_set_num_threads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
 #endif
   
-  std::vector<shark::RealVector> features;
-  std::vector<unsigned int> class_labels;
+  shark::Data<shark::RealVector> features;
+  shark::Data<unsigned int> class_labels;
 
-  Shark::ListSampleToSharkVector(this->GetInputListSample(), features);
-  Shark::ListSampleToSharkVector(this->GetTargetListSample(), class_labels);
-  shark::ClassificationDataset TrainSamples = shark::createLabeledDataFromRange(features,class_labels);
+  Shark::InputSamplesToSharkData(this, features);
+  Shark::ListSampleToSharkData(this->GetTargetListSample(), class_labels);
+  shark::ClassificationDataset TrainSamples(features,class_labels);
 
   //Set parameters
   m_RFTrainer.setMTry(m_MTry);
@@ -153,9 +153,8 @@ SharkRandomForestsMachineLearningModel<TInputValue,TOutputValue>
     itkExceptionMacro(<<"requested range ["<<startIndex<<", "<<startIndex+size<<"[ partially outside input sample list range.[0,"<<input->Size()<<"[");
     }
   
-  std::vector<shark::RealVector> features;
-  Shark::ListSampleRangeToSharkVector(input, features,startIndex,size);
-  shark::Data<shark::RealVector> inputSamples = shark::createDataFromRange(features);
+  shark::Data<shark::RealVector> inputSamples;
+  Shark::ListSampleRangeToSharkData(input, inputSamples,startIndex,size);
 
   #ifdef _OPENMP
   omp_set_num_threads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
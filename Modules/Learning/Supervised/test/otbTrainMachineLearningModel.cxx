@@ -45,6 +45,7 @@ typedef MachineLearningModelRegressionType::TargetSampleType     TargetSampleReg
 typedef MachineLearningModelRegressionType::TargetListSampleType TargetListSampleRegressionType;
 
 typedef otb::ConfusionMatrixCalculator<TargetListSampleType, TargetListSampleType> ConfusionMatrixCalculatorType;
+typedef MachineLearningModelType::ConfidenceListSampleType ConfidenceListSampleType;
 
 bool ReadDataFile(const std::string & infname, InputListSampleType * samples, TargetListSampleType * labels)
 {
@@ -496,6 +497,38 @@ int otbKNearestNeighborsMachineLearningModel(int argc, char * argv[])
     }
 }
 
+// Check that batch predictions on the flattened trees are identical to the
+// predictions of the OpenCV model
+template <class TModel>
+bool CheckFlatPrediction(TModel * classifier, const InputListSampleType * samples, bool withConfidence)
+{
+  ConfidenceListSampleType::Pointer quality = ConfidenceListSampleType::New();
+  ConfidenceListSampleType::Pointer qualityRef = ConfidenceListSampleType::New();
+
+  classifier->SetFlatPrediction(true);
+  TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, withConfidence ? quality.GetPointer() : ITK_NULLPTR);
+  classifier->SetFlatPrediction(false);
+  TargetListSampleType::Pointer predictedRef = classifier->PredictBatch(samples, withConfidence ? qualityRef.GetPointer() : ITK_NULLPTR);
+  classifier->SetFlatPrediction(true);
+
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+    {
+    if (predicted->GetMeasurementVector(i)[0] != predictedRef->GetMeasurementVector(i)[0])
+      {
+      std::cout << "Flat prediction of sample " << i << " is " << predicted->GetMeasurementVector(i)[0]
+                << " instead of " << predictedRef->GetMeasurementVector(i)[0] << std::endl;
+      return false;
+      }
+    if (withConfidence && quality->GetMeasurementVector(i)[0] != qualityRef->GetMeasurementVector(i)[0])
+      {
+      std::cout << "Flat confidence of sample " << i << " is " << quality->GetMeasurementVector(i)[0]
+                << " instead of " << qualityRef->GetMeasurementVector(i)[0] << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
 int otbRandomForestsMachineLearningModelNew(int itkNotUsed(argc), char * itkNotUsed(argv) [])
 {
   typedef otb::RandomForestsMachineLearningModel<InputValueType,TargetValueType> RandomForestType;
@@ -541,6 +574,22 @@ int otbRandomForestsMachineLearningModel(int argc, char * argv[])
 
   TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
 
+  if (!CheckFlatPrediction(classifier.GetPointer(), samples, false))
+    {
+    return EXIT_FAILURE;
+    }
+  classifier->SetComputeMargin(false);
+  if (!CheckFlatPrediction(classifier.GetPointer(), samples, true))
+    {
+    return EXIT_FAILURE;
+    }
+  classifier->SetComputeMargin(true);
+  if (!CheckFlatPrediction(classifier.GetPointer(), samples, true))
+    {
+    return EXIT_FAILURE;
+    }
+  classifier->SetComputeMargin(false);
+
   ConfusionMatrixCalculatorType::Pointer cmCalculator = ConfusionMatrixCalculatorType::New();
 
   cmCalculator->SetProducedLabels(predicted);
@@ -559,6 +608,11 @@ int otbRandomForestsMachineLearningModel(int argc, char * argv[])
   classifierLoad->Load(argv[2]);
   TargetListSampleType::Pointer predictedLoad = classifierLoad->PredictBatch(samples, NULL);
 
+  if (!CheckFlatPrediction(classifierLoad.GetPointer(), samples, true))
+    {
+    return EXIT_FAILURE;
+    }
+
   ConfusionMatrixCalculatorType::Pointer cmCalculatorLoad = ConfusionMatrixCalculatorType::New();
 
   cmCalculatorLoad->SetProducedLabels(predictedLoad);
@@ -625,6 +679,12 @@ int otbBoostMachineLearningModel(int argc, char * argv[])
 
   TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
 
+  if (!CheckFlatPrediction(classifier.GetPointer(), samples, false)
+      || !CheckFlatPrediction(classifier.GetPointer(), samples, true))
+    {
+    return EXIT_FAILURE;
+    }
+
   classifier->Save(argv[2]);
 
   ConfusionMatrixCalculatorType::Pointer cmCalculator = ConfusionMatrixCalculatorType::New();
@@ -645,6 +705,11 @@ int otbBoostMachineLearningModel(int argc, char * argv[])
   classifierLoad->Load(argv[2]);
   TargetListSampleType::Pointer predictedLoad = classifierLoad->PredictBatch(samples, NULL);
 
+  if (!CheckFlatPrediction(classifierLoad.GetPointer(), samples, true))
+    {
+    return EXIT_FAILURE;
+    }
+
   ConfusionMatrixCalculatorType::Pointer cmCalculatorLoad = ConfusionMatrixCalculatorType::New();
 
   cmCalculatorLoad->SetProducedLabels(predictedLoad);
@@ -869,6 +934,11 @@ int otbDecisionTreeMachineLearningModel(int argc, char * argv[])
 
   TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
 
+  if (!CheckFlatPrediction(classifier.GetPointer(), samples, false))
+    {
+    return EXIT_FAILURE;
+    }
+
   classifier->Save(argv[2]);
 
   ConfusionMatrixCalculatorType::Pointer cmCalculator = ConfusionMatrixCalculatorType::New();
@@ -889,6 +959,11 @@ int otbDecisionTreeMachineLearningModel(int argc, char * argv[])
   classifierLoad->Load(argv[2]);
   TargetListSampleType::Pointer predictedLoad = classifierLoad->PredictBatch(samples, NULL);
 
+  if (!CheckFlatPrediction(classifierLoad.GetPointer(), samples, false))
+    {
+    return EXIT_FAILURE;
+    }
+
   ConfusionMatrixCalculatorType::Pointer cmCalculatorLoad = ConfusionMatrixCalculatorType::New();
 
   cmCalculatorLoad->SetProducedLabels(predictedLoad);
@@ -72,9 +72,8 @@ SharkKMeansMachineLearningModel<TInputValue, TOutputValue>
 ::Train()
 {
   // Parse input data and convert to Shark Data
-  std::vector<shark::RealVector> vector_data;
-  otb::Shark::ListSampleToSharkVector( this->GetInputListSample(), vector_data );
-  shark::Data<shark::RealVector> data = shark::createDataFromRange( vector_data );
+  shark::Data<shark::RealVector> data;
+  otb::Shark::InputSamplesToSharkData( this, data );
 
   // Normalized input value if necessary
   if( m_Normalized )
@@ -147,9 +146,8 @@ SharkKMeansMachineLearningModel<TInputValue, TOutputValue>
     }
 
   // Convert input list of features to shark data format
-  std::vector<shark::RealVector> features;
-  otb::Shark::ListSampleRangeToSharkVector( input, features, startIndex, size );
-  shark::Data<shark::RealVector> inputSamples = shark::createDataFromRange( features );
+  shark::Data<shark::RealVector> inputSamples;
+  otb::Shark::ListSampleRangeToSharkData( input, inputSamples, startIndex, size );
 
   shark::Data<ClusteringOutputType> clusters;
   try
@@ -66,6 +66,10 @@ public:
   /** Blocks until all processes have reached this routine */
   void barrier();
 
+  /** Gathers count values of each process in the receive buffer of the
+   *  root process, which must hold count values per process */
+  void gather(const double* sendBuffer, int count, double* recvBuffer, int root = 0);
+
   /** Log error */
   void logError(const std::string message);
 
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMPISharedCounter_h
+#define otbMPISharedCounter_h
+
+#include "itkLightObject.h"
+#include "itkObjectFactory.h"
+
+namespace otb {
+
+/** \class MPISharedCounter
+  *  \brief Counter shared by all the MPI processes
+  *
+  * The counter is stored on process 0 and updated with atomic one-sided
+  * operations (MPI-3), so that any process can fetch a new value without
+  * waiting for the others. It is typically used to hand out work items
+  * dynamically. Create() and Free() are collective operations and must be
+  * called by all the processes. Without MPI (or with a single process),
+  * the counter is local.
+  *
+  * \ingroup OTBMPIConfig
+  */
+class MPISharedCounter: public itk::LightObject
+{
+public:
+  /** Standard class typedefs. */
+  typedef MPISharedCounter              Self;
+  typedef itk::LightObject              Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MPISharedCounter, itk::LightObject);
+
+  /** Creates the shared counter with an initial value (collective) */
+  void Create(long initialValue);
+
+  /** Releases the shared counter (collective) */
+  void Free();
+
+  /** Atomically adds increment to the counter and returns its previous value */
+  long FetchAndAdd(long increment = 1);
+
+protected:
+  /** Constructor */
+  MPISharedCounter();
+
+  /** Destructor. Free() must have been called before, since it is collective */
+  virtual ~MPISharedCounter();
+
+private:
+  MPISharedCounter(const MPISharedCounter &); //purposely not implemented
+  void operator =(const MPISharedCounter&); //purposely not implemented
+
+  struct Internals;
+  Internals * m_Internals;
+};
+
+} // End namespace otb
+
+#endif //otbMPISharedCounter_h
@@ -19,6 +19,7 @@
  */
 
 #include "otbMPIConfig.h"
+#include "otbMPISharedCounter.h"
 
 #include <exception>
 #include <cstdlib>
@@ -26,6 +27,7 @@
 #include <sstream>
 #include <string>
 #include <cassert>
+#include <algorithm>
 
 #if defined(__GNUC__) || defined(__clang__)
 # pragma GCC diagnostic push
@@ -169,6 +171,17 @@ void MPIConfig::barrier()
 	OTB_MPI_CHECK_RESULT(MPI_Barrier, (MPI_COMM_WORLD));
 }
 
+void MPIConfig::gather(const double* sendBuffer, int count, double* recvBuffer, int root)
+{
+  if( !m_initialized )
+    {
+    std::copy(sendBuffer, sendBuffer + count, recvBuffer);
+    return;
+    }
+  OTB_MPI_CHECK_RESULT(MPI_Gather, (const_cast<double*>(sendBuffer), count, MPI_DOUBLE,
+                                    recvBuffer, count, MPI_DOUBLE, root, MPI_COMM_WORLD));
+}
+
 void MPIConfig::logError(const std::string message) {
    if (m_MyRank == 0)
    {
@@ -183,4 +196,85 @@ void MPIConfig::logInfo(const std::string message) {
    }
 }
 
+/** Shared counter internals, hiding the MPI window */
+struct MPISharedCounter::Internals
+{
+  MPI_Win Window;
+  long *  Value;
+  long    LocalValue;
+  bool    Shared;
+};
+
+MPISharedCounter::MPISharedCounter()
+  : m_Internals(ITK_NULLPTR)
+{
+}
+
+MPISharedCounter::~MPISharedCounter()
+{
+  delete m_Internals;
+}
+
+void MPISharedCounter::Create(long initialValue)
+{
+  this->Free();
+
+  MPIConfig::Pointer config = MPIConfig::Instance();
+  m_Internals = new Internals;
+  m_Internals->Value = ITK_NULLPTR;
+  m_Internals->LocalValue = initialValue;
+  m_Internals->Shared = config->GetNbProcs() > 1;
+
+  if( m_Internals->Shared )
+    {
+    // The counter is stored on process 0 only
+    const bool isOwner = ( config->GetMyRank() == 0 );
+    MPI_Aint size = isOwner ? static_cast<MPI_Aint>(sizeof(long)) : 0;
+    OTB_MPI_CHECK_RESULT( MPI_Win_allocate, ( size, sizeof(long), MPI_INFO_NULL, MPI_COMM_WORLD,
+                                              &m_Internals->Value, &m_Internals->Window ));
+    if( isOwner )
+      {
+      OTB_MPI_CHECK_RESULT( MPI_Win_lock, ( MPI_LOCK_EXCLUSIVE, 0, 0, m_Internals->Window ));
+      *m_Internals->Value = initialValue;
+      OTB_MPI_CHECK_RESULT( MPI_Win_unlock, ( 0, m_Internals->Window ));
+      }
+    config->barrier();
+    OTB_MPI_CHECK_RESULT( MPI_Win_lock_all, ( MPI_MODE_NOCHECK, m_Internals->Window ));
+    }
+}
+
+void MPISharedCounter::Free()
+{
+  if( m_Internals == ITK_NULLPTR )
+    {
+    return;
+    }
+  if( m_Internals->Shared )
+    {
+    OTB_MPI_CHECK_RESULT( MPI_Win_unlock_all, ( m_Internals->Window ));
+    OTB_MPI_CHECK_RESULT( MPI_Win_free, ( &m_Internals->Window ));
+    }
+  delete m_Internals;
+  m_Internals = ITK_NULLPTR;
+}
+
+long MPISharedCounter::FetchAndAdd(long increment)
+{
+  if( m_Internals == ITK_NULLPTR )
+    {
+    itkExceptionMacro(<< "Shared counter is not created");
+    }
+  long previous = m_Internals->LocalValue;
+  if( m_Internals->Shared )
+    {
+    OTB_MPI_CHECK_RESULT( MPI_Fetch_and_op, ( &increment, &previous, MPI_LONG, 0, 0, MPI_SUM, m_Internals->Window ));
+    OTB_MPI_CHECK_RESULT( MPI_Win_flush, ( 0, m_Internals->Window ));
+    }
+  else
+    {
+    m_Internals->LocalValue += increment;
+    }
+  return previous;
+}
+
 } // End namespace otb
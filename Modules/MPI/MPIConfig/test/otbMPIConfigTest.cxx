@@ -20,8 +20,12 @@
 
 
 #include "otbMPIConfig.h"
+#include "otbMPISharedCounter.h"
 #include <iostream>
 #include "itkMultiThreader.h"
+#include <algorithm>
+#include <numeric>
+#include <vector>
 
 int otbMPIConfigTest(int argc, char* argv[]) {
 
@@ -36,3 +40,50 @@ int otbMPIConfigTest(int argc, char* argv[]) {
   return EXIT_SUCCESS;
 }
 
+
+int otbMPISharedCounterTest(int argc, char* argv[]) {
+
+  // MPI Configuration
+  typedef otb::MPIConfig    MPIConfigType;
+  MPIConfigType::Pointer config = MPIConfigType::Instance();
+  config->Init(argc,argv,true);
+
+  const long nbFetch = 100;
+
+  otb::MPISharedCounter::Pointer counter = otb::MPISharedCounter::New();
+  counter->Create(0);
+
+  // Each value must be fetched by a single process
+  double sum = 0;
+  for (long i = 0; i < nbFetch; ++i)
+    {
+    sum += counter->FetchAndAdd(1);
+    }
+  config->barrier();
+  const long total = counter->FetchAndAdd(0);
+  counter->Free();
+
+  const unsigned int nbProcs = std::max(config->GetNbProcs(), 1U);
+  std::vector<double> sums(nbProcs);
+  config->gather(&sum, 1, &(sums[0]));
+
+  if (total != nbFetch * static_cast<long>(nbProcs))
+    {
+    std::cerr << "Process " << config->GetMyRank() << " reads " << total << " instead of "
+              << nbFetch * nbProcs << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (config->GetMyRank() == 0)
+    {
+    const double expected = 0.5 * static_cast<double>(total) * static_cast<double>(total - 1);
+    const double gathered = std::accumulate(sums.begin(), sums.end(), 0.0);
+    if (gathered != expected)
+      {
+      std::cerr << "Sum of fetched values is " << gathered << " instead of " << expected << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
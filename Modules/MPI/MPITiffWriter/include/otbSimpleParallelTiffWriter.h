@@ -27,6 +27,7 @@
 #include "otbStreamingManager.h"
 #include "otbExtendedFilenameToWriterOptions.h"
 #include "otbMPIConfig.h"
+#include "otbMPISharedCounter.h"
 
 // Time probe
 #include "itkTimeProbe.h"
@@ -104,6 +105,21 @@ namespace otb
  * layout is optimized for the number of MPI processes for stripped regions.
  * TODO: optimize the splitting layout for tiled regions
  *
+ * By default, divisions are assigned to the MPI processes in a round-robin
+ * fashion. With DynamicScheduling on, each process starts with the division
+ * matching its rank and then requests the next division to process through
+ * a counter shared over MPI, so that processes handling cheap divisions
+ * (no-data areas for instance) go on with the remaining ones instead of
+ * waiting for the others. In verbose mode, the master process reports the
+ * processing, writing and waiting times of each process.
+ *
+ * Tiles can be compressed with DEFLATE or LZW (TiffCompression, or the
+ * gdal:co:COMPRESS option of the extended filename). The output is then
+ * tiled and divided in bands of whole tile rows: each process compresses
+ * its tiles locally, appends them at the end of the file at an offset
+ * obtained from a counter shared over MPI, and the tile offsets are
+ * gathered and written in the TIFF directory when the raster is closed.
+ *
  *
  * \sa ImageFileWriter
  * \ingroup OTBMPITiffWriter
@@ -250,11 +266,19 @@ public:
   itkSetMacro(VirtualMode, bool);
   itkGetMacro(VirtualMode, bool);
 
+  /** Distribute the divisions dynamically among the MPI processes */
+  itkSetMacro(DynamicScheduling, bool);
+  itkGetMacro(DynamicScheduling, bool);
+  itkBooleanMacro(DynamicScheduling);
+
   /* GeoTiff options */
   itkSetMacro(TiffTileSize, int);
   itkGetMacro(TiffTileSize, int);
   itkSetMacro(TiffTiledMode, bool);
   itkGetMacro(TiffTiledMode, bool);
+  /** Compression of the tiles: NONE (default), DEFLATE or LZW */
+  itkSetMacro(TiffCompression, std::string);
+  itkGetMacro(TiffCompression, std::string);
 
 protected:
   SimpleParallelTiffWriter();
@@ -296,6 +320,26 @@ private:
    */
   unsigned int OptimizeStrippedSplittingLayout(unsigned int n);
 
+  /*
+   * Returns the region of a division
+   */
+  InputImageRegionType GetDivisionRegion(unsigned int division);
+
+  /*
+   * Processes a division and writes it to the output raster
+   */
+  void ProcessAndWriteDivision(const InputImageRegionType & streamRegion,
+                               sptw::PTIFF * output_raster,
+                               double & processDuration,
+                               double & writeDuration);
+
+  /*
+   * Gathers the runtimes of all processes and reports them on the master
+   */
+  void ReportLoadBalance(double processDuration, double writeDuration,
+                         double waitDuration, double numberOfProcessedRegions,
+                         double overallDuration);
+
   unsigned int m_NumberOfDivisions;
   unsigned int m_CurrentDivision;
   float m_DivisionProgress;
@@ -329,6 +373,14 @@ private:
   bool m_Verbose;
   bool m_VirtualMode;
   bool m_TiffTiledMode;
+  std::string m_TiffCompression;
+  bool m_DynamicScheduling;
+
+  // Compressed output: divisions are bands of whole tile rows
+  InputImageRegionType m_CompressedRegion;
+  unsigned long m_CompressedLinesPerDivision;
+  // Compressed output: end of the data written in the file
+  otb::MPISharedCounter::Pointer m_CompressedDataEnd;
 };
 
 
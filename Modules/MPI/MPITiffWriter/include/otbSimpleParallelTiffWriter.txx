@@ -61,12 +61,19 @@ SimpleParallelTiffWriter<TInputImage>
   // Strip blocks
   m_TiffTiledMode = false;
 
+  // Uncompressed blocks
+  m_TiffCompression = "NONE";
+  m_CompressedLinesPerDivision = 0;
+
   // Verbose
   m_Verbose = false;
 
   // Virtual mode
   m_VirtualMode = false;
 
+  // Static (round-robin) distribution of the divisions
+  m_DynamicScheduling = false;
+
   // By default, we use striped streaming, with automatic region size
   // We don't set any parameter, so the memory size is retrieved from the OTB configuration options
   //this->SetAutomaticAdaptativeStreaming();
@@ -113,6 +120,138 @@ SimpleParallelTiffWriter<TInputImage>
 
  }
 
+/*
+ * Returns the region of a division
+ */
+template <class TInputImage>
+typename SimpleParallelTiffWriter<TInputImage>::InputImageRegionType
+SimpleParallelTiffWriter<TInputImage>
+::GetDivisionRegion(unsigned int division)
+ {
+  if (m_CompressedLinesPerDivision == 0)
+    {
+    return m_StreamingManager->GetSplit(division);
+    }
+
+  // Band of whole tile rows
+  InputImageRegionType region = m_CompressedRegion;
+  const unsigned long firstLine = division * m_CompressedLinesPerDivision;
+  region.SetIndex(1, m_CompressedRegion.GetIndex()[1] + firstLine);
+  region.SetSize(1, std::min(m_CompressedLinesPerDivision,
+                             static_cast<unsigned long>(m_CompressedRegion.GetSize()[1]) - firstLine));
+  return region;
+ }
+
+/*
+ * Processes a division and writes it to the output raster
+ */
+template <class TInputImage>
+void
+SimpleParallelTiffWriter<TInputImage>
+::ProcessAndWriteDivision(const InputImageRegionType & streamRegion,
+                          PTIFF * output_raster,
+                          double & processDuration,
+                          double & writeDuration)
+ {
+  InputImageType * inputPtr = const_cast<InputImageType *>(this->GetInput());
+
+  /*
+   * Processing
+   */
+  itk::TimeProbe processingTime;
+  processingTime.Start();
+  inputPtr->SetRequestedRegion(streamRegion);
+  inputPtr->PropagateRequestedRegion();
+  inputPtr->UpdateOutputData();
+  processingTime.Stop();
+  processDuration += processingTime.GetTotal();
+
+  /*
+   * Writing using SPTW
+   */
+  itk::TimeProbe writingTime;
+  writingTime.Start();
+  if (!m_VirtualMode && m_CompressedDataEnd.IsNotNull())
+    {
+    // Compress the tiles locally, then reserve their place at the end of the file
+    sptw::CompressedArea area;
+    SPTW_ERROR sperr = sptw::compress_area(output_raster,
+        inputPtr->GetBufferPointer(),
+        streamRegion.GetIndex()[0],
+        streamRegion.GetIndex()[1],
+        streamRegion.GetIndex()[0] + streamRegion.GetSize()[0] -1,
+        streamRegion.GetIndex()[1] + streamRegion.GetSize()[1] -1,
+        &area);
+    if (sperr == sptw::SP_None)
+      {
+      const long offset = m_CompressedDataEnd->FetchAndAdd(static_cast<long>(area.data.size()));
+      sperr = sptw::write_compressed_area(output_raster, area, offset);
+      }
+    if (sperr != sptw::SP_None)
+      {
+      otb::MPIConfig::Instance()->logError("Error writing compressed tiles");
+      otb::MPIConfig::Instance()->abort(EXIT_FAILURE);
+      }
+    }
+  else if (!m_VirtualMode)
+    {
+    sptw::write_area(output_raster,
+        inputPtr->GetBufferPointer(),
+        streamRegion.GetIndex()[0],
+        streamRegion.GetIndex()[1],
+        streamRegion.GetIndex()[0] + streamRegion.GetSize()[0] -1,
+        streamRegion.GetIndex()[1] + streamRegion.GetSize()[1] -1);
+    }
+  writingTime.Stop();
+  writeDuration += writingTime.GetTotal();
+ }
+
+/*
+ * Gathers the runtimes of all processes and reports them on the master
+ */
+template <class TInputImage>
+void
+SimpleParallelTiffWriter<TInputImage>
+::ReportLoadBalance(double processDuration, double writeDuration,
+                    double waitDuration, double numberOfProcessedRegions,
+                    double overallDuration)
+ {
+  // Get timings
+  const int nValues = 4;
+  double runtimes[nValues] = {processDuration, writeDuration, waitDuration, numberOfProcessedRegions};
+  const unsigned int nbProcs = std::max(otb::MPIConfig::Instance()->GetNbProcs(), 1U);
+  std::vector<double> process_runtimes(nbProcs*nValues);
+  otb::MPIConfig::Instance()->gather(runtimes, nValues, &(process_runtimes[0]));
+
+  // Display timings
+  if (otb::MPIConfig::Instance()->GetMyRank() == 0 && m_Verbose)
+    {
+    std::ostringstream oss;
+    oss << "Runtime, in seconds" << std::endl;
+    oss << "Process Id\tProcessing\tWriting\tWaiting" << std::endl;
+    double maxBusy = 0.0;
+    double sumBusy = 0.0;
+    for (unsigned int i = 0; i < process_runtimes.size(); i+=nValues)
+      {
+      oss << (i/nValues) <<
+        "\t" << process_runtimes[i] <<
+        "\t" << process_runtimes[i+1] <<
+        "\t" << process_runtimes[i+2] <<
+        "\t(" << process_runtimes[i+3] << " regions)" << std::endl;
+      const double busy = process_runtimes[i] + process_runtimes[i+1];
+      maxBusy = std::max(maxBusy, busy);
+      sumBusy += busy;
+      }
+    oss << "Overall time: " << overallDuration << std::endl;
+    // Ratio between the busiest process and the average one, 1 is a perfect balance
+    if (sumBusy > 0.0)
+      {
+      oss << "Load imbalance (max/mean busy time): " << maxBusy * nbProcs / sumBusy;
+      }
+    otb::MPIConfig::Instance()->logInfo(oss.str());
+    }
+ }
+
 template <class TInputImage>
 void
 SimpleParallelTiffWriter<TInputImage>
@@ -517,12 +656,44 @@ SimpleParallelTiffWriter<TInputImage>
     dataType = otb::GdalDataTypeBridge::GetGDALDataType<ImagePixelType>();
     }
 
+  // Compression of the tiles, the extended filename has precedence
+  std::string compression = m_TiffCompression;
+  if (m_FilenameHelper->gdalCreationOptionsIsSet())
+    {
+    typename FNameHelperType::GDALCOType options = m_FilenameHelper->GetgdalCreationOptions();
+    for (typename FNameHelperType::GDALCOType::const_iterator it = options.begin(); it != options.end(); ++it)
+      {
+      if (boost::istarts_with(*it, "COMPRESS="))
+        {
+        compression = it->substr(9);
+        }
+      }
+    }
+  boost::algorithm::to_upper(compression);
+  const bool compressed = (compression != "NONE") && !m_VirtualMode;
+  if (compressed)
+    {
+    if (compression != "DEFLATE" && compression != "LZW")
+      {
+      itkExceptionMacro(<<"Unsupported compression " << compression << ", supported compressions are NONE, DEFLATE and LZW");
+      }
+    if (m_FilenameHelper->BoxIsSet())
+      {
+      itkExceptionMacro(<<"Compressed output can not be used with the box option");
+      }
+    if (!m_TiffTiledMode)
+      {
+      itkWarningMacro(<<"Compressed output is tiled. Switching to tiled mode.");
+      m_TiffTiledMode = true;
+      }
+    }
+
   /************************************************************************
    *                         Raster creation
    ************************************************************************/
 
   // First, compute the block size
-  int block_size_x = m_TiffTiledMode;
+  int block_size_x = m_TiffTileSize;
 
   if (m_TiffTiledMode)
     {
@@ -562,7 +733,8 @@ SimpleParallelTiffWriter<TInputImage>
         geotransform,
         inputPtr->GetProjectionRef(),
         block_size_x,
-        m_TiffTiledMode);
+        m_TiffTiledMode,
+        compressed ? compression : "NONE");
 
     if (sperr != sptw::SP_None)
       {
@@ -624,14 +796,35 @@ SimpleParallelTiffWriter<TInputImage>
   m_StreamingManager->PrepareStreaming(inputPtr, inputRegion);
   m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
 
-  // Recompute a new splitting layout which fits better the MPI number of processes
-  // TODO make it work on tiled splits !
-  // [dirtycode]
-  unsigned int newNumberOfStrippedSplits = OptimizeStrippedSplittingLayout(m_NumberOfDivisions);
-  this->SetNumberOfDivisionsStrippedStreaming(newNumberOfStrippedSplits);
-  m_StreamingManager->PrepareStreaming(inputPtr, inputRegion);
-  m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
-  // [/dirtycode]
+  m_CompressedLinesPerDivision = 0;
+  m_CompressedDataEnd = ITK_NULLPTR;
+  if (compressed)
+    {
+    // Each tile must be compressed by a single process: divisions are bands
+    // of whole tile rows, at least as many as the streaming manager splits
+    const unsigned long tileHeight = output_raster->block_y_size;
+    const unsigned long nbLines = inputRegion.GetSize()[1];
+    const unsigned long nbTileRows = (nbLines + tileHeight - 1) / tileHeight;
+    const unsigned long nbSplits = std::min(static_cast<unsigned long>(std::max(m_NumberOfDivisions, 1U)), nbTileRows);
+    m_CompressedLinesPerDivision = ((nbTileRows + nbSplits - 1) / nbSplits) * tileHeight;
+    m_CompressedRegion = inputRegion;
+    m_NumberOfDivisions = (nbLines + m_CompressedLinesPerDivision - 1) / m_CompressedLinesPerDivision;
+
+    // Compressed tiles are appended to the file
+    m_CompressedDataEnd = otb::MPISharedCounter::New();
+    m_CompressedDataEnd->Create(output_raster->data_offset);
+    }
+  else
+    {
+    // Recompute a new splitting layout which fits better the MPI number of processes
+    // TODO make it work on tiled splits !
+    // [dirtycode]
+    unsigned int newNumberOfStrippedSplits = OptimizeStrippedSplittingLayout(m_NumberOfDivisions);
+    this->SetNumberOfDivisionsStrippedStreaming(newNumberOfStrippedSplits);
+    m_StreamingManager->PrepareStreaming(inputPtr, inputRegion);
+    m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
+    // [/dirtycode]
+    }
 
   // Configure process objects
   this->UpdateProgress(0);
@@ -663,82 +856,65 @@ SimpleParallelTiffWriter<TInputImage>
   // Loop on streaming tiles
   double processDuration(0), writeDuration(0), numberOfProcessedRegions(0);
   InputImageRegionType streamRegion;
-  for (m_CurrentDivision = 0;
-      m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
-      m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
+  if (m_DynamicScheduling)
     {
-    streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+    // Each process starts with the division matching its rank, then requests
+    // the next division to process from the shared counter
+    const unsigned int nbProcs = std::max(otb::MPIConfig::Instance()->GetNbProcs(), 1U);
+    otb::MPISharedCounter::Pointer nextDivision = otb::MPISharedCounter::New();
+    nextDivision->Create(nbProcs);
+
+    for (m_CurrentDivision = otb::MPIConfig::Instance()->GetMyRank();
+        m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
+        m_CurrentDivision = static_cast<unsigned int>(nextDivision->FetchAndAdd(1)), m_DivisionProgress = 0)
+      {
+      streamRegion = this->GetDivisionRegion(m_CurrentDivision);
+      this->ProcessAndWriteDivision(streamRegion, output_raster, processDuration, writeDuration);
+      numberOfProcessedRegions += 1;
+      this->UpdateFilterProgress();
+      }
 
-    if (GetProcFromDivision(m_CurrentDivision) == otb::MPIConfig::Instance()->GetMyRank())
+    // Every process must have finished requesting divisions
+    nextDivision->Free();
+    }
+  else
+    {
+    for (m_CurrentDivision = 0;
+        m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
+        m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
       {
-      /*
-       * Processing
-       */
-      itk::TimeProbe processingTime;
-      processingTime.Start();
-      inputPtr->SetRequestedRegion(streamRegion);
-      inputPtr->PropagateRequestedRegion();
-      inputPtr->UpdateOutputData();
-      processingTime.Stop();
-      processDuration += processingTime.GetTotal();
-
-      /*
-       * Writing using SPTW
-       */
-      itk::TimeProbe writingTime;
-      writingTime.Start();
-      if (!m_VirtualMode)
+      if (GetProcFromDivision(m_CurrentDivision) == otb::MPIConfig::Instance()->GetMyRank())
         {
-        sptw::write_area(output_raster,
-            inputPtr->GetBufferPointer(),
-            streamRegion.GetIndex()[0],
-            streamRegion.GetIndex()[1],
-            streamRegion.GetIndex()[0] + streamRegion.GetSize()[0] -1,
-            streamRegion.GetIndex()[1] + streamRegion.GetSize()[1] -1);
+        streamRegion = this->GetDivisionRegion(m_CurrentDivision);
+        this->ProcessAndWriteDivision(streamRegion, output_raster, processDuration, writeDuration);
+        numberOfProcessedRegions += 1;
         }
-      writingTime.Stop();
-      writeDuration += writingTime.GetTotal();
-      numberOfProcessedRegions += 1;
       }
     }
 
-  // Clean up
-  close_raster(output_raster);
+  if (m_CompressedDataEnd.IsNotNull())
+    {
+    m_CompressedDataEnd->Free();
+    m_CompressedDataEnd = ITK_NULLPTR;
+    }
+
+  // Clean up (and write the offsets of compressed tiles)
+  if (output_raster != NULL && close_raster(output_raster) != sptw::SP_None)
+    {
+    otb::MPIConfig::Instance()->logError("Error closing raster");
+    otb::MPIConfig::Instance()->abort(EXIT_FAILURE);
+    }
   output_raster = NULL;
 
   // We wait for other process
+  itk::TimeProbe waitingTime;
+  waitingTime.Start();
   otb::MPIConfig::Instance()->barrier();
+  waitingTime.Stop();
   overallTime.Stop();
 
-  /* TODO: Use MPIConfig helper instead of MPI methods
-	// Get timings
-	const int nValues = 3;
-	double runtimes[nValues] = {processDuration, writeDuration, numberOfProcessedRegions};
-	std::vector<double> process_runtimes(otb::MPIConfig::Instance()->GetNbProcs()*nValues);
-	MPI_Gather(runtimes,
-			nValues,
-			MPI_DOUBLE,
-			&(process_runtimes[0]),
-			nValues,
-			MPI_DOUBLE,
-			0,
-			MPI_COMM_WORLD);
-
-	// Display timings
-	if (otb::MPIConfig::Instance()->GetMyRank() == 0 && m_Verbose)
-	  {
-      itkDebugMacro( "Runtime, in seconds" );
-      itkDebugMacro( "Process Id\tProcessing\tWriting" );
-	  for (unsigned int i = 0; i < process_runtimes.size(); i+=nValues)
-	    {
-      itkDebugMacro( <<(int (i/nValues)) << 
-	        "\t" << process_runtimes[i] <<
-	        "\t" << process_runtimes[i+1] <<
-	        "\t("<< process_runtimes[i+2] << " regions)" );
-	    }
-	  itkDebugMacro( "Overall time:" << overallTime.GetTotal() );
-	  }
-   */
+  this->ReportLoadBalance(processDuration, writeDuration, waitingTime.GetTotal(),
+                          numberOfProcessedRegions, overallTime.GetTotal());
 
   /**
    * If we ended due to aborting, push the progress up to 1.0 (since
@@ -36,10 +36,10 @@ int otbMPISPTWReadWriteTest(int argc, char* argv[])
   config->Init(argc,argv);
 
   // Get command line arguments
-  if (argc != 3)
+  if (argc != 3 && argc != 4)
     {
     std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " inputImageFile outputImageFile " << std::endl;
+    std::cerr << argv[0] << " inputImageFile outputImageFile [dynamic|deflate|lzw]" << std::endl;
     return EXIT_SUCCESS;
     }
 
@@ -60,6 +60,20 @@ int otbMPISPTWReadWriteTest(int argc, char* argv[])
   std::string outputFilename = std::string(argv[2]);
   writer->SetFileName(outputFilename);
   writer->SetInput(reader->GetOutput());
+  if (argc == 4 && std::string(argv[3]) == "dynamic")
+    {
+    // Small divisions, requested by the processes as they go
+    writer->SetNumberOfLinesStrippedStreaming(10);
+    writer->DynamicSchedulingOn();
+    writer->SetVerbose(true);
+    }
+  else if (argc == 4)
+    {
+    // Compressed tiles, small enough to have several tiles per process
+    writer->SetTiffTiledMode(true);
+    writer->SetTiffTileSize(64);
+    writer->SetTiffCompression(argv[3]);
+    }
   
   // Execute the MPI pipeline
   try{
@@ -84,6 +84,11 @@ public:
   /** Evalulate the function at specified index */
   OutputType EvaluateAtIndex(const IndexType& index) const ITK_OVERRIDE;
 
+  /** Evaluate the function on the length pixels of a line, starting at
+   * index. The lookup values of the line are computed at once, which avoids
+   * searching the calibration vectors for each pixel. */
+  void EvaluateLine(const IndexType& index, unsigned int length, OutputType * output) const;
+
   /** Evaluate the function at non-integer positions */
   OutputType Evaluate(const PointType& point) const ITK_OVERRIDE
   {
@@ -177,6 +182,10 @@ protected:
   /** print method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
 
+  /** Evaluate the function at an index inside the buffer, with the given
+   * lookup value */
+  OutputType EvaluateAtIndexWithLookupValue(const IndexType& index, RealType lutVal) const;
+
   /** Flags to indicate if these values needs to be applied in calibration*/
 
 private:
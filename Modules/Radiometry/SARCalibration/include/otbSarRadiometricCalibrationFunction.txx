@@ -24,6 +24,7 @@
 
 #include "otbSarRadiometricCalibrationFunction.h"
 #include "itkNumericTraits.h"
+#include <vector>
 
 namespace otb
 {
@@ -106,6 +107,43 @@ SarRadiometricCalibrationFunction<TInputImage, TCoordRep>
     return (itk::NumericTraits<OutputType>::max());
     }
 
+  RealType lutVal = 1.0;
+  if (m_ApplyLookupDataCorrection)
+    {
+    lutVal = static_cast<RealType>(m_Lut->GetValue(index[0], index[1]));
+    }
+  return this->EvaluateAtIndexWithLookupValue(index, lutVal);
+}
+
+template <class TInputImage, class TCoordRep>
+void
+SarRadiometricCalibrationFunction<TInputImage, TCoordRep>
+::EvaluateLine(const IndexType& index, unsigned int length, OutputType * output) const
+{
+  std::vector<double> lutValues(length, 1.0);
+  if (m_ApplyLookupDataCorrection && length > 0)
+    {
+    m_Lut->GetValues(index[0], index[1], length, &lutValues[0]);
+    }
+
+  IndexType pixelIndex = index;
+  for (unsigned int i = 0; i < length; ++i, ++pixelIndex[0])
+    {
+    if (!this->IsInsideBuffer(pixelIndex))
+      {
+      output[i] = itk::NumericTraits<OutputType>::max();
+      continue;
+      }
+    output[i] = this->EvaluateAtIndexWithLookupValue(pixelIndex, static_cast<RealType>(lutValues[i]));
+    }
+}
+
+template <class TInputImage, class TCoordRep>
+typename SarRadiometricCalibrationFunction<TInputImage, TCoordRep>
+::OutputType
+SarRadiometricCalibrationFunction<TInputImage, TCoordRep>
+::EvaluateAtIndexWithLookupValue(const IndexType& index, RealType lutVal) const
+{
   /* convert index to point */
   PointType point;
   if (m_ApplyAntennaPatternGain || m_ApplyIncidenceAngleCorrection || m_ApplyRangeSpreadLossCorrection)
@@ -154,7 +192,6 @@ SarRadiometricCalibrationFunction<TInputImage, TCoordRep>
     * above values (incidence angle, rangespreadloss etc.. */
   if (m_ApplyLookupDataCorrection)
     {
-    RealType lutVal = static_cast<RealType>(m_Lut->GetValue(index[0], index[1]));
     sigma /= lutVal * lutVal;
     }
 
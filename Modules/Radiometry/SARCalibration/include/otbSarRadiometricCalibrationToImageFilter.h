@@ -120,6 +120,11 @@ protected:
   /** Update the function list and input parameters*/
   void BeforeThreadedGenerateData() ITK_OVERRIDE;
 
+  /** Evaluate the function line by line, so that the lookup data is
+   * interpolated once per output line */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                            itk::ThreadIdType threadId) ITK_OVERRIDE;
+
 private:
 
   SarRadiometricCalibrationToImageFilter(const Self &); //purposely not implemented
@@ -25,6 +25,9 @@
 #include "otbSarRadiometricCalibrationToImageFilter.h"
 #include "otbSarImageMetadataInterfaceFactory.h"
 #include "otbSarCalibrationLookupData.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
+#include <vector>
 
 namespace otb
 {
@@ -170,6 +173,38 @@ See Also: otbSentinel1ImageMetadataInterface, otbTerraSarImageMetadataInterface,
     }
 }
 
+template<class TInputImage, class TOutputImage>
+void
+SarRadiometricCalibrationToImageFilter<TInputImage, TOutputImage>
+::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                       itk::ThreadIdType threadId)
+{
+  FunctionPointer function = this->GetFunction();
+  OutputImagePointer outputPtr = this->GetOutput();
+
+  const unsigned int lineLength = outputRegionForThread.GetSize(0);
+  if (lineLength == 0)
+    {
+    return;
+    }
+  std::vector<FunctionValueType> values(lineLength);
+
+  itk::ImageScanlineIterator<OutputImageType> outputIt(outputPtr, outputRegionForThread);
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels() / lineLength);
+
+  outputIt.GoToBegin();
+  while (!outputIt.IsAtEnd())
+    {
+    function->EvaluateLine(outputIt.GetIndex(), lineLength, &values[0]);
+    for (unsigned int i = 0; i < lineLength; ++i, ++outputIt)
+      {
+      outputIt.Set(static_cast<OutputImagePixelType>(values[i]));
+      }
+    outputIt.NextLine();
+    progress.CompletedPixel(); // potential exception thrown here
+    }
+}
+
 } // end namespace otb
 
 #endif
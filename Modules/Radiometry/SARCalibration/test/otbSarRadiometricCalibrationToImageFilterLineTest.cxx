@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "otbSarRadiometricCalibrationToImageFilter.h"
+#include "otbImageFileReader.h"
+#include "otbExtractROI.h"
+#include "itkTimeProbe.h"
+
+// Calibrate an extract line by line and pixel by pixel, check that both
+// give the same result and report the timings
+int otbSarRadiometricCalibrationToImageFilterLineTest(int itkNotUsed(argc), char * argv[])
+{
+  const unsigned int Dimension = 2;
+  typedef float                                                                        RealType;
+  typedef std::complex<RealType>                                                       PixelType;
+  typedef otb::Image<PixelType, Dimension>                                             InputImageType;
+  typedef otb::Image<RealType, Dimension>                                              OutputImageType;
+
+  typedef otb::ImageFileReader<InputImageType>                                         ReaderType;
+  typedef otb::SarRadiometricCalibrationToImageFilter<InputImageType, OutputImageType> CalibFilterType;
+  typedef CalibFilterType::FunctionType                                                FunctionType;
+  typedef otb::ExtractROI<RealType, RealType>                                          ExtractorType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  ExtractorType::Pointer extractor = ExtractorType::New();
+  CalibFilterType::Pointer calibFilter = CalibFilterType::New();
+
+  reader->SetFileName(argv[1]);
+  calibFilter->SetInput(reader->GetOutput());
+  calibFilter->SetEnableNoise(false);
+
+  OutputImageType::RegionType region;
+  OutputImageType::IndexType  id;
+  id[0] = atoi(argv[2]);   id[1] = atoi(argv[3]);
+  OutputImageType::SizeType size;
+  size[0] = atoi(argv[4]);   size[1] = atoi(argv[5]);
+  region.SetIndex(id);
+  region.SetSize(size);
+
+  extractor->SetExtractionRegion(region);
+  extractor->SetInput(calibFilter->GetOutput());
+  extractor->Update();
+
+  // The function is set up on the buffered extract by the filter
+  const FunctionType * function = calibFilter->GetFunction();
+
+  std::vector<FunctionType::OutputType> pixelByPixel(region.GetNumberOfPixels());
+  itk::TimeProbe chrono;
+  chrono.Start();
+  FunctionType::IndexType index;
+  size_t pos = 0;
+  for (index[1] = id[1]; index[1] < id[1] + static_cast<long>(size[1]); ++index[1])
+    {
+    for (index[0] = id[0]; index[0] < id[0] + static_cast<long>(size[0]); ++index[0], ++pos)
+      {
+      pixelByPixel[pos] = function->EvaluateAtIndex(index);
+      }
+    }
+  chrono.Stop();
+  const double pixelByPixelTime = chrono.GetTotal();
+
+  std::vector<FunctionType::OutputType> lineByLine(region.GetNumberOfPixels());
+  chrono.Reset();
+  chrono.Start();
+  index = id;
+  for (unsigned int line = 0; line < size[1]; ++line, ++index[1])
+    {
+    function->EvaluateLine(index, size[0], &lineByLine[line * size[0]]);
+    }
+  chrono.Stop();
+  const double lineByLineTime = chrono.GetTotal();
+
+  std::cout << region.GetNumberOfPixels() << " pixels, EvaluateAtIndex(): " << pixelByPixelTime
+            << " s, EvaluateLine(): " << lineByLineTime << " s" << std::endl;
+
+  // Compare both evaluations and the filter output
+  const OutputImageType * output = extractor->GetOutput();
+  OutputImageType::IndexType outputIndex = output->GetLargestPossibleRegion().GetIndex();
+  bool ok = true;
+  pos = 0;
+  for (unsigned int y = 0; y < size[1]; ++y)
+    {
+    for (unsigned int x = 0; x < size[0]; ++x, ++pos)
+      {
+      OutputImageType::IndexType current = outputIndex;
+      current[0] += x;
+      current[1] += y;
+      const double reference = pixelByPixel[pos];
+      const double tolerance = 1e-6 * std::max(1.0, std::abs(reference));
+      if (std::abs(reference - lineByLine[pos]) > tolerance
+          || std::abs(reference - output->GetPixel(current)) > tolerance)
+        {
+        std::cerr << "Pixel (" << id[0] + x << ", " << id[1] + y << ") differs, EvaluateAtIndex() gives "
+                  << reference << ", EvaluateLine() gives " << lineByLine[pos]
+                  << ", the filter gives " << output->GetPixel(current) << std::endl;
+        ok = false;
+        }
+      }
+    }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -26,6 +26,7 @@
 #include "itkConstNeighborhoodIterator.h"
 #include "itkImageRegionIterator.h"
 #include "otbImage.h"
+#include <vector>
 
 namespace otb
 {
@@ -63,6 +64,12 @@ public:
 
     return ssd;
   }
+
+  // Contribution of a single pair of pixels to the SSD
+  inline double PixelCost(double a, double b) const
+  {
+    return (a-b)*(a-b);
+  }
 };
 
 
@@ -108,6 +115,17 @@ public:
 
     return ssd;
   }
+
+  // Same metric from the sums of the values and products of the blocks
+  inline MetricValueType BoxMetric(double size, double sumA, double sumB,
+                                   double sumAA, double sumBB, double sumAB) const
+  {
+    // Expansion of the sum of (a/meana-b/meanb)^2, with meana = sumA/size
+    double ssd = size * size * (sumAA / (sumA * sumA) - 2. * sumAB / (sumA * sumB) + sumBB / (sumB * sumB));
+
+    // Rounding may give slightly negative values for identical blocks
+    return static_cast<MetricValueType>(ssd < 0. ? 0. : ssd);
+  }
 };
 
 
@@ -179,6 +197,26 @@ public:
 
     return static_cast<MetricValueType>(ncc);
   }
+
+  // Same metric from the sums of the values and products of the blocks
+  inline MetricValueType BoxMetric(double size, double sumA, double sumB,
+                                   double sumAA, double sumBB, double sumAB) const
+  {
+    // Centered sums multiplied by size, exact for integer pixel values
+    double cov = size * sumAB - sumA * sumB;
+    double varA = size * sumAA - sumA * sumA;
+    double varB = size * sumBB - sumB * sumB;
+
+    // Same thresholds as above, where sigma^2 = var / (size * (size-1))
+    double norm = 1e-40 * size * (size - 1);
+    double ncc = 0.0;
+    if(varA > norm && varB > norm)
+      {
+      ncc = vcl_abs(cov)/vcl_sqrt(varA*varB);
+      }
+
+    return static_cast<MetricValueType>(ncc);
+  }
 };
 
 /** \class LPBlockMatching
@@ -229,11 +267,112 @@ public:
     return score;
   }
 
+  // Contribution of a single pair of pixels to the L^p score
+  inline double PixelCost(double a, double b) const
+  {
+    return vcl_pow( vcl_abs(a-b) , m_P);
+  }
+
 private:
 
   double m_P;
 };
 
+/** Metric category of block-matching functors whose metric is a plain
+ *  sum of per-pixel costs. Such functors provide a
+ *  PixelCost(double, double) method. */
+struct PixelWiseSumMetricTag {};
+
+/** Metric category of block-matching functors whose metric is a
+ *  closed form of the sums of a, b, a^2, b^2 and ab over the blocks.
+ *  Such functors provide a BoxMetric(size, sumA, sumB, sumAA, sumBB,
+ *  sumAB) method. */
+struct BoxSumMetricTag {};
+
+/** Metric category of any other block-matching functor */
+struct GenericMetricTag {};
+
+/** \class BlockMatchingBoxSums
+ *  \brief Sums of the values and products of the pixels of two blocks
+ *
+ *  Used by PixelWiseBlockMatchingImageFilter to slide the sums needed by
+ *  the functors of the BoxSumMetricTag category.
+ *
+ * \ingroup OTBDisparityMap
+ */
+struct BlockMatchingBoxSums
+{
+  BlockMatchingBoxSums() : A(0.), B(0.), AA(0.), BB(0.), AB(0.) {}
+
+  BlockMatchingBoxSums & operator+=(const BlockMatchingBoxSums & other)
+  {
+    A += other.A;
+    B += other.B;
+    AA += other.AA;
+    BB += other.BB;
+    AB += other.AB;
+    return *this;
+  }
+
+  BlockMatchingBoxSums operator-(const BlockMatchingBoxSums & other) const
+  {
+    BlockMatchingBoxSums result(*this);
+    result.A -= other.A;
+    result.B -= other.B;
+    result.AA -= other.AA;
+    result.BB -= other.BB;
+    result.AB -= other.AB;
+    return result;
+  }
+
+  double A;
+  double B;
+  double AA;
+  double BB;
+  double AB;
+};
+
+/** \class BlockMatchingMetricTraits
+ *  \brief Gives the metric category of a block-matching functor
+ *
+ *  PixelWiseBlockMatchingImageFilter computes the metric of functors of
+ *  the PixelWiseSumMetricTag (SSD, L^p) and BoxSumMetricTag (SSD divided
+ *  by mean, NCC) categories with sliding sums, so that the cost does not
+ *  depend on the radius of the blocks. Other functors are evaluated on
+ *  each pair of neighborhoods.
+ *
+ * \ingroup OTBDisparityMap
+ */
+template <class TBlockMatchingFunctor>
+struct BlockMatchingMetricTraits
+{
+  typedef GenericMetricTag MetricCategory;
+};
+
+template <class TInputImage, class TOutputMetricImage>
+struct BlockMatchingMetricTraits< SSDBlockMatching<TInputImage,TOutputMetricImage> >
+{
+  typedef PixelWiseSumMetricTag MetricCategory;
+};
+
+template <class TInputImage, class TOutputMetricImage>
+struct BlockMatchingMetricTraits< LPBlockMatching<TInputImage,TOutputMetricImage> >
+{
+  typedef PixelWiseSumMetricTag MetricCategory;
+};
+
+template <class TInputImage, class TOutputMetricImage>
+struct BlockMatchingMetricTraits< SSDDivMeanBlockMatching<TInputImage,TOutputMetricImage> >
+{
+  typedef BoxSumMetricTag MetricCategory;
+};
+
+template <class TInputImage, class TOutputMetricImage>
+struct BlockMatchingMetricTraits< NCCBlockMatching<TInputImage,TOutputMetricImage> >
+{
+  typedef BoxSumMetricTag MetricCategory;
+};
+
 } // End Namespace Functor
 
 /** \class PixelWiseBlockMatchingImageFilter
@@ -271,6 +410,13 @@ private:
  *  between the two input images (displacement is given in pixels, from left
  *  image to right image).
  *
+ *  When the functor metric is a sum of per-pixel costs (SSD, L^p) or a
+ *  closed form of the sums of a, b, a^2, b^2 and ab over the blocks (SSD
+ *  divided by mean, NCC), see Functor::BlockMatchingMetricTraits, the
+ *  metric of all the blocks is computed with sliding sums for each
+ *  disparity, which makes the computation time independent of the radius
+ *  of the blocks.
+ *
  *  Masks are not mandatory. A mask allows indicating pixels validity in
  *  either left or right image. Left and right masks can be used independently.
  *  If masks are used, only pixels whose mask values are strictly positive
@@ -320,6 +466,8 @@ public:
   typedef TOutputDisparityImage                             OutputDisparityImageType;
   typedef TMaskImage                                        InputMaskImageType;
   typedef TBlockMatchingFunctor                             BlockMatchingFunctorType;
+  typedef typename Functor::BlockMatchingMetricTraits
+    <TBlockMatchingFunctor>::MetricCategory                 MetricCategoryType;
 
   typedef typename InputImageType::SizeType                 SizeType;
   typedef typename InputImageType::IndexType                IndexType;
@@ -461,6 +609,41 @@ protected:
   /** Threaded generate data */
   void ThreadedGenerateData(const RegionType & outputRegionForThread, itk::ThreadIdType threadId) ITK_OVERRIDE;
 
+  /** Block-matching evaluating the functor on each pair of neighborhoods */
+  void ThreadedBlockMatching(const RegionType & outputRegionForThread, itk::ThreadIdType threadId,
+                             const Functor::GenericMetricTag &);
+
+  /** Block-matching with sliding sums of the per-pixel costs */
+  void ThreadedBlockMatching(const RegionType & outputRegionForThread, itk::ThreadIdType threadId,
+                             const Functor::PixelWiseSumMetricTag &);
+
+  /** Block-matching with sliding sums of the values and products of the pixels */
+  void ThreadedBlockMatching(const RegionType & outputRegionForThread, itk::ThreadIdType threadId,
+                             const Functor::BoxSumMetricTag &);
+
+  /** Block-matching sliding the block sums of type TBlockSums */
+  template <class TBlockSums>
+  void ThreadedSlidingBlockMatching(const RegionType & outputRegionForThread, itk::ThreadIdType threadId);
+
+  /** Add weight times the per-pixel costs of a row of blocks to the column sums */
+  void AccumulateRowCosts(long startX, long y, int hdisparity, int vdisparity, double weight,
+                          std::vector<double> & leftRow, std::vector<double> & rightRow,
+                          std::vector<double> & columnSums) const;
+
+  /** Add weight times the values and products of a row of blocks to the column sums */
+  void AccumulateRowCosts(long startX, long y, int hdisparity, int vdisparity, double weight,
+                          std::vector<double> & leftRow, std::vector<double> & rightRow,
+                          std::vector<Functor::BlockMatchingBoxSums> & columnSums) const;
+
+  /** Metric of a block from the sum of its per-pixel costs */
+  MetricValueType BlockMetric(double sum, double size) const;
+
+  /** Metric of a block from the sums of its values and products */
+  MetricValueType BlockMetric(const Functor::BlockMatchingBoxSums & sums, double size) const;
+
+  /** Copy a row of the image, pixels outside the buffered region are null */
+  static void FillRow(const TInputImage * image, long startX, long y, std::vector<double> & row);
+
 private:
   PixelWiseBlockMatchingImageFilter(const Self&); //purposely not implemented
   void operator=(const Self&); //purposely not implemeFnted
@@ -24,6 +24,7 @@
 #include "otbPixelWiseBlockMatchingImageFilter.h"
 #include "itkProgressReporter.h"
 #include "itkConstantBoundaryCondition.h"
+#include <algorithm>
 
 namespace otb
 {
@@ -540,6 +541,18 @@ void
 PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
 TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
 ::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  // Select the implementation depending on the metric category of the functor
+  this->ThreadedBlockMatching(outputRegionForThread, threadId, MetricCategoryType());
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ThreadedBlockMatching(const RegionType& outputRegionForThread, itk::ThreadIdType threadId,
+                        const Functor::GenericMetricTag &)
 {
   // Retrieve pointers
   const TInputImage *     inLeftPtr    = this->GetLeftInput();
@@ -766,6 +779,367 @@ TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
     }
 }
 
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ThreadedBlockMatching(const RegionType& outputRegionForThread, itk::ThreadIdType threadId,
+                        const Functor::PixelWiseSumMetricTag &)
+{
+  // Slide the sums of the per-pixel costs
+  this->template ThreadedSlidingBlockMatching<double>(outputRegionForThread, threadId);
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ThreadedBlockMatching(const RegionType& outputRegionForThread, itk::ThreadIdType threadId,
+                        const Functor::BoxSumMetricTag &)
+{
+  // Slide the sums of the values and products of the pixels
+  this->template ThreadedSlidingBlockMatching<Functor::BlockMatchingBoxSums>(outputRegionForThread, threadId);
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+template <class TBlockSums>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ThreadedSlidingBlockMatching(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  // Retrieve pointers
+  const TInputImage *     inRightPtr   = this->GetRightInput();
+  const TMaskImage  *     inLeftMaskPtr    = this->GetLeftMaskInput();
+  const TMaskImage  *     inRightMaskPtr    = this->GetRightMaskInput();
+  const TOutputDisparityImage * inHDispPtr = this->GetHorizontalDisparityInput();
+  const TOutputDisparityImage * inVDispPtr = this->GetVerticalDisparityInput();
+  TOutputMetricImage    * outMetricPtr = this->GetMetricOutput();
+  TOutputDisparityImage * outHDispPtr   = this->GetHorizontalDisparityOutput();
+  TOutputDisparityImage * outVDispPtr   = this->GetVerticalDisparityOutput();
+
+  // Set-up progress reporting (this is not exact, since we do not
+  // account for pixels that are out of range for a given disparity
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels()*(m_MaximumHorizontalDisparity - m_MinimumHorizontalDisparity + 1)*(m_MaximumVerticalDisparity - m_MinimumVerticalDisparity + 1),100);
+
+  // Handle initialization properly
+  const IndexType & threadIndex = outputRegionForThread.GetIndex();
+  const SizeType &  threadSize = outputRegionForThread.GetSize();
+  std::vector<unsigned char> initialized(outputRegionForThread.GetNumberOfPixels(), 0);
+
+  // Compute region for thread at full resolution
+  RegionType fullRegionForThread = this->ConvertSubsampledToFullRegion(outputRegionForThread, this->m_Step, this->m_GridIndex);
+
+  // Check if we use initial disparities and exploration radius
+  bool useExplorationRadius = false;
+  bool useInitDispMaps = false;
+  if (m_ExplorationRadius[0] >= 1 || m_ExplorationRadius[1] >= 1)
+    {
+    useExplorationRadius = true;
+    if (inHDispPtr && inVDispPtr)
+      {
+      useInitDispMaps = true;
+      }
+    }
+
+  // step value as disparityType
+  DisparityPixelType stepDisparityInv = 1. / static_cast<DisparityPixelType>(this->m_Step);
+
+  const long step = static_cast<long>(this->m_Step);
+  const long radiusX = static_cast<long>(m_Radius[0]);
+  const long radiusY = static_cast<long>(m_Radius[1]);
+  const long blockWidth = 2 * radiusX + 1;
+  const long blockHeight = 2 * radiusY + 1;
+  const double blockSize = static_cast<double>(blockWidth * blockHeight);
+
+  // Rows of the blocks and vertical sums of their costs, per column
+  std::vector<double> leftRow;
+  std::vector<double> rightRow;
+  std::vector<TBlockSums> columnSums;
+
+  // We loop on disparities
+  for(int vdisparity = m_MinimumVerticalDisparity; vdisparity <= m_MaximumVerticalDisparity; ++vdisparity)
+    {
+  for(int hdisparity = m_MinimumHorizontalDisparity; hdisparity <= m_MaximumHorizontalDisparity; ++hdisparity)
+    {
+    // First, we cast output region to the right image
+    IndexType rightRequestedRegionIndex = fullRegionForThread.GetIndex();
+    rightRequestedRegionIndex[0]+=hdisparity;
+    rightRequestedRegionIndex[1]+=vdisparity;
+
+    // We crop
+    RegionType inputRightRegion;
+    inputRightRegion.SetIndex(rightRequestedRegionIndex);
+    inputRightRegion.SetSize(fullRegionForThread.GetSize());
+    if (!inputRightRegion.Crop(inRightPtr->GetLargestPossibleRegion()))
+      {
+      continue;
+      }
+
+    // And then cast back
+    IndexType leftRequestedRegionIndex = inputRightRegion.GetIndex();
+    leftRequestedRegionIndex[0]-=hdisparity;
+    leftRequestedRegionIndex[1]-=vdisparity;
+
+    RegionType inputLeftRegion;
+    inputLeftRegion.SetIndex(leftRequestedRegionIndex);
+    inputLeftRegion.SetSize(inputRightRegion.GetSize());
+
+    // Compute the equivalent region in subsampled grid
+    RegionType outputRegion = this->ConvertFullToSubsampledRegion(inputLeftRegion, this->m_Step, this->m_GridIndex);
+    if (outputRegion.GetNumberOfPixels() == 0)
+      {
+      continue;
+      }
+
+    // Columns covered by the blocks centered on the output pixels
+    const long firstX = outputRegion.GetIndex(0) * step + this->m_GridIndex[0];
+    const long startX = firstX - radiusX;
+    const long nbColumns = (static_cast<long>(outputRegion.GetSize(0)) - 1) * step + blockWidth;
+
+    leftRow.resize(nbColumns);
+    rightRow.resize(nbColumns);
+    columnSums.assign(nbColumns, TBlockSums());
+
+    itk::ImageRegionIterator<TOutputMetricImage>    outMetricIt(outMetricPtr,outputRegion);
+    itk::ImageRegionIterator<TOutputDisparityImage> outHDispIt(outHDispPtr,outputRegion);
+    itk::ImageRegionIterator<TOutputDisparityImage> outVDispIt(outVDispPtr,outputRegion);
+    outMetricIt.GoToBegin();
+    outHDispIt.GoToBegin();
+    outVDispIt.GoToBegin();
+
+    long previousY = 0;
+
+    for (unsigned long j = 0; j < outputRegion.GetSize(1); ++j)
+      {
+      const long y = (outputRegion.GetIndex(1) + static_cast<long>(j)) * step + this->m_GridIndex[1];
+
+      // Slide the vertical sums from the previous row, unless it is
+      // cheaper to compute them again
+      if (j == 0 || 2 * step >= blockHeight)
+        {
+        std::fill(columnSums.begin(), columnSums.end(), TBlockSums());
+        for (long yy = y - radiusY; yy <= y + radiusY; ++yy)
+          {
+          this->AccumulateRowCosts(startX, yy, hdisparity, vdisparity, 1., leftRow, rightRow, columnSums);
+          }
+        }
+      else
+        {
+        for (long yy = previousY - radiusY; yy < y - radiusY; ++yy)
+          {
+          this->AccumulateRowCosts(startX, yy, hdisparity, vdisparity, -1., leftRow, rightRow, columnSums);
+          }
+        for (long yy = previousY + radiusY + 1; yy <= y + radiusY; ++yy)
+          {
+          this->AccumulateRowCosts(startX, yy, hdisparity, vdisparity, 1., leftRow, rightRow, columnSums);
+          }
+        }
+      previousY = y;
+
+      // Sums of the first block of the row
+      TBlockSums blockSum = TBlockSums();
+      for (long k = 0; k < blockWidth; ++k)
+        {
+        blockSum += columnSums[k];
+        }
+
+      for (unsigned long i = 0; i < outputRegion.GetSize(0); ++i)
+        {
+        // Slide the block to the next pixel of the subsampled grid
+        if (i > 0)
+          {
+          const long previousStart = (static_cast<long>(i) - 1) * step;
+          for (long k = previousStart; k < previousStart + step; ++k)
+            {
+            blockSum += columnSums[k + blockWidth] - columnSums[k];
+            }
+          }
+
+        IndexType leftIndex;
+        leftIndex[0] = firstX + static_cast<long>(i) * step;
+        leftIndex[1] = y;
+
+        IndexType rightIndex = leftIndex;
+        rightIndex[0] += hdisparity;
+        rightIndex[1] += vdisparity;
+
+        // If the masks are present and valid
+        if((!inLeftMaskPtr || inLeftMaskPtr->GetPixel(leftIndex) > 0)
+           && (!inRightMaskPtr || inRightMaskPtr->GetPixel(rightIndex) > 0))
+          {
+          int estimatedMinHDisp = m_MinimumHorizontalDisparity;
+          int estimatedMinVDisp = m_MinimumVerticalDisparity;
+          int estimatedMaxHDisp = m_MaximumHorizontalDisparity;
+          int estimatedMaxVDisp = m_MaximumVerticalDisparity;
+          if (useExplorationRadius)
+            {
+            // compute disparity bounds from initial position and exploration radius
+            if (useInitDispMaps)
+              {
+              estimatedMinHDisp = inHDispPtr->GetPixel(leftIndex) - m_ExplorationRadius[0];
+              estimatedMinVDisp = inVDispPtr->GetPixel(leftIndex) - m_ExplorationRadius[1];
+              estimatedMaxHDisp = inHDispPtr->GetPixel(leftIndex) + m_ExplorationRadius[0];
+              estimatedMaxVDisp = inVDispPtr->GetPixel(leftIndex) + m_ExplorationRadius[1];
+              }
+            else
+              {
+              estimatedMinHDisp = m_InitHorizontalDisparity - m_ExplorationRadius[0];
+              estimatedMinVDisp = m_InitVerticalDisparity - m_ExplorationRadius[1];
+              estimatedMaxHDisp = m_InitHorizontalDisparity + m_ExplorationRadius[0];
+              estimatedMaxVDisp = m_InitVerticalDisparity + m_ExplorationRadius[1];
+              }
+            // clamp to the minimum disparities
+            if (estimatedMinHDisp < m_MinimumHorizontalDisparity)
+              {
+              estimatedMinHDisp = m_MinimumHorizontalDisparity;
+              }
+            if (estimatedMinVDisp < m_MinimumVerticalDisparity)
+              {
+              estimatedMinVDisp = m_MinimumVerticalDisparity;
+              }
+            }
+
+          if (vdisparity >= estimatedMinVDisp && vdisparity <= estimatedMaxVDisp &&
+              hdisparity >= estimatedMinHDisp && hdisparity <= estimatedMaxHDisp)
+            {
+            // Same precision as the value returned by the functor
+            double metric = this->BlockMetric(blockSum, blockSize);
+
+            unsigned char & init = initialized[(outMetricIt.GetIndex()[1] - threadIndex[1]) * threadSize[0]
+                                               + (outMetricIt.GetIndex()[0] - threadIndex[0])];
+
+            // If we are at first loop, fill both outputs
+            // We adapt the disparity value to keep consistent with disparity map index space
+            if(init == 0
+               || (m_Minimize && metric < outMetricIt.Get())
+               || (!m_Minimize && metric > outMetricIt.Get()))
+              {
+              outHDispIt.Set(static_cast<DisparityPixelType>(hdisparity) * stepDisparityInv);
+              outVDispIt.Set(static_cast<DisparityPixelType>(vdisparity) * stepDisparityInv);
+              outMetricIt.Set(metric);
+              init = 1;
+              }
+            }
+          }
+        ++outMetricIt;
+        ++outHDispIt;
+        ++outVDispIt;
+        progress.CompletedPixel();
+        }
+      }
+    }
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::AccumulateRowCosts(long startX, long y, int hdisparity, int vdisparity, double weight,
+                     std::vector<double> & leftRow, std::vector<double> & rightRow,
+                     std::vector<double> & columnSums) const
+{
+  FillRow(this->GetLeftInput(), startX, y, leftRow);
+  FillRow(this->GetRightInput(), startX + hdisparity, y + vdisparity, rightRow);
+
+  // Contiguous loop, so that the compiler can vectorize simple costs
+  const long nbColumns = static_cast<long>(columnSums.size());
+  for (long k = 0; k < nbColumns; ++k)
+    {
+    columnSums[k] += weight * m_Functor.PixelCost(leftRow[k], rightRow[k]);
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::AccumulateRowCosts(long startX, long y, int hdisparity, int vdisparity, double weight,
+                     std::vector<double> & leftRow, std::vector<double> & rightRow,
+                     std::vector<Functor::BlockMatchingBoxSums> & columnSums) const
+{
+  FillRow(this->GetLeftInput(), startX, y, leftRow);
+  FillRow(this->GetRightInput(), startX + hdisparity, y + vdisparity, rightRow);
+
+  const long nbColumns = static_cast<long>(columnSums.size());
+  for (long k = 0; k < nbColumns; ++k)
+    {
+    const double a = leftRow[k];
+    const double b = rightRow[k];
+    Functor::BlockMatchingBoxSums & sums = columnSums[k];
+    sums.A += weight * a;
+    sums.B += weight * b;
+    sums.AA += weight * a * a;
+    sums.BB += weight * b * b;
+    sums.AB += weight * a * b;
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+typename PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>::MetricValueType
+PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::BlockMetric(double sum, double itkNotUsed(size)) const
+{
+  // The sliding sum may drift slightly below 0 for a perfect match
+  return static_cast<MetricValueType>(std::max(sum, 0.));
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+typename PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>::MetricValueType
+PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::BlockMetric(const Functor::BlockMatchingBoxSums & sums, double size) const
+{
+  return m_Functor.BoxMetric(size, sums.A, sums.B, sums.AA, sums.BB, sums.AB);
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::FillRow(const TInputImage * image, long startX, long y, std::vector<double> & row)
+{
+  // Pixels outside the buffered region are null, as with the constant
+  // boundary condition of the neighborhood iterators
+  std::fill(row.begin(), row.end(), 0.);
+
+  const RegionType & bufferedRegion = image->GetBufferedRegion();
+  const long bufferedStartY = bufferedRegion.GetIndex(1);
+  if (y < bufferedStartY || y >= bufferedStartY + static_cast<long>(bufferedRegion.GetSize(1)))
+    {
+    return;
+    }
+
+  const long bufferedStartX = bufferedRegion.GetIndex(0);
+  const long beginX = std::max(startX, bufferedStartX);
+  const long endX = std::min(startX + static_cast<long>(row.size()),
+                             bufferedStartX + static_cast<long>(bufferedRegion.GetSize(0)));
+
+  if (beginX < endX)
+    {
+    IndexType index;
+    index[0] = beginX;
+    index[1] = y;
+    const typename TInputImage::PixelType * pixel = image->GetBufferPointer() + image->ComputeOffset(index);
+    for (long x = beginX; x < endX; ++x, ++pixel)
+      {
+      row[x - startX] = static_cast<double>(*pixel);
+      }
+    }
+}
+
 template <class TInputImage, class TOutputMetricImage,
 class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
 typename PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
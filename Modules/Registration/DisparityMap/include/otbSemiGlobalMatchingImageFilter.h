@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSemiGlobalMatchingImageFilter_h
+#define otbSemiGlobalMatchingImageFilter_h
+
+#include "otbPixelWiseBlockMatchingImageFilter.h"
+#include "itkMultiThreader.h"
+
+namespace otb
+{
+
+/** \class SemiGlobalMatchingImageFilter
+ *  \brief Perform semi-global matching between two epipolar images
+ *
+ *  This filter estimates the horizontal disparity between two images in
+ *  epipolar geometry with the semi-global matching method (Hirschmuller,
+ *  2008). The matching cost of a pixel for a disparity is the mean
+ *  per-pixel cost of the block-matching functor over the block of radius
+ *  GetRadius(). These costs are then aggregated along several straight
+ *  paths (4 or 8, see SetNumberOfPaths()) ending at the pixel, with a
+ *  penalty P1 for disparity changes of one pixel between neighbors and a
+ *  penalty P2 for larger changes. The disparity of each pixel minimizes
+ *  the sum of the aggregated costs, which is given in the metric output.
+ *
+ *  The filter has the same inputs and outputs as
+ *  PixelWiseBlockMatchingImageFilter, from which it derives, so that it
+ *  can replace it in an epipolar pipeline, followed for instance by
+ *  SubPixelDisparityImageFilter. The block-matching functor must have a
+ *  metric which is a sum of per-pixel costs (see
+ *  Functor::BlockMatchingMetricTraits). Only horizontal disparities are
+ *  explored, with a step of 1. Exploration radius and initial disparities
+ *  are not used.
+ *
+ *  The filter is streamable: the aggregation paths start at the border
+ *  of the requested region padded by SetOverlap() pixels, so a larger
+ *  overlap makes the result closer to the one of the whole image. The
+ *  cost volumes use 8 bytes per pixel of the padded region and per
+ *  disparity, which the streaming does not estimate: the requested region
+ *  is therefore processed in strips of rows whose padded volumes fit in
+ *  SetAvailableMemory() megabytes (the OTB_MAX_RAM_HINT configuration by
+ *  default). The aggregation along each direction is parallelized over
+ *  the paths.
+ *
+ *  \sa PixelWiseBlockMatchingImageFilter
+ *  \sa SubPixelDisparityImageFilter
+ *
+ *  \ingroup Streamed
+ *  \ingroup Threaded
+ *
+ *
+ * \ingroup OTBDisparityMap
+ */
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage = TOutputMetricImage, class TMaskImage = otb::Image<unsigned char>,
+          class TBlockMatchingFunctor = Functor::SSDBlockMatching<TInputImage,TOutputMetricImage> >
+class ITK_EXPORT SemiGlobalMatchingImageFilter :
+    public PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+{
+public:
+  /** Standard class typedef */
+  typedef SemiGlobalMatchingImageFilter                     Self;
+  typedef PixelWiseBlockMatchingImageFilter<TInputImage,TOutputMetricImage,
+    TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor> Superclass;
+  typedef itk::SmartPointer<Self>                           Pointer;
+  typedef itk::SmartPointer<const Self>                     ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(SemiGlobalMatchingImageFilter, PixelWiseBlockMatchingImageFilter);
+
+  /** Useful typedefs */
+  typedef typename Superclass::SizeType                     SizeType;
+  typedef typename Superclass::IndexType                    IndexType;
+  typedef typename Superclass::RegionType                   RegionType;
+  typedef typename Superclass::MetricValueType              MetricValueType;
+  typedef typename Superclass::DisparityPixelType           DisparityPixelType;
+
+  /** Set/Get the penalty for disparity changes of one pixel */
+  itkSetMacro(P1, double);
+  itkGetConstMacro(P1, double);
+
+  /** Set/Get the penalty for disparity changes of more than one pixel */
+  itkSetMacro(P2, double);
+  itkGetConstMacro(P2, double);
+
+  /** Set/Get the number of aggregation paths (4 or 8) */
+  itkSetMacro(NumberOfPaths, unsigned int);
+  itkGetConstMacro(NumberOfPaths, unsigned int);
+
+  /** Set/Get the padding of the requested region used for aggregation */
+  itkSetMacro(Overlap, unsigned int);
+  itkGetConstMacro(Overlap, unsigned int);
+
+  /** Set/Get the memory (in MB) available for the cost volumes, 0 to use
+   *  the configured RAM hint */
+  itkSetMacro(AvailableMemory, unsigned int);
+  itkGetConstMacro(AvailableMemory, unsigned int);
+
+protected:
+  /** Constructor */
+  SemiGlobalMatchingImageFilter();
+
+  /** Destructor */
+  ~SemiGlobalMatchingImageFilter() ITK_OVERRIDE {}
+
+  /** Generate input requested region */
+  void GenerateInputRequestedRegion() ITK_OVERRIDE;
+
+  /** Generate data */
+  void GenerateData() ITK_OVERRIDE;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+  /** Steps of the computation run by the threads */
+  enum ProcessingStep
+  {
+    COMPUTE_COSTS,
+    FILL_INVALID_COSTS,
+    AGGREGATE_COSTS,
+    SELECT_DISPARITIES
+  };
+
+  /** Compute the disparities of the current strip of the output */
+  void GenerateStripData();
+
+  /** Run the current step on the work items of the thread */
+  void ThreadedStep(itk::ThreadIdType threadId, itk::ThreadIdType threadCount);
+
+  /** Compute the matching costs of the rows [begin, end) of the tile */
+  void ThreadedComputeCosts(long begin, long end, itk::ThreadIdType threadId);
+
+  /** Aggregate the costs along the paths [begin, end) of the current direction */
+  void ThreadedAggregateCosts(long begin, long end);
+
+  /** Select the disparities of the rows [begin, end) of the current strip */
+  void ThreadedSelectDisparities(long begin, long end);
+
+  /** Static function used as a "callback" by the MultiThreader */
+  static ITK_THREAD_RETURN_TYPE ThreaderCallback(void *arg);
+
+  /** Internal structure used for passing image data into the threading library */
+  struct ThreadStruct
+  {
+    Pointer Filter;
+  };
+
+private:
+  SemiGlobalMatchingImageFilter(const Self&); //purposely not implemented
+  void operator=(const Self&); //purposely not implemented
+
+  /** Penalty for disparity changes of one pixel */
+  double                        m_P1;
+
+  /** Penalty for disparity changes of more than one pixel */
+  double                        m_P2;
+
+  /** Number of aggregation paths */
+  unsigned int                  m_NumberOfPaths;
+
+  /** Padding of the requested region */
+  unsigned int                  m_Overlap;
+
+  /** Memory available for the cost volumes, in MB */
+  unsigned int                  m_AvailableMemory;
+
+  /** Rows of the output requested region currently processed */
+  RegionType                    m_StripRegion;
+
+  /** Region on which the costs are computed and aggregated */
+  RegionType                    m_TileRegion;
+
+  /** Matching costs, per pixel of the tile and per disparity */
+  std::vector<float>            m_Costs;
+
+  /** Sum of the costs aggregated along each path */
+  std::vector<float>            m_AggregatedCosts;
+
+  /** Maximum valid cost found by each thread */
+  std::vector<float>            m_ThreadMaximumCost;
+
+  /** Cost given to the disparities out of the right image or mask */
+  float                         m_InvalidCost;
+
+  /** Current step and aggregation direction */
+  ProcessingStep                m_CurrentStep;
+  IndexType                     m_Direction;
+
+  /** First pixels of the paths along the current direction */
+  std::vector<IndexType>        m_PathStarts;
+};
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbSemiGlobalMatchingImageFilter.txx"
+#endif
+
+#endif
@@ -0,0 +1,582 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSemiGlobalMatchingImageFilter_txx
+#define otbSemiGlobalMatchingImageFilter_txx
+
+#include "otbSemiGlobalMatchingImageFilter.h"
+#include "otbConfigurationManager.h"
+#include "vnl/vnl_math.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace otb
+{
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::SemiGlobalMatchingImageFilter()
+{
+  // Default penalties
+  m_P1 = 8.;
+  m_P2 = 32.;
+
+  // Default number of paths
+  m_NumberOfPaths = 8;
+
+  // Default overlap
+  m_Overlap = 16;
+
+  // Default memory budget, taken from the configuration
+  m_AvailableMemory = 0;
+
+  m_InvalidCost = 0.;
+  m_CurrentStep = COMPUTE_COSTS;
+  m_Direction.Fill(0);
+
+  // The aggregated costs are minimized
+  this->MinimizeOn();
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::GenerateInputRequestedRegion()
+{
+  // Check the inputs and request the regions needed by the block-matching
+  Superclass::GenerateInputRequestedRegion();
+
+  // Retrieve input pointers
+  TInputImage * inLeftPtr  = const_cast<TInputImage *>(this->GetLeftInput());
+  TInputImage * inRightPtr = const_cast<TInputImage *>(this->GetRightInput());
+  TMaskImage *  inLeftMaskPtr  = const_cast<TMaskImage * >(this->GetLeftMaskInput());
+  TMaskImage *  inRightMaskPtr  = const_cast<TMaskImage * >(this->GetRightMaskInput());
+
+  TOutputMetricImage    * outMetricPtr = this->GetMetricOutput();
+
+  // Check pointers before using them
+  if(!inLeftPtr || !inRightPtr || !outMetricPtr)
+    {
+    return;
+    }
+
+  // The costs are also needed on the overlap, where the paths start
+  SizeType padding = this->GetRadius();
+  padding[0] += m_Overlap;
+  padding[1] += m_Overlap;
+
+  RegionType inputLeftRegion = outMetricPtr->GetRequestedRegion();
+  inputLeftRegion.PadByRadius(padding);
+
+  // Now, we must find the corresponding region in moving image
+  RegionType inputRightRegion = inputLeftRegion;
+  inputRightRegion.SetIndex(0, inputLeftRegion.GetIndex(0) + this->GetMinimumHorizontalDisparity());
+  inputRightRegion.SetSize(0, inputLeftRegion.GetSize(0)
+                           + this->GetMaximumHorizontalDisparity() - this->GetMinimumHorizontalDisparity());
+
+  // These regions contain the ones requested by the superclass, so
+  // that they can be cropped
+  inputLeftRegion.Crop(inLeftPtr->GetLargestPossibleRegion());
+  inputRightRegion.Crop(inRightPtr->GetLargestPossibleRegion());
+
+  inLeftPtr->SetRequestedRegion(inputLeftRegion);
+  inRightPtr->SetRequestedRegion(inputRightRegion);
+
+  if(inLeftMaskPtr)
+    {
+    inLeftMaskPtr->SetRequestedRegion(inputLeftRegion);
+    }
+
+  if(inRightMaskPtr)
+    {
+    inRightMaskPtr->SetRequestedRegion(inputRightRegion);
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::GenerateData()
+{
+  // Sanity checks
+  if (this->GetStep() != 1)
+    {
+    itkExceptionMacro(<<"Semi-global matching only supports a step of 1");
+    }
+  if (this->GetMinimumVerticalDisparity() != 0 || this->GetMaximumVerticalDisparity() != 0)
+    {
+    itkExceptionMacro(<<"Semi-global matching only explores horizontal disparities");
+    }
+  if (this->GetMaximumHorizontalDisparity() < this->GetMinimumHorizontalDisparity())
+    {
+    itkExceptionMacro(<<"Maximum horizontal disparity is lower than the minimum one");
+    }
+  if (m_NumberOfPaths != 4 && m_NumberOfPaths != 8)
+    {
+    itkExceptionMacro(<<"The number of paths should be 4 or 8, not "<<m_NumberOfPaths);
+    }
+
+  this->AllocateOutputs();
+
+  TOutputMetricImage    * outMetricPtr = this->GetMetricOutput();
+  TOutputDisparityImage * outHDispPtr   = this->GetHorizontalDisparityOutput();
+  TOutputDisparityImage * outVDispPtr   = this->GetVerticalDisparityOutput();
+
+  // Fill buffers with default values
+  outMetricPtr->FillBuffer(0.);
+  outHDispPtr->FillBuffer(static_cast<DisparityPixelType>(this->GetMaximumHorizontalDisparity()));
+  outVDispPtr->FillBuffer(static_cast<DisparityPixelType>(this->GetMinimumVerticalDisparity()));
+
+  // The two cost volumes use 8 bytes per pixel and per disparity, which
+  // the streaming does not account for: the requested region is split
+  // into strips of rows whose padded volumes fit in the memory budget
+  const RegionType & requestedRegion = outMetricPtr->GetRequestedRegion();
+  const unsigned long nbDisparities = this->GetMaximumHorizontalDisparity() - this->GetMinimumHorizontalDisparity() + 1;
+
+  const double availableMemory = 1024. * 1024. *
+    (m_AvailableMemory > 0 ? m_AvailableMemory : ConfigurationManager::GetMaxRAMHint());
+  const double paddedRowMemory = 2. * sizeof(float) * nbDisparities
+    * static_cast<double>(requestedRegion.GetSize(0) + 2 * m_Overlap);
+  const double paddedRowsPerStrip = std::floor(availableMemory / paddedRowMemory);
+  unsigned long stripHeight = 1;
+  if (paddedRowsPerStrip > 2. * m_Overlap + 1.)
+    {
+    stripHeight = static_cast<unsigned long>(paddedRowsPerStrip) - 2 * m_Overlap;
+    }
+  stripHeight = std::min(stripHeight, static_cast<unsigned long>(requestedRegion.GetSize(1)));
+
+  const unsigned long nbStrips = (requestedRegion.GetSize(1) + stripHeight - 1) / stripHeight;
+  if (nbStrips > 1)
+    {
+    otbMsgDevMacro(<<"Semi-global matching of "<<requestedRegion.GetSize(1)<<" rows in "
+                   <<nbStrips<<" strips of "<<stripHeight<<" rows");
+    }
+
+  // Set up the multithreaded processing
+  ThreadStruct str;
+  str.Filter = this;
+
+  this->GetMultiThreader()->SetNumberOfThreads(this->GetNumberOfThreads());
+  this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
+
+  for (unsigned long strip = 0; strip < nbStrips; ++strip)
+    {
+    m_StripRegion = requestedRegion;
+    m_StripRegion.SetIndex(1, requestedRegion.GetIndex(1) + strip * stripHeight);
+    m_StripRegion.SetSize(1, std::min(stripHeight, requestedRegion.GetSize(1) - strip * stripHeight));
+
+    this->GenerateStripData();
+    this->UpdateProgress(static_cast<float>(strip + 1) / static_cast<float>(nbStrips));
+    }
+
+  // Release the cost volumes
+  std::vector<float>().swap(m_Costs);
+  std::vector<float>().swap(m_AggregatedCosts);
+  std::vector<IndexType>().swap(m_PathStarts);
+
+  this->UpdateProgress(1.);
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::GenerateStripData()
+{
+  // The costs are aggregated on the strip padded by the overlap
+  m_TileRegion = m_StripRegion;
+  m_TileRegion.PadByRadius(m_Overlap);
+  m_TileRegion.Crop(this->GetLeftInput()->GetLargestPossibleRegion());
+
+  const unsigned long nbDisparities = this->GetMaximumHorizontalDisparity() - this->GetMinimumHorizontalDisparity() + 1;
+  m_Costs.resize(m_TileRegion.GetNumberOfPixels() * nbDisparities);
+  m_AggregatedCosts.assign(m_TileRegion.GetNumberOfPixels() * nbDisparities, 0.f);
+  m_ThreadMaximumCost.assign(this->GetNumberOfThreads(), 0.f);
+
+  // Matching costs
+  m_CurrentStep = COMPUTE_COSTS;
+  this->GetMultiThreader()->SingleMethodExecute();
+
+  // Invalid disparities cost more than any valid one
+  m_InvalidCost = *std::max_element(m_ThreadMaximumCost.begin(), m_ThreadMaximumCost.end())
+    + static_cast<float>(m_P2) + 1.f;
+  m_CurrentStep = FILL_INVALID_COSTS;
+  this->GetMultiThreader()->SingleMethodExecute();
+
+  // Aggregation along each direction, the horizontal and vertical ones first
+  static const int directions[8][2] = {{1,0}, {-1,0}, {0,1}, {0,-1}, {1,1}, {-1,-1}, {1,-1}, {-1,1}};
+
+  const long width = m_TileRegion.GetSize(0);
+  const long height = m_TileRegion.GetSize(1);
+
+  m_CurrentStep = AGGREGATE_COSTS;
+  for (unsigned int path = 0; path < m_NumberOfPaths; ++path)
+    {
+    m_Direction[0] = directions[path][0];
+    m_Direction[1] = directions[path][1];
+
+    // Paths start on the pixels whose predecessor is out of the tile
+    m_PathStarts.clear();
+    IndexType start;
+    if (m_Direction[1] != 0)
+      {
+      start[1] = m_Direction[1] > 0 ? 0 : height - 1;
+      for (start[0] = 0; start[0] < width; ++start[0])
+        {
+        m_PathStarts.push_back(start);
+        }
+      }
+    if (m_Direction[0] != 0)
+      {
+      start[0] = m_Direction[0] > 0 ? 0 : width - 1;
+      for (start[1] = 0; start[1] < height; ++start[1])
+        {
+        if (m_Direction[1] == 0 || start[1] != (m_Direction[1] > 0 ? 0 : height - 1))
+          {
+          m_PathStarts.push_back(start);
+          }
+        }
+      }
+
+    this->GetMultiThreader()->SingleMethodExecute();
+    }
+
+  // Winner-take-all on the aggregated costs
+  m_CurrentStep = SELECT_DISPARITIES;
+  this->GetMultiThreader()->SingleMethodExecute();
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+ITK_THREAD_RETURN_TYPE
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ThreaderCallback(void *arg)
+{
+  ThreadStruct *str;
+  itk::ThreadIdType threadId, threadCount;
+
+  threadId = ((itk::MultiThreader::ThreadInfoStruct *) (arg))->ThreadID;
+  threadCount = ((itk::MultiThreader::ThreadInfoStruct *) (arg))->NumberOfThreads;
+  str = (ThreadStruct *) (((itk::MultiThreader::ThreadInfoStruct *) (arg))->UserData);
+
+  str->Filter->ThreadedStep(threadId, threadCount);
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ThreadedStep(itk::ThreadIdType threadId, itk::ThreadIdType threadCount)
+{
+  // Work items of the current step: rows of the tile or of the output,
+  // or paths
+  long nbItems = 0;
+  switch (m_CurrentStep)
+    {
+    case COMPUTE_COSTS:
+    case FILL_INVALID_COSTS:
+      nbItems = m_TileRegion.GetSize(1);
+      break;
+    case AGGREGATE_COSTS:
+      nbItems = m_PathStarts.size();
+      break;
+    case SELECT_DISPARITIES:
+      nbItems = m_StripRegion.GetSize(1);
+      break;
+    }
+
+  // Split them evenly between the threads
+  const long begin = nbItems * static_cast<long>(threadId) / static_cast<long>(threadCount);
+  const long end = nbItems * static_cast<long>(threadId + 1) / static_cast<long>(threadCount);
+  if (begin >= end)
+    {
+    return;
+    }
+
+  switch (m_CurrentStep)
+    {
+    case COMPUTE_COSTS:
+      this->ThreadedComputeCosts(begin, end, threadId);
+      break;
+    case FILL_INVALID_COSTS:
+      {
+      const unsigned long rowSize = m_TileRegion.GetSize(0)
+        * (this->GetMaximumHorizontalDisparity() - this->GetMinimumHorizontalDisparity() + 1);
+      std::vector<float>::iterator costIt = m_Costs.begin() + begin * rowSize;
+      std::vector<float>::iterator costEnd = m_Costs.begin() + end * rowSize;
+      for (; costIt != costEnd; ++costIt)
+        {
+        if (vnl_math_isnan(*costIt))
+          {
+          *costIt = m_InvalidCost;
+          }
+        }
+      }
+      break;
+    case AGGREGATE_COSTS:
+      this->ThreadedAggregateCosts(begin, end);
+      break;
+    case SELECT_DISPARITIES:
+      this->ThreadedSelectDisparities(begin, end);
+      break;
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ThreadedComputeCosts(long begin, long end, itk::ThreadIdType threadId)
+{
+  const TInputImage * inRightPtr   = this->GetRightInput();
+  const TMaskImage  * inLeftMaskPtr    = this->GetLeftMaskInput();
+  const TMaskImage  * inRightMaskPtr    = this->GetRightMaskInput();
+
+  const RegionType & rightLargestRegion = inRightPtr->GetLargestPossibleRegion();
+
+  const long minDisparity = this->GetMinimumHorizontalDisparity();
+  const long nbDisparities = this->GetMaximumHorizontalDisparity() - minDisparity + 1;
+  const long radiusX = static_cast<long>(this->GetRadius()[0]);
+  const long radiusY = static_cast<long>(this->GetRadius()[1]);
+  const long blockWidth = 2 * radiusX + 1;
+  const double blockSize = static_cast<double>(blockWidth * (2 * radiusY + 1));
+
+  const long tileX = m_TileRegion.GetIndex(0);
+  const long tileY = m_TileRegion.GetIndex(1);
+  const long width = m_TileRegion.GetSize(0);
+
+  // Columns covered by the blocks centered on the tile
+  const long startX = tileX - radiusX;
+  const long nbColumns = width + 2 * radiusX;
+
+  std::vector<double> leftRow(nbColumns);
+  std::vector<double> rightRow(nbColumns);
+  std::vector<double> columnSums(nbColumns);
+
+  float maximumCost = m_ThreadMaximumCost[threadId];
+
+  for (long d = 0; d < nbDisparities; ++d)
+    {
+    const int hdisparity = static_cast<int>(minDisparity + d);
+
+    for (long j = begin; j < end; ++j)
+      {
+      const long y = tileY + j;
+
+      // Slide the vertical sums of the per-pixel costs from the previous row
+      if (j == begin)
+        {
+        std::fill(columnSums.begin(), columnSums.end(), 0.);
+        for (long yy = y - radiusY; yy <= y + radiusY; ++yy)
+          {
+          this->AccumulateRowCosts(startX, yy, hdisparity, 0, 1., leftRow, rightRow, columnSums);
+          }
+        }
+      else
+        {
+        this->AccumulateRowCosts(startX, y - radiusY - 1, hdisparity, 0, -1., leftRow, rightRow, columnSums);
+        this->AccumulateRowCosts(startX, y + radiusY, hdisparity, 0, 1., leftRow, rightRow, columnSums);
+        }
+
+      double blockSum = 0.;
+      for (long k = 0; k < blockWidth; ++k)
+        {
+        blockSum += columnSums[k];
+        }
+
+      float * cost = &m_Costs[j * width * nbDisparities + d];
+      for (long i = 0; i < width; ++i, cost += nbDisparities)
+        {
+        // Slide the block along the row
+        if (i > 0)
+          {
+          blockSum += columnSums[i - 1 + blockWidth] - columnSums[i - 1];
+          }
+
+        IndexType leftIndex;
+        leftIndex[0] = tileX + i;
+        leftIndex[1] = y;
+
+        IndexType rightIndex = leftIndex;
+        rightIndex[0] += hdisparity;
+
+        if (inLeftMaskPtr && !(inLeftMaskPtr->GetPixel(leftIndex) > 0))
+          {
+          // Masked pixels do not favor any disparity
+          *cost = 0.f;
+          }
+        else if (!rightLargestRegion.IsInside(rightIndex)
+                 || (inRightMaskPtr && !(inRightMaskPtr->GetPixel(rightIndex) > 0)))
+          {
+          // Invalid disparity, its cost is set once all the costs are known
+          *cost = std::numeric_limits<float>::quiet_NaN();
+          }
+        else
+          {
+          // The sliding sum may drift slightly below 0 for a perfect match
+          *cost = static_cast<float>(std::max(0., blockSum) / blockSize);
+          maximumCost = std::max(maximumCost, *cost);
+          }
+        }
+      }
+    }
+
+  m_ThreadMaximumCost[threadId] = maximumCost;
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ThreadedAggregateCosts(long begin, long end)
+{
+  const long nbDisparities = this->GetMaximumHorizontalDisparity() - this->GetMinimumHorizontalDisparity() + 1;
+  const long width = m_TileRegion.GetSize(0);
+  const long height = m_TileRegion.GetSize(1);
+  const float p1 = static_cast<float>(m_P1);
+  const float p2 = static_cast<float>(m_P2);
+
+  // Costs aggregated along the path at the previous and current pixels
+  std::vector<float> previous(nbDisparities);
+  std::vector<float> current(nbDisparities);
+
+  for (long path = begin; path < end; ++path)
+    {
+    long x = m_PathStarts[path][0];
+    long y = m_PathStarts[path][1];
+
+    // The first pixel of the path keeps its matching costs
+    long offset = (y * width + x) * nbDisparities;
+    float previousMinimum = std::numeric_limits<float>::max();
+    for (long d = 0; d < nbDisparities; ++d)
+      {
+      previous[d] = m_Costs[offset + d];
+      m_AggregatedCosts[offset + d] += previous[d];
+      previousMinimum = std::min(previousMinimum, previous[d]);
+      }
+
+    for (x += m_Direction[0], y += m_Direction[1];
+         x >= 0 && x < width && y >= 0 && y < height;
+         x += m_Direction[0], y += m_Direction[1])
+      {
+      offset = (y * width + x) * nbDisparities;
+      float currentMinimum = std::numeric_limits<float>::max();
+      for (long d = 0; d < nbDisparities; ++d)
+        {
+        float best = std::min(previous[d], previousMinimum + p2);
+        if (d > 0)
+          {
+          best = std::min(best, previous[d - 1] + p1);
+          }
+        if (d + 1 < nbDisparities)
+          {
+          best = std::min(best, previous[d + 1] + p1);
+          }
+        // Subtracting the previous minimum keeps the values bounded
+        current[d] = m_Costs[offset + d] + (best - previousMinimum);
+        m_AggregatedCosts[offset + d] += current[d];
+        currentMinimum = std::min(currentMinimum, current[d]);
+        }
+      previous.swap(current);
+      previousMinimum = currentMinimum;
+      }
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::ThreadedSelectDisparities(long begin, long end)
+{
+  const TMaskImage      * inLeftMaskPtr = this->GetLeftMaskInput();
+  TOutputMetricImage    * outMetricPtr = this->GetMetricOutput();
+  TOutputDisparityImage * outHDispPtr   = this->GetHorizontalDisparityOutput();
+
+  const RegionType & outputRegion = m_StripRegion;
+
+  const long minDisparity = this->GetMinimumHorizontalDisparity();
+  const long nbDisparities = this->GetMaximumHorizontalDisparity() - minDisparity + 1;
+  const long tileX = m_TileRegion.GetIndex(0);
+  const long tileY = m_TileRegion.GetIndex(1);
+  const long width = m_TileRegion.GetSize(0);
+
+  IndexType index;
+  for (long j = begin; j < end; ++j)
+    {
+    index[1] = outputRegion.GetIndex(1) + j;
+    for (long i = 0; i < static_cast<long>(outputRegion.GetSize(0)); ++i)
+      {
+      index[0] = outputRegion.GetIndex(0) + i;
+
+      // Masked pixels keep the default values
+      if (inLeftMaskPtr && !(inLeftMaskPtr->GetPixel(index) > 0))
+        {
+        continue;
+        }
+
+      const float * aggregatedCosts = &m_AggregatedCosts[((index[1] - tileY) * width + index[0] - tileX) * nbDisparities];
+      long bestDisparity = 0;
+      for (long d = 1; d < nbDisparities; ++d)
+        {
+        if (aggregatedCosts[d] < aggregatedCosts[bestDisparity])
+          {
+          bestDisparity = d;
+          }
+        }
+
+      outMetricPtr->SetPixel(index, static_cast<MetricValueType>(aggregatedCosts[bestDisparity]));
+      outHDispPtr->SetPixel(index, static_cast<DisparityPixelType>(minDisparity + bestDisparity));
+      }
+    }
+}
+
+template <class TInputImage, class TOutputMetricImage,
+class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+SemiGlobalMatchingImageFilter<TInputImage,TOutputMetricImage,
+TOutputDisparityImage,TMaskImage,TBlockMatchingFunctor>
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "P1: " << m_P1 << std::endl;
+  os << indent << "P2: " << m_P2 << std::endl;
+  os << indent << "Number of paths: " << m_NumberOfPaths << std::endl;
+  os << indent << "Overlap: " << m_Overlap << std::endl;
+  os << indent << "Available memory: " << m_AvailableMemory << std::endl;
+}
+
+} // End namespace otb
+
+#endif
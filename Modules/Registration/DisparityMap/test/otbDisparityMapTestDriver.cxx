@@ -43,4 +43,9 @@ void RegisterTests()
   REGISTER_TEST(otbPixelWiseBlockMatchingImageFilter);
   REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterNew);
   REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterNCC);
+  REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterSlidingSums);
+  REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterSlidingSumsFloat);
+  REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterBoxSums);
+  REGISTER_TEST(otbSemiGlobalMatchingImageFilterNew);
+  REGISTER_TEST(otbSemiGlobalMatchingImageFilter);
 }
@@ -23,10 +23,15 @@
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
 #include "otbStandardWriterWatcher.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "vnl/vnl_math.h"
+#include <algorithm>
 
 typedef otb::Image<unsigned short>                    ImageType;
 typedef otb::Image<float>                             FloatImageType;
 typedef otb::ImageFileReader<ImageType>               ReaderType;
+typedef otb::ImageFileReader<FloatImageType>          FloatReaderType;
 typedef otb::ImageFileWriter<FloatImageType> FloatWriterType;
 
 typedef otb::PixelWiseBlockMatchingImageFilter<ImageType,FloatImageType,FloatImageType,ImageType> PixelWiseBlockMatchingImageFilterType;
@@ -35,6 +40,35 @@ typedef otb::Functor::NCCBlockMatching<ImageType,FloatImageType> NCCBlockMatchin
 
 typedef otb::PixelWiseBlockMatchingImageFilter<ImageType,FloatImageType,FloatImageType,ImageType, NCCBlockMatchingFunctorType> PixelWiseNCCBlockMatchingImageFilterType;
 
+// SSD functor without the pixel-wise sum metric category: the filter
+// evaluates it on each pair of neighborhoods
+class NeighborhoodSSDBlockMatchingFunctorType : public otb::Functor::SSDBlockMatching<ImageType,FloatImageType>
+{
+};
+
+typedef otb::PixelWiseBlockMatchingImageFilter<ImageType,FloatImageType,FloatImageType,ImageType, NeighborhoodSSDBlockMatchingFunctorType> PixelWiseNeighborhoodSSDBlockMatchingImageFilterType;
+
+// Same on float images, as in the BlockMatching and StereoFramework applications
+typedef otb::PixelWiseBlockMatchingImageFilter<FloatImageType,FloatImageType,FloatImageType,ImageType> FloatPixelWiseBlockMatchingImageFilterType;
+
+class NeighborhoodFloatSSDBlockMatchingFunctorType : public otb::Functor::SSDBlockMatching<FloatImageType,FloatImageType>
+{
+};
+
+typedef otb::PixelWiseBlockMatchingImageFilter<FloatImageType,FloatImageType,FloatImageType,ImageType, NeighborhoodFloatSSDBlockMatchingFunctorType> FloatPixelWiseNeighborhoodSSDBlockMatchingImageFilterType;
+
+// NCC and SSD divided by mean functors without the box sum metric
+// category: the filter evaluates them on each pair of neighborhoods
+class NeighborhoodNCCBlockMatchingFunctorType : public otb::Functor::NCCBlockMatching<ImageType,FloatImageType>
+{
+};
+
+typedef otb::Functor::SSDDivMeanBlockMatching<ImageType,FloatImageType> SSDDivMeanBlockMatchingFunctorType;
+
+class NeighborhoodSSDDivMeanBlockMatchingFunctorType : public SSDDivMeanBlockMatchingFunctorType
+{
+};
+
 int otbPixelWiseBlockMatchingImageFilterNew(int itkNotUsed(argc), char * itkNotUsed(argv) [])
 {
   // Instantiation
@@ -126,3 +160,228 @@ int otbPixelWiseBlockMatchingImageFilterNCC(int argc, char * argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbPixelWiseBlockMatchingImageFilterSlidingSums(int itkNotUsed(argc), char * argv[])
+{
+  ReaderType::Pointer leftReader = ReaderType::New();
+  leftReader->SetFileName(argv[1]);
+
+  ReaderType::Pointer rightReader = ReaderType::New();
+  rightReader->SetFileName(argv[2]);
+
+  // SSD computed with sliding sums
+  PixelWiseBlockMatchingImageFilterType::Pointer bmFilter = PixelWiseBlockMatchingImageFilterType::New();
+  bmFilter->SetLeftInput(leftReader->GetOutput());
+  bmFilter->SetRightInput(rightReader->GetOutput());
+  bmFilter->SetRadius(atoi(argv[3]));
+  bmFilter->SetMinimumHorizontalDisparity(atoi(argv[4]));
+  bmFilter->SetMaximumHorizontalDisparity(atoi(argv[5]));
+  bmFilter->SetMinimumVerticalDisparity(atoi(argv[6]));
+  bmFilter->SetMaximumVerticalDisparity(atoi(argv[7]));
+  bmFilter->SetStep(atoi(argv[8]));
+  bmFilter->Update();
+
+  // SSD computed on each pair of neighborhoods
+  PixelWiseNeighborhoodSSDBlockMatchingImageFilterType::Pointer refFilter = PixelWiseNeighborhoodSSDBlockMatchingImageFilterType::New();
+  refFilter->SetLeftInput(leftReader->GetOutput());
+  refFilter->SetRightInput(rightReader->GetOutput());
+  refFilter->SetRadius(atoi(argv[3]));
+  refFilter->SetMinimumHorizontalDisparity(atoi(argv[4]));
+  refFilter->SetMaximumHorizontalDisparity(atoi(argv[5]));
+  refFilter->SetMinimumVerticalDisparity(atoi(argv[6]));
+  refFilter->SetMaximumVerticalDisparity(atoi(argv[7]));
+  refFilter->SetStep(atoi(argv[8]));
+  refFilter->Update();
+
+  itk::ImageRegionConstIterator<FloatImageType> metricIt(bmFilter->GetMetricOutput(), bmFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> hDispIt(bmFilter->GetHorizontalDisparityOutput(), bmFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> vDispIt(bmFilter->GetVerticalDisparityOutput(), bmFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> refMetricIt(refFilter->GetMetricOutput(), refFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> refHDispIt(refFilter->GetHorizontalDisparityOutput(), refFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> refVDispIt(refFilter->GetVerticalDisparityOutput(), refFilter->GetMetricOutput()->GetLargestPossibleRegion());
+
+  for (metricIt.GoToBegin(), hDispIt.GoToBegin(), vDispIt.GoToBegin(),
+       refMetricIt.GoToBegin(), refHDispIt.GoToBegin(), refVDispIt.GoToBegin();
+       !metricIt.IsAtEnd();
+       ++metricIt, ++hDispIt, ++vDispIt, ++refMetricIt, ++refHDispIt, ++refVDispIt)
+    {
+    if (metricIt.Get() != refMetricIt.Get()
+        || hDispIt.Get() != refHDispIt.Get()
+        || vDispIt.Get() != refVDispIt.Get())
+      {
+      std::cerr << "Pixel " << metricIt.GetIndex() << ": metric " << metricIt.Get()
+                << " and disparity (" << hDispIt.Get() << ", " << vDispIt.Get()
+                << ") instead of metric " << refMetricIt.Get() << " and disparity ("
+                << refHDispIt.Get() << ", " << refVDispIt.Get() << ")" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
+
+// Read an image as float and scale it, so that the squared differences
+// are not integers
+FloatImageType::Pointer ReadScaledFloatImage(const char * filename)
+{
+  FloatReaderType::Pointer reader = FloatReaderType::New();
+  reader->SetFileName(filename);
+  reader->Update();
+
+  FloatImageType::Pointer image = reader->GetOutput();
+  image->DisconnectPipeline();
+
+  itk::ImageRegionIterator<FloatImageType> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    it.Set(it.Get() / 7.f + 0.1f);
+    }
+  return image;
+}
+
+int otbPixelWiseBlockMatchingImageFilterSlidingSumsFloat(int itkNotUsed(argc), char * argv[])
+{
+  FloatImageType::Pointer leftImage = ReadScaledFloatImage(argv[1]);
+  FloatImageType::Pointer rightImage = ReadScaledFloatImage(argv[2]);
+
+  // SSD computed with sliding sums
+  FloatPixelWiseBlockMatchingImageFilterType::Pointer bmFilter = FloatPixelWiseBlockMatchingImageFilterType::New();
+  bmFilter->SetLeftInput(leftImage);
+  bmFilter->SetRightInput(rightImage);
+  bmFilter->SetRadius(atoi(argv[3]));
+  bmFilter->SetMinimumHorizontalDisparity(atoi(argv[4]));
+  bmFilter->SetMaximumHorizontalDisparity(atoi(argv[5]));
+  bmFilter->Update();
+
+  // SSD computed on each pair of neighborhoods
+  FloatPixelWiseNeighborhoodSSDBlockMatchingImageFilterType::Pointer refFilter = FloatPixelWiseNeighborhoodSSDBlockMatchingImageFilterType::New();
+  refFilter->SetLeftInput(leftImage);
+  refFilter->SetRightInput(rightImage);
+  refFilter->SetRadius(atoi(argv[3]));
+  refFilter->SetMinimumHorizontalDisparity(atoi(argv[4]));
+  refFilter->SetMaximumHorizontalDisparity(atoi(argv[5]));
+  refFilter->Update();
+
+  itk::ImageRegionConstIterator<FloatImageType> metricIt(bmFilter->GetMetricOutput(), bmFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> hDispIt(bmFilter->GetHorizontalDisparityOutput(), bmFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> refMetricIt(refFilter->GetMetricOutput(), refFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> refHDispIt(refFilter->GetHorizontalDisparityOutput(), refFilter->GetMetricOutput()->GetLargestPossibleRegion());
+
+  // The sums are not exact on float images: the metrics may differ
+  // slightly, and so may the disparities of metrics that are equal up to
+  // rounding, but the metrics can not be negative
+  const double tolerance = 1e-4;
+
+  for (metricIt.GoToBegin(), hDispIt.GoToBegin(), refMetricIt.GoToBegin(), refHDispIt.GoToBegin();
+       !metricIt.IsAtEnd();
+       ++metricIt, ++hDispIt, ++refMetricIt, ++refHDispIt)
+    {
+    const double metric = metricIt.Get();
+    const double refMetric = refMetricIt.Get();
+    if (metric < 0. || !(vcl_abs(metric - refMetric) <= tolerance * std::max(1., vcl_abs(refMetric))))
+      {
+      std::cerr << "Pixel " << metricIt.GetIndex() << ": metric " << metric
+                << " instead of " << refMetric << std::endl;
+      return EXIT_FAILURE;
+      }
+    if (hDispIt.Get() != refHDispIt.Get())
+      {
+      std::cout << "Pixel " << metricIt.GetIndex() << ": disparity " << hDispIt.Get()
+                << " instead of " << refHDispIt.Get() << " for close metrics" << std::endl;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
+
+template <class TBlockMatchingFunctor, class TNeighborhoodBlockMatchingFunctor>
+int CompareBoxSumsToNeighborhoods(ReaderType * leftReader, ReaderType * rightReader,
+                                  char * argv[], bool minimize)
+{
+  typedef otb::PixelWiseBlockMatchingImageFilter<ImageType,FloatImageType,FloatImageType,ImageType,
+    TBlockMatchingFunctor> BoxSumsFilterType;
+  typedef otb::PixelWiseBlockMatchingImageFilter<ImageType,FloatImageType,FloatImageType,ImageType,
+    TNeighborhoodBlockMatchingFunctor> NeighborhoodFilterType;
+
+  // Metric computed with sliding box sums
+  typename BoxSumsFilterType::Pointer bmFilter = BoxSumsFilterType::New();
+  bmFilter->SetLeftInput(leftReader->GetOutput());
+  bmFilter->SetRightInput(rightReader->GetOutput());
+  bmFilter->SetRadius(atoi(argv[3]));
+  bmFilter->SetMinimumHorizontalDisparity(atoi(argv[4]));
+  bmFilter->SetMaximumHorizontalDisparity(atoi(argv[5]));
+  bmFilter->SetStep(atoi(argv[6]));
+  bmFilter->SetMinimize(minimize);
+  bmFilter->Update();
+
+  // Metric computed on each pair of neighborhoods
+  typename NeighborhoodFilterType::Pointer refFilter = NeighborhoodFilterType::New();
+  refFilter->SetLeftInput(leftReader->GetOutput());
+  refFilter->SetRightInput(rightReader->GetOutput());
+  refFilter->SetRadius(atoi(argv[3]));
+  refFilter->SetMinimumHorizontalDisparity(atoi(argv[4]));
+  refFilter->SetMaximumHorizontalDisparity(atoi(argv[5]));
+  refFilter->SetStep(atoi(argv[6]));
+  refFilter->SetMinimize(minimize);
+  refFilter->Update();
+
+  itk::ImageRegionConstIterator<FloatImageType> metricIt(bmFilter->GetMetricOutput(), bmFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> hDispIt(bmFilter->GetHorizontalDisparityOutput(), bmFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> refMetricIt(refFilter->GetMetricOutput(), refFilter->GetMetricOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> refHDispIt(refFilter->GetHorizontalDisparityOutput(), refFilter->GetMetricOutput()->GetLargestPossibleRegion());
+
+  // The closed forms round differently: the metrics may differ slightly,
+  // and so may the disparities of metrics that are equal up to rounding
+  const double tolerance = 1e-4;
+
+  for (metricIt.GoToBegin(), hDispIt.GoToBegin(), refMetricIt.GoToBegin(), refHDispIt.GoToBegin();
+       !metricIt.IsAtEnd();
+       ++metricIt, ++hDispIt, ++refMetricIt, ++refHDispIt)
+    {
+    const double metric = metricIt.Get();
+    const double refMetric = refMetricIt.Get();
+    if (vnl_math_isnan(metric) && vnl_math_isnan(refMetric))
+      {
+      continue;
+      }
+
+    if (!(vcl_abs(metric - refMetric) <= tolerance * std::max(1., vcl_abs(refMetric))))
+      {
+      std::cerr << "Pixel " << metricIt.GetIndex() << ": metric " << metric
+                << " instead of " << refMetric << std::endl;
+      return EXIT_FAILURE;
+      }
+    if (hDispIt.Get() != refHDispIt.Get())
+      {
+      std::cout << "Pixel " << metricIt.GetIndex() << ": disparity " << hDispIt.Get()
+                << " instead of " << refHDispIt.Get() << " for close metrics" << std::endl;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
+
+int otbPixelWiseBlockMatchingImageFilterBoxSums(int itkNotUsed(argc), char * argv[])
+{
+  ReaderType::Pointer leftReader = ReaderType::New();
+  leftReader->SetFileName(argv[1]);
+
+  ReaderType::Pointer rightReader = ReaderType::New();
+  rightReader->SetFileName(argv[2]);
+
+  if (CompareBoxSumsToNeighborhoods<NCCBlockMatchingFunctorType, NeighborhoodNCCBlockMatchingFunctorType>(
+        leftReader, rightReader, argv, false) != EXIT_SUCCESS)
+    {
+    std::cerr << "NCC metric differs from the neighborhood evaluation" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (CompareBoxSumsToNeighborhoods<SSDDivMeanBlockMatchingFunctorType, NeighborhoodSSDDivMeanBlockMatchingFunctorType>(
+        leftReader, rightReader, argv, true) != EXIT_SUCCESS)
+    {
+    std::cerr << "SSD divided by mean metric differs from the neighborhood evaluation" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbSemiGlobalMatchingImageFilter.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkTimeProbe.h"
+
+typedef otb::Image<unsigned short>                    ImageType;
+typedef otb::Image<float>                             FloatImageType;
+typedef otb::ImageFileReader<ImageType>               ReaderType;
+typedef otb::ImageFileWriter<FloatImageType>          FloatWriterType;
+
+typedef otb::PixelWiseBlockMatchingImageFilter<ImageType,FloatImageType,FloatImageType,ImageType> BlockMatchingFilterType;
+typedef otb::SemiGlobalMatchingImageFilter<ImageType,FloatImageType,FloatImageType,ImageType>     SemiGlobalMatchingFilterType;
+typedef otb::SemiGlobalMatchingImageFilter<FloatImageType,FloatImageType,FloatImageType,ImageType> FloatSemiGlobalMatchingFilterType;
+
+int otbSemiGlobalMatchingImageFilterNew(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  // Instantiation
+  SemiGlobalMatchingFilterType::Pointer sgmFilter = SemiGlobalMatchingFilterType::New();
+
+  std::cout << sgmFilter << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+int otbSemiGlobalMatchingImageFilter(int itkNotUsed(argc), char * argv[])
+{
+  ReaderType::Pointer leftReader = ReaderType::New();
+  leftReader->SetFileName(argv[1]);
+
+  ReaderType::Pointer rightReader = ReaderType::New();
+  rightReader->SetFileName(argv[2]);
+
+  const unsigned int radius = atoi(argv[4]);
+  const int minDisparity = atoi(argv[5]);
+  const int maxDisparity = atoi(argv[6]);
+
+  leftReader->Update();
+  rightReader->Update();
+
+  // Block-matching
+  BlockMatchingFilterType::Pointer bmFilter = BlockMatchingFilterType::New();
+  bmFilter->SetLeftInput(leftReader->GetOutput());
+  bmFilter->SetRightInput(rightReader->GetOutput());
+  bmFilter->SetRadius(radius);
+  bmFilter->SetMinimumHorizontalDisparity(minDisparity);
+  bmFilter->SetMaximumHorizontalDisparity(maxDisparity);
+
+  itk::TimeProbe bmChrono;
+  bmChrono.Start();
+  bmFilter->Update();
+  bmChrono.Stop();
+
+  // Semi-global matching
+  SemiGlobalMatchingFilterType::Pointer sgmFilter = SemiGlobalMatchingFilterType::New();
+  sgmFilter->SetLeftInput(leftReader->GetOutput());
+  sgmFilter->SetRightInput(rightReader->GetOutput());
+  sgmFilter->SetRadius(radius);
+  sgmFilter->SetMinimumHorizontalDisparity(minDisparity);
+  sgmFilter->SetMaximumHorizontalDisparity(maxDisparity);
+
+  FloatWriterType::Pointer dispWriter = FloatWriterType::New();
+  dispWriter->SetInput(sgmFilter->GetHorizontalDisparityOutput());
+  dispWriter->SetFileName(argv[3]);
+
+  itk::TimeProbe sgmChrono;
+  sgmChrono.Start();
+  sgmFilter->Update();
+  sgmChrono.Stop();
+
+  dispWriter->Update();
+
+  std::cout << "Block-matching: " << bmChrono.GetTotal() << " s, semi-global matching ("
+            << sgmFilter->GetNumberOfPaths() << " paths): " << sgmChrono.GetTotal() << " s" << std::endl;
+
+  // Without penalties, the aggregated costs are proportional to the
+  // block-matching metric and give the same disparities. A 1 MB budget
+  // splits the image into strips, which must not change them either.
+  SemiGlobalMatchingFilterType::Pointer wtaFilter = SemiGlobalMatchingFilterType::New();
+  wtaFilter->SetLeftInput(leftReader->GetOutput());
+  wtaFilter->SetRightInput(rightReader->GetOutput());
+  wtaFilter->SetRadius(radius);
+  wtaFilter->SetMinimumHorizontalDisparity(minDisparity);
+  wtaFilter->SetMaximumHorizontalDisparity(maxDisparity);
+  wtaFilter->SetP1(0.);
+  wtaFilter->SetP2(0.);
+  wtaFilter->SetNumberOfPaths(4);
+  wtaFilter->SetAvailableMemory(1);
+  wtaFilter->Update();
+
+  itk::ImageRegionConstIterator<FloatImageType> bmIt(bmFilter->GetHorizontalDisparityOutput(),
+                                                     bmFilter->GetHorizontalDisparityOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> wtaIt(wtaFilter->GetHorizontalDisparityOutput(),
+                                                      wtaFilter->GetHorizontalDisparityOutput()->GetLargestPossibleRegion());
+
+  for (bmIt.GoToBegin(), wtaIt.GoToBegin(); !bmIt.IsAtEnd(); ++bmIt, ++wtaIt)
+    {
+    if (bmIt.Get() != wtaIt.Get())
+      {
+      std::cerr << "Pixel " << bmIt.GetIndex() << ": disparity " << wtaIt.Get()
+                << " instead of " << bmIt.Get() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Identical float images must match at disparity 0 everywhere, even
+  // though the sliding sums of the costs drift around 0
+  FloatImageType::RegionType floatRegion;
+  floatRegion.SetSize(0, 64);
+  floatRegion.SetSize(1, 48);
+  FloatImageType::Pointer floatImage = FloatImageType::New();
+  floatImage->SetRegions(floatRegion);
+  floatImage->Allocate();
+
+  unsigned int seed = 12345;
+  itk::ImageRegionIterator<FloatImageType> floatIt(floatImage, floatRegion);
+  for (floatIt.GoToBegin(); !floatIt.IsAtEnd(); ++floatIt)
+    {
+    seed = seed * 1103515245u + 12345u;
+    floatIt.Set(static_cast<float>((seed >> 8) % 100000) / 7.f);
+    }
+
+  FloatSemiGlobalMatchingFilterType::Pointer floatFilter = FloatSemiGlobalMatchingFilterType::New();
+  floatFilter->SetLeftInput(floatImage);
+  floatFilter->SetRightInput(floatImage);
+  floatFilter->SetRadius(radius);
+  floatFilter->SetMinimumHorizontalDisparity(minDisparity);
+  floatFilter->SetMaximumHorizontalDisparity(maxDisparity);
+  floatFilter->Update();
+
+  itk::ImageRegionConstIterator<FloatImageType> zeroIt(floatFilter->GetHorizontalDisparityOutput(), floatRegion);
+  for (zeroIt.GoToBegin(); !zeroIt.IsAtEnd(); ++zeroIt)
+    {
+    if (zeroIt.Get() != 0.f)
+      {
+      std::cerr << "Identical images, pixel " << zeroIt.GetIndex() << ": disparity " << zeroIt.Get()
+                << " instead of 0" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
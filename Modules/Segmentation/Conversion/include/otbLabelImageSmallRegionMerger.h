@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLabelImageSmallRegionMerger_h
+#define otbLabelImageSmallRegionMerger_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** \class LabelImageSmallRegionMerger
+ * \brief Merges the small regions of a segmentation with their closest
+ * adjacent region
+ *
+ * The regions are described by their population, the sum of their spectral
+ * values and the list of adjacent label pairs, as computed by
+ * StreamingLabelImageAdjacencyFilter. The region adjacency graph is stored
+ * in compressed sparse row arrays.
+ *
+ * Regions are processed by increasing size, from 1 pixel to MinSize - 1
+ * pixels: each region of the current size is merged with the adjacent region
+ * whose mean spectral value is the closest. Merges of a pass are decided with
+ * the statistics from the beginning of the pass, and a merged region takes
+ * the smallest label. All passes are done in memory, the graph being
+ * contracted after each pass.
+ *
+ * The result is a look-up table giving the final label of each input label,
+ * which can be applied with itk::ChangeLabelImageFilter.
+ *
+ * \sa StreamingLabelImageAdjacencyFilter
+ *
+ * \ingroup OTBConversion
+ */
+template <class TLabel>
+class ITK_EXPORT LabelImageSmallRegionMerger : public itk::Object
+{
+public:
+  /** Standard class typedefs */
+  typedef LabelImageSmallRegionMerger   Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(LabelImageSmallRegionMerger, itk::Object);
+
+  typedef TLabel                               LabelType;
+  typedef std::vector<LabelType>               LUTType;
+  typedef std::vector<unsigned long>           PopulationContainerType;
+  typedef std::vector<double>                  SumContainerType;
+  typedef std::pair<LabelType, LabelType>      EdgeType;
+  typedef std::vector<EdgeType>                EdgeContainerType;
+
+  /** Regions with less pixels than MinSize are merged */
+  itkSetMacro(MinSize, unsigned int);
+  itkGetConstMacro(MinSize, unsigned int);
+
+  /** Set the population and the sum of spectral values of each label. The
+   * components of label l are stored from index l * nbComponents in sums. */
+  void SetLabelStatistics(const PopulationContainerType & population,
+                          const SumContainerType & sums,
+                          unsigned int nbComponents);
+
+  /** Set the pairs of adjacent labels. Pairs do not need to be sorted. */
+  void SetAdjacentLabels(const EdgeContainerType & edges);
+
+  /** Merge the small regions */
+  void Update();
+
+  /** Final label of each input label */
+  const LUTType & GetLUT() const
+  {
+    return m_LUT;
+  }
+
+protected:
+  LabelImageSmallRegionMerger();
+  ~LabelImageSmallRegionMerger() ITK_OVERRIDE {}
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+private:
+  LabelImageSmallRegionMerger(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  /** Build the adjacency graph from the edges, which are sorted and cleared */
+  void BuildGraph(EdgeContainerType & edges);
+
+  /** Find the adjacent region with the closest mean spectral value.
+   * Returns false if the region has no neighbor. */
+  bool FindClosestNeighbor(LabelType label, LabelType & neighbor) const;
+
+  /** Replace the labels of the graph by their final label */
+  void ContractGraph();
+
+  unsigned int m_MinSize;
+
+  unsigned int m_NumberOfComponents;
+
+  PopulationContainerType m_Population;
+
+  SumContainerType m_Sums;
+
+  /** Neighbors of label l are m_Neighbors[m_NeighborOffsets[l]] to
+   * m_Neighbors[m_NeighborOffsets[l+1]-1], sorted */
+  std::vector<unsigned long> m_NeighborOffsets;
+  std::vector<LabelType>     m_Neighbors;
+
+  LUTType m_LUT;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbLabelImageSmallRegionMerger.txx"
+#endif
+
+#endif
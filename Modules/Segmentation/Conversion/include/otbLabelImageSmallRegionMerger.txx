@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLabelImageSmallRegionMerger_txx
+#define otbLabelImageSmallRegionMerger_txx
+
+#include "otbLabelImageSmallRegionMerger.h"
+#include "itkNumericTraits.h"
+#include "otbMacro.h"
+
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TLabel>
+LabelImageSmallRegionMerger<TLabel>
+::LabelImageSmallRegionMerger()
+  : m_MinSize(1),
+    m_NumberOfComponents(0)
+{
+}
+
+template <class TLabel>
+void
+LabelImageSmallRegionMerger<TLabel>
+::SetLabelStatistics(const PopulationContainerType & population,
+                     const SumContainerType & sums,
+                     unsigned int nbComponents)
+{
+  if (sums.size() != population.size() * nbComponents)
+    {
+    itkExceptionMacro(<< "Sums of " << sums.size() / vcl_max(nbComponents, 1u)
+                      << " labels given for " << population.size() << " labels");
+    }
+  m_Population = population;
+  m_Sums = sums;
+  m_NumberOfComponents = nbComponents;
+  this->Modified();
+}
+
+template <class TLabel>
+void
+LabelImageSmallRegionMerger<TLabel>
+::SetAdjacentLabels(const EdgeContainerType & edges)
+{
+  EdgeContainerType graphEdges(edges);
+  this->BuildGraph(graphEdges);
+  this->Modified();
+}
+
+template <class TLabel>
+void
+LabelImageSmallRegionMerger<TLabel>
+::BuildGraph(EdgeContainerType & edges)
+{
+  // Both directions of each edge are stored
+  const typename EdgeContainerType::size_type nbEdges = edges.size();
+  edges.reserve(2 * nbEdges);
+  for (typename EdgeContainerType::size_type i = 0; i < nbEdges; ++i)
+    {
+    edges.push_back(EdgeType(edges[i].second, edges[i].first));
+    }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+  unsigned long nbLabels = m_Population.size();
+  if (!edges.empty())
+    {
+    nbLabels = vcl_max(nbLabels, static_cast<unsigned long>(edges.back().first) + 1);
+    }
+
+  m_NeighborOffsets.assign(nbLabels + 1, 0);
+  m_Neighbors.clear();
+  m_Neighbors.reserve(edges.size());
+
+  for (typename EdgeContainerType::const_iterator it = edges.begin(); it != edges.end(); ++it)
+    {
+    if (it->first != it->second)
+      {
+      m_NeighborOffsets[static_cast<unsigned long>(it->first) + 1]++;
+      m_Neighbors.push_back(it->second);
+      }
+    }
+  for (unsigned long label = 0; label < nbLabels; ++label)
+    {
+    m_NeighborOffsets[label + 1] += m_NeighborOffsets[label];
+    }
+
+  EdgeContainerType().swap(edges);
+}
+
+template <class TLabel>
+bool
+LabelImageSmallRegionMerger<TLabel>
+::FindClosestNeighbor(LabelType label, LabelType & neighbor) const
+{
+  const unsigned long curLabel = static_cast<unsigned long>(label);
+  const unsigned long first = m_NeighborOffsets[curLabel];
+  const unsigned long last = m_NeighborOffsets[curLabel + 1];
+
+  double err = itk::NumericTraits<double>::max();
+  bool found = false;
+
+  for (unsigned long n = first; n < last; ++n)
+    {
+    const unsigned long tmpLabel = static_cast<unsigned long>(m_Neighbors[n]);
+    double tmpError = 0;
+    for (unsigned int comp = 0; comp < m_NumberOfComponents; ++comp)
+      {
+      const double curComp = m_Sums[curLabel * m_NumberOfComponents + comp] / m_Population[curLabel];
+      // The mean of the neighbor is truncated, as in the original
+      // LSMSSmallRegionsMerging implementation
+      const int tmpComp = m_Sums[tmpLabel * m_NumberOfComponents + comp] / m_Population[tmpLabel];
+      tmpError += (curComp - tmpComp) * (curComp - tmpComp);
+      }
+    if (tmpError < err)
+      {
+      err = tmpError;
+      neighbor = m_Neighbors[n];
+      found = true;
+      }
+    }
+  return found;
+}
+
+template <class TLabel>
+void
+LabelImageSmallRegionMerger<TLabel>
+::ContractGraph()
+{
+  const unsigned long nbLabels = m_NeighborOffsets.size() - 1;
+
+  EdgeContainerType edges;
+  edges.reserve(m_Neighbors.size() / 2);
+  for (unsigned long label = 0; label < nbLabels; ++label)
+    {
+    const LabelType newLabel = m_LUT[label];
+    for (unsigned long n = m_NeighborOffsets[label]; n < m_NeighborOffsets[label + 1]; ++n)
+      {
+      const LabelType newNeighbor = m_LUT[m_Neighbors[n]];
+      if (label < static_cast<unsigned long>(m_Neighbors[n]) && newLabel != newNeighbor)
+        {
+        edges.push_back(EdgeType(std::min(newLabel, newNeighbor), std::max(newLabel, newNeighbor)));
+        }
+      }
+    }
+
+  // Release the former graph before building the new one
+  std::vector<LabelType>().swap(m_Neighbors);
+  this->BuildGraph(edges);
+}
+
+template <class TLabel>
+void
+LabelImageSmallRegionMerger<TLabel>
+::Update()
+{
+  const unsigned long nbGraphLabels = m_NeighborOffsets.empty() ? 0 : m_NeighborOffsets.size() - 1;
+  const unsigned long nbLabels = vcl_max(static_cast<unsigned long>(m_Population.size()), nbGraphLabels);
+
+  // Labels with no neighbor, or seen only in the adjacency (no pixel)
+  m_NeighborOffsets.resize(nbLabels + 1, m_NeighborOffsets.empty() ? 0 : m_NeighborOffsets.back());
+  m_Population.resize(nbLabels, 0);
+  m_Sums.resize(nbLabels * m_NumberOfComponents, 0.);
+
+  m_LUT.resize(nbLabels);
+  for (unsigned long label = 0; label < nbLabels; ++label)
+    {
+    m_LUT[label] = static_cast<LabelType>(label);
+    }
+
+  LUTType LUTtmp;
+
+  for (unsigned int size = 1; size < m_MinSize; ++size)
+    {
+    // LUTtmp is modified during the pass, the LUT only at the end of the pass
+    LUTtmp = m_LUT;
+    bool hasMerged = false;
+
+    for (unsigned long curLabel = 0; curLabel < nbLabels; ++curLabel)
+      {
+      // Merged labels have no pixel left, so only regions are considered
+      if (m_Population[curLabel] != size)
+        {
+        continue;
+        }
+
+      LabelType adjLabel = 0;
+      if (!this->FindClosestNeighbor(static_cast<LabelType>(curLabel), adjLabel))
+        {
+        continue;
+        }
+
+      // Fusion of the two regions, the smallest label is kept
+      LabelType curLabelLUT = static_cast<LabelType>(curLabel);
+      LabelType adjLabelLUT = adjLabel;
+      while (LUTtmp[curLabelLUT] != curLabelLUT)
+        {
+        curLabelLUT = LUTtmp[curLabelLUT];
+        }
+      while (LUTtmp[adjLabelLUT] != adjLabelLUT)
+        {
+        adjLabelLUT = LUTtmp[adjLabelLUT];
+        }
+      if (curLabelLUT < adjLabelLUT)
+        {
+        LUTtmp[adjLabelLUT] = curLabelLUT;
+        }
+      else
+        {
+        LUTtmp[curLabelLUT] = adjLabelLUT;
+        }
+      hasMerged = true;
+      }
+
+    if (!hasMerged)
+      {
+      continue;
+      }
+
+    for (unsigned long label = 0; label < nbLabels; ++label)
+      {
+      LabelType can = static_cast<LabelType>(label);
+      while (LUTtmp[can] != can)
+        {
+        can = LUTtmp[can];
+        }
+      LUTtmp[label] = can;
+      }
+
+    for (unsigned long label = 0; label < nbLabels; ++label)
+      {
+      m_LUT[label] = LUTtmp[label];
+      const unsigned long root = static_cast<unsigned long>(m_LUT[label]);
+      if ((m_Population[label] != 0) && (root != label))
+        {
+        m_Population[root] += m_Population[label];
+        m_Population[label] = 0;
+        for (unsigned int comp = 0; comp < m_NumberOfComponents; ++comp)
+          {
+          m_Sums[root * m_NumberOfComponents + comp] += m_Sums[label * m_NumberOfComponents + comp];
+          }
+        }
+      }
+
+    this->ContractGraph();
+
+    otbMsgDevMacro(<< "Small regions merging pass " << size << ": "
+                   << m_Neighbors.size() / 2 << " adjacent region pairs left");
+    }
+}
+
+template <class TLabel>
+void
+LabelImageSmallRegionMerger<TLabel>
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "MinSize: " << m_MinSize << std::endl;
+  os << indent << "Number of labels: " << m_Population.size() << std::endl;
+  os << indent << "Number of adjacent label pairs: " << m_Neighbors.size() / 2 << std::endl;
+}
+
+} // end namespace otb
+
+#endif
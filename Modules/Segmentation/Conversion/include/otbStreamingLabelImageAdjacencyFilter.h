@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingLabelImageAdjacencyFilter_h
+#define otbStreamingLabelImageAdjacencyFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** \class PersistentLabelImageAdjacencyFilter
+ * \brief Computes the population, the spectral sums and the adjacency of the
+ * regions of a 2D label image
+ *
+ * For each label, the number of pixels and the sum of the pixels of the
+ * spectral image (second input) are accumulated. Two labels are adjacent if
+ * they share an edge (4-connectivity). Adjacency is stored as a list of
+ * label pairs (smaller label first), sorted and without duplicates once
+ * Synthetize() has been called.
+ *
+ * Each thread accumulates in its own containers, which are merged after
+ * each streamed region. The label image is requested with one more column
+ * and one more line than the streamed region, so that adjacency across
+ * region borders is not lost.
+ *
+ * This filter persists its temporary data. It means that if you Update it n times on n different
+ * requested regions, the output statistics will be the statistics of the whole set of n regions.
+ *
+ * To reset the temporary data, one should call the Reset() function.
+ *
+ * \sa StreamingLabelImageAdjacencyFilter
+ * \sa LabelImageSmallRegionMerger
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBConversion
+ */
+template<class TLabelImage, class TSpectralImage>
+class ITK_EXPORT PersistentLabelImageAdjacencyFilter :
+  public PersistentImageFilter<TLabelImage, TLabelImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentLabelImageAdjacencyFilter             Self;
+  typedef PersistentImageFilter<TLabelImage, TLabelImage> Superclass;
+  typedef itk::SmartPointer<Self>                         Pointer;
+  typedef itk::SmartPointer<const Self>                   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentLabelImageAdjacencyFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TLabelImage                          LabelImageType;
+  typedef typename LabelImageType::PixelType   LabelType;
+  typedef typename LabelImageType::RegionType  RegionType;
+  typedef typename LabelImageType::IndexType   IndexType;
+  typedef TSpectralImage                       SpectralImageType;
+
+  itkStaticConstMacro(ImageDimension, unsigned int, TLabelImage::ImageDimension);
+
+  typedef itk::ImageBase<ImageDimension>       ImageBaseType;
+
+  /** Statistics typedefs */
+  typedef std::vector<unsigned long>           PopulationContainerType;
+  typedef std::vector<double>                  SumContainerType;
+  typedef std::pair<LabelType, LabelType>      EdgeType;
+  typedef std::vector<EdgeType>                EdgeContainerType;
+
+  /** Set the spectral image */
+  void SetInputSpectralImage(const SpectralImageType * image);
+
+  /** Get the spectral image */
+  const SpectralImageType * GetInputSpectralImage();
+
+  /** Number of pixels of each label, indexed by label */
+  const PopulationContainerType & GetLabelPopulation() const
+  {
+    return m_LabelPopulation;
+  }
+
+  /** Sum of the spectral pixels of each label: the components of label l
+   * are stored from index l * GetNumberOfComponents() */
+  const SumContainerType & GetLabelSums() const
+  {
+    return m_LabelSums;
+  }
+
+  /** Pairs of adjacent labels, smaller label first */
+  const EdgeContainerType & GetAdjacentLabels() const
+  {
+    return m_Edges;
+  }
+
+  /** Number of components of the spectral image */
+  unsigned int GetNumberOfComponents() const
+  {
+    return m_NumberOfComponents;
+  }
+
+  void AllocateOutputs() ITK_OVERRIDE;
+
+  void GenerateOutputInformation() ITK_OVERRIDE;
+
+  void GenerateInputRequestedRegion() ITK_OVERRIDE;
+
+  void Synthetize(void) ITK_OVERRIDE;
+
+  void Reset(void) ITK_OVERRIDE;
+
+protected:
+  PersistentLabelImageAdjacencyFilter();
+  ~PersistentLabelImageAdjacencyFilter() ITK_OVERRIDE {}
+  void PrintSelf(std::ostream& os, itk::Indent indent) const ITK_OVERRIDE;
+
+  void BeforeThreadedGenerateData() ITK_OVERRIDE;
+
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) ITK_OVERRIDE;
+
+  void AfterThreadedGenerateData() ITK_OVERRIDE;
+
+private:
+  PersistentLabelImageAdjacencyFilter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+
+  /** Sort the edges and remove duplicates */
+  static void SortUnique(EdgeContainerType & edges);
+
+  /** Statistics accumulated by one thread on the current region */
+  struct ThreadStatistics
+  {
+    std::map<LabelType, unsigned long> Slots;
+    std::vector<LabelType>             Labels;
+    PopulationContainerType            Population;
+    SumContainerType                   Sums;
+    EdgeContainerType                  Edges;
+  };
+
+  std::vector<ThreadStatistics> m_ThreadStatistics;
+
+  PopulationContainerType m_LabelPopulation;
+  SumContainerType        m_LabelSums;
+  EdgeContainerType       m_Edges;
+
+  /** Number of edges of m_Edges after the last duplicate removal */
+  typename EdgeContainerType::size_type m_NumberOfUniqueEdges;
+
+  unsigned int m_NumberOfComponents;
+}; // end of class PersistentLabelImageAdjacencyFilter
+
+
+/*===========================================================================*/
+
+/** \class StreamingLabelImageAdjacencyFilter
+ * \brief Computes the population, the spectral sums and the adjacency of the
+ * regions of a large label image
+ *
+ * This class streams the whole label image through the
+ * PersistentLabelImageAdjacencyFilter. It is typically used to build
+ * the region adjacency graph processed by LabelImageSmallRegionMerger:
+ *
+ * \code
+ * typedef otb::StreamingLabelImageAdjacencyFilter<LabelImageType, ImageType> AdjacencyFilterType;
+ * AdjacencyFilterType::Pointer adjacency = AdjacencyFilterType::New();
+ * adjacency->SetInput(labelImage);
+ * adjacency->SetInputSpectralImage(image);
+ * adjacency->Update();
+ * \endcode
+ *
+ * \sa PersistentLabelImageAdjacencyFilter
+ * \sa PersistentFilterStreamingDecorator
+ *
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBConversion
+ */
+template<class TLabelImage, class TSpectralImage>
+class ITK_EXPORT StreamingLabelImageAdjacencyFilter :
+  public PersistentFilterStreamingDecorator<PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage> >
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingLabelImageAdjacencyFilter Self;
+  typedef PersistentFilterStreamingDecorator
+  <PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage> > Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingLabelImageAdjacencyFilter, PersistentFilterStreamingDecorator);
+
+  typedef TLabelImage    LabelImageType;
+  typedef TSpectralImage SpectralImageType;
+
+  typedef typename Superclass::FilterType::PopulationContainerType PopulationContainerType;
+  typedef typename Superclass::FilterType::SumContainerType        SumContainerType;
+  typedef typename Superclass::FilterType::EdgeContainerType       EdgeContainerType;
+
+  /** Set the label image */
+  using Superclass::SetInput;
+  void SetInput(const LabelImageType * input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+
+  /** Get the label image */
+  const LabelImageType * GetInput()
+  {
+    return this->GetFilter()->GetInput();
+  }
+
+  /** Set the spectral image */
+  void SetInputSpectralImage(const SpectralImageType * input)
+  {
+    this->GetFilter()->SetInputSpectralImage(input);
+  }
+
+  /** Get the spectral image */
+  const SpectralImageType * GetInputSpectralImage()
+  {
+    return this->GetFilter()->GetInputSpectralImage();
+  }
+
+  /** Number of pixels of each label, indexed by label */
+  const PopulationContainerType & GetLabelPopulation() const
+  {
+    return this->GetFilter()->GetLabelPopulation();
+  }
+
+  /** Sum of the spectral pixels of each label */
+  const SumContainerType & GetLabelSums() const
+  {
+    return this->GetFilter()->GetLabelSums();
+  }
+
+  /** Pairs of adjacent labels, smaller label first */
+  const EdgeContainerType & GetAdjacentLabels() const
+  {
+    return this->GetFilter()->GetAdjacentLabels();
+  }
+
+  /** Number of components of the spectral image */
+  unsigned int GetNumberOfComponents() const
+  {
+    return this->GetFilter()->GetNumberOfComponents();
+  }
+
+protected:
+  /** Constructor */
+  StreamingLabelImageAdjacencyFilter() {}
+  /** Destructor */
+  ~StreamingLabelImageAdjacencyFilter() ITK_OVERRIDE {}
+
+private:
+  StreamingLabelImageAdjacencyFilter(const Self &); //purposely not implemented
+  void operator =(const Self&); //purposely not implemented
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingLabelImageAdjacencyFilter.txx"
+#endif
+
+#endif
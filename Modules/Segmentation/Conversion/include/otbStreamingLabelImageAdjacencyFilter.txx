@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingLabelImageAdjacencyFilter_txx
+#define otbStreamingLabelImageAdjacencyFilter_txx
+
+#include "otbStreamingLabelImageAdjacencyFilter.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkProgressReporter.h"
+#include <algorithm>
+
+namespace otb
+{
+
+template<class TLabelImage, class TSpectralImage>
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::PersistentLabelImageAdjacencyFilter()
+  : m_NumberOfUniqueEdges(0),
+    m_NumberOfComponents(0)
+{
+  this->SetNumberOfRequiredInputs(2);
+}
+
+template<class TLabelImage, class TSpectralImage>
+void
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::SetInputSpectralImage(const SpectralImageType * image)
+{
+  // Process object is not const-correct so the const_cast is required here
+  this->itk::ProcessObject::SetNthInput(1, const_cast<SpectralImageType *>(image));
+}
+
+template<class TLabelImage, class TSpectralImage>
+const typename PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>::SpectralImageType *
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::GetInputSpectralImage()
+{
+  return static_cast<const SpectralImageType *>(this->itk::ProcessObject::GetInput(1));
+}
+
+template<class TLabelImage, class TSpectralImage>
+void
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  if (this->GetInput())
+    {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+      {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+      }
+    }
+}
+
+template<class TLabelImage, class TSpectralImage>
+void
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::AllocateOutputs()
+{
+  // The output image of this filter is not intended to be used
+}
+
+template<class TLabelImage, class TSpectralImage>
+void
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::GenerateInputRequestedRegion()
+{
+  const RegionType & outputRegion = this->GetOutput()->GetRequestedRegion();
+
+  // The spectral image is only read on the processed region
+  SpectralImageType * spectralPtr = const_cast<SpectralImageType *>(this->GetInputSpectralImage());
+  if (spectralPtr)
+    {
+    RegionType spectralRegion;
+    this->CallCopyOutputRegionToInputRegion(spectralRegion, outputRegion);
+    spectralPtr->SetRequestedRegion(spectralRegion);
+    }
+
+  // The labels of the next column and of the next line are needed to find
+  // the neighbors of the pixels on the right and bottom borders
+  LabelImageType * labelPtr = const_cast<LabelImageType *>(this->GetInput());
+  if (labelPtr)
+    {
+    RegionType labelRegion = outputRegion;
+    typename RegionType::SizeType size = labelRegion.GetSize();
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+      size[dim] += 1;
+      }
+    labelRegion.SetSize(size);
+    labelRegion.Crop(labelPtr->GetLargestPossibleRegion());
+    labelPtr->SetRequestedRegion(labelRegion);
+    }
+}
+
+template<class TLabelImage, class TSpectralImage>
+void
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::Reset()
+{
+  m_LabelPopulation.clear();
+  m_LabelSums.clear();
+  m_Edges.clear();
+  m_NumberOfUniqueEdges = 0;
+  m_NumberOfComponents = 0;
+  m_ThreadStatistics.clear();
+}
+
+template<class TLabelImage, class TSpectralImage>
+void
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::Synthetize()
+{
+  SortUnique(m_Edges);
+  m_NumberOfUniqueEdges = m_Edges.size();
+  m_ThreadStatistics.clear();
+}
+
+template<class TLabelImage, class TSpectralImage>
+void
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::SortUnique(EdgeContainerType & edges)
+{
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+}
+
+template<class TLabelImage, class TSpectralImage>
+void
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::BeforeThreadedGenerateData()
+{
+  m_NumberOfComponents = this->GetInputSpectralImage()->GetNumberOfComponentsPerPixel();
+  m_ThreadStatistics.clear();
+  m_ThreadStatistics.resize(this->GetNumberOfThreads());
+}
+
+template<class TLabelImage, class TSpectralImage>
+void
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  const LabelImageType * labelPtr = this->GetInput();
+  const SpectralImageType * spectralPtr = this->GetInputSpectralImage();
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  ThreadStatistics & stats = m_ThreadStatistics[threadId];
+
+  const RegionType & bufferedRegion = labelPtr->GetBufferedRegion();
+  const long bufferEndX = bufferedRegion.GetIndex()[0] + static_cast<long>(bufferedRegion.GetSize()[0]);
+  const long bufferEndY = bufferedRegion.GetIndex()[1] + static_cast<long>(bufferedRegion.GetSize()[1]);
+  const long lineStride = bufferedRegion.GetSize()[0];
+
+  const long startX = outputRegionForThread.GetIndex()[0];
+  const long startY = outputRegionForThread.GetIndex()[1];
+  const long endX = startX + static_cast<long>(outputRegionForThread.GetSize()[0]);
+  const long endY = startY + static_cast<long>(outputRegionForThread.GetSize()[1]);
+
+  itk::ImageRegionConstIterator<SpectralImageType> spectralIt(spectralPtr, outputRegionForThread);
+  spectralIt.GoToBegin();
+
+  // Slot of the label of the previous pixel, labels come by runs
+  LabelType currentLabel = 0;
+  unsigned long currentSlot = 0;
+  bool hasCurrentLabel = false;
+
+  IndexType lineIndex;
+  lineIndex[0] = startX;
+
+  for (long y = startY; y < endY; ++y)
+    {
+    lineIndex[1] = y;
+    const LabelType * label = labelPtr->GetBufferPointer() + labelPtr->ComputeOffset(lineIndex);
+    const bool hasNextLine = (y + 1 < bufferEndY);
+
+    for (long x = startX; x < endX; ++x, ++label, ++spectralIt)
+      {
+      if (!hasCurrentLabel || *label != currentLabel)
+        {
+        currentLabel = *label;
+        hasCurrentLabel = true;
+        typename std::map<LabelType, unsigned long>::iterator slotIt = stats.Slots.find(currentLabel);
+        if (slotIt == stats.Slots.end())
+          {
+          currentSlot = stats.Labels.size();
+          stats.Slots.insert(slotIt, std::make_pair(currentLabel, currentSlot));
+          stats.Labels.push_back(currentLabel);
+          stats.Population.push_back(0);
+          stats.Sums.resize(stats.Sums.size() + m_NumberOfComponents, 0.);
+          }
+        else
+          {
+          currentSlot = slotIt->second;
+          }
+        }
+
+      stats.Population[currentSlot]++;
+      const typename SpectralImageType::PixelType & value = spectralIt.Get();
+      double * sums = &stats.Sums[currentSlot * m_NumberOfComponents];
+      for (unsigned int comp = 0; comp < m_NumberOfComponents; ++comp)
+        {
+        sums[comp] += value[comp];
+        }
+
+      // Edges with the right and bottom neighbors. Consecutive duplicates
+      // (long common borders) are skipped right away.
+      if (x + 1 < bufferEndX && label[1] != currentLabel)
+        {
+        const EdgeType edge(std::min(currentLabel, label[1]), std::max(currentLabel, label[1]));
+        if (stats.Edges.empty() || stats.Edges.back() != edge)
+          {
+          stats.Edges.push_back(edge);
+          }
+        }
+      if (hasNextLine && label[lineStride] != currentLabel)
+        {
+        const EdgeType edge(std::min(currentLabel, label[lineStride]), std::max(currentLabel, label[lineStride]));
+        if (stats.Edges.empty() || stats.Edges.back() != edge)
+          {
+          stats.Edges.push_back(edge);
+          }
+        }
+
+      progress.CompletedPixel();
+      }
+    }
+}
+
+template<class TLabelImage, class TSpectralImage>
+void
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::AfterThreadedGenerateData()
+{
+  for (typename std::vector<ThreadStatistics>::iterator statsIt = m_ThreadStatistics.begin();
+       statsIt != m_ThreadStatistics.end(); ++statsIt)
+    {
+    // Labels are sorted in the map, so the last one is the largest
+    if (!statsIt->Slots.empty())
+      {
+      const unsigned long maxLabel = static_cast<unsigned long>(statsIt->Slots.rbegin()->first);
+      if (maxLabel >= m_LabelPopulation.size())
+        {
+        m_LabelPopulation.resize(maxLabel + 1, 0);
+        m_LabelSums.resize((maxLabel + 1) * m_NumberOfComponents, 0.);
+        }
+      }
+
+    for (unsigned long slot = 0; slot < statsIt->Labels.size(); ++slot)
+      {
+      const unsigned long label = static_cast<unsigned long>(statsIt->Labels[slot]);
+      m_LabelPopulation[label] += statsIt->Population[slot];
+      for (unsigned int comp = 0; comp < m_NumberOfComponents; ++comp)
+        {
+        m_LabelSums[label * m_NumberOfComponents + comp] += statsIt->Sums[slot * m_NumberOfComponents + comp];
+        }
+      }
+
+    SortUnique(statsIt->Edges);
+    m_Edges.insert(m_Edges.end(), statsIt->Edges.begin(), statsIt->Edges.end());
+
+    // Free the thread containers before the next region
+    *statsIt = ThreadStatistics();
+    }
+
+  // Keep the memory used by duplicate edges bounded
+  if (m_Edges.size() > 2 * m_NumberOfUniqueEdges + 1024)
+    {
+    SortUnique(m_Edges);
+    m_NumberOfUniqueEdges = m_Edges.size();
+    }
+}
+
+template<class TLabelImage, class TSpectralImage>
+void
+PersistentLabelImageAdjacencyFilter<TLabelImage, TSpectralImage>
+::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of labels: " << m_LabelPopulation.size() << std::endl;
+  os << indent << "Number of adjacent label pairs: " << m_Edges.size() << std::endl;
+}
+
+} // end namespace otb
+#endif
@@ -37,6 +37,7 @@ void RegisterTests()
   REGISTER_TEST(otbVectorDataRasterizeFilter);
   REGISTER_TEST(otbLabelImageRegionPruningFilter);
   REGISTER_TEST(otbLabelImageRegionMergingFilter);
+  REGISTER_TEST(otbLabelImageSmallRegionMerger);
   REGISTER_TEST(otbLabelMapToVectorDataFilter);
   REGISTER_TEST(otbLabelMapToVectorDataFilterNew);
 }
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2005-2017 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbVectorImage.h"
+#include "otbStreamingLabelImageAdjacencyFilter.h"
+#include "otbLabelImageSmallRegionMerger.h"
+
+int otbLabelImageSmallRegionMerger(int itkNotUsed(argc), char * itkNotUsed(argv) [])
+{
+  typedef unsigned int                                  LabelType;
+  typedef otb::Image<LabelType, 2>                      LabelImageType;
+  typedef otb::VectorImage<float, 2>                    ImageType;
+  typedef otb::StreamingLabelImageAdjacencyFilter<LabelImageType, ImageType> AdjacencyFilterType;
+  typedef otb::LabelImageSmallRegionMerger<LabelType>  MergerType;
+
+  const unsigned int size = 6;
+  const LabelType labels[size][size] = {
+    {1, 1, 1, 2, 2, 2},
+    {1, 1, 1, 2, 2, 2},
+    {1, 1, 3, 2, 2, 2},
+    {4, 4, 4, 4, 5, 5},
+    {4, 4, 4, 4, 5, 5},
+    {4, 4, 4, 4, 4, 6}};
+  const float values[7] = {0, 10, 50, 45, 100, 90, 0};
+
+  LabelImageType::RegionType region;
+  region.SetSize(0, size);
+  region.SetSize(1, size);
+
+  LabelImageType::Pointer labelImage = LabelImageType::New();
+  labelImage->SetRegions(region);
+  labelImage->Allocate();
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(1);
+  image->Allocate();
+
+  LabelImageType::IndexType index;
+  ImageType::PixelType pixel(1);
+  for (index[1] = 0; index[1] < static_cast<long>(size); ++index[1])
+    {
+    for (index[0] = 0; index[0] < static_cast<long>(size); ++index[0])
+      {
+      const LabelType label = labels[index[1]][index[0]];
+      labelImage->SetPixel(index, label);
+      pixel[0] = values[label];
+      image->SetPixel(index, pixel);
+      }
+    }
+
+  // Stream by 2 lines, with 2 threads, so that adjacency crosses region borders
+  AdjacencyFilterType::Pointer adjacency = AdjacencyFilterType::New();
+  adjacency->SetInput(labelImage);
+  adjacency->SetInputSpectralImage(image);
+  adjacency->GetFilter()->SetNumberOfThreads(2);
+  adjacency->GetStreamer()->SetNumberOfLinesStrippedStreaming(2);
+  adjacency->Update();
+
+  const unsigned long expectedPopulation[7] = {0, 8, 9, 1, 13, 4, 1};
+  for (LabelType label = 0; label < 7; ++label)
+    {
+    if (adjacency->GetLabelPopulation()[label] != expectedPopulation[label])
+      {
+      std::cerr << "Wrong population for label " << label << ": " << adjacency->GetLabelPopulation()[label]
+                << " instead of " << expectedPopulation[label] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  if (adjacency->GetAdjacentLabels().size() != 10)
+    {
+    std::cerr << "Wrong number of adjacent labels: " << adjacency->GetAdjacentLabels().size()
+              << " instead of 10" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  MergerType::Pointer merger = MergerType::New();
+  merger->SetLabelStatistics(adjacency->GetLabelPopulation(),
+                             adjacency->GetLabelSums(),
+                             adjacency->GetNumberOfComponents());
+  merger->SetAdjacentLabels(adjacency->GetAdjacentLabels());
+
+  // Single pixel regions are merged with the closest neighbor: 3 with 2 and 6 with 5
+  merger->SetMinSize(5);
+  merger->Update();
+  const LabelType expectedLUT5[7] = {0, 1, 2, 2, 4, 5, 5};
+
+  for (LabelType label = 0; label < 7; ++label)
+    {
+    if (merger->GetLUT()[label] != expectedLUT5[label])
+      {
+      std::cerr << "MinSize 5: label " << label << " merged into " << merger->GetLUT()[label]
+                << " instead of " << expectedLUT5[label] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Then the 5 pixels region made of 5 and 6 is merged with 2
+  merger = MergerType::New();
+  merger->SetLabelStatistics(adjacency->GetLabelPopulation(),
+                             adjacency->GetLabelSums(),
+                             adjacency->GetNumberOfComponents());
+  merger->SetAdjacentLabels(adjacency->GetAdjacentLabels());
+  merger->SetMinSize(6);
+  merger->Update();
+  const LabelType expectedLUT6[7] = {0, 1, 2, 2, 4, 2, 2};
+
+  for (LabelType label = 0; label < 7; ++label)
+    {
+    if (merger->GetLUT()[label] != expectedLUT6[label])
+      {
+      std::cerr << "MinSize 6: label " << label << " merged into " << merger->GetLUT()[label]
+                << " instead of " << expectedLUT6[label] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -17,6 +17,7 @@
 
 #include <fcntl.h>
 #include <gdal_priv.h>
+#include <cpl_conv.h>
 #include <cpl_string.h>
 #include <ogr_api.h>
 #include <ogr_spatialref.h>
@@ -168,12 +169,292 @@ int write_int64(PTIFF *tiff_file,
   return 0;
 }
 
+/*
+ * Export an unsigned integer on size bytes, returns false if it does not fit
+ */
+bool export_uint(int64_t num, int size, uint8_t *buffer, bool big_endian) {
+  if (num < 0 || (size < 8 && (num >> (8 * size)) != 0)) {
+    return false;
+  }
+  for (int i = 0; i < size; ++i) {
+    const uint8_t byte = static_cast<uint8_t>(num >> (8 * i));
+    if (big_endian) {
+      buffer[size - 1 - i] = byte;
+    } else {
+      buffer[i] = byte;
+    }
+  }
+  return true;
+}
+
+/*
+ * Write a large buffer, MPI counts being limited to int
+ */
+SPTW_ERROR write_bytes(PTIFF *tiff_file,
+                       int64_t offset,
+                       const unsigned char *buffer,
+                       int64_t size) {
+  const int64_t max_chunk = 1 << 30;
+  while (size > 0) {
+    const int count = static_cast<int>(std::min(size, max_chunk));
+    int rc = MPI_File_write_at(tiff_file->fh,
+                               offset,
+                               const_cast<unsigned char*>(buffer),
+                               count,
+                               MPI_BYTE,
+                               MPI_STATUS_IGNORE);
+    if (rc != MPI_SUCCESS) {
+      return SP_WriteError;
+    }
+    offset += count;
+    buffer += count;
+    size -= count;
+  }
+  return SP_None;
+}
+
+/*
+ * TIFF LZW encoder (MSB first bit order, codes from 9 to 12 bits), following
+ * the conventions of the libtiff encoder
+ */
+class LZWEncoder {
+ public:
+  explicit LZWEncoder(std::vector<unsigned char> *output)
+      : output_(output), bit_buffer_(0), bit_count_(0) {
+    reset();
+  }
+
+  void encode(const unsigned char *data, size_t size) {
+    put_code(kClear);
+    if (size == 0) {
+      put_code(kEOI);
+      flush();
+      return;
+    }
+    int prefix = data[0];
+    for (size_t i = 1; i < size; ++i) {
+      const unsigned char c = data[i];
+      const int child = find_child(prefix, c);
+      if (child >= 0) {
+        prefix = child;
+        continue;
+      }
+      put_code(prefix);
+      add_entry(prefix, c);
+      prefix = c;
+    }
+    put_code(prefix);
+    next_free_++;
+    if (next_free_ > max_code_ && nbits_ < kMaxBits) {
+      nbits_++;
+      max_code_ = (1 << nbits_) - 1;
+    }
+    put_code(kEOI);
+    flush();
+  }
+
+ private:
+  static const int kClear = 256;
+  static const int kEOI = 257;
+  static const int kFirst = 258;
+  static const int kMinBits = 9;
+  static const int kMaxBits = 12;
+  static const int kTableSize = 1 << kMaxBits;
+
+  void reset() {
+    nbits_ = kMinBits;
+    max_code_ = (1 << kMinBits) - 1;
+    next_free_ = kFirst;
+    for (int i = 0; i < kTableSize; ++i) {
+      first_child_[i] = -1;
+    }
+  }
+
+  int find_child(int prefix, unsigned char c) const {
+    for (int code = first_child_[prefix]; code >= 0; code = next_sibling_[code]) {
+      if (suffix_[code] == c) {
+        return code;
+      }
+    }
+    return -1;
+  }
+
+  void add_entry(int prefix, unsigned char c) {
+    const int code = next_free_++;
+    suffix_[code] = c;
+    first_child_[code] = -1;
+    next_sibling_[code] = first_child_[prefix];
+    first_child_[prefix] = code;
+    if (next_free_ == kTableSize - 2) {
+      // Table is full, emit a clear code and start again
+      put_code(kClear);
+      reset();
+    } else if (next_free_ > max_code_) {
+      nbits_++;
+      max_code_ = (1 << nbits_) - 1;
+    }
+  }
+
+  void put_code(int code) {
+    bit_buffer_ = (bit_buffer_ << nbits_) | static_cast<uint32_t>(code);
+    bit_count_ += nbits_;
+    while (bit_count_ >= 8) {
+      bit_count_ -= 8;
+      output_->push_back(static_cast<unsigned char>(bit_buffer_ >> bit_count_));
+    }
+  }
+
+  void flush() {
+    if (bit_count_ > 0) {
+      output_->push_back(static_cast<unsigned char>(bit_buffer_ << (8 - bit_count_)));
+      bit_count_ = 0;
+    }
+  }
+
+  std::vector<unsigned char> *output_;
+  uint32_t bit_buffer_;
+  int bit_count_;
+  int nbits_;
+  int max_code_;
+  int next_free_;
+  int first_child_[kTableSize];
+  int next_sibling_[kTableSize];
+  unsigned char suffix_[kTableSize];
+};
+
+/*
+ * Compress a tile and append it to output, returns the compressed size or
+ * -1 on error
+ */
+int64_t compress_tile(int compression,
+                      const unsigned char *tile,
+                      size_t size,
+                      std::vector<unsigned char> *output) {
+  const size_t start = output->size();
+  if (compression == COMPRESSION_LZW) {
+    LZWEncoder encoder(output);
+    encoder.encode(tile, size);
+  } else if (compression == COMPRESSION_ADOBE_DEFLATE
+             || compression == COMPRESSION_DEFLATE) {
+    size_t compressed_size = 0;
+    void *compressed = CPLZLibDeflate(tile, size, -1, NULL, 0, &compressed_size);
+    if (compressed == NULL) {
+      return -1;
+    }
+    const unsigned char *bytes = static_cast<const unsigned char*>(compressed);
+    output->insert(output->end(), bytes, bytes + compressed_size);
+    VSIFree(compressed);
+  } else {
+    return -1;
+  }
+  return static_cast<int64_t>(output->size() - start);
+}
+
+/*
+ * Write the values of a TileOffsets or TileByteCounts directory entry
+ */
+SPTW_ERROR write_entry_values(PTIFF *tiff_file,
+                              int64_t entry_offset,
+                              const int64_t *values,
+                              int64_t value_count) {
+  uint8_t type_buffer[2];
+  MPI_File_read_at(tiff_file->fh,
+                   entry_offset + 2,
+                   type_buffer,
+                   2,
+                   MPI_BYTE,
+                   MPI_STATUS_IGNORE);
+  const int type_size = get_type_size(static_cast<TIFFDataType>(
+      parse_int16(type_buffer, tiff_file->big_endian)));
+  const int64_t element_count = read_int64(tiff_file,
+                                           entry_offset + 4,
+                                           tiff_file->big_endian);
+  if (type_size == 0 || element_count != value_count) {
+    return SP_BadArg;
+  }
+
+  // Values are stored in the entry itself when they fit in 8 bytes
+  const int64_t values_offset = (element_count * type_size <= 8)
+      ? entry_offset + 12
+      : read_int64(tiff_file, entry_offset + 12, tiff_file->big_endian);
+
+  std::vector<unsigned char> buffer(element_count * type_size);
+  for (int64_t i = 0; i < element_count; ++i) {
+    if (!export_uint(values[i], type_size, &buffer[i * type_size],
+                     tiff_file->big_endian)) {
+      fprintf(stderr, "SPTW: tile offset or size does not fit in the tiff directory\n");
+      return SP_WriteError;
+    }
+  }
+  return write_bytes(tiff_file, values_offset, &buffer[0], buffer.size());
+}
+
+/*
+ * Gather the offsets and byte counts of the compressed tiles written by all
+ * processes and write them in the tiff directory (collective)
+ */
+SPTW_ERROR write_compressed_tile_offsets(PTIFF *tiff_file) {
+  const int64_t tile_count = tiff_file->tiles_across * tiff_file->tiles_down;
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // Each tile is written by a single process, others keep 0
+  if (rank == 0) {
+    MPI_Reduce(MPI_IN_PLACE, tiff_file->tile_offsets, tile_count,
+               MPI_INT64_T, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(MPI_IN_PLACE, tiff_file->tile_byte_counts, tile_count,
+               MPI_INT64_T, MPI_MAX, 0, MPI_COMM_WORLD);
+  } else {
+    MPI_Reduce(tiff_file->tile_offsets, NULL, tile_count,
+               MPI_INT64_T, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(tiff_file->tile_byte_counts, NULL, tile_count,
+               MPI_INT64_T, MPI_MAX, 0, MPI_COMM_WORLD);
+  }
+
+  SPTW_ERROR err = SP_None;
+  if (rank == 0) {
+    // Check tiff version, should be 0x002b for BigTiff
+    uint8_t version_data[2];
+    MPI_File_read_at(tiff_file->fh, 2, version_data, 2, MPI_BYTE,
+                     MPI_STATUS_IGNORE);
+    if (parse_int16(version_data, tiff_file->big_endian) != 0x002b) {
+      err = SP_BadArg;
+    } else {
+      const int64_t doffset = read_int64(tiff_file, 8, tiff_file->big_endian);
+      const int64_t entry_count = read_int64(tiff_file, doffset,
+                                             tiff_file->big_endian);
+      int64_t entry_offset = doffset + sizeof(int64_t);
+      for (int64_t i = 0; i < entry_count && err == SP_None; ++i) {
+        uint8_t tag_buffer[2];
+        MPI_File_read_at(tiff_file->fh, entry_offset, tag_buffer, 2,
+                         MPI_BYTE, MPI_STATUS_IGNORE);
+        const int16_t entry_tag = parse_int16(tag_buffer,
+                                              tiff_file->big_endian);
+        if (entry_tag == TIFFTAG_TILEOFFSETS) {
+          err = write_entry_values(tiff_file, entry_offset,
+                                   tiff_file->tile_offsets, tile_count);
+        } else if (entry_tag == TIFFTAG_TILEBYTECOUNTS) {
+          err = write_entry_values(tiff_file, entry_offset,
+                                   tiff_file->tile_byte_counts, tile_count);
+        }
+        entry_offset += 20;
+      }
+    }
+  }
+  return err;
+}
+
 SPTW_ERROR populate_tile_offsets(PTIFF *tiff_file,
                                  int64_t tile_size,
                                  bool tiled = true) {
   MPI_Status status;
   bool big_endian = false;   // Is tiff file big endian?
 
+  // Compressed tiles are placed as they are written
+  if (tiff_file->compression != COMPRESSION_NONE) {
+    return SP_None;
+  }
+
   // Read endianess of file
   uint8_t endian_flag[2] = { 0x49, 0x49 };
   MPI_File_read_at(tiff_file->fh, 0, endian_flag, 2, MPI_BYTE, &status);
@@ -270,7 +551,8 @@ SPTW_ERROR create_generic_raster(string filename,
 		double *geotransform,
 		string projection_srs,
 		int block_size_x,
-		bool tiled_mode) {
+		bool tiled_mode,
+		string compression) {
 
 	GDALAllRegister();
 
@@ -285,7 +567,7 @@ SPTW_ERROR create_generic_raster(string filename,
 	char **options = NULL;
 	options = CSLSetNameValue(options, "INTERLEAVE", "PIXEL");
 	options = CSLSetNameValue(options, "BIGTIFF", "YES");
-	options = CSLSetNameValue(options, "COMPRESS", "NONE");
+	options = CSLSetNameValue(options, "COMPRESS", compression.c_str());
 	options = CSLSetNameValue(options, "SPARSE_OK", "YES");
 	if (tiled_mode)
 	{
@@ -319,6 +601,14 @@ SPTW_ERROR create_generic_raster(string filename,
 	out_sr.exportToWkt(&wkt);
 	output->SetProjection(wkt);
 
+	// Compressed tiles are all written later by the processes
+	if (compression != "NONE") {
+		OGRFree(wkt);
+		CSLDestroy(options);
+		GDALClose(output);
+		return SP_None;
+	}
+
 	// Write first and last pixel in the raster
 	double *data = new double(sizeof(*data) * 4 * output->GetRasterCount());
 	CPLErr rcode = output->RasterIO(GF_Write,
@@ -512,6 +802,10 @@ PTIFF* open_raster(string filename) {
   ptiff->first_strip_offset = -1;
   ptiff->block_x_size = ptiff->x_size;
   ptiff->block_y_size = ptiff->y_size;
+  ptiff->compression = COMPRESSION_NONE;
+  ptiff->tile_byte_counts = NULL;
+  ptiff->big_endian = false;
+  ptiff->data_offset = 0;
 
   GDALClose(ds);
 
@@ -529,6 +823,10 @@ PTIFF* open_raster(string filename) {
   int64_t tiles_per_image = -1;
   int64_t *tiff_offsets = NULL;
 
+  uint16 compression = COMPRESSION_NONE;
+  TIFFGetFieldDefaulted(tiffds, TIFFTAG_COMPRESSION, &compression);
+  ptiff->compression = compression;
+
   int ret = 1;
   ret &= TIFFGetField(tiffds, TIFFTAG_TILEWIDTH, &(ptiff->block_x_size));
   ret &= TIFFGetField(tiffds, TIFFTAG_TILELENGTH, &(ptiff->block_y_size));
@@ -549,6 +847,24 @@ PTIFF* open_raster(string filename) {
     memcpy(ptiff->tile_offsets,
            tiff_offsets,
            sizeof(int64_t) * tiles_per_image);
+
+    if (ptiff->compression != COMPRESSION_NONE) {
+      uint64 *tiff_byte_counts = NULL;
+      ptiff->tile_byte_counts = new int64_t[tiles_per_image];
+      if (TIFFGetField(tiffds, TIFFTAG_TILEBYTECOUNTS, &tiff_byte_counts) == 1) {
+        memcpy(ptiff->tile_byte_counts,
+               tiff_byte_counts,
+               sizeof(int64_t) * tiles_per_image);
+      } else {
+        std::fill(ptiff->tile_byte_counts,
+                  ptiff->tile_byte_counts + tiles_per_image,
+                  0);
+      }
+    }
+  } else if (ptiff->compression != COMPRESSION_NONE) {
+    fprintf(stderr, "Compressed rasters must be tiled\n");
+    TIFFClose(tiffds);
+    return NULL;
   } else if (ret != 1) {  /* for striped tiff */
     ret = TIFFGetField(tiffds, TIFFTAG_STRIPOFFSETS, &offset);
     if (ret != 1) {
@@ -597,6 +913,16 @@ PTIFF* open_raster(string filename) {
 
   MPI_File_set_atomicity(ptiff->fh, 0);
 
+  // Read endianess of file
+  uint8_t endian_flag[2] = { 0x49, 0x49 };
+  MPI_File_read_at(ptiff->fh, 0, endian_flag, 2, MPI_BYTE, MPI_STATUS_IGNORE);
+  ptiff->big_endian = (endian_flag[0] == 0x4d);
+
+  // Compressed tiles are appended to the file
+  MPI_Offset file_size = 0;
+  MPI_File_get_size(ptiff->fh, &file_size);
+  ptiff->data_offset = file_size;
+
   if (c_filename != NULL) {
     free(c_filename);
   }
@@ -605,9 +931,15 @@ PTIFF* open_raster(string filename) {
 }
 
 SPTW_ERROR close_raster(PTIFF *ptiff) {
+  SPTW_ERROR err = SP_None;
+  if (ptiff->compression != COMPRESSION_NONE) {
+    err = write_compressed_tile_offsets(ptiff);
+  }
   MPI_File_close(&(ptiff->fh));
+  delete[] ptiff->tile_offsets;
+  delete[] ptiff->tile_byte_counts;
   delete ptiff;
-  return SP_None;
+  return err;
 }
 
 SPTW_ERROR fill_stack(std::vector<Area> *write_stack,
@@ -773,4 +1105,83 @@ SPTW_ERROR write_area(PTIFF *ptiff,
   }
   return SP_None;
 }
+
+SPTW_ERROR compress_area(PTIFF *ptiff,
+                         void *data,
+                         int64_t ul_x,
+                         int64_t ul_y,
+                         int64_t lr_x,
+                         int64_t lr_y,
+                         CompressedArea *area) {
+  const int64_t bx = ptiff->block_x_size;
+  const int64_t by = ptiff->block_y_size;
+
+  // Only whole tiles can be compressed
+  if (ptiff->compression == COMPRESSION_NONE
+      || ul_x % bx != 0 || ul_y % by != 0
+      || ((lr_x + 1) % bx != 0 && lr_x != ptiff->x_size - 1)
+      || ((lr_y + 1) % by != 0 && lr_y != ptiff->y_size - 1)) {
+    return SP_BadArg;
+  }
+
+  const int64_t pixel_size = ptiff->band_type_size * ptiff->band_count;
+  const int64_t area_row_size = (lr_x - ul_x + 1) * pixel_size;
+  std::vector<unsigned char> tile(bx * by * pixel_size);
+
+  area->data.clear();
+  area->tile_indices.clear();
+  area->tile_sizes.clear();
+
+  for (int64_t tile_y = ul_y; tile_y <= lr_y; tile_y += by) {
+    for (int64_t tile_x = ul_x; tile_x <= lr_x; tile_x += bx) {
+      // Edge tiles are padded with zeros
+      const int64_t width = std::min(bx, lr_x - tile_x + 1);
+      const int64_t height = std::min(by, lr_y - tile_y + 1);
+      if (width < bx || height < by) {
+        std::fill(tile.begin(), tile.end(), 0);
+      }
+      for (int64_t y = 0; y < height; ++y) {
+        memcpy(&tile[y * bx * pixel_size],
+               static_cast<char*>(data) + (tile_y - ul_y + y) * area_row_size
+               + (tile_x - ul_x) * pixel_size,
+               width * pixel_size);
+      }
+
+      const int64_t size = compress_tile(ptiff->compression,
+                                         &tile[0],
+                                         tile.size(),
+                                         &(area->data));
+      if (size < 0) {
+        return SP_WriteError;
+      }
+      area->tile_indices.push_back(tile_x / bx + (tile_y / by) * ptiff->tiles_across);
+      area->tile_sizes.push_back(size);
+    }
+  }
+  return SP_None;
+}
+
+SPTW_ERROR write_compressed_area(PTIFF *ptiff,
+                                 const CompressedArea &area,
+                                 int64_t offset) {
+  if (ptiff->compression == COMPRESSION_NONE || offset < ptiff->data_offset) {
+    return SP_BadArg;
+  }
+  if (area.data.empty()) {
+    return SP_None;
+  }
+
+  SPTW_ERROR err = write_bytes(ptiff, offset, &(area.data[0]), area.data.size());
+  if (err != SP_None) {
+    return err;
+  }
+
+  // Offsets are written in the tiff directory when closing the raster
+  for (size_t i = 0; i < area.tile_indices.size(); ++i) {
+    ptiff->tile_offsets[area.tile_indices[i]] = offset;
+    ptiff->tile_byte_counts[area.tile_indices[i]] = area.tile_sizes[i];
+    offset += area.tile_sizes[i];
+  }
+  return SP_None;
+}
 }
@@ -23,6 +23,7 @@
 #include <mpi.h>
 
 #include <string>
+#include <vector>
 #if HAVE_STDINT_H == 0
 #include <cstdint>
 #else
@@ -91,6 +92,28 @@ namespace sptw {
         int64_t tiles_across;
         /* Number of tiles down raster */
         int64_t tiles_down;
+        /*! TIFF compression of the tiles (COMPRESSION_NONE,
+         *  COMPRESSION_LZW or COMPRESSION_ADOBE_DEFLATE) */
+        int compression;
+        /*! Byte counts of the compressed tiles written by this process */
+        int64_t *tile_byte_counts;
+        /*! Is the tiff file big endian? */
+        bool big_endian;
+        /*! End of the file when opened, compressed tiles are written after */
+        int64_t data_offset;
+    };
+
+    /**
+     * @struct CompressedArea sptw.h
+     * @brief Compressed tiles of an area, stored contiguously in data
+     */
+    struct CompressedArea {
+        /*! Compressed tiles, one after the other */
+        std::vector<unsigned char> data;
+        /*! Index of each tile in the raster */
+        std::vector<int64_t> tile_indices;
+        /*! Compressed size in bytes of each tile */
+        std::vector<int64_t> tile_sizes;
     };
 
     SPTW_ERROR populate_tile_offsets(PTIFF *tiff_file,
@@ -105,7 +128,8 @@ namespace sptw {
     		double *geotransform,
     		string projection_srs,
 			int block_size_x,
-    		bool tiled_mode);
+    		bool tiled_mode,
+    		string compression = "NONE");
 
     SPTW_ERROR create_raster(string filename,
             int64_t x_size,
@@ -124,6 +148,13 @@ namespace sptw {
             string projection_srs,
             int64_t tile_size);
     PTIFF* open_raster(string filename);
+
+    /**
+     * @brief
+     * Closes the PTIFF. This is a collective operation. For compressed
+     * rasters, the offsets and byte counts of the tiles written by all the
+     * processes are gathered and written in the tiff directory.
+     */
     SPTW_ERROR close_raster(PTIFF *ptiff);
 
     /**
@@ -152,6 +183,37 @@ namespace sptw {
             int64_t ul_y,
             int64_t lr_x,
             int64_t lr_y);
+
+    /**
+     * @brief
+     * This function compresses the tiles of an area of a compressed PTIFF.
+     * The area must be aligned on the tiles of the raster: it starts at the
+     * upper-left corner of a tile and ends at the lower-right corner of a
+     * tile or at the raster edge. The bounding box coordinates are inclusive.
+     *
+     * @param ptiff The open compressed PTIFF
+     * @param data buffer containing, row-wise, pixel interleaved data of the
+     *        area
+     * @param area Output compressed tiles of the area
+     */
+    SPTW_ERROR compress_area(PTIFF *ptiff,
+            void *data,
+            int64_t ul_x,
+            int64_t ul_y,
+            int64_t lr_x,
+            int64_t lr_y,
+            CompressedArea *area);
+
+    /**
+     * @brief
+     * This function writes compressed tiles to the open PTIFF, starting at
+     * the given file offset. The caller is responsible for allocating
+     * non-overlapping ranges of the file, after ptiff->data_offset, among
+     * the processes.
+     */
+    SPTW_ERROR write_compressed_area(PTIFF *ptiff,
+            const CompressedArea &area,
+            int64_t offset);
 }
 
 #endif  // SRC_DEMOS_SPTW_H_
@@ -24,9 +24,18 @@
 
 #include <vcl_algorithm.h>
 
+#include <deque>
+#include <list>
+#include <map>
+#include <set>
+
 #include "itkCenteredRigid2DTransform.h"
+#include "itkConditionVariable.h"
+#include "itkMultiThreader.h"
+#include "itkMutexLock.h"
 
 #include "otbFragmentShader.h"
+#include "otbGDALOverviewsBuilder.h"
 #include "otbGenericRSTransform.h"
 #include "otbGeoInterface.h"
 #include "otbGlActor.h"
@@ -128,6 +137,37 @@ public:
   itkSetMacro(SoftwareRendering, bool );
   itkGetMacro(SoftwareRendering, bool );
 
+  // Size of the tile cache set by SetNumberOfLoadingThreads()
+  static const unsigned int DefaultLoadingTileCacheSize = 128;
+
+  // Number of background threads reading tiles. If 0 (default),
+  // tiles are read synchronously in UpdateData(). Otherwise, tiles
+  // are read in the background (visible tiles first, then the tiles
+  // around the viewport and at the next zoom levels), and uploaded
+  // to the GPU by Render() when ready.
+  void SetNumberOfLoadingThreads(unsigned int nbThreads);
+  itkGetMacro(NumberOfLoadingThreads, unsigned int);
+
+  // If true, Initialize() starts building overviews in the background
+  // (in a .ovr file next to the image) when the image has none. They
+  // are used by UpdateData() once ready.
+  itkBooleanMacro(OverviewsGeneration);
+  itkSetMacro(OverviewsGeneration, bool);
+  itkGetMacro(OverviewsGeneration, bool);
+
+  // True while overviews are being built in the background
+  itkGetMacro(OverviewsBuilding, bool);
+
+  // Maximum number of decoded tiles kept in CPU memory. 0 (default)
+  // disables the cache; enabling background loading sets it to
+  // DefaultLoadingTileCacheSize if it is 0.
+  void SetTileCacheSize(unsigned int size);
+  itkGetMacro(TileCacheSize, unsigned int);
+
+  // True if some visible tiles are still being read in the
+  // background: Render() should be called again later to display them
+  bool HasPendingTiles() const;
+
   void CreateShader();
 
   void SetResolutionAlgorithm(ResolutionAlgorithm::type alg)
@@ -254,6 +294,32 @@ protected:
   };
 
   typedef std::vector<Tile>                                                       TileVectorType;    
+
+  // Identify a decoded tile in the CPU cache
+  struct TileKey
+  {
+    unsigned int m_Resolution;
+    IndexType m_Index;
+    SizeType m_Size;
+    unsigned int m_RedIdx;
+    unsigned int m_GreenIdx;
+    unsigned int m_BlueIdx;
+
+    bool operator<(const TileKey & other) const;
+  };
+
+  // Tile read request for the loading threads
+  struct TileRequest
+  {
+    TileKey m_Key;
+    std::string m_FileName;
+    unsigned long m_Generation;
+  };
+
+  typedef std::list<TileKey>                                                      TileKeyListType;
+  typedef std::pair<VectorImageType::Pointer, TileKeyListType::iterator>          CachedTileType;
+  typedef std::map<TileKey, CachedTileType>                                       TileCacheType;
+  typedef std::deque<TileRequest>                                                 TileRequestQueueType;
   
 private:
   // prevent implementation
@@ -262,6 +328,49 @@ private:
 
   // Load tile to GPU
   void LoadTile(Tile& tile);
+
+  // Read tile data from the file (synchronously)
+  void ReadTile(Tile& tile);
+
+  TileKey GetTileKey(const Tile& tile) const;
+
+  // Retrieve tile data from the CPU cache (caller holds m_LoadingLock)
+  VectorImageType::Pointer GetCachedTile(const TileKey & key);
+
+  // Insert tile data in the CPU cache (caller holds m_LoadingLock)
+  void AddCachedTile(const TileKey & key, VectorImageType * image);
+
+  // Compute the tiles of region at given resolution
+  void ComputeTileRegions(const RegionType & region, const RegionType & largest, std::vector<RegionType> & tiles) const;
+
+  // Queue background reads for tiles not already available
+  void RequestTiles(const std::vector<RegionType> & tiles, unsigned int resolution, TileRequestQueueType & queue);
+
+  // Upload pending tiles which have been read in the background
+  void UploadReadyTiles();
+
+  void StartLoadingThreads();
+
+  void StopLoadingThreads();
+
+  // Loop of the background loading threads
+  void LoadingLoop();
+
+  void StartOverviewsGeneration();
+
+  // Wait for the overviews thread. If abort is true, generation is
+  // cancelled and the partial overviews file is removed.
+  void StopOverviewsGeneration(bool abort);
+
+  // Switch to the overviews built in the background, if ready
+  void UpdateOverviews();
+
+  // Read the list of resolutions available in file
+  void ReadAvailableResolutions();
+
+  static ITK_THREAD_RETURN_TYPE OverviewsThreadCallback(void * arg);
+
+  static ITK_THREAD_RETURN_TYPE LoadingThreadCallback(void * arg);
   
   // Unload tile from GPU
   void UnloadTile(Tile& tile);
@@ -319,6 +428,43 @@ private:
 
   bool m_SoftwareRendering;
 
+  unsigned int m_NumberOfLoadingThreads;
+
+  unsigned int m_TileCacheSize;
+
+  // Visible tiles waiting for the background threads
+  TileVectorType m_PendingTiles;
+
+  // Decoded tiles in CPU memory, with LRU order (most recent first)
+  TileCacheType m_TileCache;
+  TileKeyListType m_TileCacheLRU;
+
+  // Background reads, highest priority first
+  TileRequestQueueType m_RequestQueue;
+  std::set<TileKey> m_InFlightTiles;
+
+  // Incremented each time the image changes, to discard outdated reads
+  unsigned long m_Generation;
+
+  bool m_StopLoading;
+
+  itk::SimpleMutexLock m_LoadingLock;
+  itk::ConditionVariable::Pointer m_RequestCondition;
+  itk::MultiThreader::Pointer m_LoadingThreader;
+  std::vector<itk::ThreadIdType> m_LoadingThreadIds;
+
+  bool m_OverviewsGeneration;
+
+  bool m_OverviewsBuilding;
+
+  // Set by the overviews thread when done (guarded by m_LoadingLock)
+  bool m_OverviewsDone;
+
+  bool m_OverviewsSucceeded;
+
+  GDALOverviewsBuilder::Pointer m_OverviewsBuilder;
+  itk::ThreadIdType m_OverviewsThreadId;
+
 }; // End class GlImageActor
 
 } // End namespace otb
@@ -26,6 +26,7 @@ ENABLE_SHARED
     OTBCommon
     OTBStatistics
     OTBGdalAdapters
+    OTBIOGDAL
     OTBImageIO
     OTBTransform
     OTBImageManipulation
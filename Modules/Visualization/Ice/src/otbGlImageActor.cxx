@@ -21,11 +21,14 @@
 #include "otbGlImageActor.h"
 #include "otbViewSettings.h"
 #include "otbMath.h"
+#include "otbMacro.h"
 #ifdef _WIN32
 #include <windows.h>
 #endif
 #include <GL/glew.h>
 
+#include <cstdio>
+
 #include "otbStandardShader.h"
 
 #include "itkListSample.h"
@@ -34,6 +37,41 @@
 namespace otb
 {
 
+namespace
+{
+// Extended filename to read the given overview level of filename
+std::string GetResolutionFileName(const std::string & filename, unsigned int resolution)
+{
+  std::ostringstream extFilename;
+  extFilename<<filename;
+  if ( filename.find('?') == std::string::npos )
+    {
+    extFilename << '?';
+    }
+  extFilename<<"&resol="<<resolution;
+
+  return extFilename.str();
+}
+}
+
+bool GlImageActor::TileKey::operator<(const TileKey & other) const
+{
+  if(m_Resolution != other.m_Resolution)
+    return m_Resolution < other.m_Resolution;
+  for(unsigned int dim = 0; dim < 2; ++dim)
+    {
+    if(m_Index[dim] != other.m_Index[dim])
+      return m_Index[dim] < other.m_Index[dim];
+    if(m_Size[dim] != other.m_Size[dim])
+      return m_Size[dim] < other.m_Size[dim];
+    }
+  if(m_RedIdx != other.m_RedIdx)
+    return m_RedIdx < other.m_RedIdx;
+  if(m_GreenIdx != other.m_GreenIdx)
+    return m_GreenIdx < other.m_GreenIdx;
+  return m_BlueIdx < other.m_BlueIdx;
+}
+
 GlImageActor::GlImageActor()
   : m_TileSize(256),
     m_FileName(),
@@ -54,12 +92,35 @@ GlImageActor::GlImageActor()
     m_ViewportForwardRotationTransform(RigidTransformType::New()),
     m_ViewportBackwardRotationTransform(RigidTransformType::New()),
     m_ResolutionAlgorithm(ResolutionAlgorithm::Nearest),
-    m_SoftwareRendering(false)
+    m_SoftwareRendering(false),
+    m_NumberOfLoadingThreads(0),
+    m_TileCacheSize(0),
+    m_PendingTiles(),
+    m_TileCache(),
+    m_TileCacheLRU(),
+    m_RequestQueue(),
+    m_InFlightTiles(),
+    m_Generation(0),
+    m_StopLoading(false),
+    m_LoadingLock(),
+    m_RequestCondition(itk::ConditionVariable::New()),
+    m_LoadingThreader(itk::MultiThreader::New()),
+    m_LoadingThreadIds(),
+    m_OverviewsGeneration(false),
+    m_OverviewsBuilding(false),
+    m_OverviewsDone(false),
+    m_OverviewsSucceeded(false),
+    m_OverviewsBuilder(),
+    m_OverviewsThreadId(0)
 {}
 
 GlImageActor
 ::~GlImageActor()
 {
+  // Loading threads must not outlive the actor
+  StopLoadingThreads();
+  StopOverviewsGeneration(true);
+
   // Release OpenGL texture names.
   for( TileVectorType::iterator it( m_LoadedTiles.begin() );
        it!=m_LoadedTiles.end();
@@ -136,6 +197,8 @@ void GlImageActor::Initialize(const std::string & filename)
   //   << std::hex << this << "::Initialize( '" << filename << "' )" << std::endl;
 
   // First, clean up any previous data
+  StopOverviewsGeneration(true);
+
   this->ClearLoadedTiles();
 
   m_FileName = filename;
@@ -157,6 +220,22 @@ void GlImageActor::Initialize(const std::string & filename)
   m_Spacing = m_FileReader->GetOutput()->GetSpacing();
   m_NumberOfComponents = m_FileReader->GetOutput()->GetNumberOfComponentsPerPixel();
 
+  ReadAvailableResolutions();
+
+  m_CurrentResolution = m_AvailableResolutions.front();
+
+  // Update transforms once data is read
+  UpdateTransforms();
+
+  if( m_OverviewsGeneration )
+    StartOverviewsGeneration();
+
+  // std::cout<<"Number of resolutions in file: "<<m_AvailableResolutions.size()<<std::endl;
+}
+
+
+void GlImageActor::ReadAvailableResolutions()
+{
   unsigned int ovrCount = m_FileReader->GetOverviewsCount();
 
   // std::cout << "overview-count: " << ovrCount << std::endl;
@@ -180,15 +259,146 @@ void GlImageActor::Initialize(const std::string & filename)
 
   for( unsigned int i=0; i<ovrCount; ++i )
     m_AvailableResolutions.push_back( i );
+}
 
-  m_CurrentResolution = m_AvailableResolutions.front();
+void GlImageActor::StartOverviewsGeneration()
+{
+  if( !GDALOverviewsBuilder::CanGenerateOverviews( m_FileName ) )
+    return;
 
-  // Update transforms once data is read
-  UpdateTransforms();
+  GDALOverviewsBuilder::Pointer builder( GDALOverviewsBuilder::New() );
 
-  // std::cout<<"Number of resolutions in file: "<<m_AvailableResolutions.size()<<std::endl;
+  try
+    {
+    builder->SetInputFileName( m_FileName );
+    }
+  catch( itk::ExceptionObject & err )
+    {
+    otbMsgDevMacro(<<"Can not generate overviews: "<<err);
+    return;
+    }
+
+  // Existing overviews are used as is
+  if( builder->GetOverviewsCount()>0 )
+    return;
+
+  // Build levels down to the first one fitting in a tile, so that the
+  // whole image is displayed from a few tiles
+  GDALOverviewsBuilder::SizeVector sizes;
+  builder->ListResolutions( sizes, 2, 9999 );
+
+  unsigned int count = 0;
+
+  while( count<sizes.size() &&
+         std::max( sizes[ count ][ 0 ], sizes[ count ][ 1 ] )>m_TileSize )
+    ++ count;
+
+  if( count<sizes.size() )
+    ++ count;
+
+  if( count<2 )
+    return;
+
+  builder->SetResolutionFactor( 2 );
+  builder->SetNbResolutions( count );
+  builder->SetResamplingMethod( GDAL_RESAMPLING_AVERAGE );
+  builder->SetCompressionMethod( GDAL_COMPRESSION_NONE );
+  builder->SetFormat( GDAL_FORMAT_GEOTIFF );
+  builder->SetBypassEnabled( false );
+
+  m_OverviewsBuilder = builder;
+  m_OverviewsDone = false;
+  m_OverviewsSucceeded = false;
+  m_OverviewsBuilding = true;
+
+  m_OverviewsThreadId =
+    m_LoadingThreader->SpawnThread( &GlImageActor::OverviewsThreadCallback, this );
+}
+
+ITK_THREAD_RETURN_TYPE GlImageActor::OverviewsThreadCallback(void * arg)
+{
+  itk::MultiThreader::ThreadInfoStruct * threadInfo = static_cast<itk::MultiThreader::ThreadInfoStruct *>(arg);
+
+  GlImageActor * actor = static_cast<GlImageActor *>(threadInfo->UserData);
+
+  bool succeeded = true;
+
+  try
+    {
+    actor->m_OverviewsBuilder->Update();
+    }
+  catch( itk::ExceptionObject & err )
+    {
+    otbMsgDevMacro(<<"Overviews generation failed: "<<err);
+    succeeded = false;
+    }
+
+  actor->m_LoadingLock.Lock();
+  actor->m_OverviewsDone = true;
+  actor->m_OverviewsSucceeded = succeeded;
+  actor->m_LoadingLock.Unlock();
+
+  return ITK_THREAD_RETURN_VALUE;
 }
 
+void GlImageActor::StopOverviewsGeneration(bool abort)
+{
+  if( !m_OverviewsBuilding )
+    return;
+
+  if( abort )
+    m_OverviewsBuilder->AbortGenerateDataOn();
+
+  m_LoadingThreader->TerminateThread( m_OverviewsThreadId );
+
+  m_OverviewsBuilding = false;
+
+  // Release the dataset before removing its overviews
+  m_OverviewsBuilder = GDALOverviewsBuilder::Pointer();
+
+  if( abort || !m_OverviewsSucceeded )
+    {
+    std::remove( ( m_FileName + ".ovr" ).c_str() );
+    m_OverviewsSucceeded = false;
+    }
+}
+
+void GlImageActor::UpdateOverviews()
+{
+  if( !m_OverviewsBuilding )
+    return;
+
+  m_LoadingLock.Lock();
+  bool done = m_OverviewsDone;
+  m_LoadingLock.Unlock();
+
+  if( !done )
+    return;
+
+  StopOverviewsGeneration(false);
+
+  if( !m_OverviewsSucceeded )
+    return;
+
+  // Re-open the file to use the new overviews. Tiles read so far came
+  // from full resolution decimation and are discarded.
+  ClearLoadedTiles();
+
+  m_FileReader = ReaderType::New();
+  m_FileReader->SetFileName(m_FileName);
+  m_FileReader->GetOutput()->UpdateOutputInformation();
+
+  ReadAvailableResolutions();
+
+  if( m_CurrentResolution>=m_AvailableResolutions.size() )
+    m_CurrentResolution = m_AvailableResolutions.size() - 1;
+
+  if( m_CurrentResolution>0 )
+    {
+    m_FileReader->SetFileName(GetResolutionFileName(m_FileName, m_CurrentResolution));
+    m_FileReader->GetOutput()->UpdateOutputInformation();
+    }
+}
 
 void GlImageActor::GetExtent(double & ulx, double & uly, double & lrx, double & lry) const
 {
@@ -229,12 +439,18 @@ void GlImageActor::ProcessViewSettings()
 
 void GlImageActor::UpdateData()
 {
+  // Switch to overviews if they have been built meanwhile
+  UpdateOverviews();
+
   // Update resolution needed
   UpdateResolution();
 
   // First, clean existing tiles
   CleanLoadedTiles();
 
+  // Pending tiles are recomputed from the current viewport
+  m_PendingTiles.clear();
+
   // Retrieve settings
   ViewSettings::ConstPointer settings = GetSettings();
 
@@ -255,49 +471,173 @@ void GlImageActor::UpdateData()
  
   // Now we have the requested part of image, we need to find the
   // corresponding tiles
+  std::vector<RegionType> tileRegions;
+  ComputeTileRegions(requested, largest, tileRegions);
+
+  std::vector<RegionType> missingRegions;
+
+  for(std::vector<RegionType>::const_iterator it = tileRegions.begin();
+      it != tileRegions.end(); ++it)
+    {
+    Tile newTile;
+
+    newTile.m_TextureId = 0;
+    newTile.m_ImageRegion = *it;
+
+    ImageRegionToViewportQuad(newTile.m_ImageRegion,newTile.m_UL,newTile.m_UR,newTile.m_LL,newTile.m_LR,false);
+
+    newTile.m_RedIdx = m_RedIdx;
+    newTile.m_GreenIdx = m_GreenIdx;
+    newTile.m_BlueIdx = m_BlueIdx;
+    newTile.m_Resolution = m_CurrentResolution;
+    newTile.m_TileSize = m_TileSize;
+
+    if(!TileAlreadyLoaded(newTile))
+      {
+      if(m_NumberOfLoadingThreads == 0)
+        {
+        LoadTile(newTile);
+        }
+      else
+        {
+        m_PendingTiles.push_back(newTile);
+        missingRegions.push_back(newTile.m_ImageRegion);
+        }
+      }
+    }
+
+  if(m_NumberOfLoadingThreads == 0)
+    return;
+
+  // Visible tiles first
+  TileRequestQueueType queue;
+  RequestTiles(missingRegions, m_CurrentResolution, queue);
+
+  std::vector<RegionType> prefetchRegions;
+
+  // Then a ring of tiles around the viewport
+  RegionType ring = requested;
+  ring.PadByRadius(m_TileSize);
+  ring.Crop(largest);
+
+  std::vector<RegionType> ringRegions;
+  ComputeTileRegions(ring, largest, ringRegions);
+
+  for(std::vector<RegionType>::const_iterator it = ringRegions.begin();
+      it != ringRegions.end(); ++it)
+    {
+    if(std::find(tileRegions.begin(), tileRegions.end(), *it) == tileRegions.end())
+      {
+      prefetchRegions.push_back(*it);
+      }
+    }
+  RequestTiles(prefetchRegions, m_CurrentResolution, queue);
+
+  // Then the same area at the next zoom levels
+  for(int step = -1; step <= 1; step += 2)
+    {
+    int resolution = static_cast<int>(m_CurrentResolution) + step;
+
+    if(resolution < 0 || resolution >= static_cast<int>(m_AvailableResolutions.size()))
+      continue;
+
+    RegionType levelLargest;
+    IndexType levelIndex;
+    SizeType levelSize;
+    const unsigned int factor = 1 << resolution;
 
+    for(unsigned int dim = 0; dim < 2; ++dim)
+      {
+      levelSize[dim] = (m_LargestRegion.GetSize()[dim] + factor - 1) / factor;
+
+      if(step > 0)
+        {
+        levelIndex[dim] = requested.GetIndex()[dim] / 2;
+        }
+      else
+        {
+        levelIndex[dim] = requested.GetIndex()[dim] * 2;
+        }
+      }
+    levelLargest.SetSize(levelSize);
+
+    RegionType levelRequested;
+    levelRequested.SetIndex(levelIndex);
+    for(unsigned int dim = 0; dim < 2; ++dim)
+      {
+      levelSize[dim] = step > 0 ? (requested.GetSize()[dim] + 1) / 2 : requested.GetSize()[dim] * 2;
+      }
+    levelRequested.SetSize(levelSize);
+
+    if(!levelRequested.Crop(levelLargest))
+      continue;
+
+    prefetchRegions.clear();
+    ComputeTileRegions(levelRequested, levelLargest, prefetchRegions);
+    RequestTiles(prefetchRegions, resolution, queue);
+    }
+
+  // Keep room in the cache for the visible tiles: prefetching is
+  // limited to half of the cache
+  if(queue.size() > std::max(m_TileCacheSize / 2, static_cast<unsigned int>(missingRegions.size())))
+    {
+    queue.resize(std::max(m_TileCacheSize / 2, static_cast<unsigned int>(missingRegions.size())));
+    }
+
+  // Replace the previous requests, which may not be relevant anymore
+  m_LoadingLock.Lock();
+  m_RequestQueue.swap(queue);
+  m_LoadingLock.Unlock();
+
+  m_RequestCondition->Broadcast();
+}
+
+void GlImageActor::ComputeTileRegions(const RegionType & region, const RegionType & largest, std::vector<RegionType> & tiles) const
+{
   // First compute needed tiles
-  unsigned int nbTilesX = vcl_ceil(static_cast<double>(requested.GetIndex()[0] + requested.GetSize()[0])/m_TileSize) -vcl_floor(static_cast<double>(requested.GetIndex()[0])/m_TileSize);
-  unsigned int nbTilesY = vcl_ceil(static_cast<double>(requested.GetIndex()[1] + requested.GetSize()[1])/m_TileSize) -vcl_floor(static_cast<double>(requested.GetIndex()[1])/m_TileSize);
-  //unsigned int nbTilesY = vcl_ceil(static_cast<double>(requested.GetSize()[1])/m_TileSize);
-  unsigned int tileStartX = m_TileSize*(requested.GetIndex()[0]/m_TileSize);
-  unsigned int tileStartY = m_TileSize*(requested.GetIndex()[1]/m_TileSize);
-  
+  unsigned int nbTilesX = vcl_ceil(static_cast<double>(region.GetIndex()[0] + region.GetSize()[0])/m_TileSize) -vcl_floor(static_cast<double>(region.GetIndex()[0])/m_TileSize);
+  unsigned int nbTilesY = vcl_ceil(static_cast<double>(region.GetIndex()[1] + region.GetSize()[1])/m_TileSize) -vcl_floor(static_cast<double>(region.GetIndex()[1])/m_TileSize);
+  unsigned int tileStartX = m_TileSize*(region.GetIndex()[0]/m_TileSize);
+  unsigned int tileStartY = m_TileSize*(region.GetIndex()[1]/m_TileSize);
+
   SizeType tileSize;
   tileSize.Fill(m_TileSize);
-  Tile newTile;
-  
-   for(unsigned int i = 0; i < nbTilesX; ++i)
+
+  for(unsigned int i = 0; i < nbTilesX; ++i)
     {
     for(unsigned int j = 0; j<nbTilesY; ++j)
       {
-      
-      newTile.m_TextureId = 0;
-
       IndexType tileIndex;
       tileIndex[0] = static_cast<unsigned int>(tileStartX+i*m_TileSize);
       tileIndex[1] = static_cast<unsigned int>(tileStartY+j*m_TileSize);
-      
-      newTile.m_ImageRegion.SetSize(tileSize);
-      newTile.m_ImageRegion.SetIndex(tileIndex);
-
-      newTile.m_ImageRegion.Crop( largest );
-
-      ImageRegionToViewportQuad(newTile.m_ImageRegion,newTile.m_UL,newTile.m_UR,newTile.m_LL,newTile.m_LR,false);
 
-      newTile.m_RedIdx = m_RedIdx;
-      newTile.m_GreenIdx = m_GreenIdx;
-      newTile.m_BlueIdx = m_BlueIdx;
-      newTile.m_Resolution = m_CurrentResolution;
-      newTile.m_TileSize = m_TileSize;
+      RegionType tileRegion(tileIndex, tileSize);
 
-      if(!TileAlreadyLoaded(newTile))
+      if(tileRegion.Crop(largest))
         {
-        LoadTile(newTile);
+        tiles.push_back(tileRegion);
         }
       }
     }
+}
 
+void GlImageActor::RequestTiles(const std::vector<RegionType> & tiles, unsigned int resolution, TileRequestQueueType & queue)
+{
+  TileRequest request;
+  request.m_FileName = GetResolutionFileName(m_FileName, resolution);
+  request.m_Generation = m_Generation;
+  request.m_Key.m_Resolution = resolution;
+  request.m_Key.m_RedIdx = m_RedIdx;
+  request.m_Key.m_GreenIdx = m_GreenIdx;
+  request.m_Key.m_BlueIdx = m_BlueIdx;
+
+  for(std::vector<RegionType>::const_iterator it = tiles.begin();
+      it != tiles.end(); ++it)
+    {
+    request.m_Key.m_Index = it->GetIndex();
+    request.m_Key.m_Size = it->GetSize();
+    queue.push_back(request);
+    }
 }
 
 bool GlImageActor::TileAlreadyLoaded(const Tile& tile)
@@ -326,6 +666,10 @@ void GlImageActor::Render()
   //   << "\tpixel: " << m_SoftwareRendering << std::endl
   //   << "\ttile: " << m_TileSize << std::endl;
 
+  // Tiles read in the background are uploaded from the rendering
+  // thread, which owns the OpenGL context
+  UploadReadyTiles();
+
   if( !m_SoftwareRendering && !m_Shader.IsNull() )
     {
     // std::cout << "\tGLSL" << std::endl;
@@ -507,25 +851,23 @@ void GlImageActor::LoadTile(Tile& tile)
   //   << "]"
   //   << std::endl;
 
-  ExtractROIFilterType::Pointer extract = ExtractROIFilterType::New();
-
-  extract->SetInput(m_FileReader->GetOutput());
-  extract->SetExtractionRegion(tile.m_ImageRegion);
-  extract->SetChannel(tile.m_RedIdx);
-  extract->SetChannel(tile.m_GreenIdx);
-  extract->SetChannel(tile.m_BlueIdx);
-
-  // std::cout << "ExtractROIFilter::Update()...";
-  extract->Update();
-  // std::cout << "\tDONE\n";
+  if(tile.m_Image.IsNull())
+    {
+    m_LoadingLock.Lock();
+    tile.m_Image = GetCachedTile(GetTileKey(tile));
+    m_LoadingLock.Unlock();
+    }
 
-  tile.m_Image = extract->GetOutput();
+  if(tile.m_Image.IsNull())
+    {
+    ReadTile(tile);
+    }
 
   if(!m_SoftwareRendering)
     {
-    itk::ImageRegionConstIterator<VectorImageType> it(extract->GetOutput(),extract->GetOutput()->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<VectorImageType> it(tile.m_Image,tile.m_Image->GetLargestPossibleRegion());
     
-    float * buffer = new float[4*extract->GetOutput()->GetLargestPossibleRegion().GetNumberOfPixels()];
+    float * buffer = new float[4*tile.m_Image->GetLargestPossibleRegion().GetNumberOfPixels()];
     
     unsigned int idx = 0;
     
@@ -573,8 +915,8 @@ void GlImageActor::LoadTile(Tile& tile)
 // #endif
     glTexImage2D(
       GL_TEXTURE_2D, 0, GL_RGB32F,
-      extract->GetOutput()->GetLargestPossibleRegion().GetSize()[0],
-      extract->GetOutput()->GetLargestPossibleRegion().GetSize()[1], 
+      tile.m_Image->GetLargestPossibleRegion().GetSize()[0],
+      tile.m_Image->GetLargestPossibleRegion().GetSize()[1], 
       0, GL_BGRA, GL_FLOAT,
       buffer);
     
@@ -586,6 +928,292 @@ void GlImageActor::LoadTile(Tile& tile)
     // And push to loaded texture
     m_LoadedTiles.push_back(tile);
 }
+
+void GlImageActor::ReadTile(Tile& tile)
+{
+  ExtractROIFilterType::Pointer extract = ExtractROIFilterType::New();
+
+  extract->SetInput(m_FileReader->GetOutput());
+  extract->SetExtractionRegion(tile.m_ImageRegion);
+  extract->SetChannel(tile.m_RedIdx);
+  extract->SetChannel(tile.m_GreenIdx);
+  extract->SetChannel(tile.m_BlueIdx);
+
+  // std::cout << "ExtractROIFilter::Update()...";
+  extract->Update();
+  // std::cout << "\tDONE\n";
+
+  tile.m_Image = extract->GetOutput();
+  tile.m_Image->DisconnectPipeline();
+
+  m_LoadingLock.Lock();
+  AddCachedTile(GetTileKey(tile), tile.m_Image);
+  m_LoadingLock.Unlock();
+}
+
+GlImageActor::TileKey GlImageActor::GetTileKey(const Tile& tile) const
+{
+  TileKey key;
+  key.m_Resolution = tile.m_Resolution;
+  key.m_Index = tile.m_ImageRegion.GetIndex();
+  key.m_Size = tile.m_ImageRegion.GetSize();
+  key.m_RedIdx = tile.m_RedIdx;
+  key.m_GreenIdx = tile.m_GreenIdx;
+  key.m_BlueIdx = tile.m_BlueIdx;
+
+  return key;
+}
+
+GlImageActor::VectorImageType::Pointer GlImageActor::GetCachedTile(const TileKey & key)
+{
+  TileCacheType::iterator it = m_TileCache.find(key);
+
+  if(it == m_TileCache.end())
+    {
+    return VectorImageType::Pointer();
+    }
+
+  // Mark as most recently used
+  m_TileCacheLRU.splice(m_TileCacheLRU.begin(), m_TileCacheLRU, it->second.second);
+
+  return it->second.first;
+}
+
+void GlImageActor::AddCachedTile(const TileKey & key, VectorImageType * image)
+{
+  if(m_TileCacheSize == 0 || m_TileCache.count(key))
+    {
+    return;
+    }
+
+  m_TileCacheLRU.push_front(key);
+  m_TileCache[key] = CachedTileType(image, m_TileCacheLRU.begin());
+
+  // Evict least recently used tiles. Tiles loaded on GPU keep a
+  // reference to their data.
+  while(m_TileCache.size() > m_TileCacheSize)
+    {
+    m_TileCache.erase(m_TileCacheLRU.back());
+    m_TileCacheLRU.pop_back();
+    }
+}
+
+void GlImageActor::UploadReadyTiles()
+{
+  if(m_PendingTiles.empty())
+    {
+    return;
+    }
+
+  TileVectorType readyTiles;
+  TileVectorType pendingTiles;
+
+  m_LoadingLock.Lock();
+
+  // If nothing is left to read, remaining tiles have been evicted or
+  // have failed to load: they are read synchronously
+  const bool idle = m_RequestQueue.empty() && m_InFlightTiles.empty();
+
+  for(TileVectorType::iterator it = m_PendingTiles.begin();
+      it != m_PendingTiles.end(); ++it)
+    {
+    TileKey key = GetTileKey(*it);
+
+    it->m_Image = GetCachedTile(key);
+
+    if(it->m_Image.IsNotNull() || idle)
+      {
+      readyTiles.push_back(*it);
+      }
+    else
+      {
+      pendingTiles.push_back(*it);
+      }
+    }
+
+  m_LoadingLock.Unlock();
+
+  m_PendingTiles.swap(pendingTiles);
+
+  for(TileVectorType::iterator it = readyTiles.begin();
+      it != readyTiles.end(); ++it)
+    {
+    if(!TileAlreadyLoaded(*it))
+      {
+      // View settings may have changed since the tile was requested
+      ImageRegionToViewportQuad(it->m_ImageRegion,it->m_UL,it->m_UR,it->m_LL,it->m_LR,false);
+
+      LoadTile(*it);
+      }
+    }
+}
+
+bool GlImageActor::HasPendingTiles() const
+{
+  return !m_PendingTiles.empty();
+}
+
+void GlImageActor::SetNumberOfLoadingThreads(unsigned int nbThreads)
+{
+  if(nbThreads == m_NumberOfLoadingThreads)
+    {
+    return;
+    }
+
+  StopLoadingThreads();
+
+  m_NumberOfLoadingThreads = nbThreads;
+
+  // Tiles read in the background are handed over through the cache
+  if(m_NumberOfLoadingThreads > 0 && m_TileCacheSize == 0)
+    {
+    SetTileCacheSize(DefaultLoadingTileCacheSize);
+    }
+
+  StartLoadingThreads();
+
+  this->Modified();
+}
+
+void GlImageActor::SetTileCacheSize(unsigned int size)
+{
+  m_LoadingLock.Lock();
+
+  m_TileCacheSize = size;
+
+  while(m_TileCache.size() > m_TileCacheSize)
+    {
+    m_TileCache.erase(m_TileCacheLRU.back());
+    m_TileCacheLRU.pop_back();
+    }
+
+  m_LoadingLock.Unlock();
+
+  this->Modified();
+}
+
+void GlImageActor::StartLoadingThreads()
+{
+  m_StopLoading = false;
+
+  for(unsigned int i = 0; i < m_NumberOfLoadingThreads; ++i)
+    {
+    m_LoadingThreadIds.push_back(
+      m_LoadingThreader->SpawnThread(&GlImageActor::LoadingThreadCallback, this));
+    }
+}
+
+void GlImageActor::StopLoadingThreads()
+{
+  m_LoadingLock.Lock();
+  m_StopLoading = true;
+  m_RequestQueue.clear();
+  m_LoadingLock.Unlock();
+
+  m_RequestCondition->Broadcast();
+
+  for(std::vector<itk::ThreadIdType>::const_iterator it = m_LoadingThreadIds.begin();
+      it != m_LoadingThreadIds.end(); ++it)
+    {
+    m_LoadingThreader->TerminateThread(*it);
+    }
+
+  m_LoadingThreadIds.clear();
+}
+
+ITK_THREAD_RETURN_TYPE GlImageActor::LoadingThreadCallback(void * arg)
+{
+  itk::MultiThreader::ThreadInfoStruct * threadInfo = static_cast<itk::MultiThreader::ThreadInfoStruct *>(arg);
+
+  static_cast<GlImageActor *>(threadInfo->UserData)->LoadingLoop();
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+void GlImageActor::LoadingLoop()
+{
+  // Readers are not thread-safe: each thread has its own, one per
+  // resolution level of the current image
+  typedef std::map<std::string, ReaderType::Pointer> ReaderMapType;
+  ReaderMapType readers;
+  unsigned long readersGeneration = 0;
+
+  m_LoadingLock.Lock();
+
+  while(true)
+    {
+    while(!m_StopLoading && m_RequestQueue.empty())
+      {
+      m_RequestCondition->Wait(&m_LoadingLock);
+      }
+
+    if(m_StopLoading)
+      {
+      break;
+      }
+
+    TileRequest request = m_RequestQueue.front();
+    m_RequestQueue.pop_front();
+
+    if(m_TileCache.count(request.m_Key) || m_InFlightTiles.count(request.m_Key))
+      {
+      continue;
+      }
+
+    m_InFlightTiles.insert(request.m_Key);
+
+    m_LoadingLock.Unlock();
+
+    // Release the readers of the previous image
+    if(request.m_Generation != readersGeneration)
+      {
+      readers.clear();
+      readersGeneration = request.m_Generation;
+      }
+
+    VectorImageType::Pointer image;
+
+    try
+      {
+      ReaderType::Pointer & reader = readers[request.m_FileName];
+
+      if(reader.IsNull())
+        {
+        reader = ReaderType::New();
+        reader->SetFileName(request.m_FileName);
+        }
+
+      ExtractROIFilterType::Pointer extract = ExtractROIFilterType::New();
+
+      extract->SetInput(reader->GetOutput());
+      extract->SetExtractionRegion(RegionType(request.m_Key.m_Index, request.m_Key.m_Size));
+      extract->SetChannel(request.m_Key.m_RedIdx);
+      extract->SetChannel(request.m_Key.m_GreenIdx);
+      extract->SetChannel(request.m_Key.m_BlueIdx);
+      extract->Update();
+
+      image = extract->GetOutput();
+      image->DisconnectPipeline();
+      }
+    catch(itk::ExceptionObject & err)
+      {
+      otbMsgDevMacro(<<"Failed to load tile: "<<err);
+      image = VectorImageType::Pointer();
+      }
+
+    m_LoadingLock.Lock();
+
+    m_InFlightTiles.erase(request.m_Key);
+
+    // Discard tiles read from an image which has been replaced meanwhile
+    if(image.IsNotNull() && request.m_Generation == m_Generation)
+      {
+      AddCachedTile(request.m_Key, image);
+      }
+    }
+
+  m_LoadingLock.Unlock();
+}
   
 void GlImageActor::UnloadTile(Tile& tile)
 {
@@ -665,6 +1293,16 @@ void GlImageActor::ClearLoadedTiles()
     UnloadTile(*it);
     }
   m_LoadedTiles.clear();
+
+  m_PendingTiles.clear();
+
+  // Cached tiles and background reads refer to the previous image
+  m_LoadingLock.Lock();
+  ++m_Generation;
+  m_RequestQueue.clear();
+  m_TileCache.clear();
+  m_TileCacheLRU.clear();
+  m_LoadingLock.Unlock();
 }
 
 void GlImageActor::ImageRegionToViewportExtent(const RegionType& region, double & ulx, double & uly, double & lrx, double& lry) const
@@ -1038,16 +1676,8 @@ void GlImageActor::UpdateResolution()
   if(newResolution != m_CurrentResolution)
     {
     m_CurrentResolution = newResolution;
-    
-    std::ostringstream extFilename;
-    extFilename<<m_FileName;
-    if ( m_FileName.find('?') == std::string::npos )
-      {
-      extFilename << '?';
-      }
-    extFilename<<"&resol="<<m_CurrentResolution;
 
-    m_FileReader->SetFileName(extFilename.str());
+    m_FileReader->SetFileName(GetResolutionFileName(m_FileName, m_CurrentResolution));
     m_FileReader->GetOutput()->UpdateOutputInformation();
   // std::cout << "Switched to resolution: " << m_CurrentResolution <<
   // std::endl;
@@ -112,6 +112,9 @@ private:
   // Render help
   void DrawHelp();
 
+  // True if an image actor is still reading visible tiles
+  bool HasPendingTiles();
+
 
   // Update shader with current color and position
   void UpdateShaderColorAndPosition(double vpx, double vpy,otb::GlImageActor * currentActor);
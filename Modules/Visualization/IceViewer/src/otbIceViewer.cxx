@@ -21,6 +21,7 @@
 #include <algorithm>
 
 #include <otbImageMetadataInterfaceFactory.h>
+#include <itksys/SystemTools.hxx>
 
 #include "otbGlROIActor.h"
 #include "otbGlVectorActor.h"
@@ -98,6 +99,14 @@ void IceViewer::AddImage(const std::string & fname, const std::string & key, con
 					     glslVersion ) )
     actor->CreateShader();
 
+  // Build missing overviews in the background, so that zoomed-out
+  // views do not decimate the full resolution image
+  actor->OverviewsGenerationOn();
+
+  // Read tiles in the background, so that panning and zooming do not
+  // wait for the disk
+  actor->SetNumberOfLoadingThreads(2);
+
   actor->Initialize(fname);
   actor->SetVisible(true);
 
@@ -365,11 +374,37 @@ void IceViewer::Start()
 
     // Swap buffers
     glfwSwapBuffers(m_Window);
-     
-    glfwWaitEvents();
+
+    if(HasPendingTiles())
+      {
+      // Render again soon to display the tiles read in the background
+      glfwPollEvents();
+      itksys::SystemTools::Delay(20);
+      }
+    else
+      {
+      glfwWaitEvents();
+      }
     }
 }
 
+bool IceViewer::HasPendingTiles()
+{
+  std::vector<std::string> renderingOrder = m_View->GetRenderingOrder();
+
+  for(std::vector<std::string>::const_iterator it = renderingOrder.begin();
+      it != renderingOrder.end(); ++it)
+    {
+    otb::GlImageActor::Pointer imageActor = dynamic_cast<otb::GlImageActor*>(m_View->GetActor(*it).GetPointer());
+
+    if(imageActor.IsNotNull() && imageActor->GetVisible() && imageActor->HasPendingTiles())
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
 void IceViewer::DrawHud()
 {
   double posx, posy, vpx, vpy,hudposx,hudposy,hudvpx,hudvpy;
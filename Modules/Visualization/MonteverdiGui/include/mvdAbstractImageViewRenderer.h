@@ -213,6 +213,12 @@ public:
    */
   virtual void SaveScreenshot( const QString & ) const =0;
 
+  /**
+   * \return true if some visible tiles are still being read in the
+   * background, and the view should be painted again later.
+   */
+  virtual bool HasPendingTiles() const =0;
+
   /**
    */
   inline bool SetBypassRenderingEnabled( bool );
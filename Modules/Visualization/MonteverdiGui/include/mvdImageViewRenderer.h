@@ -192,6 +192,8 @@ public:
 
   void SaveScreenshot( const QString & ) const ITK_OVERRIDE;
 
+  bool HasPendingTiles() const ITK_OVERRIDE;
+
   bool
     Reproject( PointType & center,
                SpacingType & spacing,
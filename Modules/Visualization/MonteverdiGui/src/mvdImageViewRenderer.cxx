@@ -977,6 +977,9 @@ ImageViewRenderer
 	    glImageActor->CreateShader();
 	    }
 
+	  // Read tiles in the background (see ImageViewWidget::paintGL()).
+	  glImageActor->SetNumberOfLoadingThreads( 2 );
+
           glImageActor->Initialize(
             QFile::encodeName(
               vectorImageModel->GetFilename()
@@ -1178,6 +1181,32 @@ ImageViewRenderer
   m_GlView->SaveScreenshot( QFile::encodeName( filename ).constData() );
 }
 
+/*****************************************************************************/
+bool
+ImageViewRenderer
+::HasPendingTiles() const
+{
+  assert( !m_GlView.IsNull() );
+
+  otb::GlView::StringVectorType keys( m_GlView->GetRenderingOrder() );
+
+  for( otb::GlView::StringVectorType::const_iterator it( keys.begin() );
+       it != keys.end();
+       ++ it )
+    {
+    otb::GlImageActor::Pointer imageActor(
+      otb::DynamicCast< otb::GlImageActor >( m_GlView->GetActor( *it ) )
+    );
+
+    if( !imageActor.IsNull() &&
+        imageActor->GetVisible() &&
+        imageActor->HasPendingTiles() )
+      return true;
+    }
+
+  return false;
+}
+
 /*****************************************************************************/
 bool
 ImageViewRenderer
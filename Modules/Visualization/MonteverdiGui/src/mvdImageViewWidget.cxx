@@ -28,6 +28,7 @@
 //
 // Qt includes (sorted by alphabetic order)
 //// Must be included before system/custom includes.
+#include <QTimer>
 
 //
 // System includes (sorted by alphabetic order)
@@ -693,6 +694,12 @@ ImageViewWidget
   // OpenGL paint using new rendering-context.
   m_Renderer->PaintGL( c );
 
+  //
+  // Paint again later while tiles are read in the background.
+  if( !m_Renderer->IsBypassRenderingEnabled() &&
+      m_Renderer->HasPendingTiles() )
+    QTimer::singleShot( 20, this, SLOT( updateGL() ) );
+
   //
   // Post-rendering tasks.
   if( !m_Renderer->IsBypassRenderingEnabled() &&